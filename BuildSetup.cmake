@@ -45,6 +45,31 @@ else()
     message( ERROR "CMAKE_SYSTEM_NAME = ${CMAKE_SYSTEM_NAME}, not supported. Currently supported: Linux, Darwin, SunOS, Windows" )
 endif()
 
+#----------------------------------------
+# Language standard and threads.  The library
+# uses C++11 threads, so select C++11 unless
+# another -std flag was given on the command line.
+#----------------------------------------
+if( (CMAKE_COMPILER_IS_GNUCXX OR ${CMAKE_CXX_COMPILER_ID} MATCHES "Clang")
+    AND NOT CMAKE_CXX_FLAGS MATCHES "-std=" )
+    set( CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -std=c++11" )
+endif()
+find_package( Threads REQUIRED )
+
+#----------------------------------------
+# Optional system BLAS for the Matrix
+# product kernels (see MatrixKernels.hpp)
+#----------------------------------------
+if( USE_BLAS )
+    find_package( BLAS )
+    if( BLAS_FOUND )
+        message( STATUS "Using BLAS for Matrix products: ${BLAS_LIBRARIES}" )
+        add_definitions( -DGPSTK_HAVE_BLAS )
+    else()
+        message( WARNING "USE_BLAS=ON but no BLAS was found; using the built-in Matrix kernels" )
+    endif()
+endif()
+
 #----------------------------------------
 # When doing a debug build, enable the
 # address sanitizer. This has a 2x slowdown
@@ -189,6 +189,7 @@ public:
    string Obspath,SP3path,Navpath;      // paths
 
    bool dumpHeader;              // input dump headers
+   bool useCache;                // read obs files through binary caches
    vector<RinexSatID> InputSats; // input RinexSatID to dump
    vector<string> InputTags;     // input all tags
    vector<string> InputCombos;   // input linear combination tags
@@ -786,7 +787,7 @@ void Configuration::SetDefaults(void) throw()
    elevlimit = 0.0;
 
    userfmt = gpsfmt;
-   help = verbose = noHeader = dumpHeader = doTECU = false;
+   help = verbose = noHeader = dumpHeader = doTECU = useCache = false;
    debug = -1;
 
    NonObsTags.push_back("RNG");
@@ -1226,6 +1227,8 @@ string Configuration::BuildCommandLine(void) throw()
             "         with optional weather T(C),P(mb),RH(%)]");
    opts.Add(0,"ionoht", "ht", false, false, &IonoHt, "",
             "Ionospheric height in kilometers [for VI, LAT, LON]");
+   opts.Add(0, "cache", "", false, false, &useCache, "",
+            "Read obs via (and create) binary cache files <file>.gpstkobs");
 
    opts.Add(0, "timefmt", "fmt", false, false, &userfmt, "# Output:",
             "Format for time tags (see GPSTK::Epoch::printf) in output");
@@ -1495,6 +1498,7 @@ try {
       else
          LOG(DEBUG) << "Opened input file " << filename;
       istrm.exceptions(ios::failbit);
+      istrm.useCache = C.useCache;
 
       // read the header ----------------------------------------------
       try { istrm >> Rhead; }
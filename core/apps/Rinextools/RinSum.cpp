@@ -66,6 +66,7 @@
 #include "Rinex3ObsStream.hpp"
 #include "Rinex3ObsHeader.hpp"
 #include "Rinex3ObsData.hpp"
+#include "Rinex3ObsTable.hpp"
 #include "RinexUtilities.hpp"
 
 #include "msecHandler.hpp"
@@ -111,7 +112,7 @@ private:
       endTime.setTimeSystem(TimeSystem::Any);
       userfmt = gpsfmt;
       help = verbose = brief = nohead = notab = gpstime = sorttime = vistab
-         = dogaps = doms = ycode = quiet = false;
+         = dogaps = doms = ycode = quiet = usecache = false;
       debug = -1;
       dt = -1.0;
       vres = 0;
@@ -126,7 +127,7 @@ public:
 
       // start command line input
    bool help, verbose, brief, nohead, notab, gpstime, sorttime, dogaps, doms,
-      vistab, ycode, quiet;
+      vistab, ycode, quiet, usecache;
    int debug, vres;
    double dt;
    string cfgfile, userfmt;
@@ -482,6 +483,8 @@ string Configuration::BuildCommandLine(void) throw()
 
    opts.Add(0, "ycode", "", false, false, &ycode, "# Other:",
             "Assume v2.11 P mean Y");
+   opts.Add(0, "cache", "", false, false, &usecache, "",
+            "Read data via (and create) binary cache files <file>.gpstkobs");
    opts.Add(0, "verbose", "", false, false, &verbose, "",
             "Print extra output information");
    opts.Add(0, "debug", "", false, false, &debug, "",
@@ -707,6 +710,7 @@ int ProcessFiles(void) throw(Exception)
             continue;
          }
          istrm.exceptions(ios::failbit);
+         istrm.useCache = C.usecache;
 
          // get file size - on windows its different b/c of CRs
          //char ch;
@@ -789,6 +793,7 @@ int ProcessFiles(void) throw(Exception)
          int nepochs(0), ncommentblocks(0), nmaxobs(0);
          vector<TableData> table;            // table of counts per sat,obs
          map<char, vector<int> > totals;     // totals per system,obs
+         Rinex3ObsTable obsTable;            // the epochs that are counted
 
          prevObsTime = CommonTime::BEGINNING_OF_TIME;
          firstObsTime = CommonTime::BEGINNING_OF_TIME;
@@ -981,6 +986,10 @@ int ProcessFiles(void) throw(Exception)
                   // TD test after 50 epochs - wrong dt is disasterous
             }
 
+               // keep the data; the counts are computed column-wise
+               // once the whole file has been read
+            obsTable.addEpoch(Rdata);
+
                // loop over satellites -------------------------------------
             Rinex3ObsData::DataMap::const_iterator it;
             for(it=Rdata.obs.begin(); it != Rdata.obs.end(); ++it)
@@ -1042,25 +1051,20 @@ int ProcessFiles(void) throw(Exception)
                   oss << "Sat " << setw(2) << sat;
                }
 
+                  // only debug output and the millisecond handler
+                  // need the individual observations
+               if(!C.doms && C.debug < 0)
+                  continue;
+
                   // first, find the current system...
                char sysCode = sat.systemChar();
                string sysStr(string(1,sysCode));
 
-                  // update Obs data totals
                for(size_t index=0; index != vecData.size(); index++)
                {
                   if(C.debug > -1)
                      oss << " (" << index << ")";
 
-                     // if this observation is not zero, update it's total count
-                  if(vecData[index].data != 0)
-                  {
-                     (ptab->nobs)[index]++;                 // per obs
-                     if(totals[sysCode].size() == 0)
-                        totals[sysCode] = vector<int>(vecData.size());
-                     totals[sysCode][index]++;              // per system
-                  }
-
                      // if looking for milliseconds, update handler
                   if(C.doms && vecData[index].data != 0)
                   {
@@ -1139,6 +1143,26 @@ int ProcessFiles(void) throw(Exception)
 
          istrm.close();
 
+            // update Obs data totals: count the non-zero data of each
+            // included satellite, per obs and per system
+         for(i=0; i<table.size(); i++)
+         {
+            Rinex3ObsTable::SatMap::const_iterator cit;
+            cit = obsTable.sats.find(table[i].sat);
+            if(cit == obsTable.sats.end())
+               continue;
+            const vector<vector<double> >& cols(cit->second.data);
+            char sysCode = table[i].sat.systemChar();
+            if(totals[sysCode].size() == 0)
+               totals[sysCode] = vector<int>(cols.size());
+            for(j=0; j<cols.size(); j++)
+            {
+               int n = Rinex3ObsTable::countNonZero(cols[j]);
+               table[i].nobs[j] += n;                 // per obs
+               totals[sysCode][j] += n;               // per system
+            }
+         }
+
             // check that we found some data
          if(nepochs <= 0)
          {
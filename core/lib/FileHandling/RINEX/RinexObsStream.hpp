@@ -48,6 +48,7 @@
 #include <string>
 
 #include "FFTextStream.hpp"
+#include "CommonTime.hpp"
 #include "RinexObsHeader.hpp"
 
 namespace gpstk
@@ -109,6 +110,11 @@ namespace gpstk
          /// The header for this file.
       RinexObsHeader header;
 
+         /** Time of the last epoch read that carried a time.  Event
+          * records (epoch flags 2-4) may omit the epoch time, in
+          * which case this time is used instead. */
+      CommonTime previousTime;
+
          /// Check if the input stream is the kind of RinexObsStream
       static bool isRinexObsStream(std::istream& i);
 
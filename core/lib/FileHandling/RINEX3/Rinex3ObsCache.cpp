@@ -0,0 +1,447 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file Rinex3ObsCache.cpp
+ * Binary cache of the epoch records of a RINEX observation file.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "StringUtils.hpp"
+#include "Rinex3ObsCache.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+      /// Identifies a cache file.
+   static const char cacheMagic[8] = { 'G','P','S','T','K','O','B','S' };
+      /// Written in native byte order to detect foreign caches.
+   static const uint32_t byteOrderMark = 0x01020304;
+
+      /// Blank flags of an observation, packed into one byte.
+   enum CacheBlankBits
+   {
+      cacheDataBlank = 0x01,
+      cacheLLIBlank  = 0x02,
+      cacheSSIBlank  = 0x04
+   };
+
+
+      /// Append the bytes of \a val to \a buf.
+   template <class T>
+   static void putValue(string& buf, const T& val)
+   {
+      buf.append(reinterpret_cast<const char*>(&val), sizeof(T));
+   }
+
+
+      /** Decode a value from \a buf at \a pos and advance \a pos.
+       * @throw FFStreamError if \a buf is too short. */
+   template <class T>
+   static T getValue(const string& buf, size_t& pos)
+   {
+      if (pos + sizeof(T) > buf.size())
+      {
+         FFStreamError e("Truncated RINEX observation cache");
+         GPSTK_THROW(e);
+      }
+      T val;
+      memcpy(&val, buf.data() + pos, sizeof(T));
+      pos += sizeof(T);
+      return val;
+   }
+
+
+      /// Adler-32 checksum of \a buf.
+   static uint32_t adler32(const string& buf)
+   {
+      const uint32_t mod = 65521;
+      uint32_t a = 1, b = 0;
+      const unsigned char *p = reinterpret_cast<const unsigned char*>(
+         buf.data());
+      size_t n = buf.size();
+      while (n > 0)
+      {
+            // 5552 bytes is the longest run that can't overflow b
+         size_t block = (n < 5552) ? n : 5552;
+         n -= block;
+         while (block-- > 0)
+         {
+            a += *p++;
+            b += a;
+         }
+         a %= mod;
+         b %= mod;
+      }
+      return (b << 16) | a;
+   }
+
+
+      /// Split \a text into lines, dropping line terminators.
+   static vector<string> splitLines(const string& text)
+   {
+      vector<string> lines;
+      size_t start = 0;
+      while (start < text.size())
+      {
+         size_t end = text.find('\n', start);
+         if (end == string::npos)
+            end = text.size();
+         string line(text, start, end - start);
+         while (!line.empty() && (line[line.size()-1] == '\r'))
+            line.erase(line.size()-1);
+         lines.push_back(line);
+         start = end + 1;
+      }
+      return lines;
+   }
+
+
+   const unsigned Rinex3ObsCache::version = 1;
+
+
+   string Rinex3ObsCache ::
+   cacheName(const std::string& fn)
+   {
+      return fn + ".gpstkobs";
+   }
+
+
+   Rinex3ObsCache ::
+   Rinex3ObsCache()
+         : mode(idle), sourceSize(0), sourceTime(0), pos(0)
+   {
+   }
+
+
+   bool Rinex3ObsCache ::
+   getFileInfo(const std::string& fn, long long& size, long long& mtime)
+   {
+      struct stat st;
+      if (stat(fn.c_str(), &st) != 0)
+         return false;
+      size = st.st_size;
+      mtime = st.st_mtime;
+      return true;
+   }
+
+
+   bool Rinex3ObsCache ::
+   openRead(const std::string& fn, const std::string& headerText)
+   {
+      close();
+      if (!getFileInfo(fn, sourceSize, sourceTime))
+         return false;
+
+      ifstream ifs(cacheName(fn).c_str(), ios::in | ios::binary);
+      if (!ifs)
+         return false;
+      string buf;
+      ifs.seekg(0, ios::end);
+      streamoff len = ifs.tellg();
+      if (len <= 0)
+         return false;
+      buf.resize(static_cast<size_t>(len));
+      ifs.seekg(0, ios::beg);
+      if (!ifs.read(&buf[0], len))
+         return false;
+
+      try
+      {
+         size_t p = 0;
+         if ((buf.size() < sizeof(cacheMagic)) ||
+             (memcmp(buf.data(), cacheMagic, sizeof(cacheMagic)) != 0))
+            return false;
+         p += sizeof(cacheMagic);
+         if ((getValue<uint32_t>(buf, p) != version) ||
+             (getValue<uint32_t>(buf, p) != byteOrderMark) ||
+             (getValue<int64_t>(buf, p) != sourceSize) ||
+             (getValue<int64_t>(buf, p) != sourceTime))
+            return false;
+         uint64_t hdrLen = getValue<uint64_t>(buf, p);
+         if ((hdrLen != headerText.size()) || (p + hdrLen > buf.size()) ||
+             (buf.compare(p, hdrLen, headerText) != 0))
+            return false;
+         p += hdrLen;
+         uint64_t payLen = getValue<uint64_t>(buf, p);
+         uint32_t check = getValue<uint32_t>(buf, p);
+         if (p + payLen != buf.size())
+            return false;
+         payload.assign(buf, p, payLen);
+         if (adler32(payload) != check)
+         {
+            payload.clear();
+            return false;
+         }
+      }
+      catch (FFStreamError& e)
+      {
+         return false;
+      }
+
+      source = fn;
+      header = headerText;
+      pos = 0;
+      mode = reading;
+      return true;
+   }
+
+
+   bool Rinex3ObsCache ::
+   getRecord(Rinex3ObsData& rod, double rinexVersion)
+      throw(FFStreamError)
+   {
+      if ((mode != reading) || (pos >= payload.size()))
+         return false;
+
+      try
+      {
+            // the RINEX 3 parser starts each record from scratch
+         if (rinexVersion >= 3)
+            rod = Rinex3ObsData();
+
+         int64_t day = getValue<int64_t>(payload, pos);
+         int64_t msod = getValue<int64_t>(payload, pos);
+         double fsod = getValue<double>(payload, pos);
+         int32_t ts = getValue<int32_t>(payload, pos);
+         rod.time.setInternal(day, msod, fsod, TimeSystem(ts));
+         rod.epochFlag = getValue<int16_t>(payload, pos);
+         rod.numSVs = getValue<int16_t>(payload, pos);
+         rod.clockOffset = getValue<double>(payload, pos);
+
+         uint32_t auxLen = getValue<uint32_t>(payload, pos);
+         if (pos + auxLen > payload.size())
+         {
+            FFStreamError e("Truncated RINEX observation cache");
+            GPSTK_THROW(e);
+         }
+         if (auxLen > 0)
+         {
+            vector<string> lines(splitLines(payload.substr(pos, auxLen)));
+            pos += auxLen;
+            rod.auxHeader.clear();
+            for (size_t i = 0; i < lines.size(); i++)
+            {
+               StringUtils::stripTrailing(lines[i]);
+               rod.auxHeader.parseHeaderRecord(lines[i]);
+            }
+         }
+
+         uint32_t numSats = getValue<uint32_t>(payload, pos);
+         if ((rod.epochFlag == 0) || (rod.epochFlag == 1) ||
+             (rod.epochFlag == 6))
+            rod.obs.clear();
+         for (uint32_t s = 0; s < numSats; s++)
+         {
+            RinexSatID sat;
+            sat.system = static_cast<SatID::SatelliteSystem>(
+               getValue<int32_t>(payload, pos));
+            sat.id = getValue<int32_t>(payload, pos);
+            uint32_t numObs = getValue<uint32_t>(payload, pos);
+            vector<RinexDatum>& vec = rod.obs[sat];
+            vec.resize(numObs);
+            for (uint32_t i = 0; i < numObs; i++)
+            {
+               RinexDatum& rd(vec[i]);
+               rd.data = getValue<double>(payload, pos);
+               rd.lli = getValue<int16_t>(payload, pos);
+               rd.ssi = getValue<int16_t>(payload, pos);
+               uint8_t blank = getValue<uint8_t>(payload, pos);
+               rd.dataBlank = (blank & cacheDataBlank) != 0;
+               rd.lliBlank = (blank & cacheLLIBlank) != 0;
+               rd.ssiBlank = (blank & cacheSSIBlank) != 0;
+            }
+         }
+      }
+      catch (FFStreamError& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+      catch (Exception& e)
+      {
+         FFStreamError err(e);
+         err.addText("In RINEX observation cache of " + source);
+         GPSTK_THROW(err);
+      }
+      return true;
+   }
+
+
+   bool Rinex3ObsCache ::
+   openWrite(const std::string& fn, const std::string& headerText)
+   {
+      close();
+      if (!getFileInfo(fn, sourceSize, sourceTime))
+         return false;
+      source = fn;
+      header = headerText;
+      mode = writing;
+      return true;
+   }
+
+
+   void Rinex3ObsCache ::
+   addRecord(const Rinex3ObsData& rod, const std::string& recordText)
+   {
+      if (mode != writing)
+         return;
+
+      long day, msod;
+      double fsod;
+      TimeSystem ts;
+      rod.time.getInternal(day, msod, fsod, ts);
+      putValue<int64_t>(payload, day);
+      putValue<int64_t>(payload, msod);
+      putValue<double>(payload, fsod);
+      putValue<int32_t>(payload, ts.getTimeSystem());
+      putValue<int16_t>(payload, rod.epochFlag);
+      putValue<int16_t>(payload, rod.numSVs);
+      putValue<double>(payload, rod.clockOffset);
+
+         // Auxiliary header records are kept as the text of their
+         // header lines, which are the last numSVs lines of the record.
+      string aux;
+      if ((rod.epochFlag >= 2) && (rod.epochFlag <= 5) && (rod.numSVs > 0))
+      {
+         vector<string> lines(splitLines(recordText));
+         size_t first = (lines.size() > size_t(rod.numSVs))
+            ? lines.size() - rod.numSVs : 0;
+         for (size_t i = first; i < lines.size(); i++)
+            aux += lines[i] + "\n";
+      }
+      putValue<uint32_t>(payload, aux.size());
+      payload += aux;
+
+      bool hasObs = ((rod.epochFlag == 0) || (rod.epochFlag == 1) ||
+                     (rod.epochFlag == 6));
+      putValue<uint32_t>(payload, hasObs ? rod.obs.size() : 0);
+      if (!hasObs)
+         return;
+      Rinex3ObsData::DataMap::const_iterator it;
+      for (it = rod.obs.begin(); it != rod.obs.end(); it++)
+      {
+         putValue<int32_t>(payload, it->first.system);
+         putValue<int32_t>(payload, it->first.id);
+         putValue<uint32_t>(payload, it->second.size());
+         for (size_t i = 0; i < it->second.size(); i++)
+         {
+            const RinexDatum& rd(it->second[i]);
+            putValue<double>(payload, rd.data);
+            putValue<int16_t>(payload, rd.lli);
+            putValue<int16_t>(payload, rd.ssi);
+            putValue<uint8_t>(payload,
+                              (rd.dataBlank ? cacheDataBlank : 0) |
+                              (rd.lliBlank ? cacheLLIBlank : 0) |
+                              (rd.ssiBlank ? cacheSSIBlank : 0));
+         }
+      }
+   }
+
+
+   bool Rinex3ObsCache ::
+   write()
+   {
+      if (mode != writing)
+         return false;
+
+      string name(cacheName(source));
+      ostringstream tmp;
+      tmp << name << ".tmp";
+#ifndef _WIN32
+      tmp << getpid();
+#endif
+      tmp << "." << this;
+      string tmpName(tmp.str());
+
+      bool ok;
+      {
+         ofstream ofs(tmpName.c_str(), ios::out | ios::binary | ios::trunc);
+         if (!ofs)
+         {
+            close();
+            return false;
+         }
+         string head(cacheMagic, sizeof(cacheMagic));
+         putValue<uint32_t>(head, version);
+         putValue<uint32_t>(head, byteOrderMark);
+         putValue<int64_t>(head, sourceSize);
+         putValue<int64_t>(head, sourceTime);
+         putValue<uint64_t>(head, header.size());
+         head += header;
+         putValue<uint64_t>(head, payload.size());
+         putValue<uint32_t>(head, adler32(payload));
+         ofs.write(head.data(), head.size());
+         ofs.write(payload.data(), payload.size());
+         ofs.close();
+         ok = !ofs.fail();
+      }
+      if (ok && (std::rename(tmpName.c_str(), name.c_str()) != 0))
+      {
+            // rename() doesn't replace an existing file everywhere
+         std::remove(name.c_str());
+         ok = (std::rename(tmpName.c_str(), name.c_str()) == 0);
+      }
+      if (!ok)
+         std::remove(tmpName.c_str());
+      close();
+      return ok;
+   }
+
+
+   void Rinex3ObsCache ::
+   close()
+   {
+      mode = idle;
+      source.clear();
+      header.clear();
+      payload.clear();
+      pos = 0;
+      sourceSize = sourceTime = 0;
+   }
+
+} // namespace gpstk
@@ -0,0 +1,175 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file Rinex3ObsCache.hpp
+ * Binary cache of the epoch records of a RINEX observation file.
+ */
+
+#ifndef GPSTK_RINEX3OBSCACHE_HPP
+#define GPSTK_RINEX3OBSCACHE_HPP
+
+#include <string>
+
+#include "Exception.hpp"
+#include "FFStream.hpp"
+#include "Rinex3ObsData.hpp"
+
+namespace gpstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * This class reads and writes a binary cache of the epoch
+       * records of a RINEX observation file (version 2 or 3), so
+       * that a file which is processed repeatedly only has to be
+       * parsed once.  The cache is a sidecar file named after the
+       * source file (see cacheName()) and holds the records in the
+       * machine's native binary format: epoch time, flag, clock
+       * offset and, per satellite, the data, LLI, SSI and blank
+       * flags of each observation.  The raw text of auxiliary header
+       * records (epoch flags 2-5) is stored and re-parsed when read.
+       *
+       * A cache is only used if it matches its source: the size and
+       * modification time of the source file, and the complete text
+       * of the RINEX header, must be the same as when the cache was
+       * written.  The payload carries an Adler-32 checksum, and
+       * caches written on a machine of different byte order or with
+       * a different format version are ignored.  An unusable cache
+       * is never an error; the source file is simply parsed again.
+       *
+       * Normally this class is not used directly but through
+       * Rinex3ObsStream::useCache.
+       *
+       * @sa Rinex3ObsStream and Rinex3ObsData.
+       */
+   class Rinex3ObsCache
+   {
+   public:
+         /// Version of the cache file format.
+      static const unsigned version;
+
+         /// Return the name of the cache file for the source file \a fn.
+      static std::string cacheName(const std::string& fn);
+
+         /// Default constructor, neither reading nor writing.
+      Rinex3ObsCache();
+
+         /** Load the cache of a source file.
+          * @param[in] fn the source RINEX file.
+          * @param[in] headerText the raw text of the RINEX header
+          *   of \a fn, as currently in the file.
+          * @return true if a cache matching \a fn was found and
+          *   loaded, in which case the records are available through
+          *   getRecord().
+          */
+      bool openRead(const std::string& fn, const std::string& headerText);
+
+         /** Get the next record from a loaded cache.  The record is
+          * filled in the same way as by Rinex3ObsData::reallyGetRecord.
+          * @param[in,out] rod the record to fill.
+          * @param[in] rinexVersion the RINEX version of the source.
+          * @return false if there are no more records.
+          * @throw FFStreamError if the cache is corrupt.
+          */
+      bool getRecord(Rinex3ObsData& rod, double rinexVersion)
+         throw(FFStreamError);
+
+         /** Start collecting records for a new cache.
+          * @param[in] fn the source RINEX file.
+          * @param[in] headerText the raw text of the RINEX header of \a fn.
+          * @return false if the source can't be examined.
+          */
+      bool openWrite(const std::string& fn, const std::string& headerText);
+
+         /** Add a record to the cache being collected.
+          * @param[in] rod the record as read from the source.
+          * @param[in] recordText the raw text of the record; only
+          *   used for auxiliary header records.
+          */
+      void addRecord(const Rinex3ObsData& rod, const std::string& recordText);
+
+         /** Write the collected records to the cache file.  The file
+          * is written under a temporary name and then renamed, so
+          * other readers never see a partial cache.
+          * @return true on success.
+          */
+      bool write();
+
+         /// Forget any loaded or collected records.
+      void close();
+
+         /// Return true if records are being read from a cache.
+      bool isReading() const
+      { return mode == reading; }
+
+         /// Return true if records are being collected for a cache.
+      bool isWriting() const
+      { return mode == writing; }
+
+   private:
+         /// What the object is currently doing.
+      enum Mode
+      {
+         idle,
+         reading,
+         writing
+      };
+
+         /// Get the size and modification time of a file.
+      static bool getFileInfo(const std::string& fn,
+                              long long& size, long long& mtime);
+
+      Mode mode;
+         /// The source file name.
+      std::string source;
+         /// Size and modification time of the source file.
+      long long sourceSize, sourceTime;
+         /// Raw header text of the source file.
+      std::string header;
+         /// Encoded records.
+      std::string payload;
+         /// Read position in #payload.
+      size_t pos;
+   }; // class Rinex3ObsCache
+
+      //@}
+
+} // namespace gpstk
+
+#endif // GPSTK_RINEX3OBSCACHE_HPP
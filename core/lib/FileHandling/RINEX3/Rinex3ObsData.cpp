@@ -362,8 +362,6 @@ namespace gpstk
    void reallyGetRecordVer2(Rinex3ObsStream& strm, Rinex3ObsData& rod)
       throw(Exception)
    {
-      static CommonTime previousTime(CommonTime::BEGINNING_OF_TIME);
-
          // get the epoch line and check
       string line;
       while(line.empty())        // ignore blank lines in place of epoch lines
@@ -377,7 +375,7 @@ namespace gpstk
       }
 
          // process the epoch line, including SV list and clock bias
-      rod.epochFlag = asInt(line.substr(28,1));
+      rod.epochFlag = asInt(line, 28, 1);
       if((rod.epochFlag < 0) || (rod.epochFlag > 6))
       {
          FFStreamError e("Invalid epoch flag: " + asString(rod.epochFlag));
@@ -399,7 +397,7 @@ namespace gpstk
          GPSTK_THROW(e);
       }
       else if(noEpochTime)
-         rod.time = previousTime;
+         rod.time = strm.previousTime;
       else
       {
          try
@@ -424,12 +422,12 @@ namespace gpstk
                int yy = (static_cast<CivilTime>(strm.header.firstObs)).year/100;
                yy *= 100;
 
-               year  = asInt(   line.substr(1,  2 ));
-               month = asInt(   line.substr(4,  2 ));
-               day   = asInt(   line.substr(7,  2 ));
-               hour  = asInt(   line.substr(10, 2 ));
-               min   = asInt(   line.substr(13, 2 ));
-               sec   = asDouble(line.substr(15, 11));
+               year  = asInt(   line, 1, 2);
+               month = asInt(   line, 4, 2);
+               day   = asInt(   line, 7, 2);
+               hour  = asInt(   line, 10, 2);
+               min   = asInt(   line, 13, 2);
+               sec   = asDouble(line, 15, 11);
 
                   // Real Rinex has epochs 'yy mm dd hr 59 60.0'
                   // surprisingly often....
@@ -460,15 +458,15 @@ namespace gpstk
             // end rod.time = parseTime(line, strm.header);
 
             // save for next call
-         previousTime = rod.time;
+         strm.previousTime = rod.time;
       }
 
          // number of satellites
-      rod.numSVs = asInt(line.substr(29,3));
+      rod.numSVs = asInt(line, 29, 3);
 
          // clock offset
       if(line.size() > 68 )
-         rod.clockOffset = asDouble(line.substr(68, 12));
+         rod.clockOffset = asDouble(line, 68, 12);
       else
          rod.clockOffset = 0.0;
 
@@ -539,7 +537,7 @@ namespace gpstk
                string R3ot(strm.header.mapSysR2toR3ObsID[satsys][R2ot].asString());
                if(R3ot != string("   "))
                {
-                  RinexDatum tempData(line.substr(line_ndx*16, 16));
+                  RinexDatum tempData(line, line_ndx*16);
                   data.push_back(tempData);
                }
             }
@@ -613,7 +611,7 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
-      epochFlag = asInt(line.substr(31,1));
+      epochFlag = asInt(line, 31, 1);
       if(epochFlag < 0 || epochFlag > 6)
       {
          FFStreamError e("Invalid epoch flag: " + asString(epochFlag));
@@ -622,10 +620,10 @@ namespace gpstk
 
       time = parseTime(line, strm.header, strm.timesystem);
 
-      numSVs = asInt(line.substr(32,3));
+      numSVs = asInt(line, 32, 3);
 
       if(line.size() > 41)
-         clockOffset = asDouble(line.substr(41,15));
+         clockOffset = asDouble(line, 41, 15);
       else
          clockOffset = 0.0;
 
@@ -671,7 +669,7 @@ namespace gpstk
             for(int i = 0; i < size; i++)
             {
                size_t pos = 3 + 16*i;
-               RinexDatum tempData(line.substr(pos,16));
+               RinexDatum tempData(line, pos);
                data.push_back(tempData);
             }
             obs[satIndex[isv]] = data;
@@ -730,12 +728,12 @@ namespace gpstk
          int year, month, day, hour, min;
          double sec;
 
-         year  = asInt(   line.substr( 2,  4));
-         month = asInt(   line.substr( 7,  2));
-         day   = asInt(   line.substr(10,  2));
-         hour  = asInt(   line.substr(13,  2));
-         min   = asInt(   line.substr(16,  2));
-         sec   = asDouble(line.substr(19, 11));
+         year  = asInt(   line, 2, 4);
+         month = asInt(   line, 7, 2);
+         day   = asInt(   line, 10, 2);
+         hour  = asInt(   line, 13, 2);
+         min   = asInt(   line, 16, 2);
+         sec   = asDouble(line, 19, 11);
 
             // Real Rinex has epochs 'yy mm dd hr 59 60.0' surprisingly often.
          double ds = 0;
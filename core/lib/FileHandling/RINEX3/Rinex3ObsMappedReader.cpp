@@ -0,0 +1,487 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file Rinex3ObsMappedReader.cpp
+ * Memory-mapped reader for RINEX 3 observation files.
+ */
+
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "StringUtils.hpp"
+#include "CivilTime.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsMappedReader.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+      /** Decode a RINEX satellite ID in place.  The common forms are
+       * handled directly, anything else goes through RinexSatID's
+       * string constructor so that the results (and errors) are the
+       * same as Rinex3ObsData. */
+   static RinexSatID parseSat(const char *p, size_t n)
+   {
+      SatID::SatelliteSystem sys;
+      switch ((n > 0) ? p[0] : ' ')
+      {
+         case 'G': sys = SatID::systemGPS;     break;
+         case 'R': sys = SatID::systemGlonass; break;
+         case 'E': sys = SatID::systemGalileo; break;
+         case 'S': sys = SatID::systemGeosync; break;
+         case 'J': sys = SatID::systemQZSS;    break;
+         case 'C': sys = SatID::systemBeiDou;  break;
+         case 'I': sys = SatID::systemIRNSS;   break;
+         case 'T': sys = SatID::systemTransit; break;
+         default:
+            return RinexSatID(string(p, n));
+      }
+      int id = 0;
+      size_t i = 1;
+      while ((i < n) && (p[i] == ' '))
+         i++;
+      if (i == n)
+         return RinexSatID(string(p, n));
+      for ( ; i < n; i++)
+      {
+         if ((p[i] < '0') || (p[i] > '9'))
+            return RinexSatID(string(p, n));
+         id = id * 10 + (p[i] - '0');
+      }
+      return RinexSatID((id > 0) ? id : -1, sys);
+   }
+
+
+   Rinex3ObsMappedReader ::
+   Rinex3ObsMappedReader()
+         : timesystem(TimeSystem::GPS), lineNumber(0), recordNumber(0),
+           fileData(0), fileSize(0), pos(0), opened(false), mapped(false)
+   {
+   }
+
+
+   Rinex3ObsMappedReader ::
+   Rinex3ObsMappedReader(const std::string& fn)
+      throw(FFStreamError)
+         : timesystem(TimeSystem::GPS), lineNumber(0), recordNumber(0),
+           fileData(0), fileSize(0), pos(0), opened(false), mapped(false)
+   {
+      open(fn);
+   }
+
+
+   Rinex3ObsMappedReader ::
+   ~Rinex3ObsMappedReader()
+   {
+      close();
+   }
+
+
+   void Rinex3ObsMappedReader ::
+   open(const std::string& fn)
+      throw(FFStreamError)
+   {
+      close();
+      filename = fn;
+
+         // The header is read with the regular stream, it's only a
+         // few dozen lines and shares all the validation logic.
+      Rinex3ObsStream strm(fn.c_str(), ios::in);
+      if (!strm)
+      {
+         FFStreamError e("Unable to open " + fn);
+         GPSTK_THROW(e);
+      }
+      strm.exceptions(ios::failbit);
+      try
+      {
+         strm >> header;
+      }
+      catch (Exception& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+      catch (std::exception& e)
+      {
+         FFStreamError err("std::exception: " + string(e.what()));
+         GPSTK_THROW(err);
+      }
+      if (header.version < 3)
+      {
+         FFStreamError e("Rinex3ObsMappedReader only supports RINEX 3, "
+                         + fn + " is version "
+                         + StringUtils::asString(header.version, 2));
+         GPSTK_THROW(e);
+      }
+      timesystem = strm.timesystem;
+      lineNumber = strm.lineNumber;
+      pos = static_cast<size_t>(strm.tellg());
+      strm.close();
+
+      for (int i = 0; i < 128; i++)
+         numObsTypes[i] = 0;
+      Rinex3ObsHeader::RinexObsMap::const_iterator oti;
+      for (oti = header.mapObsTypes.begin(); oti != header.mapObsTypes.end();
+           oti++)
+      {
+         if (oti->first.size() == 1)
+            numObsTypes[oti->first[0] & 0x7f] = oti->second.size();
+      }
+
+#ifndef _WIN32
+      int fd = ::open(fn.c_str(), O_RDONLY);
+      struct stat st;
+      if ((fd >= 0) && (fstat(fd, &st) == 0))
+      {
+         fileSize = st.st_size;
+         if (fileSize == 0)
+         {
+            mapped = false;
+         }
+         else
+         {
+            void *addr = mmap(0, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED)
+            {
+               madvise(addr, fileSize, MADV_SEQUENTIAL);
+               fileData = static_cast<const char*>(addr);
+               mapped = true;
+            }
+         }
+      }
+      if (fd >= 0)
+         ::close(fd);
+#endif
+
+      if (!mapped)
+      {
+            // fall back to one big read
+         ifstream ifs(fn.c_str(), ios::in | ios::binary);
+         if (!ifs)
+         {
+            FFStreamError e("Unable to open " + fn);
+            GPSTK_THROW(e);
+         }
+         ifs.seekg(0, ios::end);
+         fileSize = static_cast<size_t>(ifs.tellg());
+         ifs.seekg(0, ios::beg);
+         buffer.resize(fileSize);
+         if (fileSize)
+            ifs.read(&buffer[0], fileSize);
+         fileData = fileSize ? &buffer[0] : 0;
+      }
+
+      if (pos > fileSize)
+         pos = fileSize;
+      recordNumber = 0;
+      opened = true;
+   }
+
+
+   void Rinex3ObsMappedReader ::
+   close()
+   {
+#ifndef _WIN32
+      if (mapped)
+         munmap(const_cast<char*>(fileData), fileSize);
+#endif
+      buffer.clear();
+      fileData = 0;
+      fileSize = 0;
+      pos = 0;
+      mapped = false;
+      opened = false;
+   }
+
+
+   bool Rinex3ObsMappedReader ::
+   nextLine(LineRef& line)
+   {
+      if (pos >= fileSize)
+         return false;
+      const char *start = fileData + pos;
+      size_t avail = fileSize - pos;
+      const char *eol =
+         static_cast<const char*>(memchr(start, '\n', avail));
+      size_t len = eol ? (eol - start) : avail;
+      pos += eol ? len + 1 : len;
+      lineNumber++;
+         // strip CR left by windows files, then trailing blanks
+      while ((len > 0) && ((start[len-1] == '\r') || (start[len-1] == ' ')))
+         len--;
+      line.ptr = start;
+      line.len = len;
+      return true;
+   }
+
+
+   FFStreamError Rinex3ObsMappedReader ::
+   streamError(const std::string& text) const
+   {
+      FFStreamError e(text);
+      e.addText("Near file line " + StringUtils::asString(lineNumber));
+      e.addText("In record " + StringUtils::asString(recordNumber));
+      e.addText("In file " + filename);
+      return e;
+   }
+
+
+   bool Rinex3ObsMappedReader ::
+   getRecord(Rinex3ObsData& rod)
+      throw(FFStreamError)
+   {
+      if (!opened)
+      {
+         FFStreamError e("No file open");
+         GPSTK_THROW(e);
+      }
+
+         // skip blank lines at the end of the file
+      size_t initialPos = pos;
+      unsigned int initialLine = lineNumber;
+      LineRef line;
+      while (true)
+      {
+         size_t linePos = pos;
+         unsigned int lineNum = lineNumber;
+         if (!nextLine(line))
+            return false;
+         if (line.len > 0)
+         {
+            pos = linePos;
+            lineNumber = lineNum;
+            break;
+         }
+      }
+
+      try
+      {
+         decodeRecord(rod);
+      }
+      catch (FFStreamError& e)
+      {
+         pos = initialPos;
+         lineNumber = initialLine;
+         GPSTK_RETHROW(e);
+      }
+      recordNumber++;
+      return true;
+   }
+
+
+   void Rinex3ObsMappedReader ::
+   decodeRecord(Rinex3ObsData& rod)
+   {
+      LineRef line;
+      nextLine(line);
+
+         // Check and parse the epoch line -----------------------------------
+      if ((line.at(0) != '>') || (line.at(1) != ' '))
+      {
+         FFStreamError e(streamError("Bad epoch line: >" +
+                                     string(line.ptr, line.len) + "<"));
+         GPSTK_THROW(e);
+      }
+
+      rod.epochFlag = StringUtils::asInt(line.ptr + 31,
+                                         (line.len > 31) ? 1 : 0);
+      if ((rod.epochFlag < 0) || (rod.epochFlag > 6))
+      {
+         FFStreamError e(streamError("Invalid epoch flag: " +
+                                     StringUtils::asString(rod.epochFlag)));
+         GPSTK_THROW(e);
+      }
+
+         // epoch time, same checks as Rinex3ObsData::parseTime()
+      if ((line.at( 1) != ' ') || (line.at( 6) != ' ') ||
+          (line.at( 9) != ' ') || (line.at(12) != ' ') ||
+          (line.at(15) != ' ') || (line.at(18) != ' ') ||
+          (line.at(29) != ' ') || (line.at(30) != ' '))
+      {
+         FFStreamError e(streamError("Invalid time format"));
+         GPSTK_THROW(e);
+      }
+      bool blankTime = true;
+      for (size_t i = 2; blankTime && (i < 29); i++)
+         blankTime = (line.at(i) == ' ');
+      if (blankTime)
+      {
+         rod.time = CommonTime::BEGINNING_OF_TIME;
+      }
+      else
+      {
+         char padded[30];
+         for (size_t i = 0; i < sizeof(padded); i++)
+            padded[i] = line.at(i);
+         int year   = StringUtils::asInt(padded +  2,  4);
+         int month  = StringUtils::asInt(padded +  7,  2);
+         int day    = StringUtils::asInt(padded + 10,  2);
+         int hour   = StringUtils::asInt(padded + 13,  2);
+         int minute = StringUtils::asInt(padded + 16,  2);
+         double sec = StringUtils::asDouble(padded + 19, 11);
+
+            // Real Rinex has epochs 'yy mm dd hr 59 60.0' surprisingly often.
+         double ds = 0;
+         if (sec >= 60.)
+         {
+            ds = sec;
+            sec = 0.0;
+         }
+         try
+         {
+            rod.time = CivilTime(year, month, day, hour, minute, sec)
+               .convertToCommonTime();
+            if (ds != 0)
+               rod.time += ds;
+            rod.time.setTimeSystem(timesystem);
+         }
+         catch (Exception& exc)
+         {
+            FFStreamError e(streamError(exc.getText()));
+            GPSTK_THROW(e);
+         }
+      }
+
+      rod.numSVs = (line.len > 32)
+         ? StringUtils::asInt(line.ptr + 32, std::min<size_t>(3, line.len - 32))
+         : 0;
+      rod.clockOffset = (line.len > 41)
+         ? StringUtils::asDouble(line.ptr + 41,
+                                 std::min<size_t>(15, line.len - 41))
+         : 0.0;
+
+      rod.obs.clear();
+      if (rod.auxHeader.valid)
+         rod.auxHeader.clear();
+
+         // Read the observations: SV ID and data ----------------------------
+      if ((rod.epochFlag == 0) || (rod.epochFlag == 1) || (rod.epochFlag == 6))
+      {
+         for (int isv = 0; isv < rod.numSVs; isv++)
+         {
+            if (!nextLine(line))
+            {
+               FFStreamError e(streamError("Unexpected EOF"));
+               GPSTK_THROW(e);
+            }
+
+            RinexSatID sat;
+            try
+            {
+               sat = parseSat(line.ptr, std::min<size_t>(3, line.len));
+            }
+            catch (Exception& exc)
+            {
+               FFStreamError e(streamError(exc.getText()));
+               GPSTK_THROW(e);
+            }
+
+               // Missing trailing observations are treated as
+               // blanks, as Rinex3ObsData does by padding the line.
+            int size = numObsTypes[sat.systemChar() & 0x7f];
+            vector<RinexDatum>& data = rod.obs.insert(
+               rod.obs.end(), Rinex3ObsData::DataMap::value_type(
+                  sat, vector<RinexDatum>()))->second;
+            data.resize(size);
+            for (int i = 0; i < size; i++)
+            {
+               RinexDatum& rd = data[i];
+               size_t fpos = 3 + 16*i;
+               if (fpos >= line.len)
+               {
+                  rd.data = 0.;
+                  rd.dataBlank = true;
+                  rd.lli = rd.ssi = 0;
+                  rd.lliBlank = rd.ssiBlank = true;
+                  continue;
+               }
+               const char *fld = line.ptr + fpos;
+               size_t flen = std::min<size_t>(16, line.len - fpos);
+               size_t dlen = std::min<size_t>(14, flen);
+               size_t nb = 0;
+               while ((nb < dlen) && (fld[nb] == ' '))
+                  nb++;
+               rd.dataBlank = (nb == dlen);
+               rd.data = rd.dataBlank ? 0. : StringUtils::asDouble(fld, dlen);
+               char lli = (flen > 14) ? fld[14] : ' ';
+               char ssi = (flen > 15) ? fld[15] : ' ';
+               rd.lliBlank = (lli == ' ');
+               rd.lli = ((lli >= '0') && (lli <= '9')) ? lli - '0' : 0;
+               rd.ssiBlank = (ssi == ' ');
+               rd.ssi = ((ssi >= '0') && (ssi <= '9')) ? ssi - '0' : 0;
+            }
+         }
+      }
+
+         // ... or the auxiliary header information
+      else if (rod.numSVs > 0)
+      {
+         rod.auxHeader.clear();
+         for (int i = 0; i < rod.numSVs; i++)
+         {
+            if (!nextLine(line))
+            {
+               FFStreamError e(streamError("Unexpected EOF"));
+               GPSTK_THROW(e);
+            }
+            string hdrLine(line.ptr, line.len);
+            try
+            {
+               rod.auxHeader.parseHeaderRecord(hdrLine);
+            }
+            catch (Exception& exc)
+            {
+               FFStreamError e(streamError(exc.getText()));
+               GPSTK_THROW(e);
+            }
+         }
+      }
+   }  // end decodeRecord()
+
+} // namespace gpstk
@@ -0,0 +1,195 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file Rinex3ObsMappedReader.hpp
+ * Memory-mapped reader for RINEX 3 observation files.
+ */
+
+#ifndef GPSTK_RINEX3OBSMAPPEDREADER_HPP
+#define GPSTK_RINEX3OBSMAPPEDREADER_HPP
+
+#include <string>
+#include <vector>
+
+#include "FFStream.hpp"
+#include "Rinex3ObsHeader.hpp"
+#include "Rinex3ObsData.hpp"
+
+namespace gpstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * This class reads RINEX 3 observation files by mapping the
+       * file into memory and scanning the epoch records in place.
+       * It produces exactly the same Rinex3ObsHeader and
+       * Rinex3ObsData as Rinex3ObsStream, but the data lines are
+       * never copied into std::string objects: every field is
+       * decoded directly from the mapped file with fixed-width
+       * numeric parsers.  The header is read with the regular
+       * Rinex3ObsStream machinery since it is short and its parsing
+       * is complex.
+       *
+       * Only RINEX version 3 files are supported; use
+       * Rinex3ObsStream for RINEX 2 input.
+       *
+       * @code
+       * Rinex3ObsMappedReader rdr("data.15o");
+       * Rinex3ObsData rod;
+       * while (rdr.getRecord(rod))
+       * {
+       *    ...
+       * }
+       * @endcode
+       *
+       * @note On platforms without mmap() the file body is read into
+       *   a single buffer instead, which keeps the in-place parsing.
+       *
+       * @sa Rinex3ObsStream, Rinex3ObsData and Rinex3ObsHeader.
+       */
+   class Rinex3ObsMappedReader
+   {
+   public:
+         /// Default constructor
+      Rinex3ObsMappedReader();
+
+         /** Common constructor.
+          *
+          * @param[in] fn the RINEX 3 file to open
+          * @throw FFStreamError if the file can't be opened or mapped,
+          *   or if the header is invalid.
+          */
+      Rinex3ObsMappedReader(const std::string& fn)
+         throw(FFStreamError);
+
+         /// Destructor, unmaps the file.
+      ~Rinex3ObsMappedReader();
+
+         /** Open and map a file, read its header and position at the
+          * first epoch.  Any previously opened file is closed.
+          *
+          * @param[in] fn the RINEX 3 file to open
+          * @throw FFStreamError if the file can't be opened or mapped,
+          *   if the header is invalid or if the file is not RINEX 3.
+          */
+      void open(const std::string& fn)
+         throw(FFStreamError);
+
+         /// Release the mapping.
+      void close();
+
+         /// Return true if a file is currently mapped.
+      bool isOpen() const
+      { return opened; }
+
+         /** Decode the next epoch record into \a rod.
+          *
+          * @param[out] rod the next record in the file.  Its contents
+          *   are undefined if an exception is thrown.
+          * @return true if a record was decoded, false at end of file.
+          * @throw FFStreamError if the record is malformed.  The
+          *   reader is left positioned at the start of the bad record.
+          */
+      bool getRecord(Rinex3ObsData& rod)
+         throw(FFStreamError);
+
+         /// Name of the currently open file.
+      std::string filename;
+
+         /// The header for this file.
+      Rinex3ObsHeader header;
+
+         /// Time system for epochs in this file
+      TimeSystem timesystem;
+
+         /// Number of the last line decoded (1-based, as FFTextStream).
+      unsigned int lineNumber;
+
+         /// Number of records successfully decoded.
+      unsigned long recordNumber;
+
+   private:
+         /// A line in the mapped buffer with trailing blanks removed.
+      struct LineRef
+      {
+         const char *ptr;
+         size_t len;
+
+            /// Character at \a i, blank beyond the end of the line.
+         char at(size_t i) const
+         { return (i < len) ? ptr[i] : ' '; }
+      };
+
+         /** Get the next line from the buffer.
+          * @return false if the end of the buffer has been reached. */
+      bool nextLine(LineRef& line);
+
+         /// Build an FFStreamError carrying the file and line number.
+      FFStreamError streamError(const std::string& text) const;
+
+         /// Decode one record; pos and lineNumber are advanced.
+      void decodeRecord(Rinex3ObsData& rod);
+
+         /// Start of the file contents
+      const char *fileData;
+         /// Size of the file in bytes
+      size_t fileSize;
+         /// Offset of the current position in the file
+      size_t pos;
+         /// True when a file has been opened successfully.
+      bool opened;
+         /// True when fileData is backed by a file mapping.
+      bool mapped;
+         /// Storage used when the file can't be mapped.
+      std::vector<char> buffer;
+
+         /// Number of observation types for each system character,
+         /// looked up from header.mapObsTypes once per file.
+      int numObsTypes[128];
+
+         // no copies, the mapping is owned by this object
+      Rinex3ObsMappedReader(const Rinex3ObsMappedReader&);
+      Rinex3ObsMappedReader& operator=(const Rinex3ObsMappedReader&);
+   }; // class Rinex3ObsMappedReader
+
+      //@}
+
+} // namespace gpstk
+
+#endif // GPSTK_RINEX3OBSMAPPEDREADER_HPP
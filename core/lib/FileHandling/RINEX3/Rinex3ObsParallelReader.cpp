@@ -0,0 +1,330 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file Rinex3ObsParallelReader.cpp
+ * Read several RINEX observation files concurrently and merge their
+ * epochs into a single time-ordered sequence.
+ */
+
+#include <algorithm>
+#include <functional>
+
+#include "ThreadPool.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsMappedReader.hpp"
+#include "Rinex3ObsParallelReader.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+   Rinex3ObsParallelReader::Source ::
+   Source()
+         : strm(0), mapped(0), scheduled(false), done(false), failed(false)
+   {
+   }
+
+
+   Rinex3ObsParallelReader::Source ::
+   ~Source()
+   {
+      delete strm;
+      delete mapped;
+   }
+
+
+   bool Rinex3ObsParallelReader::Source ::
+   read(Rinex3ObsData& rod)
+   {
+      if (mapped)
+         return mapped->getRecord(rod);
+      *strm >> rod;
+      return !strm->fail();
+   }
+
+
+   bool Rinex3ObsParallelReader::Head ::
+   operator<(const Head& right) const
+   {
+      if (day != right.day)
+         return day > right.day;
+      if (msod != right.msod)
+         return msod > right.msod;
+      if (fsod != right.fsod)
+         return fsod > right.fsod;
+      return source > right.source;
+   }
+
+
+   Rinex3ObsParallelReader ::
+   Rinex3ObsParallelReader(unsigned nThreads, size_t qSize)
+         : numThreads(nThreads), queueSize(qSize ? qSize : 1), pool(0),
+           stopping(false)
+   {
+   }
+
+
+   Rinex3ObsParallelReader ::
+   ~Rinex3ObsParallelReader()
+   {
+      close();
+   }
+
+
+   size_t Rinex3ObsParallelReader ::
+   addFile(const std::string& fn)
+      throw(InvalidRequest)
+   {
+      if (pool)
+      {
+         InvalidRequest e("Files can't be added after open()");
+         GPSTK_THROW(e);
+      }
+      Source *src = new Source;
+      src->filename = fn;
+      sources.push_back(src);
+      return sources.size() - 1;
+   }
+
+
+   void Rinex3ObsParallelReader ::
+   open()
+      throw(FFStreamError)
+   {
+      if (pool)
+      {
+         FFStreamError e("Rinex3ObsParallelReader is already open");
+         GPSTK_THROW(e);
+      }
+
+         // Open the files and read the headers up front so that
+         // header errors are reported here rather than as record
+         // errors.
+      for (size_t i = 0; i < sources.size(); i++)
+      {
+         Source& src = *sources[i];
+         src.strm = new Rinex3ObsStream(src.filename.c_str(), ios::in);
+         if (!*src.strm)
+         {
+            FFStreamError e("Unable to open " + src.filename);
+            GPSTK_THROW(e);
+         }
+         src.strm->exceptions(ios::failbit);
+         try
+         {
+            *src.strm >> src.header;
+            if (src.header.version >= 3)
+            {
+               delete src.strm;
+               src.strm = 0;
+               src.mapped = new Rinex3ObsMappedReader(src.filename);
+            }
+         }
+         catch (Exception& e)
+         {
+            e.addText("In file " + src.filename);
+            GPSTK_RETHROW(e);
+         }
+      }
+
+      stopping = false;
+      heads.clear();
+      pending.clear();
+      pool = new ThreadPool(numThreads);
+      unique_lock<mutex> lock(mtx);
+      for (size_t i = 0; i < sources.size(); i++)
+      {
+         pending.push_back(i);
+         schedule(i);
+      }
+   }
+
+
+   bool Rinex3ObsParallelReader ::
+   getRecord(size_t& source, Rinex3ObsData& rod)
+      throw(FFStreamError)
+   {
+      if (!pool)
+      {
+         FFStreamError e("Rinex3ObsParallelReader is not open");
+         GPSTK_THROW(e);
+      }
+
+      unique_lock<mutex> lock(mtx);
+
+         // Every source that is still active must have its next
+         // record in the heap before the earliest one can be
+         // chosen.
+      while (!pending.empty())
+      {
+         for (size_t j = 0; j < pending.size(); )
+         {
+            size_t idx = pending[j];
+            Source& src = *sources[idx];
+            if (!src.queue.empty())
+            {
+               Head h;
+               src.queue.front().time.getInternal(h.day, h.msod, h.fsod);
+               h.source = idx;
+               heads.push_back(h);
+               push_heap(heads.begin(), heads.end());
+            }
+            else if (src.done)
+            {
+               if (src.failed)
+               {
+                  pending[j] = pending.back();
+                  pending.pop_back();
+                  src.failed = false;
+                  FFStreamError e(src.error);
+                  GPSTK_THROW(e);
+               }
+            }
+            else
+            {
+               j++;
+               continue;
+            }
+            pending[j] = pending.back();
+            pending.pop_back();
+         }
+         if (!pending.empty())
+            dataReady.wait(lock);
+      }
+
+      if (heads.empty())
+         return false;
+
+      pop_heap(heads.begin(), heads.end());
+      source = heads.back().source;
+      heads.pop_back();
+      Source& src = *sources[source];
+      rod = std::move(src.queue.front());
+      src.queue.pop_front();
+      pending.push_back(source);
+         // refill once half the queue has been consumed
+      if (src.queue.size() <= queueSize / 2)
+         schedule(source);
+      return true;
+   }
+
+
+   void Rinex3ObsParallelReader ::
+   close()
+   {
+      if (pool)
+      {
+         {
+            lock_guard<mutex> lock(mtx);
+            stopping = true;
+         }
+         delete pool;
+         pool = 0;
+      }
+      for (size_t i = 0; i < sources.size(); i++)
+         delete sources[i];
+      sources.clear();
+      heads.clear();
+      pending.clear();
+   }
+
+
+   void Rinex3ObsParallelReader ::
+   schedule(size_t index)
+   {
+      Source& src = *sources[index];
+      if (src.scheduled || src.done || stopping)
+         return;
+      src.scheduled = true;
+      pool->submit(bind(&Rinex3ObsParallelReader::fill, this, index));
+   }
+
+
+   void Rinex3ObsParallelReader ::
+   fill(size_t index)
+   {
+      Source& src = *sources[index];
+      while (true)
+      {
+         {
+            lock_guard<mutex> lock(mtx);
+            if (stopping || (src.queue.size() >= queueSize))
+            {
+               src.scheduled = false;
+               return;
+            }
+         }
+
+            // parse outside the lock; only this task touches the reader
+         Rinex3ObsData rod;
+         bool got = false, failed = false;
+         FFStreamError error;
+         try
+         {
+            got = src.read(rod);
+         }
+         catch (Exception& e)
+         {
+            e.addText("In file " + src.filename);
+            error = FFStreamError(e);
+            failed = true;
+         }
+         catch (std::exception& e)
+         {
+            error = FFStreamError("std::exception: " + string(e.what()) +
+                                  " in file " + src.filename);
+            failed = true;
+         }
+
+         lock_guard<mutex> lock(mtx);
+         if (!got)
+         {
+            src.done = true;
+            src.failed = failed;
+            src.error = error;
+            src.scheduled = false;
+            dataReady.notify_all();
+            return;
+         }
+         src.queue.push_back(std::move(rod));
+         if (src.queue.size() == 1)
+            dataReady.notify_all();
+      }
+   }
+
+} // namespace gpstk
@@ -0,0 +1,222 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file Rinex3ObsParallelReader.hpp
+ * Read several RINEX observation files concurrently and merge their
+ * epochs into a single time-ordered sequence.
+ */
+
+#ifndef GPSTK_RINEX3OBSPARALLELREADER_HPP
+#define GPSTK_RINEX3OBSPARALLELREADER_HPP
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+#include "FFStream.hpp"
+#include "Rinex3ObsHeader.hpp"
+#include "Rinex3ObsData.hpp"
+
+namespace gpstk
+{
+   class ThreadPool;
+   class Rinex3ObsStream;
+   class Rinex3ObsMappedReader;
+
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * This class parses a set of RINEX observation files on a pool
+       * of worker threads and returns their records as one stream
+       * ordered by epoch time (a k-way merge of the per-file
+       * streams).  Each record is tagged with the index of the file
+       * it came from, which is the order in which the files were
+       * added.  Records with the same time are returned in file
+       * order, so the output does not depend on thread timing.
+       *
+       * Each file has a bounded queue of parsed records; workers
+       * stop parsing a file when its queue is full and resume when
+       * the consumer has drained it, so memory use is limited to
+       * about (number of files) x (queue size) records no matter how
+       * long the files are.
+       *
+       * RINEX 3 files are decoded with Rinex3ObsMappedReader, RINEX
+       * 2 files with Rinex3ObsStream.  The files must each be in
+       * time order; epochs are compared by their time value alone,
+       * time systems are not reconciled.
+       *
+       * @code
+       * Rinex3ObsParallelReader rdr;
+       * rdr.addFile("site1.15o");
+       * rdr.addFile("site2.15o");
+       * rdr.open();
+       * size_t src;
+       * Rinex3ObsData rod;
+       * while (rdr.getRecord(src, rod))
+       * {
+       *    const Rinex3ObsHeader& hdr = rdr.getHeader(src);
+       *    ...
+       * }
+       * @endcode
+       */
+   class Rinex3ObsParallelReader
+   {
+   public:
+         /** Constructor.
+          * @param[in] numThreads number of parsing threads; 0 selects
+          *   one per hardware thread.
+          * @param[in] queueSize maximum number of parsed records
+          *   held for each file. */
+      Rinex3ObsParallelReader(unsigned numThreads = 0,
+                              size_t queueSize = 64);
+
+         /// Destructor, stops the workers and closes all files.
+      ~Rinex3ObsParallelReader();
+
+         /** Add a file to the set to be read.
+          * @return the index used to identify the file's records.
+          * @throw InvalidRequest if called after open(). */
+      size_t addFile(const std::string& fn)
+         throw(InvalidRequest);
+
+         /** Open all files, read their headers and start parsing.
+          * @throw FFStreamError if a file can't be opened or has an
+          *   invalid header. */
+      void open()
+         throw(FFStreamError);
+
+         /** Get the next record in time order.
+          *
+          * @param[out] source index of the file the record came from.
+          * @param[out] rod the record.
+          * @return false when all files are exhausted.
+          * @throw FFStreamError if the next record of a file could
+          *   not be parsed.  That file is dropped from the merge and
+          *   later calls continue with the remaining files.
+          */
+      bool getRecord(size_t& source, Rinex3ObsData& rod)
+         throw(FFStreamError);
+
+         /// Stop the workers and close all files.
+      void close();
+
+         /// Number of files added.
+      size_t getNumSources() const
+      { return sources.size(); }
+
+         /// Name of the file with index \a source.
+      const std::string& getFilename(size_t source) const
+      { return sources[source]->filename; }
+
+         /// Header of the file with index \a source (valid after open()).
+      const Rinex3ObsHeader& getHeader(size_t source) const
+      { return sources[source]->header; }
+
+   private:
+         /// Everything known about one input file.
+      struct Source
+      {
+         Source();
+         ~Source();
+
+            /// Read the next record, return false at end of file.
+         bool read(Rinex3ObsData& rod);
+
+         std::string filename;
+         Rinex3ObsHeader header;
+            /// reader for RINEX 2 input
+         Rinex3ObsStream *strm;
+            /// reader for RINEX 3 input
+         Rinex3ObsMappedReader *mapped;
+            /// parsed records not yet returned
+         std::deque<Rinex3ObsData> queue;
+            /// true while a fill task is queued or running
+         bool scheduled;
+            /// true when no more records will be added to queue
+         bool done;
+            /// true if done because of a read error
+         bool failed;
+            /// the read error, if any
+         FFStreamError error;
+      };
+
+         /// Merge heap entry, the head record of one source.
+      struct Head
+      {
+         long day;
+         long msod;
+         double fsod;
+         size_t source;
+
+            /// Ordering for a min-heap: later time is "less".
+         bool operator<(const Head& right) const;
+      };
+
+         /// Worker task: parse records of a source until its queue is full.
+      void fill(size_t index);
+
+         /// Queue a fill task for \a index if one is needed; mtx held.
+      void schedule(size_t index);
+
+      std::vector<Source*> sources;
+         /// heap of the sources with a record ready
+      std::vector<Head> heads;
+         /// sources whose next record has not been put in heads yet
+      std::vector<size_t> pending;
+
+      unsigned numThreads;
+      size_t queueSize;
+      ThreadPool *pool;
+      bool stopping;
+      std::mutex mtx;
+         /// signalled when a source gets a record or finishes
+      std::condition_variable dataReady;
+
+         // not copyable
+      Rinex3ObsParallelReader(const Rinex3ObsParallelReader&);
+      Rinex3ObsParallelReader& operator=(const Rinex3ObsParallelReader&);
+   }; // class Rinex3ObsParallelReader
+
+      //@}
+
+} // namespace gpstk
+
+#endif // GPSTK_RINEX3OBSPARALLELREADER_HPP
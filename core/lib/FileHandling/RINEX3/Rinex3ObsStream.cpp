@@ -40,11 +40,14 @@
  */
 
 #include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "Rinex3ObsCache.hpp"
 
 namespace gpstk
 {
    Rinex3ObsStream ::
    Rinex3ObsStream()
+         : useCache(false), cache(NULL)
    {
       init();
    }
@@ -53,7 +56,7 @@ namespace gpstk
    Rinex3ObsStream ::
    Rinex3ObsStream( const char* fn,
                     std::ios::openmode mode )
-         : FFTextStream(fn, mode)
+         : FFTextStream(fn, mode), useCache(false), cache(NULL)
    {
       init();
    }
@@ -62,7 +65,7 @@ namespace gpstk
    Rinex3ObsStream ::
    Rinex3ObsStream( const std::string fn,
                     std::ios::openmode mode )
-         : FFTextStream(fn.c_str(), mode)
+         : FFTextStream(fn.c_str(), mode), useCache(false), cache(NULL)
    {
       init();
    }
@@ -71,6 +74,7 @@ namespace gpstk
    Rinex3ObsStream ::
    ~Rinex3ObsStream()
    {
+      delete cache;
    }
 
 
@@ -79,6 +83,7 @@ namespace gpstk
          std::ios::openmode mode )
    {
       FFTextStream::open(fn, mode);
+      init();
    }
 
 
@@ -88,6 +93,9 @@ namespace gpstk
       headerRead = false;
       header = Rinex3ObsHeader();
       timesystem = TimeSystem::GPS;
+      previousTime = CommonTime::BEGINNING_OF_TIME;
+      delete cache;
+      cache = NULL;
    }
 
 
@@ -99,6 +107,126 @@ namespace gpstk
    }
 
 
+   void Rinex3ObsStream ::
+   tryFFStreamGet(FFData& rec)
+      throw(FFStreamError, gpstk::StringUtils::StringException)
+   {
+      if (!useCache || filename.empty())
+      {
+         FFTextStream::tryFFStreamGet(rec);
+         return;
+      }
+
+      Rinex3ObsData *rod = dynamic_cast<Rinex3ObsData*>(&rec);
+      if (rod != NULL)
+      {
+            // Read the header here rather than in
+            // Rinex3ObsData::reallyGetRecord so the cache is set up
+            // before the first record.
+         if (!headerRead)
+            (*this) >> header;
+         if ((cache != NULL) && cache->isReading())
+         {
+            try
+            {
+               if (cache->getRecord(*rod, header.version))
+               {
+                  recordNumber++;
+                  return;
+               }
+            }
+            catch (FFStreamError& e)
+            {
+               mostRecentException = e;
+               setstate(std::ios::failbit);
+               conditionalThrow();
+               return;
+            }
+               // All the cached records have been read.  Skip to the
+               // end of the file so the parser reports the end of file
+               // the same way it would have without the cache.
+            cache->close();
+            clear();
+            seekg(0, std::ios::end);
+         }
+      }
+      else if (headerRead || (cache != NULL) ||
+               (dynamic_cast<Rinex3ObsHeader*>(&rec) == NULL))
+      {
+         FFTextStream::tryFFStreamGet(rec);
+         return;
+      }
+
+         // Either the header, or a record parsed from the text that
+         // may be added to the cache.
+      if (rdstate() == std::ios::eofbit)
+         clear();
+      std::streampos start = tellg();
+      try
+      {
+         FFTextStream::tryFFStreamGet(rec);
+      }
+      catch (...)
+      {
+         delete cache;
+         cache = NULL;
+         throw;
+      }
+
+      if (rod == NULL)
+      {
+         if (!headerRead)
+            return;
+         cache = new Rinex3ObsCache;
+         std::string text(getText(start));
+         if (!cache->openRead(filename, text) &&
+             !cache->openWrite(filename, text))
+         {
+            delete cache;
+            cache = NULL;
+         }
+      }
+      else if ((cache != NULL) && cache->isWriting())
+      {
+         if (!fail())
+         {
+            std::string text;
+            if ((rod->epochFlag >= 2) && (rod->epochFlag <= 5))
+               text = getText(start);
+            cache->addRecord(*rod, text);
+         }
+         else
+         {
+               // Errors leave the stream at the start of the record,
+               // only the end of the file sets eof.
+            if (eof())
+               cache->write();
+            delete cache;
+            cache = NULL;
+         }
+      }
+   }
+
+
+   std::string Rinex3ObsStream ::
+   getText(std::streampos start)
+   {
+      std::ios::iostate state = rdstate();
+      clear();
+      std::streampos end = tellg();
+      std::string text;
+      if (end > start)
+      {
+         text.resize(static_cast<size_t>(end - start));
+         seekg(start);
+         read(&text[0], text.size());
+         seekg(end);
+      }
+      clear(state);
+      return text;
+   }
+
+
    bool Rinex3ObsStream ::
    isRinex3ObsStream(std::istream& i)
    {
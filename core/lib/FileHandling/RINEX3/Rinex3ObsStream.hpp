@@ -48,10 +48,13 @@
 #include <string>
 
 #include "FFTextStream.hpp"
+#include "CommonTime.hpp"
 #include "Rinex3ObsHeader.hpp"
 
 namespace gpstk
 {
+   class Rinex3ObsCache;
+
       /// @ingroup FileHandling
       //@{
 
@@ -110,12 +113,39 @@ namespace gpstk
          /// Time system for epochs in this file
       TimeSystem timesystem;
 
+         /** Time of the last epoch read that carried a time.  RINEX 2
+          * event records (epoch flags 2-4) may omit the epoch time,
+          * in which case this time is used instead. */
+      CommonTime previousTime;
+
+         /** Read the epoch records through a binary cache (see
+          * Rinex3ObsCache).  Set this before reading the header.  If
+          * a cache matching the file exists, records are decoded
+          * from it instead of being parsed; otherwise the file is
+          * parsed as usual and a cache is written next to it once
+          * the end of the file is reached.  Records read this way
+          * are identical to parsed ones.  Off by default. */
+      bool useCache;
+
          /// Check if the input stream is the kind of Rinex3ObsStream
       static bool isRinex3ObsStream(std::istream& i);
 
+   protected:
+         /// Reads records from or adds them to the cache when useCache
+         /// is set, otherwise calls FFTextStream::tryFFStreamGet.
+      virtual void tryFFStreamGet(FFData& rec)
+         throw(FFStreamError, gpstk::StringUtils::StringException);
+
    private:
          /// Initialize internal data structures.
       void init();
+
+         /** Get the raw text of the file from \a start to the current
+          * position, leaving the position and state unchanged. */
+      std::string getText(std::streampos start);
+
+         /// Cache being read or written, if any.
+      Rinex3ObsCache *cache;
    }; // class 'Rinex3ObsStream'
 
       //@}
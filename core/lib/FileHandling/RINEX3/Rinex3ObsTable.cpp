@@ -0,0 +1,275 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file Rinex3ObsTable.cpp
+ * Column-oriented storage of a whole RINEX observation file.
+ */
+
+#include <algorithm>
+
+#include "StringUtils.hpp"
+#include "Rinex3ObsTable.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+   Rinex3ObsTable ::
+   Rinex3ObsTable()
+   {
+   }
+
+
+   void Rinex3ObsTable ::
+   clear()
+   {
+      header = Rinex3ObsHeader();
+      time.clear();
+      epochFlag.clear();
+      numSVs.clear();
+      clockOffset.clear();
+      auxHeader.clear();
+      sats.clear();
+   }
+
+
+   void Rinex3ObsTable ::
+   load(const std::string& fn)
+      throw(FFStreamError)
+   {
+      clear();
+      Rinex3ObsStream strm(fn.c_str(), ios::in);
+      if (!strm)
+      {
+         FFStreamError e("Unable to open " + fn);
+         GPSTK_THROW(e);
+      }
+      load(strm);
+   }
+
+
+   void Rinex3ObsTable ::
+   load(Rinex3ObsStream& strm)
+      throw(FFStreamError)
+   {
+      Rinex3ObsData rod;
+      try
+      {
+         if (!strm.headerRead)
+            strm >> strm.header;
+         if (strm)
+         {
+            header = strm.header;
+            while (strm >> rod)
+               addEpoch(rod);
+         }
+      }
+      catch (FFStreamError& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+      catch (Exception& e)
+      {
+         FFStreamError err(e);
+         GPSTK_THROW(err);
+      }
+      catch (std::exception& e)
+      {
+            // ios::failure at the end of the file when failbit
+            // exceptions are enabled
+         if (!strm.eof())
+         {
+            FFStreamError err("std::exception: " + string(e.what()));
+            GPSTK_THROW(err);
+         }
+      }
+         // without exceptions enabled, a read error leaves the
+         // stream failed before the end of the file
+      if (strm.fail() && !strm.eof())
+      {
+         FFStreamError err(strm.mostRecentException);
+         GPSTK_THROW(err);
+      }
+   }
+
+
+   size_t Rinex3ObsTable ::
+   addEpoch(const Rinex3ObsData& rod)
+   {
+      size_t index = time.size();
+      time.push_back(rod.time);
+      epochFlag.push_back(rod.epochFlag);
+      numSVs.push_back(rod.numSVs);
+      clockOffset.push_back(rod.clockOffset);
+      if ((rod.epochFlag >= 2) && (rod.epochFlag <= 5))
+         auxHeader[index] = rod.auxHeader;
+
+      Rinex3ObsData::DataMap::const_iterator it;
+      for (it = rod.obs.begin(); it != rod.obs.end(); it++)
+      {
+         SatColumns& sc = sats[it->first];
+         const vector<RinexDatum>& vec(it->second);
+         size_t row = sc.epoch.size();
+         sc.epoch.push_back(index);
+            // a longer list of obs types than before gets new columns
+            // that are blank in the earlier rows
+         size_t numCols = std::max<size_t>(sc.data.size(), vec.size());
+         if (sc.data.size() < numCols)
+         {
+            sc.data.resize(numCols, vector<double>(row, 0.));
+            sc.lli.resize(numCols, vector<short>(row, 0));
+            sc.ssi.resize(numCols, vector<short>(row, 0));
+            sc.blank.resize(numCols, vector<unsigned char>(
+                               row, dataBlank | lliBlank | ssiBlank));
+         }
+         for (size_t i = 0; i < numCols; i++)
+         {
+            if (i < vec.size())
+            {
+               const RinexDatum& rd(vec[i]);
+               sc.data[i].push_back(rd.data);
+               sc.lli[i].push_back(rd.lli);
+               sc.ssi[i].push_back(rd.ssi);
+               sc.blank[i].push_back((rd.dataBlank ? dataBlank : 0) |
+                                     (rd.lliBlank ? lliBlank : 0) |
+                                     (rd.ssiBlank ? ssiBlank : 0));
+            }
+            else
+            {
+               sc.data[i].push_back(0.);
+               sc.lli[i].push_back(0);
+               sc.ssi[i].push_back(0);
+               sc.blank[i].push_back(dataBlank | lliBlank | ssiBlank);
+            }
+         }
+      }
+      return index;
+   }
+
+
+   void Rinex3ObsTable ::
+   getEpoch(size_t index, Rinex3ObsData& rod) const
+      throw(InvalidRequest)
+   {
+      if (index >= time.size())
+      {
+         InvalidRequest e("Epoch index " + StringUtils::asString(index) +
+                          " is out of range");
+         GPSTK_THROW(e);
+      }
+      rod.time = time[index];
+      rod.epochFlag = epochFlag[index];
+      rod.numSVs = numSVs[index];
+      rod.clockOffset = clockOffset[index];
+      map<size_t, Rinex3ObsHeader>::const_iterator ai = auxHeader.find(index);
+      rod.auxHeader = (ai == auxHeader.end()) ? Rinex3ObsHeader() : ai->second;
+      rod.obs.clear();
+
+      SatMap::const_iterator it;
+      for (it = sats.begin(); it != sats.end(); it++)
+      {
+         const SatColumns& sc(it->second);
+         vector<size_t>::const_iterator ei =
+            lower_bound(sc.epoch.begin(), sc.epoch.end(), index);
+         if ((ei == sc.epoch.end()) || (*ei != index))
+            continue;
+         size_t row = ei - sc.epoch.begin();
+         vector<RinexDatum>& vec = rod.obs[it->first];
+         vec.resize(sc.data.size());
+         for (size_t i = 0; i < vec.size(); i++)
+         {
+            RinexDatum& rd(vec[i]);
+            rd.data = sc.data[i][row];
+            rd.lli = sc.lli[i][row];
+            rd.ssi = sc.ssi[i][row];
+            rd.dataBlank = (sc.blank[i][row] & dataBlank) != 0;
+            rd.lliBlank = (sc.blank[i][row] & lliBlank) != 0;
+            rd.ssiBlank = (sc.blank[i][row] & ssiBlank) != 0;
+         }
+      }
+   }
+
+
+   size_t Rinex3ObsTable ::
+   getNumRows() const
+   {
+      size_t rows = 0;
+      SatMap::const_iterator it;
+      for (it = sats.begin(); it != sats.end(); it++)
+         rows += it->second.size();
+      return rows;
+   }
+
+
+   const Rinex3ObsTable::SatColumns& Rinex3ObsTable ::
+   getSat(const RinexSatID& sat) const
+      throw(InvalidRequest)
+   {
+      SatMap::const_iterator it = sats.find(sat);
+      if (it == sats.end())
+      {
+         InvalidRequest e("Satellite " + sat.toString() + " is not in table");
+         GPSTK_THROW(e);
+      }
+      return it->second;
+   }
+
+
+   size_t Rinex3ObsTable ::
+   countNonZero(const std::vector<double>& col)
+   {
+         // written as a plain sum so the compiler can vectorize it
+      const double *p = col.empty() ? 0 : &col[0];
+      size_t n = col.size(), count = 0;
+      for (size_t i = 0; i < n; i++)
+         count += (p[i] != 0.);
+      return count;
+   }
+
+
+   size_t Rinex3ObsTable ::
+   countLossOfLock(const std::vector<short>& col)
+   {
+      const short *p = col.empty() ? 0 : &col[0];
+      size_t n = col.size(), count = 0;
+      for (size_t i = 0; i < n; i++)
+         count += (p[i] > 0);
+      return count;
+   }
+
+} // namespace gpstk
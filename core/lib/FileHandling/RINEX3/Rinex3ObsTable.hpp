@@ -0,0 +1,202 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file Rinex3ObsTable.hpp
+ * Column-oriented storage of a whole RINEX observation file.
+ */
+
+#ifndef GPSTK_RINEX3OBSTABLE_HPP
+#define GPSTK_RINEX3OBSTABLE_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Exception.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsHeader.hpp"
+#include "Rinex3ObsData.hpp"
+
+namespace gpstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * This class holds the observations of a RINEX file in
+       * columns rather than as a sequence of Rinex3ObsData maps.
+       * The epoch data (time, flag, clock offset) are stored once in
+       * parallel arrays indexed by epoch number.  Each satellite gets
+       * a set of rows, one per epoch in which it was observed, and
+       * for every observation type of its system there is a
+       * contiguous array of data, LLI and SSI values over those
+       * rows.  Whole-file statistics then become simple loops over
+       * std::vector<double> instead of walks over millions of map
+       * nodes.
+       *
+       * Rows of a satellite are in epoch order, and
+       * SatColumns::epoch gives the epoch index of each row.  The
+       * order of the observation types is that of
+       * Rinex3ObsHeader::mapObsTypes, as in Rinex3ObsData.
+       *
+       * @code
+       * Rinex3ObsTable table;
+       * table.load("data.15o");
+       * const Rinex3ObsTable::SatColumns& g05(table.getSat(RinexSatID("G05")));
+       * size_t n = Rinex3ObsTable::countNonZero(g05.data[0]);
+       * @endcode
+       *
+       * @sa Rinex3ObsData and Rinex3ObsStream.
+       */
+   class Rinex3ObsTable
+   {
+   public:
+         /// Bits of SatColumns::blank
+      enum BlankBits
+      {
+         dataBlank = 0x01,  ///< the data value is blank in the file
+         lliBlank  = 0x02,  ///< the LLI is blank in the file
+         ssiBlank  = 0x04   ///< the SSI is blank in the file
+      };
+
+         /// All the observations of one satellite.
+      struct SatColumns
+      {
+            /// Number of rows (epochs in which the satellite appears).
+         size_t size() const
+         { return epoch.size(); }
+
+            /// Epoch index of each row.
+         std::vector<size_t> epoch;
+            /// Observation values, indexed [obs type][row].
+         std::vector<std::vector<double> > data;
+            /// Loss of lock indicators, indexed [obs type][row].
+         std::vector<std::vector<short> > lli;
+            /// Signal strength indicators, indexed [obs type][row].
+         std::vector<std::vector<short> > ssi;
+            /// BlankBits of each value, indexed [obs type][row].
+         std::vector<std::vector<unsigned char> > blank;
+      };
+
+         /// Columns of each satellite in the table
+      typedef std::map<RinexSatID, SatColumns> SatMap;
+
+         /// Default constructor, creates an empty table.
+      Rinex3ObsTable();
+
+         /// Remove all epochs and satellites.
+      void clear();
+
+         /** Read a RINEX observation file (version 2 or 3) into the
+          * table, replacing its contents.
+          * @param[in] fn the file to read.
+          * @throw FFStreamError if the file can't be opened or read.
+          */
+      void load(const std::string& fn)
+         throw(FFStreamError);
+
+         /** Read the records remaining in \a strm and append them.
+          * The stream header is read first if that hasn't been done
+          * yet, and it is copied to #header.
+          * @param[in] strm the stream to read from.
+          * @throw FFStreamError if a record can't be read.
+          */
+      void load(Rinex3ObsStream& strm)
+         throw(FFStreamError);
+
+         /** Append one epoch record to the table.
+          * @param[in] rod the record to add.  Records with epoch
+          *   flags 2-5 are kept as epochs with auxiliary header data
+          *   and no observations.
+          * @return the index of the new epoch.
+          */
+      size_t addEpoch(const Rinex3ObsData& rod);
+
+         /** Rebuild the Rinex3ObsData for one epoch.
+          * @param[in] index the epoch index, less than getNumEpochs().
+          * @param[out] rod the record given to addEpoch(), except
+          *   that every satellite has as many observations as its
+          *   longest list in the table: a shorter list comes back
+          *   padded with blank, zero data.
+          * @throw InvalidRequest if \a index is out of range.
+          */
+      void getEpoch(size_t index, Rinex3ObsData& rod) const
+         throw(InvalidRequest);
+
+         /// Number of epochs (records) in the table.
+      size_t getNumEpochs() const
+      { return time.size(); }
+
+         /// Total number of satellite/epoch rows in the table.
+      size_t getNumRows() const;
+
+         /** Get the columns of one satellite.
+          * @throw InvalidRequest if the satellite is not in the table.
+          */
+      const SatColumns& getSat(const RinexSatID& sat) const
+         throw(InvalidRequest);
+
+         /// Count the values in \a col that are not zero.
+      static size_t countNonZero(const std::vector<double>& col);
+
+         /// Count the LLI values in \a col that are greater than zero.
+      static size_t countLossOfLock(const std::vector<short>& col);
+
+         /// The header of the file that was loaded, if any.
+      Rinex3ObsHeader header;
+
+         /// @name Epoch data, indexed by epoch
+         //@{
+      std::vector<CommonTime> time;
+      std::vector<short> epochFlag;
+      std::vector<short> numSVs;
+      std::vector<double> clockOffset;
+         //@}
+
+         /// Auxiliary header records of epochs with flags 2-5.
+      std::map<size_t, Rinex3ObsHeader> auxHeader;
+
+         /// Observation columns per satellite.
+      SatMap sats;
+   }; // class Rinex3ObsTable
+
+      //@}
+
+} // namespace gpstk
+
+#endif // GPSTK_RINEX3OBSTABLE_HPP
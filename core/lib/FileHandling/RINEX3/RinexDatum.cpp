@@ -38,6 +38,8 @@
  * Defines class methods for a single RINEX datum.
  */
 
+#include <algorithm>
+
 #include "RinexDatum.hpp"
 #include "Exception.hpp"
 #include "StringUtils.hpp"
@@ -60,42 +62,54 @@ namespace gpstk
    }
 
 
+   RinexDatum ::
+   RinexDatum(const std::string& line, std::string::size_type pos)
+   {
+      fromString(line, pos);
+   }
+
+
    void RinexDatum ::
    fromString(const std::string& str)
    {
-      std::string tmpStr;
       GPSTK_ASSERT(str.length() == 16);
-      tmpStr = str.substr(0, 14);
-      if (tmpStr.find_last_not_of(" ") == std::string::npos)
+      fromString(str, 0);
+   }
+
+
+   void RinexDatum ::
+   fromString(const std::string& line, std::string::size_type pos)
+   {
+      GPSTK_ASSERT(line.length() >= pos + 16);
+      const char *p = line.data() + pos;
+      if (std::count(p, p + 14, ' ') == 14)
       {
          data = 0.;
          dataBlank = true;
       }
       else
       {
-         data = StringUtils::asDouble(tmpStr);
+         data = StringUtils::asDouble(p, 14);
          dataBlank = false;
       }
-      tmpStr = str.substr(14, 1);
-      if (tmpStr == " ")
+      if (p[14] == ' ')
       {
          lli = 0.;
          lliBlank = true;
       }
       else
       {
-         lli = StringUtils::asInt(tmpStr);
+         lli = StringUtils::asInt(p + 14, 1);
          lliBlank = false;
       }
-      tmpStr = str.substr(15, 1);
-      if (tmpStr == " ")
+      if (p[15] == ' ')
       {
          ssi = 0.;
          ssiBlank = true;
       }
       else
       {
-         ssi = StringUtils::asInt(tmpStr);
+         ssi = StringUtils::asInt(p + 15, 1);
          ssiBlank = false;
       }
    }
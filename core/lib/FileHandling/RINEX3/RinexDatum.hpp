@@ -62,12 +62,26 @@ namespace gpstk
           * @throw AssertionFailure if str.length() != 16 */
       RinexDatum(const std::string& str);
 
+         /** Parse the 16 character RINEX OBS datum at \a pos in
+          * \a line into data members, without copying it.
+          * @param[in] line a RINEX observation line.
+          * @param[in] pos the position of the datum in \a line.
+          * @throw AssertionFailure if \a line is too short. */
+      RinexDatum(const std::string& line, std::string::size_type pos);
+
          /** Parse a RINEX OBS datum string into data members
           * @param[in] str a RINEX-formatted datum, must be 16
           *   characters in length.
           * @throw AssertionFailure if str.length() != 16 */
       void fromString(const std::string& str);
 
+         /** Parse the 16 character RINEX OBS datum at \a pos in
+          * \a line into data members, without copying it.
+          * @param[in] line a RINEX observation line.
+          * @param[in] pos the position of the datum in \a line.
+          * @throw AssertionFailure if \a line is too short. */
+      void fromString(const std::string& line, std::string::size_type pos);
+
          /// Turn this datum into a RINEX OBS formatted string
       std::string asString() const;
 
@@ -80,7 +80,7 @@ namespace Sinex
    isValidLineStructure(const std::string& line,
                                    size_t minLen,
                                    size_t maxLen,
-                                   int divs[],
+                                   const int divs[],
                                    bool toss)
    {
       size_t  sz = line.size();
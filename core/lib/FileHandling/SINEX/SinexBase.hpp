@@ -98,7 +98,7 @@ namespace gpstk
       extern bool isValidLineStructure(const std::string& line,
                                        size_t minLength,
                                        size_t maxLength,
-                                       int divs[] = NULL,  /// Array terminated by element < 0
+                                       const int divs[] = NULL,  /// Array terminated by element < 0
                                        bool toss = true);
 
          /**
@@ -11,6 +11,8 @@
  * Encapsulate SINEX file data, including I/O
  */
 
+#include <mutex>
+
 #include "StringUtils.hpp"
 #include "SinexStream.hpp"
 #include "SinexData.hpp"
@@ -31,8 +33,16 @@ namespace Sinex
    void
    Data::initBlockFactory()
    {
-      if (blockFactory.size() > 0) return;  /// Already initialized ?
+         // Data objects may be created from several threads at once
+      static std::once_flag  initialized;
+      std::call_once(initialized, &Data::fillBlockFactory);
+
+   }  // Data::initBlockFactory()
+
 
+   void
+   Data::fillBlockFactory()
+   {
       blockFactory["FILE/REFERENCE"]         = Block<FileReference>::create;
       blockFactory["FILE/COMMENT"]           = Block<FileComment>::create;
       blockFactory["INPUT/HISTORY"]          = Block<InputHistory>::create;
@@ -72,7 +82,7 @@ namespace Sinex
       blockFactory["SOLUTION/NORMAL_EQUATION_MATRIX L"] = Block<SolutionNormalEquationMatrixL>::create;
       blockFactory["SOLUTION/NORMAL_EQUATION_MATRIX U"] = Block<SolutionNormalEquationMatrixU>::create;
 
-   }  // Data::initBlockFactory()
+   }  // Data::fillBlockFactory()
 
 
    Data::~Data()
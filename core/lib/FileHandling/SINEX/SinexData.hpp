@@ -95,10 +95,14 @@ namespace gpstk
 
             /**
              * Initializes the block factory with mappings from block titles
-             * to create functions.
+             * to create functions.  This is done only once, even when
+             * called concurrently.
              */
          static void  initBlockFactory();
 
+            /// Adds the block title mappings; called by initBlockFactory().
+         static void  fillBlockFactory();
+
             /**
              * Writes the formatted record to the FFStream.
              */
@@ -61,7 +61,7 @@ namespace Sinex
          Exception  err("Invalid Sinex Header");
          GPSTK_THROW(err);
       }
-      static int FIELD_DIVS[] = {5, 10, 14, 27, 31, 44, 57, 59, 65, -1};
+      static const int FIELD_DIVS[] = {5, 10, 14, 27, 31, 44, 57, 59, 65, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -46,7 +46,7 @@ namespace Sinex
    void
    FileReference::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 19, -1};
+      static const int FIELD_DIVS[] = {0, 19, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -209,7 +209,7 @@ namespace Sinex
    void
    InputFile::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 4, 17, 47, -1};
+      static const int FIELD_DIVS[] = {0, 4, 17, 47, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -261,7 +261,7 @@ namespace Sinex
    void
    InputAck::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 4, -1};
+      static const int FIELD_DIVS[] = {0, 4, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -309,7 +309,7 @@ namespace Sinex
    void
    NutationData::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 9, -1};
+      static const int FIELD_DIVS[] = {0, 9, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -357,7 +357,7 @@ namespace Sinex
    void
    PrecessionData::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 9, -1};
+      static const int FIELD_DIVS[] = {0, 9, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -407,7 +407,7 @@ namespace Sinex
    void
    SourceId::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 5, 14, 31, -1};
+      static const int FIELD_DIVS[] = {0, 5, 14, 31, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -468,7 +468,7 @@ namespace Sinex
 
    void SiteId::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 5, 8, 18, 20, 43, 47, 50, 55, 59, 62, 67, -1};
+      static const int FIELD_DIVS[] = {0, 5, 8, 18, 20, 43, 47, 50, 55, 59, 62, 67, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -544,7 +544,7 @@ namespace Sinex
 
    void SiteData::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 5, 8, 13, 18, 21, 26, 28, 41, 54, 58, -1};
+      static const int FIELD_DIVS[] = {0, 5, 8, 13, 18, 21, 26, 28, 41, 54, 58, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -616,7 +616,7 @@ namespace Sinex
 
    void SiteReceiver::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 5, 8, 13, 15, 28, 41, 62, 68, -1};
+      static const int FIELD_DIVS[] = {0, 5, 8, 13, 15, 28, 41, 62, 68, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -683,7 +683,7 @@ namespace Sinex
 
    void SiteAntenna::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 5, 8, 13, 15, 28, 41, 62, -1};
+      static const int FIELD_DIVS[] = {0, 5, 8, 13, 15, 28, 41, 62, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -748,7 +748,7 @@ namespace Sinex
 
    void SitePhaseCenter::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 21, 27, 34, 41, 48, 55, 62, 69, -1};
+      static const int FIELD_DIVS[] = {0, 21, 27, 34, 41, 48, 55, 62, 69, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -837,7 +837,7 @@ namespace Sinex
 
    void SiteEccentricity::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 5, 8, 13, 15, 28, 41, 45, 54, 63, -1};
+      static const int FIELD_DIVS[] = {0, 5, 8, 13, 15, 28, 41, 45, 54, 63, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -905,7 +905,7 @@ namespace Sinex
 
    void SatelliteId::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 5, 8, 18, 20, 33, 46, -1};
+      static const int FIELD_DIVS[] = {0, 5, 8, 18, 20, 33, 46, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -972,7 +972,7 @@ namespace Sinex
 
    void SatellitePhaseCenter::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 5, 7, 14, 21, 28, 30, 37, 44, 51, 62, 64, -1};
+      static const int FIELD_DIVS[] = {0, 5, 7, 14, 21, 28, 30, 37, 44, 51, 62, 64, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -1043,7 +1043,7 @@ namespace Sinex
 
    void BiasEpoch::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 5, 8, 13, 15, 28, 41, -1};
+      static const int FIELD_DIVS[] = {0, 5, 8, 13, 15, 28, 41, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -1100,7 +1100,7 @@ namespace Sinex
    void
    SolutionStatistics::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 31, -1};
+      static const int FIELD_DIVS[] = {0, 31, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -1152,7 +1152,7 @@ namespace Sinex
 
    void SolutionEpoch::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 5, 8, 13, 15, 28, 41, -1};
+      static const int FIELD_DIVS[] = {0, 5, 8, 13, 15, 28, 41, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -1218,7 +1218,7 @@ namespace Sinex
 
    void SolutionEstimate::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 6, 13, 18, 21, 26, 39, 44, 46, 68, -1};
+      static const int FIELD_DIVS[] = {0, 6, 13, 18, 21, 26, 39, 44, 46, 68, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -1288,7 +1288,7 @@ namespace Sinex
 
    void SolutionApriori::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 6, 13, 18, 21, 26, 39, 44, 46, 68, -1};
+      static const int FIELD_DIVS[] = {0, 6, 13, 18, 21, 26, 39, 44, 46, 68, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -1351,7 +1351,7 @@ namespace Sinex
 
    void SolutionMatrixEstimate::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 6, 12, 34, 56, -1};
+      static const int FIELD_DIVS[] = {0, 6, 12, 34, 56, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -1464,7 +1464,7 @@ namespace Sinex
 
    void SolutionMatrixApriori::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 6, 12, 34, 56, -1};
+      static const int FIELD_DIVS[] = {0, 6, 12, 34, 56, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -1582,7 +1582,7 @@ namespace Sinex
 
    void SolutionNormalEquationVector::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 6, 13, 18, 21, 26, 39, 44, 46, -1};
+      static const int FIELD_DIVS[] = {0, 6, 13, 18, 21, 26, 39, 44, 46, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -1644,7 +1644,7 @@ namespace Sinex
 
    void SolutionNormalEquationMatrix::operator=(const std::string& line)
    {
-      static int FIELD_DIVS[] = {0, 6, 12, 34, 56, -1};
+      static const int FIELD_DIVS[] = {0, 6, 12, 34, 56, -1};
       try
       {
          isValidLineStructure(line, MIN_LINE_LEN, MAX_LINE_LEN, FIELD_DIVS);
@@ -206,6 +206,60 @@ namespace gpstk
    }
 
 
+      /* Compute the delays and the mapping function for every elevation in
+       * batch. The dry and wet mapping functions are the same in this
+       * model, so it is computed once for each elevation.
+       */
+   void GCATTropModel::batchCorrection(TropBatch& batch) const
+      throw(InvalidTropModel)
+   {
+      THROW_IF_INVALID();
+
+      resizeBatch(batch);
+      batch.dryZenith = dry_zenith_delay();
+      batch.wetZenith = wet_zenith_delay();
+      const double zenith(batch.dryZenith + batch.wetZenith);
+
+      for(size_t i=0; i<batch.elevation.size(); i++)
+      {
+         double map(0.0);
+         if(batch.elevation[i] >= 5.0)
+         {
+            double d = std::sin(batch.elevation[i]*DEG_TO_RAD);
+            d = SQRT(0.002001+(d*d));
+            map = 1.001/d;
+         }
+         batch.dryMap[i] = batch.wetMap[i] = map;
+         batch.corr[i] = zenith * map;
+      }
+   }
+
+
+      /* Compute the delays for many satellites seen from RX, as
+       * correction(RX,SV) does for one.
+       */
+   void GCATTropModel::batchCorrection( const Position& RX,
+                                        const std::vector<Position>& SV,
+                                        const CommonTime& tt,
+                                        TropBatch& batch )
+      throw(InvalidTropModel)
+   {
+      try
+      {
+         setReceiverHeight( RX.getAltitude() );
+      }
+      catch(GeometryException& e)
+      {
+         valid = false;
+      }
+
+      if(!valid) throw InvalidTropModel("Invalid model");
+
+      elevationGeodetic(RX, SV, batch.elevation);
+      GCATTropModel::batchCorrection(batch);
+   }
+
+
       /* Define the receiver height; this is required before calling
        * correction() or any of the zenith_delay or mapping_function routines.
        * @param ht Height of the receiver above mean sea level, in meters.
@@ -213,6 +213,29 @@ namespace gpstk
       { return mapping_function(elevation); };
 
 
+         /** Compute the delays and the mapping function for every
+          *  elevation in \a batch, with the zenith delays computed once.
+          */
+      virtual void batchCorrection(TropBatch& batch) const
+         throw(InvalidTropModel);
+
+
+         /** Compute the delays for many satellites seen from \a RX,
+          *  setting the receiver height as correction(RX,SV) does.
+          *
+          * @param RX    Receiver position
+          * @param SV    Satellite positions
+          * @param tt    Time. In this model, tt is a dummy parameter kept
+          *              just for consistency
+          * @param batch On output the elevations and delays
+          */
+      virtual void batchCorrection( const Position& RX,
+                                    const std::vector<Position>& SV,
+                                    const CommonTime& tt,
+                                    TropBatch& batch )
+         throw(InvalidTropModel);
+
+
          /** In GCAT tropospheric model, this is a dummy method kept here just
           *  for consistency.
           */
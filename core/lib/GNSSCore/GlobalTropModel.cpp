@@ -323,10 +323,9 @@ namespace gpstk
       throw(InvalidTropModel)
    {
       try {
-         double p;
-         p = RX.getAltitude();         if(p != height) setReceiverHeight(p);
-         p = RX.getGeodeticLatitude(); if(p != latitude) setReceiverLatitude(p);
-         p = RX.getLongitude();        if(p != longitude) setReceiverLongitude(p);
+         setReceiverHeight(RX.getAltitude());
+         setReceiverLatitude(RX.getGeodeticLatitude());
+         setReceiverLongitude(RX.getLongitude());
       }
       catch(GeometryException& e) {
          validHeight = validLat = valid = false;
@@ -346,6 +345,75 @@ namespace gpstk
 
    }  // end GlobalTropModel::correction(RX,SV)
 
+   // Compute the delays and mapping functions for every elevation in batch.
+   // The coefficients that depend on the site and day are members, and the
+   // parts of the continued fractions that do not depend on the elevation
+   // are computed once here; the arithmetic is otherwise that of
+   // correction(elevation) and the mapping functions.
+   void GlobalTropModel::batchCorrection(TropBatch& batch) const
+      throw(InvalidTropModel)
+   {
+      try { testValidity(); }
+      catch(InvalidTropModel& e) { GPSTK_RETHROW(e); }
+
+      resizeBatch(batch);
+      batch.dryZenith = GlobalTropModel::dry_zenith_delay();
+      batch.wetZenith = GlobalTropModel::wet_zenith_delay();
+
+      static const double bh = 0.0029;
+      static const double bw = 0.00146;
+      static const double cw = 0.04391;
+      static const double a_ht = 2.53e-5;
+      static const double b_ht = 5.49e-3;
+      static const double c_ht = 1.14e-3;
+      const double f1h(1.0 + ah/(1.0 + bh/(1.0 + ch)));
+      const double f1w(1.0 + aw/(1.0 + bw/(1.0 + cw)));
+      const double f1ht(1.0  + a_ht/(1.0  + b_ht/(1.0  + c_ht)));
+      const double htkm(height/1000.0);
+
+      for(size_t i=0; i<batch.elevation.size(); i++) {
+         double elevation(batch.elevation[i]);
+         if(elevation < 3.0) {
+            batch.corr[i] = batch.dryMap[i] = batch.wetMap[i] = 0.0;
+            continue;
+         }
+         double sine = ::sin(elevation*DEG_TO_RAD);
+         double map_dry = f1h / (sine + ah/(sine + bh/(sine + ch)));
+         map_dry += ( (1.0/sine) - f1ht / (sine + a_ht/(sine + b_ht/(sine + c_ht)))
+                    ) * htkm;
+         double map_wet = f1w / (sine + aw/(sine + bw/(sine + cw)));
+
+         batch.dryMap[i] = map_dry;
+         batch.wetMap[i] = map_wet;
+         batch.corr[i] = (batch.dryZenith * map_dry) + (batch.wetZenith * map_wet);
+      }
+
+   }  // end GlobalTropModel::batchCorrection(batch)
+
+   // Compute the delays for many satellites seen from RX at tt.
+   void GlobalTropModel::batchCorrection(const Position& RX,
+                                         const std::vector<Position>& SV,
+                                         const CommonTime& tt,
+                                         TropBatch& batch)
+      throw(InvalidTropModel)
+   {
+      setTime(tt);
+      try {
+         setReceiverHeight(RX.getAltitude());
+         setReceiverLatitude(RX.getGeodeticLatitude());
+         setReceiverLongitude(RX.getLongitude());
+         elevationGeodetic(RX, SV, batch.elevation);
+      }
+      catch(GeometryException& e) {
+         validHeight = validLat = valid = false;
+         GPSTK_RETHROW(e);
+      }
+
+      try { GlobalTropModel::batchCorrection(batch); }
+      catch(InvalidTropModel& e) { GPSTK_RETHROW(e); }
+
+   }  // end GlobalTropModel::batchCorrection(RX,SV,tt,batch)
+
    // Compute and return the zenith delay for hydrostatic (dry) component of
    // the troposphere. Use the Saastamoinen value.
    // Ref. Davis etal 1985 and Leick, 3rd ed, pg 197.
@@ -376,29 +444,7 @@ namespace gpstk
       try { testValidity(); } catch(InvalidTropModel& e) { GPSTK_RETHROW(e); }
       if(elevation < 3.0) { return 0.0; }
 
-      double clat = ::cos(latitude*DEG_TO_RAD);
-      double phh, c11h, c10h;
-
       static const double bh = 0.0029;
-      static const double c0h = 0.062;
-      if(latitude < 0) {
-         phh = PI;
-         c11h = 0.007;
-         c10h = 0.002;
-      }
-      else {
-         phh = 0.0;
-         c11h = 0.005;
-         c10h = 0.001;
-      }
-      double ch = c0h + ((::cos(dayfactor + phh)+1.0)*c11h/2.0 + c10h)*(1.0-clat);
-
-      double am(0.0), aa(0.0);
-      for(int i=0; i<55; i++) {
-         am += (ADryMean[i]*aP[i] + BDryMean[i]*bP[i]) * 1.0e-5;
-         aa += (ADryAmp[i]*aP[i] + BDryAmp[i]*bP[i]) * 1.0e-5;
-      }
-      double ah = am + aa*::cos(dayfactor);
 
       double sine = ::sin(elevation*DEG_TO_RAD);
       //std::cout << "sine " << std::fixed << std::setprecision(16) << sine
@@ -471,13 +517,6 @@ namespace gpstk
       static const double bw = 0.00146;
       static const double cw = 0.04391;
 
-      double am(0.0), aa(0.0);
-      for(int i=0; i<55; i++) {
-         am += (AWetMean[i]*aP[i] + BWetMean[i]*bP[i]) * 1.0e-5;
-         aa += (AWetAmp[i]*aP[i] + BWetAmp[i]*bP[i]) * 1.0e-5;
-      }
-      double aw = am + aa*::cos(dayfactor);
-
       double sine = ::sin(elevation*DEG_TO_RAD);
       //std::cout << "sine " << std::fixed << std::setprecision(16) << sine
       // << std::endl;
@@ -510,34 +549,22 @@ namespace gpstk
       try { testValidity(); }
       catch(InvalidTropModel& e) { GPSTK_RETHROW(e); }
       
-      int i;
-
       // undulation and orthometric height
-      U = 0.0;
-      for(i=0; i<55; i++) U += (Ageoid[i]*aP[i] + Bgeoid[i]*bP[i]);
+      U = geoidSum;
       double orthoht(height - U);
       if(orthoht > 44247.) GPSTK_THROW(InvalidTropModel(
                            "Invalid Global trop model: Rx Height is too large"));
 
       // press at geoid
-      double am(0.0),aa(0.0),v0;
-      for(i=0; i<55; i++) {
-         am += (APressMean[i]*aP[i] + BPressMean[i]*bP[i]);
-         aa += (APressAmp[i]*aP[i] + BPressAmp[i]*bP[i]);
-      }
-      v0 = am + aa * ::cos(dayfactor);
+      double v0;
+      v0 = pressMean + pressAmp * ::cos(dayfactor);
       
       // pressure at height
       // NB this implies any orthoht > 1/2.26e-5 == 44247.78m is invalid!
       P = v0 * ::pow(1.0-2.26e-5*orthoht,5.225);
 
       // temper on geoid
-      am = aa = 0.0;
-      for(i=0; i<55; i++) {
-         am += (ATempMean[i]*aP[i] + BTempMean[i]*bP[i]);
-         aa += (ATempAmp[i]*aP[i] + BTempAmp[i]*bP[i]);
-      }
-      v0 = am + aa * ::cos(dayfactor);
+      v0 = tempMean + tempAmp * ::cos(dayfactor);
 
       // temp at height
       T = v0 - 6.5e-3 * orthoht;
@@ -548,7 +575,7 @@ namespace gpstk
    // @param ht   Height of the receiver above mean sea level, in meters.
    void GlobalTropModel::setReceiverHeight(const double& ht)
    {
-      if(height != ht) {
+      if(!validHeight || height != ht) {
          height = ht; 
          validHeight = true;
          validCoeff = false;
@@ -561,10 +588,10 @@ namespace gpstk
    // @param lat  Latitude of receiver, in degrees.
    void GlobalTropModel::setReceiverLatitude(const double& lat)
    {
-      if(latitude != lat) {
+      if(!validLat || latitude != lat) {
          latitude = lat;
          validLat = true;
-         validCoeff = false;
+         validCoeff = validHarmonics = false;
          setValid();          // calls updateGTMCoeff()
       }
    }
@@ -574,10 +601,10 @@ namespace gpstk
    // @param lat  Longitude of receiver, in degrees East.
    void GlobalTropModel::setReceiverLongitude(const double& lon)
    {
-      if(longitude != lon) {
+      if(!validLon || longitude != lon) {
          longitude = lon;
          validLon = true;
-         validCoeff = false;
+         validCoeff = validHarmonics = false;
          setValid();          // calls updateGTMCoeff()
       }
    }
@@ -588,7 +615,7 @@ namespace gpstk
    void GlobalTropModel::setTime(const double& mjd)
    {
       double df(TWO_PI*(mjd - 44266.0)/365.25);       // -44239 + 1 - 28
-      if(df != dayfactor) {
+      if(!validDay || df != dayfactor) {
          dayfactor = df;
          validDay = true;
          validCoeff = false;
@@ -620,6 +647,7 @@ namespace gpstk
    void GlobalTropModel::setParameters(const CommonTime& time, const Position& rxPos)
    {
       validDay = validHeight = validLat = validLon = validCoeff = false;
+      validHarmonics = false;
       setTime(time);
       setReceiverHeight(rxPos.getHeight());
       setReceiverLatitude(rxPos.getGeodeticLatitude());
@@ -662,6 +690,45 @@ namespace gpstk
          }
       }
 
+      // the expansions at this site, which change only with the day
+      dryMapMean = dryMapAmp = wetMapMean = wetMapAmp = geoidSum = 0.0;
+      pressMean = pressAmp = tempMean = tempAmp = 0.0;
+      for(i=0; i<55; i++) {
+         dryMapMean += (ADryMean[i]*aP[i] + BDryMean[i]*bP[i]) * 1.0e-5;
+         dryMapAmp += (ADryAmp[i]*aP[i] + BDryAmp[i]*bP[i]) * 1.0e-5;
+         wetMapMean += (AWetMean[i]*aP[i] + BWetMean[i]*bP[i]) * 1.0e-5;
+         wetMapAmp += (AWetAmp[i]*aP[i] + BWetAmp[i]*bP[i]) * 1.0e-5;
+         geoidSum += (Ageoid[i]*aP[i] + Bgeoid[i]*bP[i]);
+         pressMean += (APressMean[i]*aP[i] + BPressMean[i]*bP[i]);
+         pressAmp += (APressAmp[i]*aP[i] + BPressAmp[i]*bP[i]);
+         tempMean += (ATempMean[i]*aP[i] + BTempMean[i]*bP[i]);
+         tempAmp += (ATempAmp[i]*aP[i] + BTempAmp[i]*bP[i]);
+      }
+
+   }
+
+   // Update the mapping function coefficients for the current site and day
+   void GlobalTropModel::updateMapCoeff(void)
+   {
+      double clat = ::cos(latitude*DEG_TO_RAD);
+      double phh, c11h, c10h;
+
+      static const double c0h = 0.062;
+      if(latitude < 0) {
+         phh = PI;
+         c11h = 0.007;
+         c10h = 0.002;
+      }
+      else {
+         phh = 0.0;
+         c11h = 0.005;
+         c10h = 0.001;
+      }
+      ch = c0h + ((::cos(dayfactor + phh)+1.0)*c11h/2.0 + c10h)*(1.0-clat);
+
+      double cday(::cos(dayfactor));
+      ah = dryMapMean + dryMapAmp*cday;
+      aw = wetMapMean + wetMapAmp*cday;
    }
 
    // Utility to test valid flags
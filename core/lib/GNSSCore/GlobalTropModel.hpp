@@ -96,7 +96,8 @@ namespace gpstk
    {
    public:
       /// Default constructor
-      GlobalTropModel(void) : validCoeff(false), validHeight(false), validLat(false),
+      GlobalTropModel(void) : validCoeff(false), validHarmonics(false),
+                              validHeight(false), validLat(false),
                               validLon(false), validDay(false)
       {
          TropModel::humid = 50.0;
@@ -114,7 +115,8 @@ namespace gpstk
       GlobalTropModel(const double& ht, const double& lat, const double& lon,
                       const double& mjd)
       {
-         validCoeff = validHeight = validLat = validLon = validDay = valid = false;
+         validCoeff = validHarmonics = validHeight = validLat = validLon
+            = validDay = valid = false;
          setReceiverHeight(ht);
          setReceiverLatitude(lat);
          setReceiverLongitude(lon);
@@ -127,7 +129,8 @@ namespace gpstk
       /// @param time Time.
       GlobalTropModel(const Position& RX, const CommonTime& time)
       {
-         validCoeff = validHeight = validLat = validLon = validDay = valid = false;
+         validCoeff = validHarmonics = validHeight = validLat = validLon
+            = validDay = valid = false;
          setReceiverHeight(RX.getAltitude());
          setReceiverLatitude(RX.getGeodeticLatitude());
          setReceiverLongitude(RX.getLongitude());
@@ -214,6 +217,20 @@ namespace gpstk
       virtual double wet_mapping_function(double elevation) const
          throw(InvalidTropModel);
 
+      /// Compute the delays and mapping functions for every elevation in
+      /// \a batch, with the mapping function coefficients and the zenith
+      /// delays computed once.
+      virtual void batchCorrection(TropBatch& batch) const
+         throw(InvalidTropModel);
+
+      /// Compute the delays for many satellites seen from \a RX at \a tt,
+      /// setting the receiver and time as correction(RX,SV,tt) does.
+      virtual void batchCorrection(const Position& RX,
+                                   const std::vector<Position>& SV,
+                                   const CommonTime& tt,
+                                   TropBatch& batch)
+         throw(InvalidTropModel);
+
       /// Compute the pressure and temperature at height, and the undulation,
       /// for the given position and time.
       /// @param P output pressure
@@ -305,21 +322,40 @@ namespace gpstk
       double P[10][10], aP[55], bP[55];
       bool validHeight, validLat, validLon, validDay, validCoeff;
 
+      /// The spherical harmonic expansions at the receiver, mean and annual
+      /// amplitude of each, which depend only on latitude and longitude.
+      double dryMapMean, dryMapAmp, wetMapMean, wetMapAmp, geoidSum,
+         pressMean, pressAmp, tempMean, tempAmp;
+      /// True when aP, bP and the sums above are for latitude, longitude.
+      bool validHarmonics;
+
+      /// Mapping function coefficients for the current site and day
+      double ah, ch, aw;
+
       /// Update coefficients when latitude and/or longitude changes
       void updateGTMCoeff(void);
 
+      /// Update ah, ch and aw when the latitude or day changes
+      void updateMapCoeff(void);
+
       /// Utility to test valid flags
       void testValidity(void) const throw(InvalidTropModel);
 
       /// Utility to set valid based on the other flags,
-      /// and update coefficients and press, temp as needed
+      /// and update coefficients and press, temp as needed.
+      /// The harmonics are only recomputed when the latitude or
+      /// longitude has changed.
       void setValid(void) throw(InvalidTropModel)
       {
          try{
             valid = validHeight && validLat && validLon && validDay;
             if(valid && !validCoeff) {
-               updateGTMCoeff();
+               if(!validHarmonics) {
+                  updateGTMCoeff();
+                  validHarmonics = true;
+               }
                validCoeff = true;
+               updateMapCoeff();
                getGPT(press,temp,undul);
             }
          } catch(Exception& e) { GPSTK_RETHROW(e); }
@@ -297,6 +297,41 @@ namespace gpstk
    }
 
 
+      // Compute the delays for many satellites seen from RX at tt, as
+      // correction(RX,SV,tt) does for one.
+   void MOPSTropModel::batchCorrection( const Position& RX,
+                                        const std::vector<Position>& SV,
+                                        const CommonTime& tt,
+                                        TropBatch& batch )
+      throw(InvalidTropModel)
+   {
+      setDayOfYear(tt);
+
+      try
+      {
+         setReceiverHeight( RX.getAltitude() );
+         setReceiverLatitude(RX.getGeodeticLatitude());
+         setWeather();
+      }
+      catch(GeometryException& e)
+      {
+         valid = false;
+      }
+
+      if(!valid) throw InvalidTropModel("Invalid model");
+
+      try
+      {
+         elevationGeodetic(RX, SV, batch.elevation);
+         GCATTropModel::batchCorrection(batch);
+      }
+      catch(InvalidTropModel& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+   }
+
+
       // Compute and return the zenith delay for the dry component of the
       // troposphere
    double MOPSTropModel::dry_zenith_delay(void) const
@@ -375,14 +410,23 @@ namespace gpstk
       }
 
          // In order to compute tropospheric delay we need to compute some
-         // extra parameters
-      try
+         // extra parameters. They depend only on latitude and day of year,
+         // so they are kept until one of those changes.
+      if( (MOPSParameters.size() == 0) ||
+          (paramLat != MOPSLat) ||
+          (paramTime != MOPSTime) )
       {
-         prepareParameters();
-      }
-      catch(InvalidTropModel& e)
-      {
-         GPSTK_RETHROW(e);
+         try
+         {
+            prepareParameters();
+            paramLat = MOPSLat;
+            paramTime = MOPSTime;
+         }
+         catch(InvalidTropModel& e)
+         {
+            MOPSParameters.resize(0);
+            GPSTK_RETHROW(e);
+         }
       }
 
       valid = validHeight && validLat && validTime;
@@ -529,7 +573,10 @@ namespace gpstk
       try
       {
             // We need to read some data
-         prepareTables();
+         if (fi0.size() == 0)
+         {
+            prepareTables();
+         }
 
             // Declare some variables
          int idmin, j, index;
@@ -250,6 +250,29 @@ namespace gpstk
          throw(InvalidTropModel);
 
 
+         /// Compute the delays and the mapping function for every elevation
+         /// in \a batch, with the zenith delays computed once.
+      virtual void batchCorrection(TropBatch& batch) const
+         throw(InvalidTropModel)
+      { GCATTropModel::batchCorrection(batch); };
+
+
+         /** Compute the delays for many satellites seen from \a RX at
+          *  \a tt, setting the receiver and day of year as
+          *  correction(RX,SV,tt) does.
+          *
+          * @param RX    Receiver position
+          * @param SV    Satellite positions
+          * @param tt    Time
+          * @param batch On output the elevations and delays
+          */
+      virtual void batchCorrection( const Position& RX,
+                                    const std::vector<Position>& SV,
+                                    const CommonTime& tt,
+                                    TropBatch& batch )
+         throw(InvalidTropModel);
+
+
          /** This method configure the model to estimate the weather using
           *  height, latitude and day of year (DOY). It is called automatically
           *  when setting those parameters.
@@ -335,6 +358,9 @@ namespace gpstk
       Matrix<double> svr;
       Vector<double> fi0;
       Vector<double> MOPSParameters;
+         /// Latitude and day of year MOPSParameters were computed for
+      double paramLat;
+      int paramTime;
 
 
          // The MOPS tropospheric model needs to compute several extra
@@ -356,6 +356,52 @@ namespace gpstk
          return 0.0;
       }
 
+      double a, b, c;
+      dryCoefficients(a, b, c);
+
+      double se = ::sin(elevation*DEG_TO_RAD);
+      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
+
+      a = 0.0000253;
+      b = 0.00549;
+      c = 0.00114;
+      map += ( NeillHeight/1000.0 ) *
+         ( 1./se - ( (1.+a/(1.+b/(1.+c))) / (se+a/(se+b/(se+c))) ) );
+
+      return map;
+   }
+
+
+      // Compute and return the mapping function for wet component of the
+      // troposphere.
+      //
+      // @param elevation Elevation of satellite as seen at receiver,
+      //                  in degrees.
+   double NeillTropModel::wet_mapping_function(double elevation) const
+      throw(InvalidTropModel)
+   {
+      THROW_IF_INVALID_DETAILED();
+
+      if(elevation < 3.0)
+      {
+         return 0.0;
+      }
+
+      double a,b,c;
+      wetCoefficients(a, b, c);
+
+      double se = ::sin(elevation*DEG_TO_RAD);
+      double map = ( 1.+ a/ (1.+ b/(1.+c) ) ) / (se + a/(se + b/(se+c) ) );
+
+      return map;
+
+   }  // end NeillTropModel::wet_mapping_function()
+
+
+      // Coefficients of the dry mapping function, interpolated in latitude
+      // and with the seasonal term for the day of year.
+   void NeillTropModel::dryCoefficients(double& a, double& b, double& c) const
+   {
       double lat, t, ct;
       lat = fabs(NeillLat);         // degrees
       t = static_cast<double>(NeillDOY) - 28.0;  // mid-winter
@@ -368,7 +414,6 @@ namespace gpstk
       t *= 360.0/365.25;            // convert to degrees
       ct = ::cos(t*DEG_TO_RAD);
 
-      double a, b, c;
       if(lat < 15.0)
       {
          a = NeillDryA[0];
@@ -393,36 +438,13 @@ namespace gpstk
          b = NeillDryB[4] - ct * NeillDryB1[4];
          c = NeillDryC[4] - ct * NeillDryC1[4];
       }
-
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
-
-      a = 0.0000253;
-      b = 0.00549;
-      c = 0.00114;
-      map += ( NeillHeight/1000.0 ) *
-         ( 1./se - ( (1.+a/(1.+b/(1.+c))) / (se+a/(se+b/(se+c))) ) );
-
-      return map;
    }
 
 
-      // Compute and return the mapping function for wet component of the
-      // troposphere.
-      //
-      // @param elevation Elevation of satellite as seen at receiver,
-      //                  in degrees.
-   double NeillTropModel::wet_mapping_function(double elevation) const
-      throw(InvalidTropModel)
+      // Coefficients of the wet mapping function, interpolated in latitude.
+   void NeillTropModel::wetCoefficients(double& a, double& b, double& c) const
    {
-      THROW_IF_INVALID_DETAILED();
-
-      if(elevation < 3.0)
-      {
-         return 0.0;
-      }
-
-      double a,b,c,lat;
+      double lat;
       lat = fabs(NeillLat);         // degrees
       if(lat < 15.0)
       {
@@ -444,13 +466,88 @@ namespace gpstk
          b = NeillWetB[4];
          c = NeillWetC[4];
       }
+   }
 
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = ( 1.+ a/ (1.+ b/(1.+c) ) ) / (se + a/(se + b/(se+c) ) );
 
-      return map;
+      // Compute the delays and mapping functions for every elevation in
+      // batch, with the coefficients and zenith delays computed once.
+   void NeillTropModel::batchCorrection(TropBatch& batch) const
+      throw(InvalidTropModel)
+   {
+      THROW_IF_INVALID_DETAILED();
 
-   }  // end NeillTropModel::wet_mapping_function()
+      resizeBatch(batch);
+      batch.dryZenith = NeillTropModel::dry_zenith_delay();
+      batch.wetZenith = NeillTropModel::wet_zenith_delay();
+
+      double ad, bd, cd, aw, bw, cw;
+      dryCoefficients(ad, bd, cd);
+      wetCoefficients(aw, bw, cw);
+
+      const double ah(0.0000253), bh(0.00549), ch(0.00114);
+      const double f1d(1.+ad/(1.+bd/(1.+cd)));
+      const double f1h(1.+ah/(1.+bh/(1.+ch)));
+      const double f1w(1.+ aw/ (1.+ bw/(1.+cw) ) );
+      const double htkm(NeillHeight/1000.0);
+
+      for(size_t i=0; i<batch.elevation.size(); i++)
+      {
+         double elevation(batch.elevation[i]);
+         if(elevation < 3.0)
+         {
+            batch.corr[i] = batch.dryMap[i] = batch.wetMap[i] = 0.0;
+            continue;
+         }
+
+         double se = ::sin(elevation*DEG_TO_RAD);
+         double map_dry = f1d/(se+ad/(se+bd/(se+cd)));
+         map_dry += htkm * ( 1./se - ( f1h / (se+ah/(se+bh/(se+ch))) ) );
+         double map_wet = f1w / (se + aw/(se + bw/(se+cw) ) );
+
+         batch.dryMap[i] = map_dry;
+         batch.wetMap[i] = map_wet;
+         batch.corr[i] = (batch.dryZenith * map_dry) +
+                         (batch.wetZenith * map_wet);
+      }
+   }
+
+
+      // Compute the delays for many satellites seen from RX at tt, as
+      // correction(RX,SV,tt) does for one.
+   void NeillTropModel::batchCorrection( const Position& RX,
+                                         const std::vector<Position>& SV,
+                                         const CommonTime& tt,
+                                         TropBatch& batch )
+      throw(InvalidTropModel)
+   {
+      setDayOfYear(tt);
+
+      try
+      {
+         setReceiverHeight( RX.getAltitude() );
+         setReceiverLatitude(RX.getGeodeticLatitude());
+         setWeather();
+      }
+      catch(GeometryException& e)
+      {
+         valid = false;
+      }
+
+      if(!valid)
+      {
+         throw InvalidTropModel("Invalid model");
+      }
+
+      try
+      {
+         elevationGeodetic(RX, SV, batch.elevation);
+         NeillTropModel::batchCorrection(batch);
+      }
+      catch(InvalidTropModel& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+   }
 
 
       // This method configure the model to estimate the weather using height,
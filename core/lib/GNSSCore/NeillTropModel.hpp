@@ -278,6 +278,23 @@ namespace gpstk
          throw(InvalidTropModel);
 
 
+         /// Compute the delays and mapping functions for every elevation
+         /// in \a batch, with the mapping function coefficients and the
+         /// zenith delays computed once.
+      virtual void batchCorrection(TropBatch& batch) const
+         throw(InvalidTropModel);
+
+
+         /// Compute the delays for many satellites seen from \a RX at
+         /// \a tt, setting the receiver and day of year as
+         /// correction(RX,SV,tt) does.
+      virtual void batchCorrection( const Position& RX,
+                                    const std::vector<Position>& SV,
+                                    const CommonTime& tt,
+                                    TropBatch& batch )
+         throw(InvalidTropModel);
+
+
          /// This method configure the model to estimate the weather using
          /// height, latitude and day of year (DOY). It is called
          /// automatically when setting those parameters.
@@ -344,6 +361,14 @@ namespace gpstk
       bool validHeight;
       bool validLat;
       bool validDOY;
+
+         /// Coefficients of the dry mapping function, for the receiver
+         /// latitude and day of year.
+      void dryCoefficients(double& a, double& b, double& c) const;
+
+         /// Coefficients of the wet mapping function, for the receiver
+         /// latitude.
+      void wetCoefficients(double& a, double& b, double& c) const;
    };
 
 }
@@ -1105,6 +1105,19 @@ namespace gpstk
                                              const double A,
                                              const double eccSq)
       throw()
+   {
+      double a[3] = { xyz[0], xyz[1], xyz[2] }, b[3];
+      convertCartesianToGeodetic(a, b, A, eccSq);
+      llh[0] = b[0];
+      llh[1] = b[1];
+      llh[2] = b[2];
+   }
+
+   void Position::convertCartesianToGeodetic(const double xyz[3],
+                                             double llh[3],
+                                             const double A,
+                                             const double eccSq)
+      throw()
    {
       double p,slat,N,htold,latold;
       p = SQRT(xyz[0]*xyz[0]+xyz[1]*xyz[1]);
@@ -749,6 +749,16 @@ namespace gpstk
                                              const double eccSq)
          throw();
 
+         /** Same as convertCartesianToGeodetic(const Triple&, Triple&,
+          * const double, const double), on plain arrays of three
+          * doubles, for inner loops that must not create Triples.
+          */
+      static void convertCartesianToGeodetic(const double xyz[3],
+                                             double llh[3],
+                                             const double A,
+                                             const double eccSq)
+         throw();
+
          /** Fundamental routine to convert geodetic to ECEF
           * (cartesian) coordinates, (Ellipsoid specified by
           * semi-major axis and eccentricity squared).
@@ -278,6 +278,43 @@ namespace gpstk
       THROW_IF_INVALID_DETAILED();
       if(elevation < 0.0) return 0.0;
 
+      double a,b,c;
+      dryCoefficients(a,b,c);
+
+      double se = ::sin(elevation*DEG_TO_RAD);
+      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
+
+      a = 0.0000253;
+      b = 0.00549;
+      c = 0.00114;
+      map += (height/1000.0)*(1./se-(1+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c))));
+
+      return map;
+
+   }  // end SaasTropModel::dry_mapping_function()
+
+      // Compute and return the mapping function for wet component of the troposphere
+      // @param elevation Elevation of satellite as seen at receiver, in degrees.
+   double SaasTropModel::wet_mapping_function(double elevation) const
+      throw(InvalidTropModel)
+   {
+      THROW_IF_INVALID_DETAILED();
+      if(elevation < 0.0) return 0.0;
+
+      double a,b,c;
+      wetCoefficients(a,b,c);
+
+      double se = ::sin(elevation*DEG_TO_RAD);
+      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
+
+      return map;
+
+   }
+
+      // Coefficients of the dry mapping function, interpolated in latitude
+      // and with the seasonal term for the day of year.
+   void SaasTropModel::dryCoefficients(double& a, double& b, double& c) const
+   {
       double lat,t,ct;
       lat = fabs(latitude);         // degrees
       t = doy - 28.;                // mid-winter
@@ -286,7 +323,6 @@ namespace gpstk
       t *= 360.0/365.25;            // convert to degrees
       ct = ::cos(t*DEG_TO_RAD);
 
-      double a,b,c;
       if(lat < 15.) {
          a = SaasDryA[0];
          b = SaasDryB[0];
@@ -308,28 +344,12 @@ namespace gpstk
          b = SaasDryB[4] - ct * SaasDryB1[4];
          c = SaasDryC[4] - ct * SaasDryC1[4];
       }
+   }
 
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
-
-      a = 0.0000253;
-      b = 0.00549;
-      c = 0.00114;
-      map += (height/1000.0)*(1./se-(1+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c))));
-
-      return map;
-
-   }  // end SaasTropModel::dry_mapping_function()
-
-      // Compute and return the mapping function for wet component of the troposphere
-      // @param elevation Elevation of satellite as seen at receiver, in degrees.
-   double SaasTropModel::wet_mapping_function(double elevation) const
-      throw(InvalidTropModel)
+      // Coefficients of the wet mapping function, interpolated in latitude.
+   void SaasTropModel::wetCoefficients(double& a, double& b, double& c) const
    {
-      THROW_IF_INVALID_DETAILED();
-      if(elevation < 0.0) return 0.0;
-
-      double a,b,c,lat;
+      double lat;
       lat = fabs(latitude);         // degrees
       if(lat < 15.) {
          a = SaasWetA[0];
@@ -348,13 +368,82 @@ namespace gpstk
          b = SaasWetB[4];
          c = SaasWetC[4];
       }
+   }
 
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
+      // Compute the delays and mapping functions for every elevation in
+      // batch, with the coefficients and zenith delays computed once.
+   void SaasTropModel::batchCorrection(TropBatch& batch) const
+      throw(InvalidTropModel)
+   {
+      if(!valid) {
+         if(!validWeather) GPSTK_THROW(
+            InvalidTropModel("Invalid Saastamoinen trop model: weather"));
+         if(!validRxLatitude) GPSTK_THROW(
+            InvalidTropModel("Invalid Saastamoinen trop model: Rx Latitude"));
+         if(!validRxHeight) GPSTK_THROW(
+            InvalidTropModel("Invalid Saastamoinen trop model: Rx Height"));
+         if(!validDOY) GPSTK_THROW(
+            InvalidTropModel("Invalid Saastamoinen trop model: day of year"));
+         GPSTK_THROW(
+            InvalidTropModel("Valid flag corrupted in Saastamoinen trop model"));
+      }
 
-      return map;
+      resizeBatch(batch);
+      batch.dryZenith = dry_zenith_delay();
+      batch.wetZenith = wet_zenith_delay();
+
+      double ad,bd,cd,aw,bw,cw;
+      dryCoefficients(ad,bd,cd);
+      wetCoefficients(aw,bw,cw);
+
+      const double ah(0.0000253), bh(0.00549), ch(0.00114);
+      const double f1d(1.+ad/(1.+bd/(1.+cd)));
+      const double f1h(1+ah/(1.+bh/(1.+ch)));
+      const double f1w(1.+aw/(1.+bw/(1.+cw)));
+      const double htkm(height/1000.0);
+
+      for(size_t i=0; i<batch.elevation.size(); i++) {
+         double elevation(batch.elevation[i]);
+         if(elevation < 0.0) {
+            batch.corr[i] = batch.dryMap[i] = batch.wetMap[i] = 0.0;
+            continue;
+         }
+
+         double se = ::sin(elevation*DEG_TO_RAD);
+         double map_dry = f1d/(se+ad/(se+bd/(se+cd)));
+         map_dry += htkm*(1./se-f1h/(se+ah/(se+bh/(se+ch))));
+         double map_wet = f1w/(se+aw/(se+bw/(se+cw)));
+
+         batch.dryMap[i] = map_dry;
+         batch.wetMap[i] = map_wet;
+         batch.corr[i] = (batch.dryZenith * map_dry
+                          + batch.wetZenith * map_wet);
+      }
 
-   }
+   }  // end SaasTropModel::batchCorrection(batch)
+
+      // Compute the delays for many satellites seen from RX at tt, as
+      // correction(RX,SV,tt) does for one.
+   void SaasTropModel::batchCorrection(const Position& RX,
+                                       const std::vector<Position>& SV,
+                                       const CommonTime& tt,
+                                       TropBatch& batch)
+      throw(InvalidTropModel)
+   {
+      SaasTropModel::setReceiverHeight(RX.getHeight());
+      SaasTropModel::setReceiverLatitude(RX.getGeodeticLatitude());
+      SaasTropModel::setDayOfYear(int((static_cast<YDSTime>(tt).doy)));
+
+      batch.elevation.resize(SV.size());
+      for(size_t i=0; i<SV.size(); i++)
+         batch.elevation[i] = RX.elevation(SV[i]);
+
+      try {
+         SaasTropModel::batchCorrection(batch);
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+
+   }  // end SaasTropModel::batchCorrection(RX,SV,tt,batch)
 
       // Re-define the weather data.
       // If called, typically called before any calls to correction().
@@ -164,6 +164,20 @@ namespace gpstk
       virtual double wet_mapping_function(double elevation) const
          throw(InvalidTropModel);
 
+         /// Compute the delays and mapping functions for every elevation in
+         /// \a batch, with the mapping function coefficients and the zenith
+         /// delays computed once.
+      virtual void batchCorrection(TropBatch& batch) const
+         throw(InvalidTropModel);
+
+         /// Compute the delays for many satellites seen from \a RX at \a tt,
+         /// setting the receiver and day of year as correction(RX,SV,tt) does.
+      virtual void batchCorrection(const Position& RX,
+                                   const std::vector<Position>& SV,
+                                   const CommonTime& tt,
+                                   TropBatch& batch)
+         throw(InvalidTropModel);
+
          /// Re-define the tropospheric model with explicit weather data.
          /// Typically called just before correction().
          /// @param wx the weather to use for this correction
@@ -202,6 +216,14 @@ namespace gpstk
       bool validRxLatitude;
       bool validRxHeight;
       bool validDOY;
+
+         /// Coefficients of the dry mapping function, for the receiver
+         /// latitude and day of year.
+      void dryCoefficients(double& a, double& b, double& c) const;
+
+         /// Coefficients of the wet mapping function, for the receiver
+         /// latitude.
+      void wetCoefficients(double& a, double& b, double& c) const;
    };
 
 }
@@ -98,6 +98,77 @@ namespace gpstk
       return c;
    }  // end TropModel::correction(RX,SV,TT)
 
+      // Compute the full delay and both mapping functions for every elevation
+      // in batch, and the zenith delays. This version calls the scalar
+      // functions for each elevation; models override it to compute the
+      // site dependent terms once.
+   void TropModel::batchCorrection(TropBatch& batch) const
+      throw(InvalidTropModel)
+   {
+      resizeBatch(batch);
+      batch.dryZenith = dry_zenith_delay();
+      batch.wetZenith = wet_zenith_delay();
+      for(size_t i=0; i<batch.elevation.size(); i++)
+      {
+         batch.corr[i] = correction(batch.elevation[i]);
+         batch.dryMap[i] = dry_mapping_function(batch.elevation[i]);
+         batch.wetMap[i] = wet_mapping_function(batch.elevation[i]);
+      }
+   }  // end TropModel::batchCorrection(batch)
+
+      // Compute the delays for many satellites seen from one receiver at one
+      // time, as correction(RX,SV,tt) does for one.
+   void TropModel::batchCorrection(const Position& RX,
+                                   const std::vector<Position>& SV,
+                                   const CommonTime& tt,
+                                   TropBatch& batch)
+      throw(InvalidTropModel)
+   {
+      batch.elevation.resize(SV.size());
+      for(size_t i=0; i<SV.size(); i++)
+         batch.elevation[i] = RX.elevation(SV[i]);
+      batchCorrection(batch);
+   }  // end TropModel::batchCorrection(RX,SV,tt,batch)
+
+   void TropModel::resizeBatch(TropBatch& batch)
+   {
+      size_t n(batch.elevation.size());
+      batch.corr.resize(n);
+      batch.dryMap.resize(n);
+      batch.wetMap.resize(n);
+   }
+
+      // The same arithmetic as Position::elevationGeodetic(), with the
+      // receiver latitude, longitude and up vector computed once.
+   void TropModel::elevationGeodetic(const Position& RX,
+                                     const std::vector<Position>& SV,
+                                     std::vector<double>& elev)
+      throw(GeometryException)
+   {
+      Position R(RX);
+      double latGeodetic = R.getGeodeticLatitude()*DEG_TO_RAD;
+      double longGeodetic = R.getLongitude()*DEG_TO_RAD;
+      R.transformTo(Position::Cartesian);
+      Triple kVector(::cos(latGeodetic)*::cos(longGeodetic),
+                     ::cos(latGeodetic)*::sin(longGeodetic),
+                     ::sin(latGeodetic));
+
+      elev.resize(SV.size());
+      for(size_t i=0; i<SV.size(); i++)
+      {
+         Position S(SV[i]);
+         S.transformTo(Position::Cartesian);
+         Triple z(S[0]-R[0], S[1]-R[1], S[2]-R[2]);
+         if(z.mag() <= 1e-4)
+         {
+            GeometryException ge("Positions are within .1 millimeter");
+            GPSTK_THROW(ge);
+         }
+         double cosUp = z.dot(kVector)/z.mag();
+         elev[i] = 90.0 - ((::acos(cosUp))*RAD_TO_DEG);
+      }
+   }
+
       // Re-define the tropospheric model with explicit weather data.
       // Typically called just before correction().
       // @param T temperature in degrees Celsius
@@ -43,6 +43,7 @@
 #ifndef TROP_MODEL_HPP
 #define TROP_MODEL_HPP
 
+#include <vector>
 #include "Exception.hpp"
 #include "ObsEpochMap.hpp"
 #include "WxObsMap.hpp"
@@ -95,6 +96,26 @@ namespace gpstk
    /// @ingroup exceptiongroup
    NEW_EXCEPTION_CLASS(InvalidTropModel, gpstk::Exception);
 
+      /** The tropospheric delays of many satellites seen from one
+       * receiver at one time, as computed by
+       * TropModel::batchCorrection().  Element i of each vector is
+       * for the satellite at elevation[i]. */
+   struct TropBatch
+   {
+         /// Elevation of each satellite as seen at receiver, in degrees
+      std::vector<double> elevation;
+         /// Full slant delay, as correction(elevation[i])
+      std::vector<double> corr;
+         /// Hydrostatic (dry) mapping function
+      std::vector<double> dryMap;
+         /// Wet mapping function
+      std::vector<double> wetMap;
+         /// Hydrostatic (dry) zenith delay, the same for all satellites
+      double dryZenith;
+         /// Wet zenith delay, the same for all satellites
+      double wetZenith;
+   };
+
    class TropModel
    {
    public:
@@ -149,6 +170,37 @@ namespace gpstk
          throw(InvalidTropModel)
       { Position R(RX),S(SV);  return TropModel::correction(R,S,tt); }
 
+         /**
+          * Compute the full delay and both mapping functions for every
+          * elevation in \a batch, and the zenith delays, in one call.
+          * The results are those of correction(), dry_mapping_function()
+          * and wet_mapping_function() for each elevation, but models
+          * compute the terms that depend only on the site and the day
+          * of year once for the whole batch.
+          * @param batch on input the elevations; on output all other
+          *   members, with the vectors sized to match the elevations.
+          */
+      virtual void batchCorrection(TropBatch& batch) const
+         throw(InvalidTropModel);
+
+         /**
+          * Compute the delays for many satellites seen from one
+          * receiver at one time.  The receiver parameters are set
+          * from \a RX and \a tt as correction(RX,SV,tt) would, once
+          * for all satellites, then the elevations are computed and
+          * batchCorrection(batch) is called.
+          * @param RX  Receiver position
+          * @param SV  Satellite positions
+          * @param tt  Time tag of the signal
+          * @param batch on output elevation and the delays, element i
+          *   for SV[i].
+          */
+      virtual void batchCorrection(const Position& RX,
+                                   const std::vector<Position>& SV,
+                                   const CommonTime& tt,
+                                   TropBatch& batch)
+         throw(InvalidTropModel);
+
          /// Compute and return the zenith delay for hydrostatic (dry)
          /// component of the troposphere
       virtual double dry_zenith_delay(void) const
@@ -236,6 +288,16 @@ namespace gpstk
          const double& ht, double& T, double& P, double& H);
 
    protected:
+         /// Resize the output vectors of \a batch to match its elevations.
+      static void resizeBatch(TropBatch& batch);
+
+         /// Set \a elev to RX.elevationGeodetic(SV[i]) for each i, with
+         /// the receiver frame computed once.
+      static void elevationGeodetic(const Position& RX,
+                                    const std::vector<Position>& SV,
+                                    std::vector<double>& elev)
+         throw(GeometryException);
+
       bool valid;                 // true only if current model parameters are valid
       double temp;                // latest value of temperature (kelvin or celsius)
       double press;               // latest value of pressure (millibars)
@@ -52,6 +52,7 @@ namespace gpstk
       // Add ephemeris information from a Rinex3NavData object.
    bool GloEphemerisStore::addEphemeris(const Rinex3NavData& data)
    {
+      checkNotFrozen("addEphemeris");
 
          // If enabled, check SV health before entering here (health = 0 -> OK)
       if( (data.health == 0) || (!onlyHealthy) )
@@ -260,6 +261,7 @@ namespace gpstk
    void GloEphemerisStore::edit( const CommonTime& tmin,
                                  const CommonTime& tmax )
    {
+      checkNotFrozen("edit");
 
          // Create a working copy
       GloEphMap bak;
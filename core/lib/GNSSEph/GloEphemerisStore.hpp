@@ -123,7 +123,7 @@ namespace gpstk
           * @param rkStep  Runge-Kutta integration step in seconds.
           */
       GloEphemerisStore& setIntegrationStep( double rkStep )
-      { step = rkStep; return (*this); };
+      { checkNotFrozen("setIntegrationStep"); step = rkStep; return (*this); };
 
          /// Get whether satellite health bit will be used or not.
       bool getCheckHealthFlag() const
@@ -134,7 +134,7 @@ namespace gpstk
           * @param checkHealth   Enable or disable the use of the health bit.
           */
       GloEphemerisStore& setCheckHealthFlag( bool checkHealth )
-      { onlyHealthy = checkHealth; return (*this); };
+      { checkNotFrozen("setCheckHealthFlag"); onlyHealthy = checkHealth; return (*this); };
 
          /** A debugging function that outputs in human readable form,
           *  all data stored in this object.
@@ -160,6 +160,7 @@ namespace gpstk
          /// Clear the dataset, meaning remove all data
       virtual void clear(void)
       {
+         frozen = false;
          pe.clear();
          initialTime = CommonTime::END_OF_TIME;
          finalTime = CommonTime::BEGINNING_OF_TIME;
@@ -187,6 +187,7 @@ namespace gpstk
    bool OrbElemStore::addOrbElem(const OrbElemBase* eph)
       throw(InvalidParameter,Exception)
    {
+     checkNotFrozen("addOrbElem");
      bool dbg = false;
      //if (eph->satID.id==2 ||
      //    eph->satID.id==5) dbg = true;
@@ -334,8 +335,9 @@ namespace gpstk
 //-----------------------------------------------------------------------------
 
    void OrbElemStore::edit(const CommonTime& tmin, const CommonTime& tmax)
-      throw()
+      throw(InvalidRequest)
    {
+      checkNotFrozen("edit");
       for(UBEMap::iterator i = ube.begin(); i != ube.end(); i++)
       {
          OrbElemMap& eMap = i->second;
@@ -629,6 +631,7 @@ namespace gpstk
    void OrbElemStore::clear()
          throw()
    {
+      frozen = false;
       for( UBEMap::iterator ui = ube.begin(); ui != ube.end(); ui++)
       {
          OrbElemMap& oem = ui->second;
@@ -702,6 +705,7 @@ namespace gpstk
 //-----------------------------------------------------------------------------
    void OrbElemStore::rationalize( )
     {
+      checkNotFrozen("rationalize");
       // check to verify that the system type is SatID::systemGPS
       bool sat_sys_gps = OrbElemStore::isSatSysPresent(SatID::systemGPS);
 
@@ -138,9 +138,10 @@ namespace gpstk
       /// Edit the dataset, removing data outside the indicated time interval
       /// @param[in] tmin defines the beginning of the time interval
       /// @param[in] tmax defines the end of the time interval
+      /// @throw InvalidRequest if the store is frozen
       virtual void edit(const CommonTime& tmin, 
                         const CommonTime& tmax = CommonTime::END_OF_TIME)
-         throw(); 
+         throw(InvalidRequest); 
 
       /// Clear the dataset, meaning remove all data
       virtual void clear(void) throw();
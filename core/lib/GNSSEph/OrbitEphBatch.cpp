@@ -0,0 +1,316 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file OrbitEphBatch.cpp Evaluate many OrbitEph objects, or one
+ * OrbitEph at many times, with the per-ephemeris constants computed
+ * once. */
+
+#include "OrbitEphBatch.hpp"
+#include "MathBase.hpp"
+#include "GNSSconstants.hpp"
+#include "GPSWeekSecond.hpp"
+#include "GPSEllipsoid.hpp"
+#include "StringUtils.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+   const size_t OrbitEphBatch::blockSize;
+
+   size_t OrbitEphBatch::add(const OrbitEph& eph)
+   {
+      if(!eph.dataLoaded())
+         GPSTK_THROW(InvalidRequest("Data not loaded"));
+      if(eph.satID.system == SatID::systemBeiDou && eph.satID.id <= 5)
+         GPSTK_THROW(InvalidRequest("BeiDou GEO satellites are not supported"));
+
+      GPSEllipsoid ell;
+      double sqrtgm = SQRT(ell.gm());
+      double Ah = SQRT(eph.A);
+
+      satID.push_back(eph.satID);
+      ctToe.push_back(eph.ctToe);
+      ctToc.push_back(eph.ctToc);
+      af0.push_back(eph.af0);
+      af1.push_back(eph.af1);
+      af2.push_back(eph.af2);
+      M0.push_back(eph.M0);
+      dn.push_back(eph.dn);
+      ecc.push_back(eph.ecc);
+      A.push_back(eph.A);
+      OMEGA0.push_back(eph.OMEGA0);
+      i0.push_back(eph.i0);
+      w.push_back(eph.w);
+      idot.push_back(eph.idot);
+      dndot.push_back(eph.dndot);
+      Adot.push_back(eph.Adot);
+      Cuc.push_back(eph.Cuc);
+      Cus.push_back(eph.Cus);
+      Crc.push_back(eph.Crc);
+      Crs.push_back(eph.Crs);
+      Cic.push_back(eph.Cic);
+      Cis.push_back(eph.Cis);
+      amm0.push_back(sqrtgm / (eph.A*Ah));
+      Ahalf.push_back(Ah);
+      q.push_back(SQRT(1.0e0 - eph.ecc*eph.ecc));
+      domk.push_back(eph.OMEGAdot - ell.angVelocity());
+         // SOW is time-system-independent
+      weToe.push_back(ell.angVelocity() * GPSWeekSecond(eph.ctToe).sow);
+      if(eph.dndot != 0.0)
+         anyDndot = true;
+
+      return satID.size() - 1;
+   }
+
+   void OrbitEphBatch::clear(void)
+   {
+      satID.clear();
+      ctToe.clear(); ctToc.clear();
+      af0.clear(); af1.clear(); af2.clear();
+      M0.clear(); dn.clear(); ecc.clear(); A.clear(); OMEGA0.clear();
+      i0.clear(); w.clear(); idot.clear();
+      dndot.clear(); Adot.clear();
+      Cuc.clear(); Cus.clear(); Crc.clear(); Crs.clear(); Cic.clear();
+      Cis.clear();
+      amm0.clear(); Ahalf.clear(); q.clear(); domk.clear(); weToe.clear();
+      anyDndot = false;
+   }
+
+   void OrbitEphBatch::svXvt(size_t index, const vector<CommonTime>& times,
+                             vector<Xvt>& xvt) const
+   {
+      if(index >= size())
+         GPSTK_THROW(InvalidRequest("Ephemeris index " +
+                                    StringUtils::asString(index) +
+                                    " is out of range"));
+      xvt.resize(times.size());
+      size_t eph[blockSize];
+      double elapte[blockSize], elaptc[blockSize];
+      for(size_t i = 0; i < blockSize; i++)
+         eph[i] = index;
+      for(size_t start = 0; start < times.size(); start += blockSize)
+      {
+         size_t n = std::min<size_t>(blockSize, times.size() - start);
+         for(size_t i = 0; i < n; i++)
+         {
+            elapte[i] = times[start+i] - ctToe[index];
+            elaptc[i] = times[start+i] - ctToc[index];
+         }
+         evaluate(n, eph, elapte, elaptc, &xvt[start]);
+      }
+   }
+
+   void OrbitEphBatch::svXvt(const CommonTime& t, vector<Xvt>& xvt) const
+   {
+      xvt.resize(size());
+      size_t eph[blockSize];
+      double elapte[blockSize], elaptc[blockSize];
+      for(size_t start = 0; start < size(); start += blockSize)
+      {
+         size_t n = std::min<size_t>(blockSize, size() - start);
+         for(size_t i = 0; i < n; i++)
+         {
+            eph[i] = start + i;
+            elapte[i] = t - ctToe[start+i];
+            elaptc[i] = t - ctToc[start+i];
+         }
+         evaluate(n, eph, elapte, elaptc, &xvt[start]);
+      }
+   }
+
+   void OrbitEphBatch::solveKepler(size_t n, const double *meana,
+                                   const double *e, double *ea)
+   {
+      bool active[blockSize];
+      for(size_t i = 0; i < n; i++)
+      {
+         ea[i] = meana[i] + e[i] * ::sin(meana[i]);
+         active[i] = true;
+      }
+
+         // Every lane takes the same steps as the do-while loop of
+         // OrbitEph::svXvt(); lanes that have converged keep their
+         // value while the others continue.
+      for(int loop_cnt = 2; ; loop_cnt++)
+      {
+         bool any = false;
+         for(size_t i = 0; i < n; i++)
+         {
+            double F = meana[i] - (ea[i] - e[i] * ::sin(ea[i]));
+            double G = 1.0 - e[i] * ::cos(ea[i]);
+            double delea = F/G;
+            ea[i] = active[i] ? ea[i] + delea : ea[i];
+            active[i] = active[i] && (fabs(delea) > 1.0e-11) &&
+               (loop_cnt <= 20);
+            any = any || active[i];
+         }
+         if(!any)
+            break;
+      }
+   }
+
+   void OrbitEphBatch::evaluate(size_t n, const size_t *eph,
+                                const double *elapte, const double *elaptc,
+                                Xvt *out) const
+   {
+      GPSEllipsoid ell;
+      const double sqrtgm = SQRT(ell.gm());
+      const double twoPI = 2.0e0 * PI;
+
+         // Gather the elements of each lane.  For a single ephemeris
+         // at many times these are all the same.
+      double lM0[blockSize], ldn[blockSize], lecc[blockSize], lA[blockSize];
+      double lOMEGA0[blockSize], li0[blockSize], lw[blockSize];
+      double lidot[blockSize], ldndot[blockSize], lAdot[blockSize];
+      double lCuc[blockSize], lCus[blockSize], lCrc[blockSize];
+      double lCrs[blockSize], lCic[blockSize], lCis[blockSize];
+      double lamm0[blockSize], lAhalf[blockSize], lq[blockSize];
+      double ldomk[blockSize], lweToe[blockSize];
+      double laf0[blockSize], laf1[blockSize], laf2[blockSize];
+      for(size_t i = 0; i < n; i++)
+      {
+         size_t k = eph[i];
+         lM0[i] = M0[k]; ldn[i] = dn[k]; lecc[i] = ecc[k]; lA[i] = A[k];
+         lOMEGA0[i] = OMEGA0[k]; li0[i] = i0[k]; lw[i] = w[k];
+         lidot[i] = idot[k]; ldndot[i] = dndot[k]; lAdot[i] = Adot[k];
+         lCuc[i] = Cuc[k]; lCus[i] = Cus[k]; lCrc[i] = Crc[k];
+         lCrs[i] = Crs[k]; lCic[i] = Cic[k]; lCis[i] = Cis[k];
+         lamm0[i] = amm0[k]; lAhalf[i] = Ahalf[k]; lq[i] = q[k];
+         ldomk[i] = domk[k]; lweToe[i] = weToe[k];
+         laf0[i] = af0[k]; laf1[i] = af1[k]; laf2[i] = af2[k];
+      }
+
+         // Mean motion and mean anomaly (LNAV: Adot==0, dndot==0)
+      double Ak[blockSize], amm[blockSize], meana[blockSize], ea[blockSize];
+      for(size_t i = 0; i < n; i++)
+      {
+         Ak[i] = lA[i] + lAdot[i] * elapte[i];
+         double dnA = ldn[i] + 0.5*ldndot[i]*elapte[i];
+         amm[i] = lamm0[i] + dnA;
+         meana[i] = fmod(lM0[i] + elapte[i] * amm[i], twoPI);
+      }
+      solveKepler(n, meana, lecc, ea);
+
+         // The relativity correction of OrbitEph::svRelativity()
+         // solves Kepler's equation without the dndot term; that only
+         // gives a different answer if dndot is not zero.
+      double sinRel[blockSize];
+      if(anyDndot)
+      {
+         double meanaRel[blockSize], eaRel[blockSize];
+         for(size_t i = 0; i < n; i++)
+            meanaRel[i] = fmod(lM0[i] + elapte[i] * (lamm0[i] + ldn[i]),
+                               twoPI);
+         solveKepler(n, meanaRel, lecc, eaRel);
+         for(size_t i = 0; i < n; i++)
+            sinRel[i] = ::sin(eaRel[i]);
+      }
+      else
+      {
+         for(size_t i = 0; i < n; i++)
+            sinRel[i] = ::sin(ea[i]);
+      }
+
+         // Clock corrections
+      for(size_t i = 0; i < n; i++)
+      {
+         out[i].relcorr = REL_CONST * lecc[i] * SQRT(Ak[i]) * sinRel[i];
+         out[i].clkbias = laf0[i] + elaptc[i] * (laf1[i] + elaptc[i] * laf2[i]);
+         out[i].clkdrift = laf1[i] + elaptc[i] * laf2[i];
+         out[i].frame = ReferenceFrame::WGS84;
+      }
+
+         // True anomaly, argument of latitude and the second
+         // harmonic corrections
+      double sinea[blockSize], G[blockSize], c2al[blockSize], s2al[blockSize];
+      double U[blockSize], R[blockSize], AINC[blockSize], ANLON[blockSize];
+      for(size_t i = 0; i < n; i++)
+      {
+         sinea[i] = ::sin(ea[i]);
+         double cosea = ::cos(ea[i]);
+         G[i] = 1.0e0 - lecc[i] * cosea;
+         double GSTA = lq[i] * sinea[i];
+         double GCTA = cosea - lecc[i];
+         double truea = atan2(GSTA, GCTA);
+         double alat = truea + lw[i];
+         double talat = 2.0e0 * alat;
+         c2al[i] = ::cos(talat);
+         s2al[i] = ::sin(talat);
+         U[i] = alat + (c2al[i] * lCuc[i] + s2al[i] * lCus[i]);
+         R[i] = Ak[i]*G[i] + (c2al[i] * lCrc[i] + s2al[i] * lCrs[i]);
+         AINC[i] = li0[i] + lidot[i] * elapte[i] +
+            (c2al[i] * lCic[i] + s2al[i] * lCis[i]);
+         ANLON[i] = lOMEGA0[i] + ldomk[i] * elapte[i] - lweToe[i];
+      }
+
+         // Earth fixed position and velocity
+      for(size_t i = 0; i < n; i++)
+      {
+         double cosu = ::cos(U[i]);
+         double sinu = ::sin(U[i]);
+         double xip = R[i] * cosu;
+         double yip = R[i] * sinu;
+         double can = ::cos(ANLON[i]);
+         double san = ::sin(ANLON[i]);
+         double cinc = ::cos(AINC[i]);
+         double sinc = ::sin(AINC[i]);
+
+         out[i].x[0] = xip*can - yip*cinc*san;
+         out[i].x[1] = xip*san + yip*cinc*can;
+         out[i].x[2] = yip*sinc;
+
+         double dek = amm[i] * Ak[i] / R[i];
+         double dlk = lAhalf[i] * lq[i] * sqrtgm / (R[i]*R[i]);
+         double div = lidot[i] - 2.0e0 * dlk *
+            (lCic[i] * s2al[i] - lCis[i] * c2al[i]);
+         double domk = ldomk[i];
+         double duv = dlk*(1.e0+ 2.e0 * (lCus[i]*c2al[i] - lCuc[i]*s2al[i]));
+         double drv = Ak[i] * lecc[i] * dek * sinea[i] - 2.e0 * dlk *
+            (lCrc[i] * s2al[i] - lCrs[i] * c2al[i]);
+         double dxp = drv*cosu - R[i]*sinu*duv;
+         double dyp = drv*sinu + R[i]*cosu*duv;
+
+         out[i].v[0] = dxp*can - xip*san*domk - dyp*cinc*san
+            + yip*(sinc*san*div - cinc*can*domk);
+         out[i].v[1] = dxp*san + xip*can*domk + dyp*cinc*can
+            - yip*(sinc*can*div + cinc*san*domk);
+         out[i].v[2] = dyp*sinc + yip*cinc*div;
+      }
+   }
+
+} // namespace gpstk
@@ -0,0 +1,171 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file OrbitEphBatch.hpp Evaluate many OrbitEph objects, or one
+ * OrbitEph at many times, with the per-ephemeris constants computed
+ * once. */
+
+#ifndef GPSTK_ORBITEPHBATCH_HPP
+#define GPSTK_ORBITEPHBATCH_HPP
+
+#include <vector>
+#include "Exception.hpp"
+#include "CommonTime.hpp"
+#include "SatID.hpp"
+#include "Xvt.hpp"
+#include "OrbitEph.hpp"
+
+namespace gpstk
+{
+      /// @ingroup GNSSEph
+      //@{
+
+      /** OrbitEphBatch holds a set of broadcast ephemerides in
+       * structure-of-arrays form and computes satellite positions,
+       * velocities and clock corrections for them in bulk.
+       *
+       * OrbitEph::svXvt() evaluates a single ephemeris at a single
+       * time and rebuilds everything that depends only on the
+       * ephemeris (the ellipsoid constants, SQRT(A), the mean
+       * motion, the GPS seconds of week of Toe, ...) on every call.
+       * Here those terms are computed once by add(), and the
+       * evaluation runs over blocks of up to #blockSize lanes, one
+       * lane per (ephemeris, time) pair, with every step of the
+       * computation a simple loop over contiguous arrays that the
+       * compiler can vectorize.  The Kepler iteration is done for all
+       * lanes together, each lane stopping with the same criterion as
+       * svXvt().
+       *
+       * The arithmetic is that of OrbitEph::svXvt(), term for term,
+       * so the results are identical to it.  BeiDou GEO satellites,
+       * which BDSEphemeris::svXvt() treats differently, are not
+       * accepted.
+       *
+       * @code
+       * OrbitEphBatch batch;
+       * for (i = ephList.begin(); i != ephList.end(); i++)
+       *    batch.add(**i);
+       * std::vector<Xvt> xvt;
+       * batch.svXvt(t, xvt);    // xvt[k] is ephemeris k at time t
+       * @endcode
+       */
+   class OrbitEphBatch
+   {
+   public:
+         /// Maximum number of lanes evaluated together.
+      static const size_t blockSize = 32;
+
+         /// Default constructor, creates an empty batch.
+      OrbitEphBatch(void) : anyDndot(false) {}
+
+         /** Add an ephemeris to the batch.
+          * @param[in] eph the ephemeris; it is copied.
+          * @return the index of the ephemeris in the batch.
+          * @throw InvalidRequest if eph has no data loaded or is for
+          *   a BeiDou GEO satellite. */
+      size_t add(const OrbitEph& eph);
+
+         /// Number of ephemerides in the batch.
+      size_t size(void) const
+      { return satID.size(); }
+
+         /// Remove all ephemerides.
+      void clear(void);
+
+         /// Satellite of the ephemeris at \a index.
+      const SatID& getSatID(size_t index) const
+      { return satID[index]; }
+
+         /** Evaluate one ephemeris at many times.
+          * @param[in] index the ephemeris index returned by add().
+          * @param[in] times the times of interest.
+          * @param[out] xvt resized to times.size(); xvt[k] is the
+          *   same as OrbitEph::svXvt(times[k]).
+          * @throw InvalidRequest if index is out of range or a time
+          *   is in an incompatible time system. */
+      void svXvt(size_t index, const std::vector<CommonTime>& times,
+                 std::vector<Xvt>& xvt) const;
+
+         /** Evaluate every ephemeris in the batch at one time.
+          * @param[in] t the time of interest.
+          * @param[out] xvt resized to size(); xvt[k] is the position
+          *   from the ephemeris with index k.
+          * @throw InvalidRequest if t is in an incompatible time
+          *   system. */
+      void svXvt(const CommonTime& t, std::vector<Xvt>& xvt) const;
+
+   private:
+         /** Evaluate n lanes, n <= blockSize.  Lane i uses ephemeris
+          * eph[i] at elapte[i] seconds from its Toe and elaptc[i]
+          * seconds from its Toc. */
+      void evaluate(size_t n, const size_t *eph, const double *elapte,
+                    const double *elaptc, Xvt *out) const;
+
+         /** Solve Kepler's equation for n lanes, with the same
+          * initial guess, tolerance and iteration limit as
+          * OrbitEph::svXvt(). */
+      static void solveKepler(size_t n, const double *meana,
+                              const double *ecc, double *ea);
+
+         /// @name Per-ephemeris data, indexed by ephemeris
+         //@{
+      std::vector<SatID> satID;
+      std::vector<CommonTime> ctToe, ctToc;
+      std::vector<double> af0, af1, af2;
+      std::vector<double> M0, dn, ecc, A, OMEGA0, i0, w, idot;
+      std::vector<double> dndot, Adot;
+      std::vector<double> Cuc, Cus, Crc, Crs, Cic, Cis;
+         /// sqrt(GM)/(A*sqrt(A)), the unperturbed mean motion
+      std::vector<double> amm0;
+         /// sqrt(A)
+      std::vector<double> Ahalf;
+         /// sqrt(1-ecc*ecc)
+      std::vector<double> q;
+         /// OMEGAdot minus the earth rotation rate
+      std::vector<double> domk;
+         /// earth rotation rate times seconds of week of Toe
+      std::vector<double> weToe;
+         /// true if any ephemeris has a non-zero dndot
+      bool anyDndot;
+         //@}
+   }; // end class OrbitEphBatch
+
+      //@}
+
+} // namespace gpstk
+
+#endif // GPSTK_ORBITEPHBATCH_HPP
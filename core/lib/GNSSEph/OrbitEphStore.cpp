@@ -45,6 +45,8 @@
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <algorithm>
+#include <atomic>
 
 #include "StringUtils.hpp"
 #include "MathBase.hpp"
@@ -57,6 +59,46 @@
 using namespace std;
 using namespace gpstk::StringUtils;
 
+namespace
+{
+      // Where the last index search of each satellite ended, for the
+      // index with the given ID.  Every thread has its own, so
+      // lookups need no locking.
+   struct IndexCursor
+   {
+      IndexCursor() : indexID(0) {}
+      unsigned long indexID;
+      std::vector<size_t> pos;
+   };
+
+      // The cursors of the last few indexes searched by a thread, so
+      // that alternating between stores (e.g. two receivers, or GPS
+      // and another system) keeps the position in each; beyond
+      // NumIndexCursors stores the oldest is reused.
+   const int NumIndexCursors = 4;
+   struct IndexCursors
+   {
+      IndexCursors() : next(0) {}
+      IndexCursor& find(unsigned long id, size_t nSats)
+      {
+         for(int i=0; i<NumIndexCursors; i++)
+            if(cursor[i].indexID == id)
+               return cursor[i];
+         IndexCursor& c(cursor[next]);
+         next = (next+1) % NumIndexCursors;
+         c.indexID = id;
+         c.pos.assign(nSats, 0);
+         return c;
+      }
+      IndexCursor cursor[NumIndexCursors];
+      int next;
+   };
+   thread_local IndexCursors indexCursors;
+
+      // IDs of OrbitEphStore indexes, unique over all stores
+   std::atomic<unsigned long> nextIndexID(1);
+}
+
 namespace gpstk
 {
    //---------------------------------------------------------------------------------
@@ -192,7 +234,9 @@ namespace gpstk
    // If keys are repeated, keep the one with the earliest transmit time.
    OrbitEph* OrbitEphStore::addEphemeris(const OrbitEph* eph)
    {
+      checkNotFrozen("addEphemeris");
       OrbitEph *ret(0);
+      clearIndex();
       try {
          // is the satellite found in the table? If not, create one
          if(satTables.find(eph->satID) == satTables.end()) {
@@ -292,6 +336,8 @@ namespace gpstk
    //---------------------------------------------------------------------------------
    void OrbitEphStore::edit(const CommonTime& tmin, const CommonTime& tmax)
    {
+      checkNotFrozen("edit");
+      clearIndex();
       for(SatTableMap::iterator i = satTables.begin(); i != satTables.end(); i++)
       {
          TimeOrbitEphTable& eMap = i->second;
@@ -320,6 +366,8 @@ namespace gpstk
    //---------------------------------------------------------------------------------
    void OrbitEphStore::clear(void)
    {
+      frozen = false;
+      clearIndex();
       for(SatTableMap::iterator ui=satTables.begin(); ui!=satTables.end(); ui++) {
          TimeOrbitEphTable& toet = ui->second;
          for(TimeOrbitEphTable::iterator toeti = toet.begin(); toeti != toet.end(); toeti++) {
@@ -374,6 +422,23 @@ namespace gpstk
    const OrbitEph* OrbitEphStore::findUserOrbitEph(const SatID& sat,
                                                    const CommonTime& t) const
    {
+      if(isIndexed()) {
+         // Same logic as below, on the flat index
+         int slot = findSatSlot(sat);
+         if(slot < 0)
+            return NULL;
+         const SatIndex& si = satIndex[slot];
+         size_t n = si.key.size();
+         size_t i = indexLowerBound(slot, t);
+         if(i == n)
+            return (si.eph[n-1]->isValid(t) ? si.eph[n-1] : NULL);
+         if(si.eph[i]->isValid(t))
+            return si.eph[i];
+         if(i > 0 && si.eph[i-1]->isValid(t))
+            return si.eph[i-1];
+         return NULL;
+      }
+
       // Is this satellite found in the table?
       if(satTables.find(sat) == satTables.end())
          return NULL;
@@ -459,6 +524,27 @@ namespace gpstk
    const OrbitEph* OrbitEphStore::findNearOrbitEph(const SatID& sat,
                                                    const CommonTime& t) const
    {
+      if(isIndexed()) {
+         // Same logic as below, on the flat index
+         int slot = findSatSlot(sat);
+         if(slot < 0)
+            return NULL;
+         const SatIndex& si = satIndex[slot];
+         size_t n = si.key.size();
+         size_t i = indexLowerBound(slot, t);
+         if(i == 0)
+            return si.eph[0];
+         if(i == n)
+            return si.eph[n-1];
+         if(!(t < si.key[i]))                 // exact match
+            return si.eph[i];
+         double diffToNext = si.eph[i]->ctToe - t;
+         double diffFromLast = t - si.eph[i-1]->ctToe;
+         if(diffToNext > diffFromLast)
+            return si.eph[i-1];
+         return si.eph[i];
+      }
+
 
         // Check for any OrbitEph for this SV
       if(satTables.find(sat) == satTables.end())
@@ -504,6 +590,66 @@ namespace gpstk
       return itNext->second;
    }
 
+   //---------------------------------------------------------------------------------
+   void OrbitEphStore::buildIndex(void)
+   {
+      checkNotFrozen("buildIndex");
+      clearIndex();
+      SatTableMap::const_iterator it;
+      for(it = satTables.begin(); it != satTables.end(); it++) {
+         const TimeOrbitEphTable& table = it->second;
+         if(table.empty() || it->first.id < 0)
+            continue;
+
+         SatIndex si;
+         si.key.reserve(table.size());
+         si.eph.reserve(table.size());
+         TimeOrbitEphTable::const_iterator ei;
+         for(ei = table.begin(); ei != table.end(); ei++) {
+            si.key.push_back(ei->first);
+            si.eph.push_back(ei->second);
+         }
+
+         const SatID& sat(it->first);
+         if((int)satSlot.size() <= sat.system)
+            satSlot.resize(sat.system+1);
+         if((int)satSlot[sat.system].size() <= sat.id)
+            satSlot[sat.system].resize(sat.id+1, -1);
+         satSlot[sat.system][sat.id] = satIndex.size();
+         satIndex.push_back(si);
+      }
+      indexID = nextIndexID++;
+   }
+
+   //---------------------------------------------------------------------------------
+   size_t OrbitEphStore::indexLowerBound(int slot, const CommonTime& t) const
+   {
+      const vector<CommonTime>& key = satIndex[slot].key;
+      size_t n = key.size();
+
+      size_t& pos = indexCursors.find(indexID, satIndex.size()).pos[slot];
+
+      // Search backward from the cursor if t is before it, otherwise
+      // step forward a few entries before falling back to a binary
+      // search of the rest.
+      size_t i = pos;
+      if(i > 0 && !(key[i-1] < t)) {
+         i = lower_bound(key.begin(), key.begin()+i, t) - key.begin();
+      }
+      else {
+         size_t steps = 0;
+         while(i < n && key[i] < t) {
+            i++;
+            if(++steps == 4) {
+               i = lower_bound(key.begin()+i, key.end(), t) - key.begin();
+               break;
+            }
+         }
+      }
+      pos = i;
+      return i;
+   }
+
    //---------------------------------------------------------------------------------
    // Add all ephemerides to an existing list<OrbitEph>.
    // If SatID sat is given, limit selections to sat's satellite system, plus if
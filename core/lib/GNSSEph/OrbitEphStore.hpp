@@ -48,6 +48,7 @@
 
 #include <iostream>
 #include <list>
+#include <vector>
 
 #include "OrbitEph.hpp"
 #include "Exception.hpp"
@@ -77,7 +78,7 @@ namespace gpstk
       OrbitEphStore()
             : initialTime(CommonTime::END_OF_TIME),
               finalTime(CommonTime::BEGINNING_OF_TIME),
-              strictMethod(true)
+              strictMethod(true), indexID(0)
       {
          timeSystem = TimeSystem::Any;
          initialTime.setTimeSystem(timeSystem);
@@ -298,13 +299,50 @@ namespace gpstk
                             SatID sat=SatID(-1,SatID::systemUnknown)) const;
 
          /// use findNearOrbitEph() in getXvt() and getSatHealth()
+         /// @throw InvalidRequest if the store is frozen
       void SearchNear(void)
-      { strictMethod = false; }
+      {
+         checkNotFrozen("SearchNear");
+         strictMethod = false;
+      }
 
          /** use findUserOrbitEph() in getXvt() and getSatHealth()
-          * (the default) */
+          * (the default)
+          * @throw InvalidRequest if the store is frozen */
       void SearchUser(void)
-      { strictMethod = true; }
+      {
+         checkNotFrozen("SearchUser");
+         strictMethod = true;
+      }
+
+         /** Build a flat lookup index of the ephemerides now in the
+          * store.  Call this once all the data are loaded.  Until the
+          * store is changed again (addEphemeris(), edit(), clear(),
+          * ...), findUserOrbitEph() and findNearOrbitEph() then find
+          * the satellite with a table lookup and the ephemeris by
+          * searching sorted arrays of validity start times, starting
+          * from where the previous search in the same thread for that
+          * satellite and store ended.  Searches at increasing times are
+          * thus O(1) on average, also when a thread alternates between
+          * up to four indexed stores; with more, the positions of the
+          * least recent are dropped and those searches are binary.
+          * The results are the same as without the index.
+          * @throw InvalidRequest if the store is frozen */
+      void buildIndex(void);
+
+         /** Build the lookup index and make the store read-only, see
+          * XvtStore::freeze(). */
+      virtual void freeze(void)
+      {
+         if(!isFrozen())
+            buildIndex();
+         XvtStore<SatID>::freeze();
+      }
+
+         /// Return true if buildIndex() was called and the store
+         /// hasn't been changed since.
+      bool isIndexed(void) const
+      { return indexID != 0; }
 
          /** Return the satellite health at the given time.
           * @param SatID sat satellite of interest
@@ -357,6 +395,47 @@ namespace gpstk
           *  getSatXvt and getSatHealth */
       bool strictMethod;
 
+         /** The ephemerides of one satellite in the index, in the
+          * order of the TimeOrbitEphTable. */
+      struct SatIndex
+      {
+         std::vector<CommonTime> key;       ///< beginning of validity
+         std::vector<const OrbitEph*> eph;  ///< the ephemerides
+      };
+
+         /// Index of each satellite in the store, see buildIndex().
+      std::vector<SatIndex> satIndex;
+
+         /// Position in satIndex, indexed [system][id], -1 if none.
+      std::vector<std::vector<int> > satSlot;
+
+         /** Unique identifier of the current index, used to validate
+          * the per-thread search cursors; 0 if there is no index. */
+      unsigned long indexID;
+
+         /// Discard the index; call whenever satTables is changed.
+      void clearIndex(void)
+      {
+         indexID = 0;
+         satIndex.clear();
+         satSlot.clear();
+      }
+
+         /** Find the satellite in the index.
+          * @return position in satIndex or -1 if not found. */
+      int findSatSlot(const SatID& sat) const
+      {
+         if(sat.system < 0 || sat.system >= (int)satSlot.size() ||
+            sat.id < 0 || sat.id >= (int)satSlot[sat.system].size())
+            return -1;
+         return satSlot[sat.system][sat.id];
+      }
+
+         /** Return the position of the first key of satIndex[slot]
+          * not less than t, i.e. what lower_bound(t) would return
+          * from the TimeOrbitEphTable of the satellite. */
+      size_t indexLowerBound(int slot, const CommonTime& t) const;
+
          /// Convenience routines
       void updateTimeLimits(const OrbitEph* eph)
       {
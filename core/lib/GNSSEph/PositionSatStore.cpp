@@ -81,6 +81,18 @@ namespace gpstk
       return os;
    }
 
+   // Return SUM[w[k]*(recs[k]->*member)[i]], one component of a
+   // Lagrange interpolation with precomputed weights.
+   static inline double weightedSum(const vector<double>& w,
+                                    const vector<const PositionRecord*>& recs,
+                                    Triple PositionRecord::*member, int i)
+   {
+      double sum(0.0);
+      for(size_t k=0; k<recs.size(); k++)
+         sum += w[k] * (recs[k]->*member)[i];
+      return sum;
+   }
+
    // Return value for the given satellite at the given time (usually via
    // interpolation of the data table). This interface from TabularSatStore.
    // @param[in] sat the SatID of the satellite of interest
@@ -97,7 +109,7 @@ namespace gpstk
          bool isExact;
          int i;
          PositionRecord rec;
-         DataTableIterator it1, it2, kt;        // cf. TabularSatStore.hpp
+         DataTableIterator it1, it2;        // cf. TabularSatStore.hpp
 
          isExact = getTableInterval(sat, ttag, Nhalf, it1, it2, haveVelocity);
          if(isExact && haveVelocity) {
@@ -106,60 +118,46 @@ namespace gpstk
          }
 
          // pull data out of the data table
-         size_t n,Nlow(Nhalf-1),Nhi(Nhalf),Nmatch(Nhalf);
-         CommonTime ttag0(it1->first);
-         vector<double> times,P[3],V[3],A[3],sigP[3],sigV[3],sigA[3];
-
-         kt = it1; n=0;
-         while(1) {
-            // find index matching ttag
-            if(isExact && ABS(kt->first - ttag) < 1.e-8)
-               Nmatch = n;
-            times.push_back(kt->first - ttag0);          // sec
-            for(i=0; i<3; i++) {
-               P[i].push_back(kt->second.Pos[i]);
-               V[i].push_back(kt->second.Vel[i]);
-               A[i].push_back(kt->second.Acc[i]);
-               sigP[i].push_back(kt->second.sigPos[i]);
-               sigV[i].push_back(kt->second.sigVel[i]);
-               sigA[i].push_back(kt->second.sigAcc[i]);
-            }
-            if(kt == it2) break;
-            ++kt;
-            ++n;
-         };
+         size_t Nlow(Nhalf-1),Nhi(Nhalf),Nmatch;
+         vector<const PositionRecord*> recs;
+         LagrangeWeights lw;
+         Nmatch = interpolationWeights(it1, it2, ttag, recs, lw);
+         if(!isExact || Nmatch == recs.size()) Nmatch = Nhalf;
 
          if(isExact && Nmatch == (int)(Nhalf-1)) { Nlow++; Nhi++; }
 
          // Lagrange interpolation
+         const vector<double>& w(lw.weights());
+         const vector<double>& dw(lw.derivativeWeights());
          rec.sigAcc = rec.Acc = Triple(0,0,0);        // default
-         double dt(ttag-ttag0), err;           // dt in seconds
          if(haveVelocity) {
             for(i=0; i<3; i++) {
                // interpolate the positions
-               rec.Pos[i] = LagrangeInterpolation(times,P[i],dt,err);
+               rec.Pos[i] = weightedSum(w,recs,&PositionRecord::Pos,i);
                if(haveAcceleration) {
                   // interpolate velocities and acclerations
-                  rec.Vel[i] = LagrangeInterpolation(times,V[i],dt,err);
-                  rec.Acc[i] = LagrangeInterpolation(times,A[i],dt,err);
+                  rec.Vel[i] = weightedSum(w,recs,&PositionRecord::Vel,i);
+                  rec.Acc[i] = weightedSum(w,recs,&PositionRecord::Acc,i);
                }
                else {
                   // interpolate velocities(dm/s) to get V and A
-                  LagrangeInterpolation(times,V[i],dt,rec.Vel[i],rec.Acc[i]);
+                  rec.Vel[i] = weightedSum(w,recs,&PositionRecord::Vel,i);
+                  rec.Acc[i] = weightedSum(dw,recs,&PositionRecord::Vel,i);
                   rec.Acc[i] *= 0.1;      // dm/s/s -> m/s/s
                }
 
                if(isExact) {
-                  rec.sigPos[i] = sigP[i][Nmatch];
-                  rec.sigVel[i] = sigV[i][Nmatch];
-                  if(haveAcceleration) rec.sigAcc[i] = sigA[i][Nmatch];
+                  rec.sigPos[i] = recs[Nmatch]->sigPos[i];
+                  rec.sigVel[i] = recs[Nmatch]->sigVel[i];
+                  if(haveAcceleration) rec.sigAcc[i] = recs[Nmatch]->sigAcc[i];
                }
                else {
                   // TD is this sigma related to 'err' in the Lagrange call?
-                  rec.sigPos[i] = RSS(sigP[i][Nhi],sigP[i][Nlow]);
-                  rec.sigVel[i] = RSS(sigV[i][Nhi],sigV[i][Nlow]);
+                  rec.sigPos[i] = RSS(recs[Nhi]->sigPos[i],recs[Nlow]->sigPos[i]);
+                  rec.sigVel[i] = RSS(recs[Nhi]->sigVel[i],recs[Nlow]->sigVel[i]);
                   if(haveAcceleration)
-                     rec.sigAcc[i] = RSS(sigA[i][Nhi],sigA[i][Nlow]);
+                     rec.sigAcc[i] = RSS(recs[Nhi]->sigAcc[i],
+                                         recs[Nlow]->sigAcc[i]);
                }
                // else Acc=sig_Acc=0   // TD can we do better?
             }
@@ -167,14 +165,15 @@ namespace gpstk
          else {               // no V data - must interpolate position to get velocity
             for(i=0; i<3; i++) {
                // interpolate positions(km) to get P and V
-               LagrangeInterpolation(times,P[i],dt,rec.Pos[i],rec.Vel[i]);
+               rec.Pos[i] = weightedSum(w,recs,&PositionRecord::Pos,i);
+               rec.Vel[i] = weightedSum(dw,recs,&PositionRecord::Pos,i);
                rec.Vel[i] *= 10000.;         // km/sec -> dm/sec
 
                if(isExact) {
-                  rec.sigPos[i] = sigP[i][Nmatch];
+                  rec.sigPos[i] = recs[Nmatch]->sigPos[i];
                }
                else {
-                  rec.sigPos[i] = RSS(sigP[i][Nhi],sigP[i][Nlow]);
+                  rec.sigPos[i] = RSS(recs[Nhi]->sigPos[i],recs[Nlow]->sigPos[i]);
                }
                // TD
                rec.sigVel[i] = 0.0;
@@ -198,7 +197,7 @@ namespace gpstk
    {
       try {
          int i;
-         DataTableIterator it1, it2, kt;
+         DataTableIterator it1, it2;
 
          if(getTableInterval(sat, ttag, Nhalf, it1, it2, true)) {
             // exact match
@@ -208,22 +207,14 @@ namespace gpstk
          }
 
          // pull data out of the data table
-         vector<double> times,P[3];
-         CommonTime ttag0(it1->first);
-         kt = it1;
-         while(1) {
-            times.push_back(kt->first - ttag0);    // sec
-            for(i=0; i<3; i++)
-               P[i].push_back(kt->second.Pos[i]);
-            if(kt == it2) break;
-            ++kt;
-         };
+         vector<const PositionRecord*> recs;
+         LagrangeWeights lw;
+         interpolationWeights(it1, it2, ttag, recs, lw);
 
          // interpolate
          Triple pos;
-         double dt(ttag-ttag0), err;
          for(i=0; i<3; i++)
-            pos[i] = LagrangeInterpolation(times,P[i],dt,err);
+            pos[i] = weightedSum(lw.weights(),recs,&PositionRecord::Pos,i);
 
          return pos;
       }
@@ -243,7 +234,7 @@ namespace gpstk
    {
       try {
          int i;
-         DataTableIterator it1, it2, kt;
+         DataTableIterator it1, it2;
 
          bool isExact(getTableInterval(sat, ttag, Nhalf, it1, it2, haveVelocity));
          if(isExact && haveVelocity) {
@@ -253,27 +244,19 @@ namespace gpstk
          }
 
          // pull data out of the data table
-         CommonTime ttag0(it1->first);
-         vector<double> times,D[3];       // D will be either Pos or Vel
-
-         kt = it1;
-         while(1) {
-            times.push_back(kt->first - ttag0);    // sec
-            for(i=0; i<3; i++)
-               D[i].push_back(haveVelocity ? kt->second.Vel[i] : kt->second.Pos[i]);
-            if(kt == it2) break;
-            ++kt;
-         };
+         vector<const PositionRecord*> recs;
+         LagrangeWeights lw;
+         interpolationWeights(it1, it2, ttag, recs, lw);
 
          // interpolate
          Triple Vel;
-         double dt(ttag-ttag0), err;
          for(i=0; i<3; i++) {
             if(haveVelocity)
-               Vel[i] = LagrangeInterpolation(times,D[i],dt,err);
+               Vel[i] = weightedSum(lw.weights(),recs,&PositionRecord::Vel,i);
             else {
-               // interpolate positions(km) to get velocity // err is dummy
-               LagrangeInterpolation(times,D[i],dt,err,Vel[i]);
+               // interpolate positions(km) to get velocity
+               Vel[i] = weightedSum(lw.derivativeWeights(),recs,
+                                    &PositionRecord::Pos,i);
                Vel[i] *= 10000.;                                  // km/s -> dm/s
             }
          }
@@ -302,7 +285,7 @@ namespace gpstk
 
       try {
          int i;
-         DataTableIterator it1, it2, kt;
+         DataTableIterator it1, it2;
 
          bool isExact(getTableInterval(sat,ttag,Nhalf,it1,it2,haveAcceleration));
          if(isExact && haveAcceleration) {
@@ -313,26 +296,19 @@ namespace gpstk
          }
 
          // pull data out of the data table
-         vector<double> times,D[3];                // D will be either Vel or Acc
-         CommonTime ttag0(it1->first);
-         kt = it1;
-         while(1) {
-            times.push_back(kt->first - ttag0);    // sec
-            for(i=0; i<3; i++)
-               D[i].push_back(haveAcceleration ? kt->second.Acc[i]:kt->second.Vel[i]);
-            if(kt == it2) break;
-            ++kt;
-         };
+         vector<const PositionRecord*> recs;
+         LagrangeWeights lw;
+         interpolationWeights(it1, it2, ttag, recs, lw);
 
          // interpolate
          Triple Acc;
-         double dt(ttag-ttag0), err;
          for(i=0; i<3; i++) {
             if(haveAcceleration) {
-               Acc[i] = LagrangeInterpolation(times,D[i],dt,err);
+               Acc[i] = weightedSum(lw.weights(),recs,&PositionRecord::Acc,i);
             }
             else {
-               LagrangeInterpolation(times,D[i],dt,err,Acc[i]);   // err is dummy
+               Acc[i] = weightedSum(lw.derivativeWeights(),recs,
+                                    &PositionRecord::Vel,i);
                Acc[i] *= 0.1;                                     // dm/s/s -> m/s/s
             }
          }
@@ -342,6 +318,37 @@ namespace gpstk
       catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
    }
 
+   // Collect the records it1 through it2 and compute the Lagrange
+   // weights at ttag; return the index of the record at ttag, if any.
+   size_t PositionSatStore::interpolationWeights(DataTableIterator it1,
+                                      const DataTableIterator& it2,
+                                      const CommonTime& ttag,
+                                      vector<const PositionRecord*>& recs,
+                                      LagrangeWeights& lw) const
+   {
+      CommonTime ttag0(it1->first);
+      vector<double> times;
+      size_t n(0), Nmatch;
+      while(1) {
+         times.push_back(it1->first - ttag0);       // sec
+         recs.push_back(&it1->second);
+         if(it1 == it2) break;
+         ++it1;
+      }
+
+      Nmatch = recs.size();
+      double dt(ttag-ttag0), step;          // dt in seconds
+      for(n=0; n<times.size(); n++)
+         if(ABS(times[n] - dt) < 1.e-8) { Nmatch = n; break; }
+
+      if(LagrangeWeights::isRegular(times, step))
+         lw.computeRegular(times.size(), step, dt);
+      else
+         lw.compute(times, dt, true);
+
+      return Nmatch;
+   }
+
    // Add a PositionRecord to the store.
    void PositionSatStore::addPositionRecord(const SatID& sat, const CommonTime& ttag,
                                             const PositionRecord& rec)
@@ -44,6 +44,7 @@
 
 #include <map>
 #include <iostream>
+#include <vector>
 
 #include "TabularSatStore.hpp"
 #include "Exception.hpp"
@@ -51,6 +52,7 @@
 #include "CommonTime.hpp"
 #include "Triple.hpp"
 #include "SP3Data.hpp"
+#include "LagrangeWeights.hpp"
 
 namespace gpstk
 {
@@ -257,6 +259,24 @@ namespace gpstk
       void rejectBadPositions(const bool flag)
       { rejectBadPosFlag=flag; }
 
+   protected:
+
+         /** Collect the records it1 through it2 and compute the
+          * Lagrange weights at ttag, once for all components.  When
+          * the records are evenly spaced, as in SP3 files, the weights
+          * come from the LagrangeWeights cache.
+          * @param[in] it1,it2 the first and last records to use.
+          * @param[in] ttag the time of interest.
+          * @param[out] recs pointers to the records.
+          * @param[out] lw the weights, including derivative weights.
+          * @return the index in recs of the record at ttag, or
+          *   recs.size() if there is none. */
+      size_t interpolationWeights(DataTableIterator it1,
+                                  const DataTableIterator& it2,
+                                  const CommonTime& ttag,
+                                  std::vector<const PositionRecord*>& recs,
+                                  LagrangeWeights& lw) const;
+
    }; // end class PositionSatStore
 
       //@}
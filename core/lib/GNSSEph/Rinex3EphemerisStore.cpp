@@ -56,6 +56,7 @@ namespace gpstk
    // @return true if data was added, false otherwise
    bool Rinex3EphemerisStore::addEphemeris(const Rinex3NavData& inRdata)
    {
+      checkNotFrozen("addEphemeris");
       Rinex3NavData Rdata(inRdata);
 
       switch(Rdata.sat.system) {
@@ -113,6 +114,7 @@ namespace gpstk
    //       >=0 number of nav records read
    int Rinex3EphemerisStore::loadFile(const string& filename, bool dump, ostream& s)
    {
+      checkNotFrozen("loadFile");
       try {
          int nread(0);
          Rinex3NavStream strm;
@@ -146,6 +146,7 @@ namespace gpstk
       virtual void edit(const CommonTime& tmin, 
                         const CommonTime& tmax = CommonTime::END_OF_TIME)
       {
+         checkNotFrozen("edit");
          if(ORBstore.size()) ORBstore.edit(tmin, tmax);
          if(GLOstore.size()) GLOstore.edit(tmin, tmax);
             //if(GEOstore.size()) GEOstore.edit(tmin, tmax);
@@ -154,12 +155,30 @@ namespace gpstk
          /// Clear the dataset, meaning remove all data
       virtual void clear(void)
       {
+         frozen = false;
          NavFiles.clear();
          ORBstore.clear();
          GLOstore.clear();
             //GEOstore.clear();
       }
 
+         /// Freeze this store and the system stores, see
+         /// XvtStore::freeze().
+      virtual void freeze(void)
+      {
+         ORBstore.freeze();
+         GLOstore.freeze();
+         XvtStore<SatID>::freeze();
+      }
+
+         /// End the read-only mode of this store and the system stores.
+      virtual void thaw(void)
+      {
+         ORBstore.thaw();
+         GLOstore.thaw();
+         XvtStore<SatID>::thaw();
+      }
+
          /** Return time system of this store. 
           * @note This is needed only to satisfy the XvtStore virtual
           * interface; the system stores (GPSstore, GLOstore, etc)
@@ -228,7 +247,10 @@ namespace gpstk
           * @param string filename file name to be added
           * @param Rinex3NavHeader head header to be added */
       void addFile(const std::string& filename, Rinex3NavHeader& head)
-      { NavFiles.addFile(filename,head); }
+      {
+         checkNotFrozen("addFile");
+         NavFiles.addFile(filename,head);
+      }
 
          /** load a RINEX navigation file
           * @param string filename name of the RINEX navigation file to read
@@ -287,6 +309,7 @@ namespace gpstk
           * @return true if an existing correction was overwritten. */
       bool addTimeCorr(const TimeSystemCorrection& tsc)
       {
+         checkNotFrozen("addTimeCorr");
             // true if this type already exists
          bool overwrite(mapTimeCorr.find(tsc.asString4()) != mapTimeCorr.end());
 
@@ -302,6 +325,7 @@ namespace gpstk
           * @return true if an existing correction was deleted. */
       bool delTimeCorr(const std::string& typestr)
       {
+         checkNotFrozen("delTimeCorr");
          std::map<std::string, TimeSystemCorrection>::iterator it;
          it = mapTimeCorr.find(typestr);
          if(it != mapTimeCorr.end()) {
@@ -320,6 +344,7 @@ namespace gpstk
           * @return the number of new TimeSystemCorrection's */
       int expandTimeCorrMap(void)
       {
+         checkNotFrozen("expandTimeCorrMap");
          int n(0);
          std::map<std::string, TimeSystemCorrection>::iterator it,jt;
 
@@ -549,6 +549,7 @@ namespace gpstk
       // or drift 'have' flags.
    void SP3EphemerisStore::loadFile(const string& filename) throw(Exception)
    {
+      checkNotFrozen("loadFile");
       try
       {
             // if using only SP3, simply read the SP3
@@ -597,6 +598,7 @@ namespace gpstk
    void SP3EphemerisStore::loadSP3File(const std::string& filename)
       throw(Exception)
    {
+      checkNotFrozen("loadSP3File");
       try
       {
          loadSP3Store(filename, useSP3clock);
@@ -611,6 +613,7 @@ namespace gpstk
    void SP3EphemerisStore::loadRinexClockFile(const std::string& filename)
       throw(Exception)
    {
+      checkNotFrozen("loadRinexClockFile");
       try
       {
          if(useSP3clock) useRinexClockData();
@@ -194,17 +194,20 @@ namespace gpstk
          /** Edit the dataset, removing data outside the indicated
           * time interval
           * @param[in] tmin defines the beginning of the time interval
-          * @param[in] tmax defines the end of the time interval */
+          * @param[in] tmax defines the end of the time interval
+          * @throw InvalidRequest if the store is frozen */
       virtual void edit(const CommonTime& tmin, 
-                        const CommonTime& tmax = CommonTime::END_OF_TIME) throw()
+                        const CommonTime& tmax = CommonTime::END_OF_TIME)
+         throw(InvalidRequest)
       {
+         checkNotFrozen("edit");
          posStore.edit(tmin, tmax);
          clkStore.edit(tmin, tmax);
       }
 
          /// Clear the dataset, meaning remove all data
       virtual void clear(void) throw()
-      { clearPosition(); clearClock(); }
+      { frozen = false; clearPosition(); clearClock(); }
  
          /// Return time system (@note usually GPS, but CANNOT assume so)
       virtual TimeSystem getTimeSystem(void) const throw()
@@ -564,6 +567,7 @@ namespace gpstk
       void addPositionRecord(const SatID& sat, const CommonTime& ttag,
                              const PositionRecord& data) throw(InvalidRequest)
       {
+         checkNotFrozen("addPositionRecord");
          try { posStore.addPositionRecord(sat,ttag,data); }
          catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
       }
@@ -572,6 +576,7 @@ namespace gpstk
       void addPositionData(const SatID& sat, const CommonTime& ttag,
                            const Triple& Pos, const Triple& sig) throw(InvalidRequest)
       {
+         checkNotFrozen("addPositionData");
          try { posStore.addPositionData(sat,ttag,Pos,sig); }
          catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
       }
@@ -580,6 +585,7 @@ namespace gpstk
       void addVelocityData(const SatID& sat, const CommonTime& ttag,
                            const Triple& Vel, const Triple& sig) throw(InvalidRequest)
       {
+         checkNotFrozen("addVelocityData");
          try { posStore.addVelocityData(sat,ttag,Vel,sig); }
          catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
       }
@@ -596,6 +602,7 @@ namespace gpstk
                           const ClockRecord& rec)
          throw(InvalidRequest)
       {
+         checkNotFrozen("addClockRecord");
          try { clkStore.addClockRecord(sat,ttag,rec); }
          catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
       }
@@ -605,6 +612,7 @@ namespace gpstk
                         const double& bias, const double& sig=0.0)
          throw(InvalidRequest)
       {
+         checkNotFrozen("addClockBias");
          try { clkStore.addClockBias(sat,ttag,bias,sig); }
          catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
       }
@@ -614,6 +622,7 @@ namespace gpstk
                          const double& drift, const double& sig=0.0)
          throw(InvalidRequest)
       {
+         checkNotFrozen("addClockDrift");
          try { clkStore.addClockDrift(sat,ttag,drift,sig); }
          catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
       }
@@ -623,6 +632,7 @@ namespace gpstk
                                 const double& accel, const double& sig=0.0)
          throw(InvalidRequest)
       {
+         checkNotFrozen("addClockAcceleration");
          try { clkStore.addClockAcceleration(sat,ttag,accel,sig); }
          catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
       }
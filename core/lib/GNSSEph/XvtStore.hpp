@@ -44,6 +44,7 @@
 #define GPSTK_XVTSTORE_INCLUDE
 
 #include <iostream>
+#include <string>
 
 #include "Exception.hpp"
 #include "CommonTime.hpp"
@@ -61,6 +62,9 @@ namespace gpstk
    class XvtStore
    {
    public:
+      XvtStore() : frozen(false)
+      {}
+
       virtual ~XvtStore()
       {}
 
@@ -120,8 +124,53 @@ namespace gpstk
       { return onlyHealthy; }
 
          /// set the flag that limits getXvt() to healthy ephemerides
+         /// @throw InvalidRequest if the store is frozen
       void setOnlyHealthyFlag(bool flag)
-      { onlyHealthy = flag; }
+      {
+         checkNotFrozen("setOnlyHealthyFlag");
+         onlyHealthy = flag;
+      }
+
+         /** Make the store read-only.  Once the data are loaded and
+          * the store configured, call freeze() before sharing the
+          * store between threads.  While it is frozen, getXvt() and
+          * the other const methods may be called from any number of
+          * threads at once without locking, and every method that
+          * would change the data (adding or loading data, edit(),
+          * ...) throws InvalidRequest instead.  Configuration
+          * methods that can't throw, for example interpolation
+          * orders, must not be called while frozen.  clear() empties
+          * the store and ends the read-only mode.  Derived classes
+          * may override this to build lookup tables first, and must
+          * then call this method. */
+      virtual void freeze(void)
+      { frozen = true; }
+
+         /** End the read-only mode, so that the store may be changed
+          * again.  No other thread may be using the store. */
+      virtual void thaw(void)
+      { frozen = false; }
+
+         /// Return true if the store is frozen (read-only).
+      bool isFrozen(void) const
+      { return frozen; }
+
+   protected:
+         /** Throw InvalidRequest if the store is frozen; called at
+          * the beginning of every method that changes the store.
+          * @param[in] method name of the calling method, for the
+          *   exception text */
+      void checkNotFrozen(const char *method) const
+      {
+         if(frozen) {
+            InvalidRequest e(std::string(method) +
+                             " is not allowed while the store is frozen");
+            GPSTK_THROW(e);
+         }
+      }
+
+         /// true while the store is read-only, see freeze()
+      bool frozen;
 
    }; // end class XvtStore
 
@@ -0,0 +1,169 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file LagrangeWeights.cpp
+ * Lagrange interpolation by precomputed basis weights.
+ */
+
+#include <cstring>
+
+#include "LagrangeWeights.hpp"
+
+using namespace std;
+
+namespace
+{
+      // One set of weights for regularly spaced abscissae.
+   struct RegularEntry
+   {
+      RegularEntry() : N(0), step(0.0), x(0.0) {}
+      size_t N;
+      double step, x;
+      vector<double> w, dw;
+   };
+
+      // Number of entries in the cache; must be a power of 2.  A
+      // query of the whole constellation at one epoch uses a single
+      // entry, so this need only cover a few epochs of interleaving.
+   const size_t cacheSize = 64;
+
+      // The cache is per thread, so lookups need no locking.
+   thread_local RegularEntry regularCache[cacheSize];
+
+   inline unsigned long long bitsOf(double d)
+   {
+      unsigned long long u;
+      memcpy(&u, &d, sizeof(u));
+      return u;
+   }
+
+   inline size_t cacheSlot(size_t N, double step, double x)
+   {
+      unsigned long long h = bitsOf(x) * 0x9E3779B97F4A7C15ULL;
+      h ^= bitsOf(step) + N;
+      h ^= h >> 29;
+      return static_cast<size_t>(h) & (cacheSize-1);
+   }
+}
+
+namespace gpstk
+{
+   void LagrangeWeights ::
+   compute(const std::vector<double>& X, double x, bool derivative)
+   {
+      computeWeights(X.empty() ? 0 : &X[0], X.size(), x, derivative, w, dw);
+   }
+
+
+   void LagrangeWeights ::
+   computeRegular(std::size_t N, double step, double x)
+   {
+      RegularEntry& entry(regularCache[cacheSlot(N, step, x)]);
+      if(entry.N != N || entry.step != step || entry.x != x) {
+         vector<double> X(N);
+         for(size_t i=0; i<N; i++)
+            X[i] = double(i)*step;
+         computeWeights(&X[0], N, x, true, entry.w, entry.dw);
+         entry.N = N;
+         entry.step = step;
+         entry.x = x;
+      }
+      w = entry.w;
+      dw = entry.dw;
+   }
+
+
+   bool LagrangeWeights ::
+   isRegular(const std::vector<double>& X, double& step)
+   {
+      if(X.size() < 2 || X[0] != 0.0 || X[1] == 0.0)
+         return false;
+      for(size_t i=2; i<X.size(); i++)
+         if(X[i] != double(i)*X[1])
+            return false;
+      step = X[1];
+      return true;
+   }
+
+
+   void LagrangeWeights ::
+   computeWeights(const double *X, std::size_t N, double x, bool deriv,
+                  std::vector<double>& w, std::vector<double>& dw)
+   {
+      w.assign(N, 0.0);
+      if(deriv) dw.assign(N, 0.0);
+      else dw.clear();
+
+      size_t i, j, k(N);
+      for(i=0; i<N; i++)
+         if(x == X[i]) { k = i; break; }
+
+      for(i=0; i<N; i++) {
+         // Li(x) = PROD[(x-Xj)/(Xi-Xj)], j!=i, and its derivative from
+         // the product rule, accumulated one factor at a time.
+         double p(1.0), dp(0.0), d(1.0);
+         for(j=0; j<N; j++) {
+            if(j == i) continue;
+            double xx(x-X[j]);
+            dp = dp*xx + p;
+            p *= xx;
+            d *= X[i]-X[j];
+         }
+         w[i] = p/d;
+         if(deriv) dw[i] = dp/d;
+      }
+
+      // at a node the interpolant is exactly the data
+      if(k < N) {
+         for(i=0; i<N; i++)
+            w[i] = (i == k ? 1.0 : 0.0);
+      }
+   }
+
+
+   double LagrangeWeights ::
+   dot(const std::vector<double>& a, const std::vector<double>& b)
+   {
+      double sum(0.0);
+      size_t n(a.size() < b.size() ? a.size() : b.size());
+      for(size_t i=0; i<n; i++)
+         sum += a[i]*b[i];
+      return sum;
+   }
+
+} // namespace gpstk
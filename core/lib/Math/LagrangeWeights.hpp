@@ -0,0 +1,142 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file LagrangeWeights.hpp
+ * Lagrange interpolation by precomputed basis weights.
+ */
+
+#ifndef GPSTK_LAGRANGEWEIGHTS_HPP
+#define GPSTK_LAGRANGEWEIGHTS_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace gpstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /** Lagrange interpolation on data (X[i],Y[i]), i=0,N-1, done
+       * by computing the basis polynomials Li(x) and their
+       * derivatives Li'(x) once, so that Y(x) = SUM[Li(x)*Yi] and
+       * dY(x)/dx = SUM[Li'(x)*Yi] are then simple dot products.
+       * When several quantities are tabulated at the same abscissae,
+       * for example the X, Y and Z components of a satellite
+       * position, the weights are computed only once for all of
+       * them, rather than once per component as with
+       * LagrangeInterpolation() in MiscMath.hpp.
+       *
+       * For regularly spaced abscissae X[i] = i*step, as in SP3
+       * files, the weights depend only on N, the step and x, and
+       * computeRegular() keeps the most recently used weights in a
+       * small cache.  The cache belongs to the calling thread, so
+       * LagrangeWeights may be used from several threads at once.
+       *
+       * @code
+       * LagrangeWeights lw;
+       * lw.compute(times, dt, true);
+       * for(i=0; i<3; i++) {
+       *    pos[i] = lw.interpolate(P[i]);
+       *    vel[i] = lw.derivative(P[i]);
+       * }
+       * @endcode
+       */
+   class LagrangeWeights
+   {
+   public:
+         /// Default constructor, no weights.
+      LagrangeWeights() {}
+
+         /** Compute the weights for abscissae X at x.
+          * @param[in] X abscissae, distinct, at least 2 of them.
+          * @param[in] x where to interpolate.
+          * @param[in] derivative if true also compute the weights of
+          *   the derivative. */
+      void compute(const std::vector<double>& X, double x,
+                   bool derivative = false);
+
+         /** Compute the weights for the abscissae X[i] = i*step,
+          * i=0,N-1 at x, using the per-thread cache.  The weights of
+          * the derivative are always computed.
+          * @param[in] N number of abscissae, at least 2.
+          * @param[in] step the spacing, not zero.
+          * @param[in] x where to interpolate. */
+      void computeRegular(std::size_t N, double step, double x);
+
+         /** Test whether X[i] == i*X[1] for all i, exactly.
+          * @param[out] step X[1] if so. */
+      static bool isRegular(const std::vector<double>& X, double& step);
+
+         /// Number of weights.
+      std::size_t size() const
+      { return w.size(); }
+
+         /// Weights Li(x).
+      const std::vector<double>& weights() const
+      { return w; }
+
+         /// Weights Li'(x) of the derivative; empty unless requested.
+      const std::vector<double>& derivativeWeights() const
+      { return dw; }
+
+         /// Return SUM[Li(x)*Y[i]].
+      double interpolate(const std::vector<double>& Y) const
+      { return dot(w, Y); }
+
+         /// Return SUM[Li'(x)*Y[i]], the derivative at x.
+      double derivative(const std::vector<double>& Y) const
+      { return dot(dw, Y); }
+
+   private:
+         /** Compute w and, if deriv, dw for abscissae X[0..N-1]. */
+      static void computeWeights(const double *X, std::size_t N, double x,
+                                 bool deriv, std::vector<double>& w,
+                                 std::vector<double>& dw);
+
+      static double dot(const std::vector<double>& a,
+                        const std::vector<double>& b);
+
+      std::vector<double> w;    ///< Li(x)
+      std::vector<double> dw;   ///< Li'(x)
+   }; // end class LagrangeWeights
+
+      //@}
+
+} // namespace gpstk
+
+#endif // GPSTK_LAGRANGEWEIGHTS_HPP
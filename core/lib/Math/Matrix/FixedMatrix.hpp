@@ -0,0 +1,480 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file FixedMatrix.hpp
+ * Matrix with its dimensions fixed at compile time
+ */
+
+#ifndef GPSTK_FIXED_MATRIX_HPP
+#define GPSTK_FIXED_MATRIX_HPP
+
+#include "Matrix.hpp"
+#include "FixedVector.hpp"
+
+namespace gpstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * Base class of a matrix with R rows and C columns known at
+       * compile time.  As with FixedVectorExpr, the element-wise
+       * operators (+, -, scalar *, transpose, outer) return objects
+       * that compute each element on demand, while products are
+       * evaluated at once into a FixedMatrix or FixedVector on the
+       * stack.  Since this is a ConstMatrixBase, fixed matrices and
+       * their expressions may be given to any function of Matrix,
+       * e.g. Matrix<double> M(A*B) or inverseSVD(A).
+       *
+       * Sizes are checked by the compiler: adding a 3x4 to a 4x3, or
+       * multiplying a 4x3 by a 4-vector, does not compile.
+       */
+   template <class T, size_t R, size_t C, class E>
+   class FixedMatrixExpr : public ConstMatrixBase<T, E>
+   {
+   public:
+         /// The number of rows.
+      size_t rows() const
+      { return R; }
+         /// The number of columns.
+      size_t cols() const
+      { return C; }
+         /// rows()*cols()
+      size_t size() const
+      { return R*C; }
+   };
+
+      /**
+       * A matrix of R rows and C columns, stored in row-major order
+       * in the object itself, so that making one never allocates
+       * memory.  Use it in place of Matrix for the small matrices
+       * of inner loops, e.g. the normal equations of a position
+       * solution.
+       *
+       * @code
+       * FixedMatrix<double,4,4> N(0.0);
+       * FixedVector<double,4> p, b(0.0);
+       * for (i = 0; i < nobs; i++)
+       * {
+       *    // ... fill p with a row of partials
+       *    N += outer(p, p);
+       *    b += resid[i] * p;
+       * }
+       * FixedVector<double,4> x(inverseChol(N) * b);
+       * @endcode
+       */
+   template <class T, size_t R, size_t C>
+   class FixedMatrix : public FixedMatrixExpr<T, R, C, FixedMatrix<T, R, C> >
+   {
+   public:
+         /// Default constructor; the elements are not initialized.
+      FixedMatrix() {}
+
+         /// Constructor with every element set to \a initialValue.
+      explicit FixedMatrix(const T& initialValue)
+      { assignFrom(initialValue); }
+
+         /// Evaluate a fixed matrix expression.
+      template <class E>
+      FixedMatrix(const FixedMatrixExpr<T, R, C, E>& x)
+      { assignFrom(x); }
+
+         /** Copy any matrix (e.g. a Matrix).
+          * @throw MatrixException if it is not R x C. */
+      template <class E>
+      explicit FixedMatrix(const ConstMatrixBase<T, E>& x)
+         throw(MatrixException)
+      { assignFrom(x); }
+
+         /// The R x C identity matrix (ones on the diagonal).
+      static FixedMatrix identity()
+      {
+         FixedMatrix m(T(0));
+         for (size_t i = 0; i < R && i < C; i++)
+            m(i,i) = T(1);
+         return m;
+      }
+
+         /// Element (i,j)
+      T& operator() (size_t i, size_t j)
+      { return v[i*C+j]; }
+         /// Element (i,j)
+      T operator() (size_t i, size_t j) const
+      { return v[i*C+j]; }
+
+         /// Pointer to the R*C contiguous elements, in row-major order.
+      T* data()
+      { return v; }
+         /// Pointer to the R*C contiguous elements, in row-major order.
+      const T* data() const
+      { return v; }
+
+         /// Set every element to \a x.
+      FixedMatrix& operator=(const T& x)
+      { return assignFrom(x); }
+
+         /// Evaluate a fixed matrix expression.
+      template <class E>
+      FixedMatrix& operator=(const FixedMatrixExpr<T, R, C, E>& x)
+      { return assignFrom(x); }
+
+         /** Copy any matrix.
+          * @throw MatrixException if it is not R x C. */
+      template <class E>
+      FixedMatrix& operator=(const ConstMatrixBase<T, E>& x)
+         throw(MatrixException)
+      { return assignFrom(x); }
+
+         /// Add a fixed matrix expression to this matrix.
+      template <class E>
+      FixedMatrix& operator+=(const FixedMatrixExpr<T, R, C, E>& x)
+      {
+         FixedMatrix t(x);
+         for (size_t i = 0; i < R*C; i++)
+            v[i] += t.v[i];
+         return *this;
+      }
+
+         /// Subtract a fixed matrix expression from this matrix.
+      template <class E>
+      FixedMatrix& operator-=(const FixedMatrixExpr<T, R, C, E>& x)
+      {
+         FixedMatrix t(x);
+         for (size_t i = 0; i < R*C; i++)
+            v[i] -= t.v[i];
+         return *this;
+      }
+
+         /// Multiply every element by \a x.
+      FixedMatrix& operator*=(const T& x)
+      {
+         for (size_t i = 0; i < R*C; i++)
+            v[i] *= x;
+         return *this;
+      }
+
+   private:
+      FixedMatrix& assignFrom(const T& x)
+      {
+         for (size_t i = 0; i < R*C; i++)
+            v[i] = x;
+         return *this;
+      }
+
+      template <class E>
+      FixedMatrix& assignFrom(const FixedMatrixExpr<T, R, C, E>& x)
+      {
+            // evaluate into a temporary, since x may be e.g. the
+            // transpose of this matrix
+         const E& e = static_cast<const E&>(x);
+         T t[R*C];
+         for (size_t i = 0; i < R; i++)
+            for (size_t j = 0; j < C; j++)
+               t[i*C+j] = e(i,j);
+         for (size_t i = 0; i < R*C; i++)
+            v[i] = t[i];
+         return *this;
+      }
+
+      template <class E>
+      FixedMatrix& assignFrom(const ConstMatrixBase<T, E>& x)
+         throw(MatrixException)
+      {
+         if (x.rows() != R || x.cols() != C)
+         {
+            MatrixException e("Incompatible dimensions in FixedMatrix "
+                              "assignment");
+            GPSTK_THROW(e);
+         }
+         for (size_t i = 0; i < R; i++)
+            for (size_t j = 0; j < C; j++)
+               v[i*C+j] = x(i,j);
+         return *this;
+      }
+
+      T v[R*C];
+   };
+
+      /// Element-wise sum of two fixed matrix expressions.
+   template <class T, size_t R, size_t C, class L, class Rt>
+   class FixedMatrixSum
+      : public FixedMatrixExpr<T, R, C, FixedMatrixSum<T, R, C, L, Rt> >
+   {
+   public:
+      FixedMatrixSum(const L& left, const Rt& right)
+            : l(left), r(right)
+      {}
+      T operator() (size_t i, size_t j) const
+      { return l(i,j) + r(i,j); }
+   private:
+      const L& l;
+      const Rt& r;
+   };
+
+      /// Element-wise difference of two fixed matrix expressions.
+   template <class T, size_t R, size_t C, class L, class Rt>
+   class FixedMatrixDifference
+      : public FixedMatrixExpr<T, R, C, FixedMatrixDifference<T, R, C, L, Rt> >
+   {
+   public:
+      FixedMatrixDifference(const L& left, const Rt& right)
+            : l(left), r(right)
+      {}
+      T operator() (size_t i, size_t j) const
+      { return l(i,j) - r(i,j); }
+   private:
+      const L& l;
+      const Rt& r;
+   };
+
+      /// A fixed matrix expression times a scalar.
+   template <class T, size_t R, size_t C, class E>
+   class FixedMatrixScaled
+      : public FixedMatrixExpr<T, R, C, FixedMatrixScaled<T, R, C, E> >
+   {
+   public:
+      FixedMatrixScaled(const E& expr, const T& scale)
+            : e(expr), s(scale)
+      {}
+      T operator() (size_t i, size_t j) const
+      { return s * e(i,j); }
+   private:
+      const E& e;
+      T s;
+   };
+
+      /// The transpose of a C x R fixed matrix expression.
+   template <class T, size_t R, size_t C, class E>
+   class FixedMatrixTranspose
+      : public FixedMatrixExpr<T, R, C, FixedMatrixTranspose<T, R, C, E> >
+   {
+   public:
+      explicit FixedMatrixTranspose(const E& expr)
+            : e(expr)
+      {}
+      T operator() (size_t i, size_t j) const
+      { return e(j,i); }
+   private:
+      const E& e;
+   };
+
+      /// The outer product of an R-vector and a C-vector.
+   template <class T, size_t R, size_t C, class L, class Rt>
+   class FixedOuterProduct
+      : public FixedMatrixExpr<T, R, C, FixedOuterProduct<T, R, C, L, Rt> >
+   {
+   public:
+      FixedOuterProduct(const L& left, const Rt& right)
+            : l(left), r(right)
+      {}
+      T operator() (size_t i, size_t j) const
+      { return l[i] * r[j]; }
+   private:
+      const L& l;
+      const Rt& r;
+   };
+
+      /// Sum of two fixed matrices of the same dimensions.
+   template <class T, size_t R, size_t C, class L, class Rt>
+   inline FixedMatrixSum<T, R, C, L, Rt>
+   operator+(const FixedMatrixExpr<T, R, C, L>& l,
+             const FixedMatrixExpr<T, R, C, Rt>& r)
+   {
+      return FixedMatrixSum<T, R, C, L, Rt>(static_cast<const L&>(l),
+                                            static_cast<const Rt&>(r));
+   }
+
+      /// Difference of two fixed matrices of the same dimensions.
+   template <class T, size_t R, size_t C, class L, class Rt>
+   inline FixedMatrixDifference<T, R, C, L, Rt>
+   operator-(const FixedMatrixExpr<T, R, C, L>& l,
+             const FixedMatrixExpr<T, R, C, Rt>& r)
+   {
+      return FixedMatrixDifference<T, R, C, L, Rt>(static_cast<const L&>(l),
+                                                   static_cast<const Rt&>(r));
+   }
+
+      /// Fixed matrix times a scalar.
+   template <class T, size_t R, size_t C, class E>
+   inline FixedMatrixScaled<T, R, C, E>
+   operator*(const FixedMatrixExpr<T, R, C, E>& m, const T& s)
+   { return FixedMatrixScaled<T, R, C, E>(static_cast<const E&>(m), s); }
+
+      /// Scalar times a fixed matrix.
+   template <class T, size_t R, size_t C, class E>
+   inline FixedMatrixScaled<T, R, C, E>
+   operator*(const T& s, const FixedMatrixExpr<T, R, C, E>& m)
+   { return FixedMatrixScaled<T, R, C, E>(static_cast<const E&>(m), s); }
+
+      /// Negative of a fixed matrix.
+   template <class T, size_t R, size_t C, class E>
+   inline FixedMatrixScaled<T, R, C, E>
+   operator-(const FixedMatrixExpr<T, R, C, E>& m)
+   { return FixedMatrixScaled<T, R, C, E>(static_cast<const E&>(m), T(-1)); }
+
+      /// Transpose of a fixed matrix, without copying it.
+   template <class T, size_t R, size_t C, class E>
+   inline FixedMatrixTranspose<T, C, R, E>
+   transpose(const FixedMatrixExpr<T, R, C, E>& m)
+   { return FixedMatrixTranspose<T, C, R, E>(static_cast<const E&>(m)); }
+
+      /// Outer product l * transpose(r) of two fixed vectors.
+   template <class T, size_t R, size_t C, class L, class Rt>
+   inline FixedOuterProduct<T, R, C, L, Rt>
+   outer(const FixedVectorExpr<T, R, L>& l, const FixedVectorExpr<T, C, Rt>& r)
+   {
+      return FixedOuterProduct<T, R, C, L, Rt>(static_cast<const L&>(l),
+                                               static_cast<const Rt&>(r));
+   }
+
+      /// Product of an R x K and a K x C fixed matrix.
+   template <class T, size_t R, size_t K, size_t C, class L, class Rt>
+   inline FixedMatrix<T, R, C>
+   operator*(const FixedMatrixExpr<T, R, K, L>& l,
+             const FixedMatrixExpr<T, K, C, Rt>& r)
+   {
+      const L& a = static_cast<const L&>(l);
+      const Rt& b = static_cast<const Rt&>(r);
+      FixedMatrix<T, R, C> m;
+      for (size_t i = 0; i < R; i++)
+         for (size_t j = 0; j < C; j++)
+         {
+            T sum(0);
+            for (size_t k = 0; k < K; k++)
+               sum += a(i,k) * b(k,j);
+            m(i,j) = sum;
+         }
+      return m;
+   }
+
+      /// Product of an R x C fixed matrix and a C-vector.
+   template <class T, size_t R, size_t C, class L, class Rt>
+   inline FixedVector<T, R>
+   operator*(const FixedMatrixExpr<T, R, C, L>& l,
+             const FixedVectorExpr<T, C, Rt>& r)
+   {
+      const L& a = static_cast<const L&>(l);
+      const Rt& b = static_cast<const Rt&>(r);
+      FixedVector<T, R> v;
+      for (size_t i = 0; i < R; i++)
+      {
+         T sum(0);
+         for (size_t k = 0; k < C; k++)
+            sum += a(i,k) * b[k];
+         v[i] = sum;
+      }
+      return v;
+   }
+
+      /// Product of an R-vector (as a row) and an R x C fixed matrix.
+   template <class T, size_t R, size_t C, class L, class Rt>
+   inline FixedVector<T, C>
+   operator*(const FixedVectorExpr<T, R, L>& l,
+             const FixedMatrixExpr<T, R, C, Rt>& r)
+   {
+      const L& a = static_cast<const L&>(l);
+      const Rt& b = static_cast<const Rt&>(r);
+      FixedVector<T, C> v;
+      for (size_t j = 0; j < C; j++)
+      {
+         T sum(0);
+         for (size_t k = 0; k < R; k++)
+            sum += a[k] * b(k,j);
+         v[j] = sum;
+      }
+      return v;
+   }
+
+      /**
+       * Invert a symmetric positive definite fixed matrix with the
+       * Cholesky-Crout algorithm, as inverseChol() does for Matrix
+       * but without allocating.
+       * @throw MatrixException if the matrix is not positive definite.
+       */
+   template <class T, size_t N, class E>
+   inline FixedMatrix<T, N, N> inverseChol(const FixedMatrixExpr<T, N, N, E>& x)
+      throw(MatrixException)
+   {
+      const E& m = static_cast<const E&>(x);
+      FixedMatrix<T, N, N> L(T(0)), LI(T(0));
+      size_t i, j, k;
+      T sum;
+
+         // decompose m = L*LT
+      for (j = 0; j < N; j++)
+      {
+         sum = m(j,j);
+         for (k = 0; k < j; k++)
+            sum -= L(j,k)*L(j,k);
+         if (!(sum > T(0)))
+         {
+            MatrixException e("CholeskyCrout fails - eigenvalue <= 0");
+            GPSTK_THROW(e);
+         }
+         L(j,j) = SQRT(sum);
+         for (i = j+1; i < N; i++)
+         {
+            sum = m(i,j);
+            for (k = 0; k < j; k++)
+               sum -= L(i,k)*L(j,k);
+            L(i,j) = sum/L(j,j);
+         }
+      }
+
+         // invert L
+      for (i = 0; i < N; i++)
+      {
+         LI(i,i) = T(1)/L(i,i);
+         for (j = 0; j < i; j++)
+         {
+            sum = T(0);
+            for (k = i; k-- > j; )
+               sum += L(i,k)*LI(k,j);
+            LI(i,j) = -sum*LI(i,i);
+         }
+      }
+
+         // m^-1 = transpose(LI)*LI
+      return transpose(LI) * LI;
+   }
+
+      //@}
+
+}  // namespace
+
+#endif
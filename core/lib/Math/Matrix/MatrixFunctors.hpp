@@ -718,6 +718,281 @@ namespace gpstk
    }; // end class CholeskyCrout
 
 
+      /**
+       * Factor-and-solve for the symmetric positive definite systems
+       * that come from (weighted) least squares, e.g. the normal
+       * matrix AT*W*A that is inverted every epoch by a navigation
+       * solution.  The matrix is decomposed in place as
+       * M = L*D*transpose(L), where L is unit lower triangular and D
+       * is diagonal, with a blocked right-looking algorithm that works
+       * down the columns (Matrix is stored by columns).  No square
+       * roots are taken, and once the object has been used for a
+       * given dimension no further memory is allocated.
+       *
+       * After the decomposition the 1-norm condition number of M is
+       * estimated using Hager's method (as refined by Higham), which
+       * costs a handful of solves, and is available from condition();
+       * it does not change the result.  If M is not positive definite
+       * a SingularMatrixException is thrown, as inverseChol() does.
+       *
+       * Callers that used inverseSVD() before may set allowSVD. Then a
+       * matrix that is not positive definite, or whose condition estimate
+       * exceeds condLimit, is inverted by SVD instead, editing the
+       * singular values with tolerance 1/condLimit just as inverseSVD()
+       * does (the default limit, 1.e8, matches its default tolerance).
+       * Editing discards information, so this is not for covariance
+       * matrices, which are often this poorly conditioned.
+       *
+       * Ref: N.J. Higham, "Accuracy and Stability of Numerical
+       * Algorithms," 2nd ed., SIAM, 2002, chapters 10 and 15.
+       *
+       * @code
+       * Matrix<double> N(AT*A);    // square, symmetric and PD
+       * Vector<double> b(AT*y);
+       * LDLDecomp<double> ldl;
+       * ldl(N);
+       * ldl.backSub(b);            // b is now inverse(N)*AT*y
+       * Matrix<double> Cov;
+       * ldl.inverse(Cov);
+       * cout << ldl.condition() << " " << ldl.usedSVD() << endl;
+       * @endcode
+       */
+   template <class T>
+   class LDLDecomp
+   {
+   public:
+      LDLDecomp(T limit = T(1.e8), size_t block = 32, bool svd = false)
+            : condLimit(limit), blockSize(block), allowSVD(svd),
+              cond(T(0)), svdUsed(false)
+      {}
+
+         /// Does the decomposition; only the lower triangle of m is used.
+         /// @throw MatrixException if m is not square and non-trivial, or
+         ///   if the SVD fallback is given the zero matrix.
+         /// @throw SingularMatrixException if m is not positive definite
+         ///   and allowSVD is false.
+      template <class BaseClass>
+      void operator() (const ConstMatrixBase<T, BaseClass>& m)
+         throw (MatrixException)
+      {
+         if(!m.isSquare() || m.rows() == 0) {
+            MatrixException e("LDLDecomp requires a square, non-trivial matrix");
+            GPSTK_THROW(e);
+         }
+
+         size_t N=m.rows(),i,j;
+         T sum, norm(0);
+         if(LD.rows() != N || LD.cols() != N) LD.resize(N,N);
+         for(j=0; j<N; j++) {
+            for(i=j; i<N; i++) LD(i,j) = m(i,j);
+         }
+            // 1-norm of the symmetric matrix, from its lower triangle
+         for(j=0; j<N; j++) {
+            sum = T(0);
+            for(i=0; i<j; i++) sum += ABS(LD(j,i));
+            for(i=j; i<N; i++) sum += ABS(LD(i,j));
+            if(sum > norm) norm = sum;
+         }
+
+         svdUsed = false;
+         cond = T(0);
+         bool pd(factor());
+         if(pd) cond = norm * inverseNorm();
+         if(!allowSVD) {
+            if(pd) return;
+            SingularMatrixException e("LDLDecomp fails - matrix is not positive definite");
+            GPSTK_THROW(e);
+         }
+         if(pd && cond <= condLimit) return;
+
+            // not positive definite, or too poorly conditioned
+         svdUsed = true;
+         for(j=0; j<N; j++) {
+            for(i=0; i<j; i++) LD(i,j) = LD(j,i) = m(j,i);
+            LD(j,j) = m(j,j);
+         }
+         Inv = inverseSVD(LD, T(1)/condLimit);
+      }  // end LDLDecomp::operator()
+
+         /// Compute inverse(m)*b, where *this is LDLDecomp(m); the solution
+         /// overwrites b.
+      template <class BaseClass2>
+      void backSub(RefVectorBase<T, BaseClass2>& b) const
+         throw (MatrixException)
+      {
+         if(LD.rows() != b.size()) {
+            MatrixException e("Vector size does not match dimension of LDLDecomp");
+            GPSTK_THROW(e);
+         }
+
+         size_t N=LD.rows(),i,j;
+         T sum;
+         if(svdUsed) {
+            for(i=0; i<N; i++) work(i) = b(i);
+            for(i=0; i<N; i++) {
+               sum = T(0);
+               for(j=0; j<N; j++) sum += Inv(i,j)*work(j);
+               b(i) = sum;
+            }
+            return;
+         }
+            // L*y = b, by columns
+         for(j=0; j<N; j++) {
+            sum = b(j);
+            if(sum != T(0)) {
+               for(i=j+1; i<N; i++) b(i) -= LD(i,j)*sum;
+            }
+         }
+         for(i=0; i<N; i++) b(i) /= LD(i,i);
+            // transpose(L)*x = inverse(D)*y
+         for(j=N-1; ; j--) {
+            sum = b(j);
+            for(i=j+1; i<N; i++) sum -= LD(i,j)*b(i);
+            b(j) = sum;
+            if(j == 0) break;       // b/c j is unsigned
+         }
+      }  // end LDLDecomp::backSub
+
+         /// Compute inverse(m), where *this is LDLDecomp(m), into inv,
+         /// which is resized only if it has the wrong dimensions.
+      void inverse(Matrix<T>& inv) const
+         throw (MatrixException)
+      {
+         size_t N=LD.rows(),i,j,k;
+         T sum;
+         if(inv.rows() != N || inv.cols() != N) inv.resize(N,N);
+         if(svdUsed) {
+            for(j=0; j<N; j++)
+               for(i=0; i<N; i++) inv(i,j) = Inv(i,j);
+            return;
+         }
+            // X = inverse(L), unit lower triangular, into the lower triangle
+         for(j=0; j<N; j++) {
+            for(i=j+1; i<N; i++) {
+               sum = -LD(i,j);
+               for(k=j+1; k<i; k++) sum -= LD(i,k)*inv(k,j);
+               inv(i,j) = sum;
+            }
+         }
+            // inverse(m) = transpose(X)*inverse(D)*X, built in the upper
+            // triangle (X has an implied unit diagonal) and then mirrored
+         for(j=0; j<N; j++) {
+            for(i=0; i<=j; i++) {
+               sum = (i == j ? T(1) : inv(j,i)) / LD(j,j);
+               for(k=j+1; k<N; k++) sum += inv(k,i)*inv(k,j)/LD(k,k);
+               inv(i,j) = sum;
+            }
+         }
+         for(j=0; j<N; j++)
+            for(i=j+1; i<N; i++) inv(i,j) = inv(j,i);
+      }  // end LDLDecomp::inverse
+
+         /// Estimate of the 1-norm condition number of m; zero when m
+         /// was not positive definite.
+      T condition() const
+      { return cond; }
+
+         /// True if the last decomposition fell back to SVD.
+      bool usedSVD() const
+      { return svdUsed; }
+
+         /// With allowSVD, matrices with condition estimates above this are
+         /// inverted by SVD; 1/condLimit is the SVD editing tolerance.
+      T condLimit;
+         /// Number of columns in each block of the decomposition.
+      size_t blockSize;
+         /// Fall back to SVD, as inverseSVD(), for matrices that are not
+         /// positive definite or are ill-conditioned; false by default.
+      bool allowSVD;
+
+         /// The decomposed matrix: L below the diagonal (its unit diagonal is
+         /// implied) and D on the diagonal. Upper triangle is trash.
+      Matrix<T> LD;
+
+   private:
+         /** Decompose LD in place, a panel of blockSize columns at a time.
+          * Within a panel each column gets the updates from the panel
+          * columns to its left, then the panel is applied to all the
+          * columns to its right at once.
+          * @return false if a pivot is not positive. */
+      bool factor()
+      {
+         size_t N=LD.rows(), nb=(blockSize > 0 ? blockSize : 1);
+         size_t k0,k1,i,j,p;
+         T d,w;
+         if(work.size() != N) work.resize(N);
+
+         for(k0=0; k0<N; k0+=nb) {
+            k1 = std::min(k0+nb, N);
+               // unblocked decomposition of the panel
+            for(j=k0; j<k1; j++) {
+               for(p=k0; p<j; p++) {
+                  w = LD(j,p)*LD(p,p);
+                  for(i=j; i<N; i++) LD(i,j) -= LD(i,p)*w;
+               }
+               d = LD(j,j);
+               if(!(d > T(0))) return false;
+               w = T(1)/d;
+               for(i=j+1; i<N; i++) LD(i,j) *= w;
+            }
+               // rank-(k1-k0) update of the trailing lower triangle
+            for(j=k1; j<N; j++) {
+               for(p=k0; p<k1; p++) {
+                  w = LD(j,p)*LD(p,p);
+                  if(w == T(0)) continue;
+                  for(i=j; i<N; i++) LD(i,j) -= LD(i,p)*w;
+               }
+            }
+         }
+         return true;
+      }  // end LDLDecomp::factor
+
+         /// Estimate the 1-norm of inverse(m), using the decomposition in LD.
+      T inverseNorm()
+      {
+         size_t N=LD.rows(),i,j,jlast(0),iter;
+         T est(0),alt(0),t;
+         if(x.size() != N) x.resize(N);
+
+         for(i=0; i<N; i++) x(i) = T(1)/T(N);
+         for(iter=0; iter<5; iter++) {
+            for(i=0; i<N; i++) work(i) = x(i);
+            backSub(work);
+            est = T(0);
+            for(i=0; i<N; i++) est += ABS(work(i));
+               // inverse(m) is symmetric, so this is transpose(inverse(m))*sign
+            for(i=0; i<N; i++) x(i) = (work(i) < T(0) ? T(-1) : T(1));
+            backSub(x);
+            j = 0;
+            for(i=1; i<N; i++) if(ABS(x(i)) > ABS(x(j))) j = i;
+               // converged when the gradient gives no better unit vector
+            if(iter > 0 && (j == jlast || ABS(x(j)) <= x(jlast))) break;
+            for(i=0; i<N; i++) x(i) = T(0);
+            x(j) = T(1);
+            jlast = j;
+         }
+            // alternating test vector guards against the rare failures
+         for(i=0; i<N; i++) {
+            t = T(1) + (N > 1 ? T(i)/T(N-1) : T(0));
+            x(i) = (i % 2 ? -t : t);
+         }
+         backSub(x);
+         for(i=0; i<N; i++) alt += ABS(x(i));
+         alt = T(2)*alt/T(3*N);
+         return (alt > est ? alt : est);
+      }  // end LDLDecomp::inverseNorm
+
+         /// Condition estimate and fallback flag of the last decomposition
+      T cond;
+      bool svdUsed;
+         /// SVD inverse, when svdUsed
+      Matrix<T> Inv;
+         /// Workspaces
+      mutable Vector<T> work;
+      Vector<T> x;
+
+   }; // end class LDLDecomp
+
       // The Householder transformation is simply an orthogonal transformation
       // designed to make the elements below the diagonal zero. It applies to any
       // matrix.
@@ -0,0 +1,95 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file MatrixKernels.cpp
+ * Matrix product kernels for double, optionally using a system BLAS
+ */
+
+#include <climits>
+#include "MatrixKernels.hpp"
+
+#ifdef GPSTK_HAVE_BLAS
+   // Fortran BLAS, as found by CMake's FindBLAS
+extern "C" void dgemm_(const char* transa, const char* transb,
+                       const int* m, const int* n, const int* k,
+                       const double* alpha, const double* a, const int* lda,
+                       const double* b, const int* ldb,
+                       const double* beta, double* c, const int* ldc);
+#endif
+
+namespace gpstk
+{
+   namespace MatrixKernels
+   {
+      void gemm(bool transA, bool transB,
+                std::size_t M, std::size_t N, std::size_t K,
+                const double* A, std::size_t lda,
+                const double* B, std::size_t ldb,
+                double* C, std::size_t ldc)
+      {
+#ifdef GPSTK_HAVE_BLAS
+            // the call overhead of the BLAS only pays off for larger
+            // products
+         const double minFlops(32.*32.*32.);
+         if(double(M)*double(N)*double(K) >= minFlops &&
+            lda <= INT_MAX && ldb <= INT_MAX && ldc <= INT_MAX &&
+            M <= INT_MAX && N <= INT_MAX && K <= INT_MAX)
+         {
+            const char ta(transA ? 'T' : 'N'), tb(transB ? 'T' : 'N');
+            const int m(M), n(N), k(K), la(lda), lb(ldb), lc(ldc);
+            const double one(1.0);
+            dgemm_(&ta, &tb, &m, &n, &k, &one, A, &la, B, &lb, &one, C, &lc);
+            return;
+         }
+#endif
+         gemmBlocked(transA, transB, M, N, K, A, lda, B, ldb, C, ldc);
+      }
+
+
+      bool haveBLAS()
+      {
+#ifdef GPSTK_HAVE_BLAS
+         return true;
+#else
+         return false;
+#endif
+      }
+
+   }  // namespace MatrixKernels
+
+}  // namespace gpstk
@@ -0,0 +1,180 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file MatrixKernels.hpp
+ * Blocked matrix product kernels used by the Matrix operators
+ */
+
+#ifndef GPSTK_MATRIX_KERNELS_HPP
+#define GPSTK_MATRIX_KERNELS_HPP
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+namespace gpstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * Matrix product kernels on column-major arrays, in the style of
+       * the BLAS routine GEMM: C += op(A)*op(B), where op(X) is X or
+       * transpose(X).  op(A) is M x K, op(B) is K x N and C is M x N,
+       * and lda, ldb and ldc are the distances between the columns of
+       * the arrays (the number of rows for a Matrix).  The transposes
+       * are never formed; when transA is true, one cache-sized block of
+       * A is copied at a time instead.
+       *
+       * For each element of C the products are added in order of
+       * increasing k, as in the naive triple loop, so the results are
+       * identical to it.  The double version may be handed to a
+       * system BLAS instead, when the library was built with
+       * USE_BLAS; the order of the sums is then up to the BLAS.
+       */
+   namespace MatrixKernels
+   {
+         /// Number of rows of C and of inner products in a cache block.
+      const std::size_t blockRows = 128, blockInner = 128;
+
+         /** C += op(A)*op(B) with the portable blocked kernel.  Each
+          * block of A is applied to four columns of C at a time, two
+          * rows at a time, which keeps A in cache and lets the compiler
+          * vectorize the inner loop. */
+      template <class T>
+      void gemmBlocked(bool transA, bool transB,
+                       std::size_t M, std::size_t N, std::size_t K,
+                       const T* A, std::size_t lda,
+                       const T* B, std::size_t ldb,
+                       T* C, std::size_t ldc)
+      {
+         std::size_t i,j,k,i0,k0,mb,kb,la;
+         std::vector<T> pack;
+         if(transA)
+            pack.resize(std::min(M,blockRows) * std::min(K,blockInner));
+            // steps through op(B) along a column (bi) and a row (bj)
+         const std::size_t bi(transB ? ldb : 1), bj(transB ? 1 : ldb);
+
+         for(k0=0; k0<K; k0+=blockInner) {
+            kb = std::min(blockInner, K-k0);
+            for(i0=0; i0<M; i0+=blockRows) {
+               mb = std::min(blockRows, M-i0);
+               const T *a;
+               if(transA) {
+                     // copy the block of transpose(A), by columns
+                  for(i=0; i<mb; i++) {
+                     const T *src(A + k0 + (i0+i)*lda);
+                     for(k=0; k<kb; k++) pack[i + k*mb] = src[k];
+                  }
+                  a = &pack[0];
+                  la = mb;
+               }
+               else {
+                  a = A + i0 + k0*lda;
+                  la = lda;
+               }
+
+               for(j=0; j+4<=N; j+=4) {
+                  T *c0(C + i0 + j*ldc), *c1(c0 + ldc), *c2(c1 + ldc),
+                     *c3(c2 + ldc);
+                  const T *b(B + k0*bi + j*bj);
+                  for(k=0; k<kb; k++, b+=bi) {
+                     const T b0(b[0]), b1(b[bj]), b2(b[2*bj]), b3(b[3*bj]);
+                     const T *ak(a + k*la);
+                     for(i=0; i+2<=mb; i+=2) {
+                           // all loads before the stores
+                        const T x0(ak[i]), x1(ak[i+1]);
+                        T s00(c0[i]), s01(c0[i+1]), s10(c1[i]), s11(c1[i+1]),
+                           s20(c2[i]), s21(c2[i+1]), s30(c3[i]), s31(c3[i+1]);
+                        s00 += x0*b0; s01 += x1*b0;
+                        s10 += x0*b1; s11 += x1*b1;
+                        s20 += x0*b2; s21 += x1*b2;
+                        s30 += x0*b3; s31 += x1*b3;
+                        c0[i] = s00; c0[i+1] = s01;
+                        c1[i] = s10; c1[i+1] = s11;
+                        c2[i] = s20; c2[i+1] = s21;
+                        c3[i] = s30; c3[i+1] = s31;
+                     }
+                     if(i < mb) {
+                        c0[i] += ak[i]*b0;
+                        c1[i] += ak[i]*b1;
+                        c2[i] += ak[i]*b2;
+                        c3[i] += ak[i]*b3;
+                     }
+                  }
+               }
+               for(; j<N; j++) {
+                  T *c0(C + i0 + j*ldc);
+                  const T *b(B + k0*bi + j*bj);
+                  for(k=0; k<kb; k++, b+=bi) {
+                     const T b0(b[0]), *ak(a + k*la);
+                     for(i=0; i<mb; i++) c0[i] += ak[i]*b0;
+                  }
+               }
+            }
+         }
+      }  // end gemmBlocked
+
+         /// C += op(A)*op(B), for any element type.
+      template <class T>
+      inline void gemm(bool transA, bool transB,
+                       std::size_t M, std::size_t N, std::size_t K,
+                       const T* A, std::size_t lda,
+                       const T* B, std::size_t ldb,
+                       T* C, std::size_t ldc)
+      { gemmBlocked(transA, transB, M, N, K, A, lda, B, ldb, C, ldc); }
+
+         /** C += op(A)*op(B) for double.  Large products go to the
+          * system BLAS if the library was built with one, the rest to
+          * gemmBlocked(). */
+      void gemm(bool transA, bool transB,
+                std::size_t M, std::size_t N, std::size_t K,
+                const double* A, std::size_t lda,
+                const double* B, std::size_t ldb,
+                double* C, std::size_t ldc);
+
+         /// True if the library was built to use a system BLAS.
+      bool haveBLAS();
+
+   }  // namespace MatrixKernels
+
+      //@}
+
+}  // namespace
+
+#endif
@@ -45,6 +45,7 @@
 #include <limits>
 #include "MiscMath.hpp"
 #include "MatrixFunctors.hpp"
+#include "MatrixKernels.hpp"
 
 namespace gpstk
 {
@@ -821,6 +822,107 @@ namespace gpstk
       return toReturn;
    }
 
+      /**
+       *  Matrix * Matrix for two Matrix objects, using the blocked
+       *  kernel; the result is the same as that of the general version.
+       */
+   template <class T>
+   inline Matrix<T> operator* (const Matrix<T>& l, const Matrix<T>& r)
+      throw (MatrixException)
+   {
+      if (l.cols() != r.rows())
+      {
+         MatrixException e("Incompatible dimensions for Matrix * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      Matrix<T> toReturn(l.rows(), r.cols(), T(0));
+      if (toReturn.size() > 0 && l.cols() > 0)
+         MatrixKernels::gemm(false, false, l.rows(), r.cols(), l.cols(),
+                             l.begin(), l.rows(), r.begin(), r.rows(),
+                             toReturn.begin(), toReturn.rows());
+      return toReturn;
+   }
+
+      /**
+       * Returns transpose(l) * r, without forming the transpose.
+       */
+   template <class T>
+   inline Matrix<T> transposeTimes(const Matrix<T>& l, const Matrix<T>& r)
+      throw (MatrixException)
+   {
+      if (l.rows() != r.rows())
+      {
+         MatrixException e("Incompatible dimensions for transpose(Matrix) * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      Matrix<T> toReturn(l.cols(), r.cols(), T(0));
+      if (toReturn.size() > 0 && l.rows() > 0)
+         MatrixKernels::gemm(true, false, l.cols(), r.cols(), l.rows(),
+                             l.begin(), l.rows(), r.begin(), r.rows(),
+                             toReturn.begin(), toReturn.rows());
+      return toReturn;
+   }
+
+      /**
+       * Returns l * transpose(r), without forming the transpose.
+       */
+   template <class T>
+   inline Matrix<T> timesTranspose(const Matrix<T>& l, const Matrix<T>& r)
+      throw (MatrixException)
+   {
+      if (l.cols() != r.cols())
+      {
+         MatrixException e("Incompatible dimensions for Matrix * transpose(Matrix)");
+         GPSTK_THROW(e);
+      }
+
+      Matrix<T> toReturn(l.rows(), r.rows(), T(0));
+      if (toReturn.size() > 0 && l.cols() > 0)
+         MatrixKernels::gemm(false, true, l.rows(), r.rows(), l.cols(),
+                             l.begin(), l.rows(), r.begin(), r.rows(),
+                             toReturn.begin(), toReturn.rows());
+      return toReturn;
+   }
+
+      /**
+       * Returns transpose(a) * w * a, e.g. the information matrix of
+       * a least squares problem with partials a and weights w.
+       */
+   template <class T>
+   inline Matrix<T> transposeWeighted(const Matrix<T>& a, const Matrix<T>& w)
+      throw (MatrixException)
+   {
+      if (w.rows() != a.rows() || w.cols() != a.rows())
+      {
+         MatrixException e("Incompatible dimensions for transpose(A) * W * A");
+         GPSTK_THROW(e);
+      }
+      return transposeTimes(a, Matrix<T>(w * a));
+   }
+
+      /**
+       * Returns transpose(a) * diag(w) * a, for weights w that are
+       * the diagonal of a weight matrix.
+       */
+   template <class T>
+   inline Matrix<T> transposeWeighted(const Matrix<T>& a, const Vector<T>& w)
+      throw (MatrixException)
+   {
+      if (w.size() != a.rows())
+      {
+         MatrixException e("Incompatible dimensions for transpose(A) * W * A");
+         GPSTK_THROW(e);
+      }
+      Matrix<T> wa(a.rows(), a.cols());
+      size_t i, j;
+      for (j = 0; j < a.cols(); j++)
+         for (i = 0; i < a.rows(); i++)
+            wa(i,j) = w(i) * a(i,j);
+      return transposeTimes(a, wa);
+   }
+
       /**
        * Matrix times vector multiplication, returning a vector.
        */
@@ -0,0 +1,324 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file FixedVector.hpp
+ * Vector with its size fixed at compile time
+ */
+
+#ifndef GPSTK_FIXED_VECTOR_HPP
+#define GPSTK_FIXED_VECTOR_HPP
+
+#include "Vector.hpp"
+
+namespace gpstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * Base class of a vector whose size N is known at compile time.
+       * The element-wise operators of fixed vectors return light
+       * objects derived from this class that compute each element
+       * when it is asked for (expression templates), so that
+       * @code
+       * FixedVector<double,4> a, b, c;
+       * c = 2.0*a - b;
+       * @endcode
+       * is a single loop with no temporaries.  Since this class is a
+       * ConstVectorBase, any fixed vector expression can be given to
+       * the functions and operators of Vector, e.g. Vector<double>
+       * v(a+b) or norm(a-b).
+       *
+       * An expression keeps references to its operands, so it must be
+       * evaluated (assigned to a FixedVector or Vector) before the
+       * end of the statement in which it is made.
+       */
+   template <class T, size_t N, class E>
+   class FixedVectorExpr : public ConstVectorBase<T, E>
+   {
+   public:
+         /// The size of the vector.
+      size_t size() const
+      { return N; }
+   };
+
+      /**
+       * A vector with N elements stored in the object itself, so
+       * that making one never allocates memory.  Use it in place of
+       * Vector for the small vectors of inner loops (positions,
+       * state vectors of a few elements).
+       */
+   template <class T, size_t N>
+   class FixedVector : public FixedVectorExpr<T, N, FixedVector<T, N> >
+   {
+   public:
+         /// Default constructor; the elements are not initialized.
+      FixedVector() {}
+
+         /// Constructor with every element set to \a initialValue.
+      explicit FixedVector(const T& initialValue)
+      { assignFrom(initialValue); }
+
+         /// Evaluate a fixed vector expression.
+      template <class E>
+      FixedVector(const FixedVectorExpr<T, N, E>& x)
+      { assignFrom(x); }
+
+         /** Copy any vector (e.g. a Vector).
+          * @throw VectorException if its size is not N. */
+      template <class E>
+      explicit FixedVector(const ConstVectorBase<T, E>& x)
+         throw(VectorException)
+      { assignFrom(x); }
+
+         /// Element i
+      T& operator[] (size_t i)
+      { return v[i]; }
+         /// Element i
+      T operator[] (size_t i) const
+      { return v[i]; }
+         /// Element i
+      T& operator() (size_t i)
+      { return v[i]; }
+         /// Element i
+      T operator() (size_t i) const
+      { return v[i]; }
+
+         /// Pointer to the first of the N contiguous elements.
+      T* data()
+      { return v; }
+         /// Pointer to the first of the N contiguous elements.
+      const T* data() const
+      { return v; }
+
+         /// Set every element to \a x.
+      FixedVector& operator=(const T& x)
+      { return assignFrom(x); }
+
+         /// Evaluate a fixed vector expression.
+      template <class E>
+      FixedVector& operator=(const FixedVectorExpr<T, N, E>& x)
+      { return assignFrom(x); }
+
+         /** Copy any vector.
+          * @throw VectorException if its size is not N. */
+      template <class E>
+      FixedVector& operator=(const ConstVectorBase<T, E>& x)
+         throw(VectorException)
+      { return assignFrom(x); }
+
+         /// Add a fixed vector expression to this vector.
+      template <class E>
+      FixedVector& operator+=(const FixedVectorExpr<T, N, E>& x)
+      {
+         const E& e = static_cast<const E&>(x);
+         for (size_t i = 0; i < N; i++)
+            v[i] += e[i];
+         return *this;
+      }
+
+         /// Subtract a fixed vector expression from this vector.
+      template <class E>
+      FixedVector& operator-=(const FixedVectorExpr<T, N, E>& x)
+      {
+         const E& e = static_cast<const E&>(x);
+         for (size_t i = 0; i < N; i++)
+            v[i] -= e[i];
+         return *this;
+      }
+
+         /// Multiply every element by \a x.
+      FixedVector& operator*=(const T& x)
+      {
+         for (size_t i = 0; i < N; i++)
+            v[i] *= x;
+         return *this;
+      }
+
+         /// Divide every element by \a x.
+      FixedVector& operator/=(const T& x)
+      {
+         for (size_t i = 0; i < N; i++)
+            v[i] /= x;
+         return *this;
+      }
+
+   private:
+      FixedVector& assignFrom(const T& x)
+      {
+         for (size_t i = 0; i < N; i++)
+            v[i] = x;
+         return *this;
+      }
+
+      template <class E>
+      FixedVector& assignFrom(const FixedVectorExpr<T, N, E>& x)
+      {
+            // all the vector expressions are element-wise, so x may
+            // refer to this vector
+         const E& e = static_cast<const E&>(x);
+         for (size_t i = 0; i < N; i++)
+            v[i] = e[i];
+         return *this;
+      }
+
+      template <class E>
+      FixedVector& assignFrom(const ConstVectorBase<T, E>& x)
+         throw(VectorException)
+      {
+         if (x.size() != N)
+         {
+            VectorException e("Incompatible size in FixedVector assignment");
+            GPSTK_THROW(e);
+         }
+         for (size_t i = 0; i < N; i++)
+            v[i] = x[i];
+         return *this;
+      }
+
+      T v[N];
+   };
+
+      /// Element-wise sum of two fixed vector expressions.
+   template <class T, size_t N, class L, class R>
+   class FixedVectorSum
+      : public FixedVectorExpr<T, N, FixedVectorSum<T, N, L, R> >
+   {
+   public:
+      FixedVectorSum(const L& left, const R& right)
+            : l(left), r(right)
+      {}
+      T operator[] (size_t i) const
+      { return l[i] + r[i]; }
+   private:
+      const L& l;
+      const R& r;
+   };
+
+      /// Element-wise difference of two fixed vector expressions.
+   template <class T, size_t N, class L, class R>
+   class FixedVectorDifference
+      : public FixedVectorExpr<T, N, FixedVectorDifference<T, N, L, R> >
+   {
+   public:
+      FixedVectorDifference(const L& left, const R& right)
+            : l(left), r(right)
+      {}
+      T operator[] (size_t i) const
+      { return l[i] - r[i]; }
+   private:
+      const L& l;
+      const R& r;
+   };
+
+      /// A fixed vector expression times a scalar.
+   template <class T, size_t N, class E>
+   class FixedVectorScaled
+      : public FixedVectorExpr<T, N, FixedVectorScaled<T, N, E> >
+   {
+   public:
+      FixedVectorScaled(const E& expr, const T& scale)
+            : e(expr), s(scale)
+      {}
+      T operator[] (size_t i) const
+      { return s * e[i]; }
+   private:
+      const E& e;
+      T s;
+   };
+
+      /// Sum of two fixed vectors of the same size.
+   template <class T, size_t N, class L, class R>
+   inline FixedVectorSum<T, N, L, R>
+   operator+(const FixedVectorExpr<T, N, L>& l, const FixedVectorExpr<T, N, R>& r)
+   {
+      return FixedVectorSum<T, N, L, R>(static_cast<const L&>(l),
+                                        static_cast<const R&>(r));
+   }
+
+      /// Difference of two fixed vectors of the same size.
+   template <class T, size_t N, class L, class R>
+   inline FixedVectorDifference<T, N, L, R>
+   operator-(const FixedVectorExpr<T, N, L>& l, const FixedVectorExpr<T, N, R>& r)
+   {
+      return FixedVectorDifference<T, N, L, R>(static_cast<const L&>(l),
+                                               static_cast<const R&>(r));
+   }
+
+      /// Fixed vector times a scalar.
+   template <class T, size_t N, class E>
+   inline FixedVectorScaled<T, N, E>
+   operator*(const FixedVectorExpr<T, N, E>& x, const T& s)
+   { return FixedVectorScaled<T, N, E>(static_cast<const E&>(x), s); }
+
+      /// Scalar times a fixed vector.
+   template <class T, size_t N, class E>
+   inline FixedVectorScaled<T, N, E>
+   operator*(const T& s, const FixedVectorExpr<T, N, E>& x)
+   { return FixedVectorScaled<T, N, E>(static_cast<const E&>(x), s); }
+
+      /// Fixed vector divided by a scalar.
+   template <class T, size_t N, class E>
+   inline FixedVectorScaled<T, N, E>
+   operator/(const FixedVectorExpr<T, N, E>& x, const T& s)
+   { return FixedVectorScaled<T, N, E>(static_cast<const E&>(x), T(1)/s); }
+
+      /// Negative of a fixed vector.
+   template <class T, size_t N, class E>
+   inline FixedVectorScaled<T, N, E>
+   operator-(const FixedVectorExpr<T, N, E>& x)
+   { return FixedVectorScaled<T, N, E>(static_cast<const E&>(x), T(-1)); }
+
+      /// Dot product of two fixed vectors of the same size.
+   template <class T, size_t N, class L, class R>
+   inline T dot(const FixedVectorExpr<T, N, L>& l,
+                const FixedVectorExpr<T, N, R>& r)
+   {
+      const L& a = static_cast<const L&>(l);
+      const R& b = static_cast<const R&>(r);
+      T sum(0);
+      for (size_t i = 0; i < N; i++)
+         sum += a[i] * b[i];
+      return sum;
+   }
+
+      //@}
+
+}  // namespace
+
+#endif
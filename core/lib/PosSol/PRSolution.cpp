@@ -40,15 +40,485 @@
 
 #include "MathBase.hpp"
 #include "PRSolution.hpp"
+#include "FixedMatrix.hpp"
 #include "GPSEllipsoid.hpp"
 #include "Combinations.hpp"
 #include "TimeString.hpp"
 #include "stl_helpers.hpp"
 #include "logstream.hpp"
+#include "ThreadPool.hpp"
+#include <cfloat>
+#include <chrono>
+#include <functional>
+#include <memory>
 
 using namespace std;
 using namespace gpstk;
 
+namespace
+{
+   typedef std::chrono::steady_clock RAIMClock;
+
+   // seconds elapsed since t0
+   inline double secondsSince(const RAIMClock::time_point& t0)
+   {
+      return std::chrono::duration<double>(RAIMClock::now() - t0).count();
+   }
+
+   // Linearization of the solution using all the satellites, from which the
+   // solution excluding some of them is predicted by removing their rows from
+   // the normal equations (a rank-k downdate).
+   class RAIMDowndater
+   {
+   public:
+      static const int maxDim = 12;
+
+      // Save the partials, weights and residuals of a converged solution,
+      // with the bounds used by predict(): slope (m/m) on the rate at which
+      // range corrections left out of the partials change with position,
+      // rhoMin the shortest range (m) and conv the convergence limit.
+      // Return false if invMC is not diagonal and positive, or the dimension
+      // is too large.
+      bool init(const Matrix<double>& Partials, const Matrix<double>& invMC,
+                const Vector<double>& Resids, double slope, double rhoMin,
+                double conv)
+      {
+         int i,j,k;
+         n = Partials.rows();
+         dim = Partials.cols();
+         if(dim < 4 || dim > maxDim || n == 0 || Resids.size() != n) return false;
+         if(invMC.rows() > 0) {
+            if(invMC.rows() != n || invMC.cols() != n) return false;
+            for(i=0; i<n; i++) for(j=0; j<n; j++)
+               if(i != j && invMC(i,j) != 0.0) return false;
+            for(i=0; i<n; i++) if(!(invMC(i,i) > 0.0)) return false;
+         }
+         if(!(rhoMin > 0.0) || slope < 0.0) return false;
+         corrSlope = slope;
+         minRange = rhoMin;
+         convLimit = conv;
+
+         P.resize(n*dim);
+         w.resize(n);
+         r.resize(n);
+         clk.resize(n);
+         wmin = wmax = rmax = 0.0;
+         for(i=0; i<n; i++) {
+            w[i] = (invMC.rows() > 0 ? invMC(i,i) : 1.0);
+            r[i] = Resids(i);
+            if(i == 0 || w[i] < wmin) wmin = w[i];
+            if(i == 0 || w[i] > wmax) wmax = w[i];
+            if(::fabs(r[i]) > rmax) rmax = ::fabs(r[i]);
+            clk[i] = -1;
+            for(j=0; j<dim; j++) {
+               P[i*dim+j] = Partials(i,j);
+               if(j >= 3 && Partials(i,j) != 0.0) clk[i] = j;
+            }
+            if(clk[i] == -1) return false;
+         }
+
+         // normal equations PT*W*P and PT*W*r
+         N.assign(dim*dim,0.0);
+         b.assign(dim,0.0);
+         for(k=0; k<n; k++) {
+            const double *p(&P[k*dim]);
+            for(i=0; i<dim; i++) {
+               b[i] += w[k]*p[i]*r[k];
+               for(j=0; j<dim; j++) N[i*dim+j] += w[k]*p[i]*p[j];
+            }
+         }
+         return true;
+      }
+
+      // Predict the RMS residual of the solution excluding rows excl[0..nexcl-1]
+      // (increasing), and a bound tol on its difference from the RMS residual
+      // of the converged solution (cf. tolerance()).
+      // Return 0 ok, -2 singular, -3 fewer rows than unknowns, -4 the bound
+      // does not hold and the subset must be solved.
+      int predict(const int *excl, int nexcl, double& rms, double& tol) const
+      {
+         int i,j,k,m,e;
+         int count[maxDim] = {0}, act[maxDim];
+         double M[maxDim*maxDim], v[maxDim], diag[maxDim];
+
+         // count rows of each clock, and find the columns still present
+         for(i=0; i<n; i++) count[clk[i]]++;
+         for(e=0; e<nexcl; e++) count[clk[excl[e]]]--;
+         for(m=0,j=0; j<dim; j++)
+            if(j < 3 || count[j] > 0) act[m++] = j;
+         if(n-nexcl < m) return -3;
+
+         // downdate the normal equations
+         for(i=0; i<m; i++) {
+            v[i] = b[act[i]];
+            for(j=0; j<m; j++) M[i*m+j] = N[act[i]*dim+act[j]];
+         }
+         for(e=0; e<nexcl; e++) {
+            const double *p(&P[excl[e]*dim]);
+            const double we(w[excl[e]]);
+            for(i=0; i<m; i++) {
+               v[i] -= we*p[act[i]]*r[excl[e]];
+               for(j=0; j<m; j++) M[i*m+j] -= we*p[act[i]]*p[act[j]];
+            }
+         }
+
+         // Cholesky decomposition M = L*LT, in place in the lower triangle
+         for(i=0; i<m; i++) diag[i] = M[i*m+i];
+         for(j=0; j<m; j++) {
+            double d(M[j*m+j]);
+            for(k=0; k<j; k++) d -= M[j*m+k]*M[j*m+k];
+            if(d <= 1.e-12*diag[j]) return -2;
+            d = ::sqrt(d);
+            M[j*m+j] = d;
+            for(i=j+1; i<m; i++) {
+               double s(M[i*m+j]);
+               for(k=0; k<j; k++) s -= M[i*m+k]*M[j*m+k];
+               M[i*m+j] = s/d;
+            }
+         }
+         // solve L*y = v, then LT*dx = y
+         for(i=0; i<m; i++) {
+            for(k=0; k<i; k++) v[i] -= M[i*m+k]*v[k];
+            v[i] /= M[i*m+i];
+         }
+         for(i=m-1; i>=0; i--) {
+            for(k=i+1; k<m; k++) v[i] -= M[k*m+i]*v[k];
+            v[i] /= M[i*m+i];
+         }
+         double shift(::sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2])), vnorm(0.0);
+         for(k=0; k<m; k++) vnorm += v[k]*v[k];
+         vnorm = ::sqrt(vnorm);
+
+         // post-fit residuals of the remaining rows
+         double sum(0.0);
+         for(e=0,i=0; i<n; i++) {
+            if(e < nexcl && excl[e] == i) { e++; continue; }
+            const double *p(&P[i*dim]);
+            double res(r[i]);
+            for(k=0; k<m; k++) res -= p[act[k]]*v[k];
+            sum += res*res;
+         }
+         rms = ::sqrt(sum/double(n-nexcl));
+
+         // trace of inverse(M) = squared Frobenius norm of inverse(L), a
+         // column at a time; traces of M and of the normal matrix it came from
+         double tinv(0.0), trM(0.0), trN(0.0);
+         for(j=0; j<m; j++) {
+            trM += diag[j];
+            trN += N[act[j]*dim+act[j]];
+            for(i=j; i<m; i++) {
+               double s(i == j ? 1.0 : 0.0);
+               for(k=j; k<i; k++) s -= M[i*m+k]*v[k];
+               v[i] = s/M[i*m+i];
+               tinv += v[i]*v[i];
+            }
+         }
+         return tolerance(n-nexcl, m, rms, shift, vnorm, tinv, trM, trN, tol);
+      }
+
+   private:
+      // Bound the difference between the predicted RMS residual rms and that
+      // of the converged solution, for a subset of nrow rows and m states, with
+      // position shift and state change vnorm from the full solution; tinv,
+      // trM and trN are the traces of inverse(M), M and the normal matrix
+      // before the downdate.
+      //
+      // With both residual vectors at convergence, the difference is the part
+      // of the model error h that least squares does not absorb, (I-PG)h, plus
+      // the effect of the partials turning as the position moves, plus
+      // rounding and convergence errors. If the position moves by sigma from
+      // the full solution, each element of h is at most
+      //    e = slope*sigma + sigma^2/(2*rhoMin),
+      // the range corrections not in the partials and the curvature of the
+      // range. The weighted projector PG has 2-norm at most sqrt(wmax/wmin),
+      // G has 2-norm at most sqrt(wmax*tinv), each direction cosine turns by
+      // at most sigma/rhoMin, and cond(M) <= trM*tinv. The converged position
+      // differs from the prediction by at most |G|*|h|; sigma = 2*shift+1m
+      // covers that when |G|*|h| <= shift+1m, which is checked, so the
+      // bound is a first order one in the model error.
+      // Return 0, or -4 if the check fails.
+      int tolerance(int nrow, int m, double rms, double shift, double vnorm,
+                    double tinv, double trM, double trN, double& tol) const
+      {
+         const double sigma(2.0*shift + 1.0), rn(::sqrt(double(nrow)));
+         const double err(corrSlope*sigma + sigma*sigma/(2.0*minRange));
+         const double gnorm(::sqrt(wmax*tinv)), gamma(::sqrt(wmax/wmin));
+         if(gnorm*rn*err > shift + 1.0) return -4;
+
+         // cancellation in the downdate and the solve, |dv| <= m*eps*cond*|v|,
+         // scaled by the normal matrix before the downdate; rows have norm
+         // sqrt(2) (direction cosines and one clock)
+         double round(8.0*m*DBL_EPSILON*std::max(trM,trN)*tinv*(vnorm+rmax));
+         // each SimplePRSolution() residual is from the last iterate, within
+         // sqrt(2)*convLimit of the converged one
+         double conv((1.0+gamma)*::sqrt(2.0)*convLimit);
+         // the turning of the partials, |dP| <= sqrt(nrow)*sigma/rhoMin, moves
+         // the projector by at most 2*|dP|*|G|
+         double turn(2.0*rn*(sigma/minRange)*gnorm*(rms+err));
+
+         tol = round + conv + gamma*err + turn;
+         return 0;
+      }
+
+      int n, dim;                   // number of rows (satellites) and states
+      std::vector<double> P;        // partials, row-major n x dim
+      std::vector<double> w, r;     // weights and residuals
+      std::vector<int> clk;         // clock column of each row
+      std::vector<double> N, b;     // PT*W*P and PT*W*r
+      double wmin, wmax, rmax;      // range of the weights, largest |residual|
+      double corrSlope, minRange;   // model bounds, cf. init()
+      double convLimit;             // convergence limit of SimplePRSolution()
+   };
+
+   // predict subsets [begin,end) of combos, each of k row indexes
+   void predictSubsets(const RAIMDowndater *dd, const std::vector<int> *combos,
+                       int k, size_t begin, size_t end, std::vector<int> *code,
+                       std::vector<double> *rms, std::vector<double> *tol)
+   {
+      for(size_t i=begin; i<end; i++)
+         (*code)[i] = dd->predict(k > 0 ? &(*combos)[i*k] : 0, k,
+                                  (*rms)[i], (*tol)[i]);
+   }
+
+   // Decide which of the combinations of n satellites taken k at a time
+   // (in the order of Combinations::Next()) must be solved in full; the others
+   // cannot be the best of the stage. code, rms and tol are the predictions,
+   // cf. RAIMDowndater::predict(). With nthreads > 1, pool is created when
+   // first needed and then reused. Return the number of subsets predicted.
+   int screenSubsets(const RAIMDowndater& dd, int n, int k, unsigned nthreads,
+                     std::unique_ptr<ThreadPool>& pool,
+                     std::vector<bool>& runCombo, std::vector<int>& code,
+                     std::vector<double>& rms, std::vector<double>& tol)
+   {
+      std::vector<int> combos;
+      Combinations Combo(n,k);
+      do {
+         for(int j=0; j<k; j++) combos.push_back(Combo.Selection(j));
+      } while(Combo.Next() != -1);
+
+      const size_t ncombo(combos.size()/k);
+      code.resize(ncombo);
+      rms.resize(ncombo);
+      tol.resize(ncombo);
+
+      // the predictions are independent; share them out when there are many
+      if(nthreads > 1 && ncombo >= 1024) {
+         if(!pool) pool.reset(new ThreadPool(nthreads));
+         size_t chunk((ncombo + nthreads - 1)/nthreads);
+         for(size_t i=0; i<ncombo; i+=chunk)
+            pool->submit(std::bind(predictSubsets, &dd, &combos, k, i,
+                                   std::min<size_t>(i+chunk,ncombo),
+                                   &code, &rms, &tol));
+         pool->wait();
+      }
+      else
+         predictSubsets(&dd, &combos, k, 0, ncombo, &code, &rms, &tol);
+
+      // the exhaustive search stops at the first subset that is too small
+      size_t i, nreach(ncombo);
+      for(i=0; i<ncombo; i++)
+         if(code[i] == -3) { nreach = i+1; break; }
+
+      // a subset can be the best only if the lower end of its range is
+      // below the least upper end
+      double best(-1.0);
+      for(i=0; i<nreach; i++) {
+         if(code[i] != 0) continue;
+         if(best < 0.0 || rms[i]+tol[i] < best) best = rms[i]+tol[i];
+      }
+
+      runCombo.assign(nreach,false);
+      for(i=0; i<nreach; i++)
+         runCombo[i] = (code[i] != 0 || rms[i]-tol[i] <= best);
+      // the last subset always sets the return value of the stage
+      if(nreach > 0) runCombo[nreach-1] = true;
+
+      return ncombo;
+   }
+
+   // Column k of transpose(P)*W, where W is the identity if it is empty.
+   template <size_t D>
+   inline void weightedColumn(const Matrix<double>& P, const Matrix<double>& W,
+                              size_t k, FixedVector<double,D>& t)
+   {
+      size_t j;
+      if(W.rows() == 0) {
+         for(j=0; j<D; j++) t[j] = P(k,j);
+         return;
+      }
+      t = 0.0;
+      for(size_t m=0; m<P.rows(); m++) {
+         const double w(W(m,k));
+         if(w == 0.0) continue;
+         for(j=0; j<D; j++) t[j] += P(m,j)*w;
+      }
+   }
+
+   // Least squares step of SimplePRSolution() with D unknowns, with the
+   // normal equations on the stack: Cov = inverse(PT*W*P), dX = Cov*PT*W*r.
+   // LDL falls back to SVD, as always used before, when PT*W*P is so
+   // ill-conditioned that inverseSVD() would edit the singular values.
+   // Return 0, or -2 if the problem is singular.
+   template <size_t D>
+   int fixedLeastSquares(const Matrix<double>& P, const Matrix<double>& W,
+                         const Vector<double>& r, LDLDecomp<double>& ldl,
+                         Matrix<double>& Cov, Vector<double>& dX)
+   {
+      size_t j;
+      FixedMatrix<double,D,D> N(0.0);
+      FixedVector<double,D> b(0.0),t,p;
+      for(size_t k=0; k<P.rows(); k++) {
+         weightedColumn(P, W, k, t);
+         for(j=0; j<D; j++) p[j] = P(k,j);
+         N += outer(t,p);
+         b += r(k)*t;
+      }
+
+      try { ldl(N); }
+      catch(SingularMatrixException& sme) { return -2; }
+      ldl.inverse(Cov);
+      dX.resize(D);
+      for(j=0; j<D; j++) dX(j) = b[j];
+      ldl.backSub(dX);
+      return 0;
+   }
+
+   // Column j of the generalized inverse G = Cov*PT*W; return the sum of
+   // squares of its elements in g2, and (P*G)(j,j) in pg.
+   template <size_t D>
+   void fixedGainColumn(const Matrix<double>& P, const Matrix<double>& W,
+                        const Matrix<double>& Cov, size_t j,
+                        double& g2, double& pg)
+   {
+      FixedMatrix<double,D,D> C(Cov);
+      FixedVector<double,D> t,p;
+      weightedColumn(P, W, j, t);
+      for(size_t k=0; k<D; k++) p[k] = P(j,k);
+      FixedVector<double,D> g(C*t);
+      g2 = dot(g,g);
+      pg = dot(p,g);
+   }
+
+   // The same for any dimension, using Matrix.
+   int genericLeastSquares(const Matrix<double>& P, const Matrix<double>& W,
+                           const Vector<double>& r, LDLDecomp<double>& ldl,
+                           Matrix<double>& Cov, Vector<double>& dX)
+   {
+      Matrix<double> PTW(W.rows() > 0 ? transposeTimes(P, W) : transpose(P));
+      try { ldl(PTW * P); }
+      catch(SingularMatrixException& sme) { return -2; }
+      ldl.inverse(Cov);
+      dX = PTW * r;
+      ldl.backSub(dX);
+      return 0;
+   }
+
+   void genericGainColumn(const Matrix<double>& P, const Matrix<double>& W,
+                          const Matrix<double>& Cov, size_t j,
+                          double& g2, double& pg)
+   {
+      Vector<double> t(P.rowCopy(j));
+      if(W.rows() > 0) t = transpose(P) * W.colCopy(j);
+      Vector<double> g(Cov * t);
+      g2 = dot(g,g);
+      pg = dot(P.rowCopy(j),g);
+   }
+
+   // Solutions of up to 6 systems (dimension 9) use the fixed-size kernels.
+   int leastSquares(const Matrix<double>& P, const Matrix<double>& W,
+                    const Vector<double>& r, LDLDecomp<double>& ldl,
+                    Matrix<double>& Cov, Vector<double>& dX)
+   {
+      switch(P.cols()) {
+         case 4: return fixedLeastSquares<4>(P, W, r, ldl, Cov, dX);
+         case 5: return fixedLeastSquares<5>(P, W, r, ldl, Cov, dX);
+         case 6: return fixedLeastSquares<6>(P, W, r, ldl, Cov, dX);
+         case 7: return fixedLeastSquares<7>(P, W, r, ldl, Cov, dX);
+         case 8: return fixedLeastSquares<8>(P, W, r, ldl, Cov, dX);
+         case 9: return fixedLeastSquares<9>(P, W, r, ldl, Cov, dX);
+      }
+      return genericLeastSquares(P, W, r, ldl, Cov, dX);
+   }
+
+   void gainColumn(const Matrix<double>& P, const Matrix<double>& W,
+                   const Matrix<double>& Cov, size_t j, double& g2, double& pg)
+   {
+      switch(P.cols()) {
+         case 4: fixedGainColumn<4>(P, W, Cov, j, g2, pg); return;
+         case 5: fixedGainColumn<5>(P, W, Cov, j, g2, pg); return;
+         case 6: fixedGainColumn<6>(P, W, Cov, j, g2, pg); return;
+         case 7: fixedGainColumn<7>(P, W, Cov, j, g2, pg); return;
+         case 8: fixedGainColumn<8>(P, W, Cov, j, g2, pg); return;
+         case 9: fixedGainColumn<9>(P, W, Cov, j, g2, pg); return;
+      }
+      genericGainColumn(P, W, Cov, j, g2, pg);
+   }
+
+   // True if S is below the horizon of R (geocentric), i.e. if
+   // Position::elevation() would be negative.
+   bool belowHorizon(const double R[3], const double S[3])
+   {
+      double z[3] = { S[0]-R[0], S[1]-R[1], S[2]-R[2] };
+      double zz(z[0]*z[0]+z[1]*z[1]+z[2]*z[2]);
+      double rr(R[0]*R[0]+R[1]*R[1]+R[2]*R[2]);
+      if(zz <= 1.e-14 || rr <= 1.e-14)
+         GPSTK_THROW(GeometryException("Divide by Zero Error"));
+      return (z[0]*R[0]+z[1]*R[1]+z[2]*R[2] < 0.0);
+   }
+
+   // Bounds for RAIMDowndater::init() at the solution Sol: slope, the rate
+   // (m/m) at which the corrections that the partials leave out change with
+   // the receiver position, and rhoMin, the shortest range. The rotation of
+   // the Earth during the flight time moves a satellite at radius |SV| by
+   // omega*|SV|/c per meter of range; the trop gradient of each satellite is
+   // found by central differences of 10m and doubled to allow for its change
+   // over the shifts of the subsets. Trop is treated as SimplePRSolution()
+   // does. Return false if the TropModel throws.
+   bool correctionBounds(const vector<SatID>& Sats, const Matrix<double>& SVP,
+                         const Vector<double>& Sol, TropModel *pTropModel,
+                         const CommonTime& T, double& slope, double& rhoMin)
+   {
+      GPSEllipsoid ellip;
+      const double h(10.0);
+      double rx[3],sv[3],llh[3],tc[2],grad[3],svmax(0.0),tmax(0.0);
+      Position RX,SV;
+      rhoMin = -1.0;
+      try {
+         for(size_t i=0; i<Sats.size(); i++) {
+            if(Sats[i].id <= 0) continue;
+            for(int k=0; k<3; k++) sv[k] = SVP(i,k);
+            double rho(RSS(sv[0]-Sol(0), sv[1]-Sol(1), sv[2]-Sol(2)));
+            if(rhoMin < 0.0 || rho < rhoMin) rhoMin = rho;
+            svmax = std::max(svmax, RSS(sv[0],sv[1],sv[2]));
+            SV.setECEF(sv[0],sv[1],sv[2]);
+
+            for(int k=0; k<3; k++) {
+               for(int j=0; j<2; j++) {
+                  for(int l=0; l<3; l++) rx[l] = Sol(l);
+                  rx[k] += (j == 0 ? h : -h);
+                  Position::convertCartesianToGeodetic(rx, llh, ellip.a(),
+                                                       ellip.eccSquared());
+                  if(belowHorizon(rx,sv) || llh[2] > 44247. || llh[2] < -1000.)
+                     tc[j] = 0.0;
+                  else {
+                     RX.setECEF(rx[0],rx[1],rx[2]);
+                     tc[j] = pTropModel->correction(RX,SV,T);
+                  }
+               }
+               grad[k] = (tc[0]-tc[1])/(2.0*h);
+            }
+            tmax = std::max(tmax, RSS(grad[0],grad[1],grad[2]));
+         }
+      }
+      catch(Exception& e) { return false; }
+
+      slope = ellip.angVelocity()*svmax/ellip.c() + 2.0*tmax;
+      return (rhoMin > 0.0);
+   }
+
+} // end anonymous namespace
+
+
 namespace gpstk
 {
    const string PRSolution::calfmt = string("%04Y/%02m/%02d %02H:%02M:%02S %P");
@@ -208,7 +678,7 @@ namespace gpstk
 
       int iret(0),k,n;
       size_t i, j;
-      double rho,wt,svxyz[3];
+      double rho,wt,svxyz[3],rxxyz[3],llh[3],dirCos[3];
       GPSEllipsoid ellip;
 
       Valid = Mixed = false;
@@ -216,10 +686,14 @@ namespace gpstk
       try {
          // -----------------------------------------------------------
          // counts, systems and dimensions
-         vector<SatID::SatelliteSystem> mySyss;
+         // (the ws* workspace members are reused, so that a solution of the
+         // same size as the last one does not allocate)
+         vector<SatID::SatelliteSystem>& mySyss(wsSyss);
+         mySyss.clear();
          {
             // define the Syss (system IDs) vector, and count good satellites
-            vector<SatID::SatelliteSystem> tempSyss;
+            vector<SatID::SatelliteSystem>& tempSyss(wsTempSyss);
+            tempSyss.clear();
             for(Nsvs=0,i=0; i<Sats.size(); i++) {
                if(Sats[i].id <= 0)                          // reject marked sats
                   continue;
@@ -248,10 +722,12 @@ namespace gpstk
 
          // -----------------------------------------------------------
          // build the measurement covariance matrix
-         Matrix<double> iMC;
+         // (resize just once, since Vector::resize reallocates when growing)
+         Matrix<double>& iMC(wsInvMC);
+         const size_t nMC(invMC.rows() > 0 ? Nsvs : 0);
+         iMC.resize(nMC,nMC);
          if(invMC.rows() > 0) {
             LOG(DEBUG) << "Build inverse MCov";
-            iMC = Matrix<double>(Nsvs,Nsvs,0.0);
             for(n=0,i=0; i<Sats.size(); i++) {
                if(Sats[i].id <= 0) continue;
                for(k=0,j=0; j<Sats.size(); j++) {
@@ -266,13 +742,12 @@ namespace gpstk
 
          // -----------------------------------------------------------
          // define for computation
-         Vector<double> CRange(Nsvs),dX(dim);
-         Matrix<double> P(Nsvs,dim,0.0),PT,G(dim,Nsvs),PG(Nsvs,Nsvs),Rotation;
-         Triple dirCos;
-         Xvt SV,RX;
+         double CRange;
+         Vector<double>& dX(wsDX);
+         Matrix<double>& P(wsPartials);
+         P.resize(Nsvs,dim,0.0);
 
          Solution.resize(dim);
-         Covariance.resize(dim,dim);
          Resids.resize(Nsvs);
          Slopes.resize(Nsvs);
          LOG(DEBUG) << " Solution dimension is " << dim << " and Nsvs is " << Nsvs;
@@ -283,14 +758,15 @@ namespace gpstk
          double converge(0.0);
 
          // start with solution = apriori
-         Vector<double> APSolution;
+         Vector<double>& APSolution(wsAPSolution);
          if(hasMemory) {
-            APSolution = Solution = memory.getAprioriSolution(mySyss);
+            memory.getAprioriSolution(mySyss, APSolution);
+            Solution = APSolution;
             LOG(DEBUG) << " apriori solution (" << Solution.size() << ") is [ "
                << fixed << setprecision(3) << Solution << " ]";
          }
          else {
-            Solution = Vector<double>(dim,0.0);
+            Solution = 0.0;
             LOG(DEBUG) << " no memory - no apriori solution";
          }
 
@@ -300,7 +776,9 @@ namespace gpstk
             TropFlag = false;       // true means the trop corr was NOT applied
 
             // current estimate of position solution
-            RX.x = Triple(Solution(0),Solution(1),Solution(2));
+            rxxyz[0] = Solution(0);
+            rxxyz[1] = Solution(1);
+            rxxyz[2] = Solution(2);
 
             // loop over satellites, computing partials matrix
             for(n=0,i=0; i<Sats.size(); i++) {
@@ -333,27 +811,27 @@ namespace gpstk
 
                // ------------ data
                // corrected pseudorange (m) minus geometric range
-               CRange(n) = SVP(i,3) - rho;
+               CRange = SVP(i,3) - rho;
 
                // correct for troposphere and PCOs (but not on the first iteration)
                if(n_iterate > 0) {
-                  SV.x = Triple(svxyz[0],svxyz[1],svxyz[2]);
-                  Position R,S;
-                  R.setECEF(RX.x[0],RX.x[1],RX.x[2]);
-                  S.setECEF(SV.x[0],SV.x[1],SV.x[2]);
-
                   // trop
-                  double tc(R.getHeight());  // tc is a dummy here
                   // must test R for reasonableness to avoid corrupting TropModel
                   // Global model sets the upper limit
-                  if(R.elevation(S) < 0.0 || tc > 44247. || tc < -1000.0) {
+                  Position::convertCartesianToGeodetic(rxxyz, llh, ellip.a(),
+                                                       ellip.eccSquared());
+                  double tc(llh[2]);  // tc is a dummy here
+                  if(belowHorizon(rxxyz,svxyz) || tc > 44247. || tc < -1000.0) {
                      tc = 0.0;
                      TropFlag = true;        // true means failed to apply trop corr
                   }
-                  else
-                     tc = pTropModel->correction(R,S,T);    // pTropModel not const
+                  else {
+                     wsRX.setECEF(rxxyz[0],rxxyz[1],rxxyz[2]);
+                     wsSV.setECEF(svxyz[0],svxyz[1],svxyz[2]);
+                     tc = pTropModel->correction(wsRX,wsSV,T);  // pTropModel not const
+                  }
 
-                  CRange(n) -= tc;
+                  CRange -= tc;
                   LOG(DEBUG) << "Trop " << i << " " << Sats[i] << " "
                      << fixed << setprecision(3) << tc;
 
@@ -367,7 +845,7 @@ namespace gpstk
                LOG(DEBUG) << "Clock is (" << j << ") " << clk;
 
                // data vector: corrected range residual
-               Resids(n) = CRange(n) - clk;
+               Resids(n) = CRange - clk;
 
                // ------------ least squares
                // partials matrix
@@ -393,35 +871,18 @@ namespace gpstk
                << fixed << setprecision(3) << Resids;
 
             // ------------------------------------------------------
-            // compute information matrix (inverse covariance) and generalized inverse
-            PT = transpose(P);
-
-            // weight matrix = measurement covariance inverse
-            if(invMC.rows() > 0) Covariance = PT * iMC * P;
-            else                 Covariance = PT * P;
-
-            // invert using SVD
-            try {
-               Covariance = inverseSVD(Covariance);
-            }
-            catch(SingularMatrixException& sme) { return -2; }
+            // compute information matrix (inverse covariance), invert it and
+            // compute the solution update dX = Cov*PT*iMC*Resids; the
+            // weight matrix is the measurement covariance inverse
+            if(leastSquares(P, iMC, Resids, wsLDL, Covariance, dX) != 0)
+               return -2;
             LOG(DEBUG) << "InvCov (" << Covariance.rows() << "x" << Covariance.cols()
                << ")\n" << fixed << setprecision(4) << Covariance;
 
-            // generalized inverse
-            if(invMC.rows() > 0) G = Covariance * PT * iMC;
-            else                 G = Covariance * PT;
-
-            // PG is used for Slope computation
-            PG = P * G;
-            LOG(DEBUG) << "PG (" << PG.rows() << "x" << PG.cols()
-               << ")\n" << fixed << setprecision(4) << PG;
-
             n_iterate++;                        // increment number iterations
 
             // ------------------------------------------------------
             // compute solution
-            dX = G * Resids;
             LOG(DEBUG) << "Computed dX(" << dX.size() << ")";
             Solution += dX;
 
@@ -444,24 +905,33 @@ namespace gpstk
                                  << printTime(T,timfmt);
 
          // compute slopes and find max member
+         // G = Cov*PT*iMC is the generalized inverse; PG = P*G
          MaxSlope = 0.0;
          Slopes = 0.0;
          if(iret == 0) for(j=0,i=0; i<Sats.size(); i++) {
             if(Sats[i].id <= 0) continue;
 
+            double GG, PG;
+            gainColumn(P, iMC, Covariance, j, GG, PG);
+
             // NB when one (few) sats have their own clock, PG(j,j) = 1 (nearly 1)
             // and slope is inf (large)
-            if(::fabs(1.0-PG(j,j)) < 1.e-8) continue;
+            if(::fabs(1.0-PG) < 1.e-8) continue;
 
-            for(int k=0; k<dim; k++) Slopes(j) += G(k,j)*G(k,j); // TD dim=4 here?
-            Slopes(j) = SQRT(Slopes(j)*double(n-dim)/(1.0-PG(j,j)));
+            Slopes(j) = SQRT(GG*double(n-dim)/(1.0-PG));
             if(Slopes(j) > MaxSlope) MaxSlope = Slopes(j);
             j++;
          }
 
          // compute pre-fit residuals
-         if(hasMemory)
-            PreFitResidual = P*(Solution-APSolution) - Resids;
+         if(hasMemory) {
+            PreFitResidual.resize(Nsvs);
+            for(i=0; i<Nsvs; i++) {
+               double sum(0.0);
+               for(j=0; j<dim; j++) sum += P(i,j)*(Solution(j)-APSolution(j));
+               PreFitResidual(i) = sum - Resids(i);
+            }
+         }
 
          // Compute RMS residual (member)
          RMSResidual = RMS(Resids);
@@ -500,6 +970,9 @@ namespace gpstk
                                TropModel *pTropModel)
       throw(Exception)
    {
+      RAIMClock::time_point tstart(RAIMClock::now()), t0;
+      Timing.reset();
+
       try {
          LOG(DEBUG) << "RAIMCompute at time " << printTime(Tr,gpsfmt);
 
@@ -515,6 +988,16 @@ namespace gpstk
          vector<SatID> BestSats,SaveSats;
          Matrix<double> SVP,BestCov,BestInvMCov,BestPartials;
          vector<SatID::SatelliteSystem> BestSyss;
+         // linearization of the all-satellite solution, if IncrementalRAIM,
+         // the combinations in each stage that must be solved in full, and
+         // the predictions, to check them against the solutions
+         RAIMDowndater Downdater;
+         bool Incremental(false),Screen(false),Mispredicted(false);
+         vector<bool> RunCombo;
+         vector<int> PredCode;
+         vector<double> PredRMS,PredTol;
+         std::unique_ptr<ThreadPool> Pool;
+         double StageBestRMS;
 
          // initialize
          Valid = false;
@@ -526,7 +1009,9 @@ namespace gpstk
          // NB this routine will: define Syss if it is empty,
          //    reject sat systems not found in Syss, and
          //    reject sats without ephemeris.
+         t0 = RAIMClock::now();
          N = PreparePRSolution(Tr, Sats, Syss, Pseudorange, pEph, SVP);
+         Timing.prepare = secondsSince(t0);
 
          if(LOGlevel >= ConfigureLOG::Level("DEBUG")) {
             LOG(DEBUG) << "Prepare returns " << N;
@@ -546,7 +1031,7 @@ namespace gpstk
          }
 
          // return is >=0(number of good sats) or -4(no ephemeris)
-         if(N <= 0) return -4;
+         if(N <= 0) { Timing.total = secondsSince(tstart); return -4; }
 
          // ----------------------------------------------------------------
          // Build GoodIndexes based on Sats; save Sats as SaveSats.
@@ -584,8 +1069,29 @@ namespace gpstk
             // compute all the combinations of N satellites taken stage at a time
             Combinations Combo(N,stage);
 
+            // predict the solution for each combination, and find those that
+            // could be the best of the stage; not when the stage is repeated
+            // because a prediction was found to be wrong
+            Screen = (Incremental && stage > 0 && !Mispredicted);
+            StageBestRMS = BestRMS;
+            if(Screen) {
+               t0 = RAIMClock::now();
+               Timing.nScreened += screenSubsets(Downdater, N, stage, RAIMThreads,
+                                          Pool, RunCombo, PredCode, PredRMS, PredTol);
+               Timing.screen += secondsSince(t0);
+            }
+            size_t icombo(0);
+
             // compute a solution for each combination of marked satellites
             do {
+               ++Timing.nSubsets;
+               const size_t ic(icombo++);
+               if(Screen && ic < RunCombo.size() && !RunCombo[ic]) {
+                  LOG(DEBUG) << " RAIM: skip combo " << ic
+                     << ", predicted not to be the best";
+                  continue;
+               }
+
                // Mark the satellites for this combination
                Sats = SaveSats;
                for(i=0; i<GoodIndexes.size(); i++)
@@ -611,8 +1117,30 @@ namespace gpstk
                //       -2  singular problem
                //       -3  not enough good data
                //       -4  no ephemeris
+               t0 = RAIMClock::now();
                iret = SimplePRSolution(Tr, Sats, SVP, invMC, pTropModel,
                        MaxNIterations, ConvergenceLimit, Syss, Resids, Slopes);
+               Timing.solve += secondsSince(t0);
+               ++Timing.nSolved;
+
+               // the converged solution with all the satellites is the one
+               // from which the others are predicted
+               if(stage == 0 && IncrementalRAIM && iret == 0) {
+                  double slope, rhoMin;
+                  Incremental = correctionBounds(Sats, SVP, Solution, pTropModel,
+                                                 Tr, slope, rhoMin)
+                     && Downdater.init(Partials, invMeasCov, Resids, slope, rhoMin,
+                                       ConvergenceLimit);
+               }
+
+               // check the prediction; if it is wrong, the bound it was screened
+               // with does not hold for this data
+               if(Screen && ic < PredCode.size() && PredCode[ic] == 0 &&
+                  (iret != 0 || ::fabs(RMSResidual-PredRMS[ic]) > PredTol[ic])) {
+                  LOG(DEBUG) << " RAIM: combo " << ic << " RMS " << RMSResidual
+                     << " was predicted " << PredRMS[ic] << " +- " << PredTol[ic];
+                  Mispredicted = true;
+               }
 
                LOG(DEBUG) << " RAIM: SimplePRS returns " << iret;
                if(iret <= 0 && iret > BestIret) BestIret = iret;
@@ -670,6 +1198,16 @@ namespace gpstk
 
             } while(Combo.Next() != -1);  // get the next combinations and repeat
 
+            // a wrong prediction: repeat the stage, solving every subset. The
+            // solutions are the same, so restoring BestRMS is enough for the
+            // result to be that of the exhaustive search.
+            if(Screen && Mispredicted) {
+               LOG(DEBUG) << " RAIM: repeat stage " << stage << " without screening";
+               BestRMS = StageBestRMS;
+               continue;
+            }
+            Mispredicted = false;
+
             // end of the stage
             if(BestRMS > 0.0 && BestRMS < RMSLimit) {          // success
                LOG(DEBUG) << " RAIM: Success in the RAIM loop";
@@ -777,6 +1315,12 @@ namespace gpstk
          LOG(DEBUG) << " RAIM exit with ret value " << iret
                      << " and Valid " << (Valid ? "T":"F");
 
+         Timing.total = secondsSince(tstart);
+         LOG(DEBUG) << " RAIM timing: total " << Timing.total
+            << " s, prepare " << Timing.prepare << " s, solve " << Timing.solve
+            << " s (" << Timing.nSolved << "), screen " << Timing.screen
+            << " s (" << Timing.nScreened << " of " << Timing.nSubsets << ")";
+
          return iret;
       }
       catch(Exception& e) {
@@ -789,7 +1333,7 @@ namespace gpstk
    int PRSolution::DOPCompute(void) throw(Exception)
    {
       try {
-         Matrix<double> PTP(transpose(Partials)*Partials);
+         Matrix<double> PTP(transposeTimes(Partials,Partials));
          Matrix<double> Cov(inverseLUD(PTP));
          PDOP = SQRT(Cov(0,0)+Cov(1,1)+Cov(2,2));
          TDOP = 0.0;
@@ -238,19 +238,30 @@ namespace gpstk
       /// Get the apriori solution, given the systems in the current epoch's data
       Vector<double> getAprioriSolution(std::vector<SatID::SatelliteSystem> syss)
       {
-         if(APSolution.size() == 3 + syss.size())
-            return APSolution;
+         Vector<double> aps;
+         getAprioriSolution(syss, aps);
+         return aps;
+      }
+
+      /// Get the apriori solution, given the systems in the current epoch's data,
+      /// into aps (which is resized, reusing its storage if large enough)
+      void getAprioriSolution(const std::vector<SatID::SatelliteSystem>& syss,
+                              Vector<double>& aps)
+      {
+         if(APSolution.size() == 3 + syss.size()) {
+            aps = APSolution;
+            return;
+         }
 
          // must cut down the vector
          int j;
          size_t i;
-         Vector<double> aps(3+syss.size(),0.0);
+         aps.resize(3+syss.size(),0.0);
          for(i=0; i<3; i++) aps[i] = APSolution[i];
          for(j=3,i=0; i<APsysIDs.size(); i++) {
             if(std::find(syss.begin(),syss.end(),APsysIDs[i]) != syss.end())
                aps[j++] = APSolution[3+i];
          }
-         return aps;
       }
 
       /// get the aposteriori variance of unit weight; return zero if not enough
@@ -301,7 +312,7 @@ namespace gpstk
                ident(invMC);
             }
             Matrix<double> sumInfo(was.getInfo());
-            Matrix<double> Ginv(Part*sumInfo*transpose(Part) + invMC);
+            Matrix<double> Ginv(timesTranspose(Part*sumInfo, Part) + invMC);
             Matrix<double> G(inverseSVD(Ginv));
             Vector<double> Gpfr(G*PreFitResid);
             APV += dot(PreFitResid,Gpfr);
@@ -349,6 +360,29 @@ namespace gpstk
 
 
 
+   /// Timing and work counters of one call to PRSolution::RAIMCompute(); times
+   /// are wall clock seconds.
+   class RAIMTiming {
+   public:
+      double total;     ///< time in RAIMCompute()
+      double prepare;   ///< time in PreparePRSolution()
+      double solve;     ///< time in SimplePRSolution(), all calls
+      double screen;    ///< time predicting subset solutions by downdating
+      int nSubsets;     ///< number of satellite subsets considered
+      int nScreened;    ///< number of subsets predicted by downdating
+      int nSolved;      ///< number of calls to SimplePRSolution()
+
+      /// constructor
+      RAIMTiming() throw() { reset(); }
+
+      /// set all times and counts to zero
+      void reset(void) throw()
+      {
+         total = prepare = solve = screen = 0.0;
+         nSubsets = nScreened = nSolved = 0;
+      }
+   }; // end class RAIMTiming
+
    /// This class defines an interface to routines which compute a position
    /// and time solution from pseudorange data, with a data editing algorithm
    /// based on Receiver Autonomous Integrity Monitoring (RAIM) concepts.
@@ -387,7 +421,10 @@ namespace gpstk
                              MaxNIterations(10),
                              ConvergenceLimit(3.e-7),
                              hasMemory(true),
-                             Valid(false)
+                             IncrementalRAIM(true),
+                             RAIMThreads(0),
+                             Valid(false),
+                             wsLDL(1.e8, 32, true)
          {}
       /// Return the status of solution
       bool isValid() const throw() { return Valid; }
@@ -430,6 +467,25 @@ namespace gpstk
       /// and a combined weighted average solution.
       bool hasMemory;
 
+      /// If true, RAIMCompute() linearizes about the solution using all the
+      /// satellites and, for each subset of satellites to be rejected, predicts
+      /// the RMS residual by downdating the normal equations of that solution,
+      /// with a first order bound on the error of the prediction (rounding,
+      /// convergence, range curvature, and the trop and Earth rotation
+      /// corrections, which are not in the partials). SimplePRSolution() is
+      /// then called only for the subsets that could be the best of their
+      /// stage. Each of those solutions is checked against its prediction;
+      /// if one falls outside the bound the stage is repeated without
+      /// screening, so the selection is that of the exhaustive search.
+      /// The prediction is used only with a diagonal (or no) invMC.
+      bool IncrementalRAIM;
+
+      /// Number of threads used by RAIMCompute() to predict the subset solutions
+      /// when there are very many of them (1024 or more in a stage); one pool is
+      /// started, when first needed, for each call. 0 or 1 (the default) means
+      /// the predictions are made in the calling thread.
+      unsigned RAIMThreads;
+
       // input and output: -------------------------------------------------
 
       /// vector<SatID> containing satellite IDs for all the satellites input, with
@@ -504,6 +560,9 @@ namespace gpstk
       /// the slope is large; applies only after calls to RAIMCompute().
       bool RMSFlag, SlopeFlag;
 
+      /// timing and work counters of the last call to RAIMCompute()
+      RAIMTiming Timing;
+
       // member functions -------------------------------------------
 
       /// Compute the satellite position / corrected range matrix (SVP) which is used
@@ -672,6 +731,16 @@ namespace gpstk
       /// empty vector used to detect default
       static const Vector<double> PRSNullVector;
 
+      /// workspace of SimplePRSolution(), kept between calls so that
+      /// repeated solutions of the same size do not allocate
+      std::vector<SatID::SatelliteSystem> wsSyss, wsTempSyss;
+      Matrix<double> wsPartials, wsInvMC;
+      Vector<double> wsAPSolution, wsDX;
+      Position wsRX, wsSV;
+      /// with the SVD fallback, so singular and ill-conditioned problems are
+      /// handled as inverseSVD() did
+      LDLDecomp<double> wsLDL;
+
    }; // end class PRSolution
 
    //@}
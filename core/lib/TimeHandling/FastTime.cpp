@@ -0,0 +1,117 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/// @file FastTime.cpp
+
+#include <sstream>
+#include <iomanip>
+
+#include "FastTime.hpp"
+
+namespace gpstk
+{
+   void FastTime::split(long& day, long& msod) const
+   {
+      day = static_cast<long>(m_msec / MS_PER_DAY);
+      msod = static_cast<long>(m_msec - static_cast<long long>(day) *
+                               MS_PER_DAY);
+      if (msod < 0)
+      {
+         msod += MS_PER_DAY;
+         --day;
+      }
+   }
+
+   CommonTime FastTime::convertToCommonTime() const
+   {
+      long day, msod;
+      split(day, msod);
+      CommonTime ct;
+      try
+      {
+         ct.setInternal(day, msod, m_fsec, m_timeSystem);
+      }
+      catch (InvalidParameter& ip)
+      {
+         GPSTK_RETHROW(ip);
+      }
+      return ct;
+   }
+
+   void FastTime::convertFromCommonTime(const CommonTime& ct)
+   {
+      long day, msod;
+      ct.getInternal(day, msod, m_fsec, m_timeSystem);
+      m_msec = static_cast<long long>(day) * MS_PER_DAY + msod;
+   }
+
+   double FastTime::getSecondOfDay() const
+   {
+      long day, msod;
+      split(day, msod);
+      return static_cast<double>(msod) * SEC_PER_MS + m_fsec;
+   }
+
+   std::string FastTime::asString() const
+   {
+         // no range check, so out of range results can be printed
+      using namespace std;
+      long day, msod;
+      split(day, msod);
+      ostringstream oss;
+      oss << setfill('0')
+          << setw(7) << day  << " "
+          << setw(8) << msod << " "
+          << fixed << setprecision(15) << setw(17) << m_fsec
+          << " " << m_timeSystem.asString();
+      return oss.str();
+   }
+
+   void FastTime::throwSystemMismatch() const
+   {
+      InvalidRequest ir("FastTime objects not in same time system,"
+                        " cannot be compared or differenced");
+      GPSTK_THROW(ir);
+   }
+
+   std::ostream& operator<<(std::ostream& o, const FastTime& ft)
+   {
+      o << ft.asString();
+      return o;
+   }
+
+} // namespace
@@ -0,0 +1,282 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/// @file FastTime.hpp
+/// A time representation for arithmetic in inner loops.
+
+#ifndef GPSTK_FASTTIME_HPP
+#define GPSTK_FASTTIME_HPP
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include "CommonTime.hpp"
+
+namespace gpstk
+{
+      /// @ingroup TimeHandling
+      //@{
+
+      /**
+       * FastTime holds the same instant as a CommonTime, but as a
+       * single integer count of milliseconds since the CommonTime
+       * day 0, plus the fraction of a millisecond in seconds:
+       *
+       *  Quantity   >=     <
+       *  --------   ---   ---
+       *   msec       0    END_LIMIT_JDAY * 86400000
+       *   fsec       0    0.001
+       *
+       * The fraction is exactly CommonTime's fractional second of
+       * day, and the count is day * 86400000 + msod, so conversions
+       * in either direction are lossless.  Because there is no day
+       * field to carry into, adding seconds or differencing two times
+       * is a couple of integer and floating point operations, with
+       * no calls into the library and none of the rounding repair of
+       * CommonTime::normalize().
+       *
+       * Use it where many times are stepped or differenced, e.g. when
+       * generating a grid of epochs or sorting large sets of
+       * observations, and convert to and from CommonTime at the
+       * edges:
+       *
+       * @code
+       * FastTime t(start);                    // start is a CommonTime
+       * for (int i = 0; i < n; i++, t += 30.)
+       *    ...
+       * CommonTime end(t.convertToCommonTime());
+       * @endcode
+       *
+       * FastTime does no range checking on arithmetic;
+       * convertToCommonTime() throws if the result is not
+       * representable.
+       */
+   class FastTime
+   {
+   public:
+         /// Default constructor, the beginning of CommonTime day 0.
+      explicit FastTime(const TimeSystem& timeSystem = TimeSystem::Unknown)
+            : m_msec(0), m_fsec(0.), m_timeSystem(timeSystem)
+      {}
+
+         /// Construct from a CommonTime without loss.
+      FastTime(const CommonTime& ct)
+      { convertFromCommonTime(ct); }
+
+         /** Convert to CommonTime.
+          * @throw InvalidParameter if the time is outside the range of
+          *   CommonTime. */
+      CommonTime convertToCommonTime() const;
+
+         /// Set this object to the instant of \a ct without loss.
+      void convertFromCommonTime(const CommonTime& ct);
+
+         /// @see convertToCommonTime()
+      operator CommonTime() const
+      { return convertToCommonTime(); }
+
+         /// Milliseconds since the start of CommonTime day 0.
+      long long getMilliseconds() const
+      { return m_msec; }
+
+         /// Fraction of the millisecond, in seconds.
+      double getFractionalSeconds() const
+      { return m_fsec; }
+
+         /// Time in days, including the fraction of a day.
+      double getDays() const
+      {
+         return static_cast<double>(m_msec) * DAY_PER_MS +
+            m_fsec * DAY_PER_SEC;
+      }
+
+         /// Seconds of day (ignoring the day).
+      double getSecondOfDay() const;
+
+      TimeSystem getTimeSystem() const
+      { return m_timeSystem; }
+
+      void setTimeSystem(const TimeSystem& timeSystem)
+      { m_timeSystem = timeSystem; }
+
+         /**
+          * @name FastTime Arithmetic Operations
+          * These behave as the CommonTime operations of the same
+          * names.
+          */
+         //@{
+         /** Difference two times.
+          * @return the difference in seconds.
+          * @throw InvalidRequest if the time systems differ and
+          *   neither is TimeSystem::Any. */
+      double operator-(const FastTime& right) const
+      {
+         checkSystem(right);
+         return static_cast<double>(m_msec - right.m_msec) * SEC_PER_MS +
+            (m_fsec - right.m_fsec);
+      }
+
+         /// Add seconds to this time.
+      FastTime& addSeconds(double seconds)
+      {
+         double ms = std::floor(seconds * MS_PER_SEC);
+         m_msec += static_cast<long long>(ms);
+         m_fsec += seconds - ms / MS_PER_SEC;
+         if (m_fsec >= SEC_PER_MS)
+         {
+            m_fsec -= SEC_PER_MS;
+            ++m_msec;
+         }
+         else if (m_fsec < 0.)
+         {
+            m_fsec += SEC_PER_MS;
+            --m_msec;
+               // -1e-20 + 0.001 rounds up to 0.001
+            if (m_fsec >= SEC_PER_MS)
+            {
+               m_fsec = 0.;
+               ++m_msec;
+            }
+         }
+         return *this;
+      }
+
+         /// Add whole seconds to this time.
+      FastTime& addSeconds(long seconds)
+      {
+         m_msec += static_cast<long long>(seconds) * MS_PER_SEC;
+         return *this;
+      }
+
+         /// Add days to this time.
+      FastTime& addDays(long days)
+      {
+         m_msec += static_cast<long long>(days) * MS_PER_DAY;
+         return *this;
+      }
+
+         /// Add milliseconds to this time.
+      FastTime& addMilliseconds(long long msec)
+      {
+         m_msec += msec;
+         return *this;
+      }
+
+      FastTime& operator+=(double seconds)
+      { return addSeconds(seconds); }
+
+      FastTime& operator-=(double seconds)
+      { return addSeconds(-seconds); }
+
+      FastTime operator+(double seconds) const
+      { return FastTime(*this).addSeconds(seconds); }
+
+      FastTime operator-(double seconds) const
+      { return FastTime(*this).addSeconds(-seconds); }
+         //@}
+
+         /**
+          * @name FastTime Comparison Operators
+          * Equality uses the tolerance CommonTime::eps on the
+          * fraction, as CommonTime does.  The ordering operators
+          * throw InvalidRequest if the time systems differ and
+          * neither is TimeSystem::Any.
+          */
+         //@{
+      bool operator==(const FastTime& right) const
+      {
+         if ((m_timeSystem != TimeSystem::Any &&
+              right.m_timeSystem != TimeSystem::Any) &&
+             m_timeSystem != right.m_timeSystem)
+            return false;
+         return (m_msec == right.m_msec &&
+                 std::fabs(m_fsec - right.m_fsec) < CommonTime::eps);
+      }
+
+      bool operator!=(const FastTime& right) const
+      { return !operator==(right); }
+
+      bool operator<(const FastTime& right) const
+      {
+         checkSystem(right);
+         return (m_msec < right.m_msec ||
+                 (m_msec == right.m_msec && m_fsec < right.m_fsec));
+      }
+
+      bool operator>(const FastTime& right) const
+      { return right.operator<(*this); }
+
+      bool operator<=(const FastTime& right) const
+      { return !right.operator<(*this); }
+
+      bool operator>=(const FastTime& right) const
+      { return !operator<(right); }
+         //@}
+
+         /// Same layout as CommonTime::asString().
+      std::string asString() const;
+
+   private:
+         /// Throw InvalidRequest if the time systems are incompatible.
+      void checkSystem(const FastTime& right) const
+      {
+         if ((m_timeSystem != TimeSystem::Any &&
+              right.m_timeSystem != TimeSystem::Any) &&
+             m_timeSystem != right.m_timeSystem)
+            throwSystemMismatch();
+      }
+
+      void throwSystemMismatch() const;
+
+         /// Split the millisecond count into day and millisecond of day.
+      void split(long& day, long& msod) const;
+
+         /// milliseconds since the start of CommonTime day 0
+      long long m_msec;
+         /// fraction of a millisecond, in seconds, in [0, 0.001)
+      double m_fsec;
+      TimeSystem m_timeSystem;
+   }; // end class FastTime
+
+   std::ostream& operator<<(std::ostream& o, const FastTime& ft);
+
+      //@}
+
+} // namespace
+
+#endif // GPSTK_FASTTIME_HPP
@@ -38,6 +38,23 @@
 #include "TimeConstants.hpp"
 #include <math.h>
 
+namespace
+{
+      // The last conversion made in each direction, per thread.
+      // Epochs are usually handled in time order, so converting a
+      // CivilTime or YDSTime to or from CommonTime nearly always
+      // repeats the day of the previous call.
+   struct CalendarEntry
+   {
+      bool valid;
+      long jd;
+      int year, month, day;
+   };
+
+   thread_local CalendarEntry lastJDtoCalendar = { false, 0, 0, 0, 0 };
+   thread_local CalendarEntry lastCalendarToJD = { false, 0, 0, 0, 0 };
+}
+
 namespace gpstk
 {
 
@@ -52,6 +69,15 @@ namespace gpstk
                              int& imonth,
                              int& iday )
    {
+      CalendarEntry& last(lastJDtoCalendar);
+      if(last.valid && last.jd == jd)
+      {
+         iyear = last.year;
+         imonth = last.month;
+         iday = last.day;
+         return;
+      }
+
       long L, M, N, P, Q;
       if(jd > 2299160)    // after Oct 4, 1582
       {
@@ -93,12 +119,25 @@ namespace gpstk
          imonth = 3;
          iday = 1;
       }
+
+      last.valid = true;
+      last.jd = jd;
+      last.year = iyear;
+      last.month = imonth;
+      last.day = iday;
    }
 
    long convertCalendarToJD( int yy,
                              int mm,
                              int dd )
    {
+      CalendarEntry& last(lastCalendarToJD);
+      if(last.valid && last.year == yy && last.month == mm && last.day == dd)
+         return last.jd;
+      last.year = yy;
+      last.month = mm;
+      last.day = dd;
+
       if(yy == 0)
          --yy;         // there is no year 0
 
@@ -141,6 +180,9 @@ namespace gpstk
             --jd;
          }
       }
+
+      last.valid = true;
+      last.jd = jd;
       return jd;
    }
 
@@ -56,6 +56,8 @@ namespace gpstk
        * Algorithm references: Sinnott, R. W. "Bits and Bytes,"
        *  Sky & Telescope Magazine, Vol 82, p. 183, August 1991, and
        *  The Astronomical Almanac, published by the U.S. Naval Observatory.
+       * @note The last result is cached per thread, so repeated
+       *  conversions of the same day cost a comparison.
        */
    void convertJDtoCalendar( long jd,
                              int& iyear,
@@ -74,6 +76,8 @@ namespace gpstk
        * Algorithm references: Sinnott, R. W. "Bits and Bytes,"
        *  Sky & Telescope Magazine, Vol 82, p. 183, August 1991, and
        *  The Astronomical Almanac, published by the U.S. Naval Observatory.
+       * @note The last result is cached per thread, so repeated
+       *  conversions of the same day cost a comparison.
        */
    long convertCalendarToJD( int iyear,
                              int imonth,
@@ -0,0 +1,966 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/// @file TimeFormat.cpp  Precompiled time format for printing and scanning.
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "TimeFormat.hpp"
+
+#include "ANSITime.hpp"
+#include "CivilTime.hpp"
+#include "GPSWeekSecond.hpp"
+#include "BDSWeekSecond.hpp"
+#include "GALWeekSecond.hpp"
+#include "QZSWeekSecond.hpp"
+#include "IRNWeekSecond.hpp"
+#include "GPSWeekZcount.hpp"
+#include "JulianDate.hpp"
+#include "MJD.hpp"
+#include "UnixTime.hpp"
+#include "PosixTime.hpp"
+#include "YDSTime.hpp"
+
+#include "TimeConverters.hpp"
+#include "TimeConstants.hpp"
+
+using namespace std;
+
+namespace
+{
+   using namespace gpstk;
+
+      // TimeTag classes, in the order that printTime() tries them.
+   enum TagBits
+   {
+      ansiBit  = 0x0001,
+      civilBit = 0x0002,
+      gpswsBit = 0x0004,
+      gpswzBit = 0x0008,
+      jdBit    = 0x0010,
+      mjdBit   = 0x0020,
+      unixBit  = 0x0040,
+      posixBit = 0x0080,
+      ydsBit   = 0x0100,
+      galBit   = 0x0200,
+      bdsBit   = 0x0400,
+      qzsBit   = 0x0800,
+      irnBit   = 0x1000
+   };
+
+      // A print identifier, the first class in printTime() order
+      // that prints it, whether it takes a precision, and what
+      // replaces it in the sprintf() conversion.  P is printed the
+      // same by every class, so it needs none of them.
+   struct FieldSpec
+   {
+      char id;
+      unsigned tag;
+      bool isFloat;
+      const char *conv;
+   };
+
+   const FieldSpec fieldSpecs[] =
+   {
+      { 'K', ansiBit,  false, "lu" },
+      { 'P', 0,        false, "s"  },
+      { 'Y', civilBit, false, "d"  },
+      { 'y', civilBit, false, "d"  },
+      { 'm', civilBit, false, "u"  },
+      { 'b', civilBit, false, "s"  },
+      { 'B', civilBit, false, "s"  },
+      { 'd', civilBit, false, "u"  },
+      { 'H', civilBit, false, "u"  },
+      { 'M', civilBit, false, "u"  },
+      { 'S', civilBit, false, "u"  },
+      { 'f', civilBit, true,  "f"  },
+      { 'E', gpswsBit, false, "u"  },
+      { 'F', gpswsBit, false, "u"  },
+      { 'G', gpswsBit, false, "u"  },
+      { 'w', gpswsBit, false, "u"  },
+      { 'g', gpswsBit, true,  "f"  },
+      { 'z', gpswzBit, false, "u"  },
+      { 'Z', gpswzBit, false, "u"  },
+      { 'c', gpswzBit, false, "u"  },
+      { 'C', gpswzBit, false, "u"  },
+      { 'J', jdBit,    true,  "Lf" },
+      { 'Q', mjdBit,   true,  "Lf" },
+      { 'U', unixBit,  false, "lu" },
+      { 'u', unixBit,  false, "lu" },
+      { 'W', posixBit, false, "lu" },
+      { 'N', posixBit, false, "lu" },
+      { 'j', ydsBit,   false, "u"  },
+      { 's', ydsBit,   true,  "f"  },
+      { 'T', galBit,   false, "u"  },
+      { 'L', galBit,   false, "u"  },
+      { 'l', galBit,   false, "u"  },
+      { 'R', bdsBit,   false, "u"  },
+      { 'D', bdsBit,   false, "u"  },
+      { 'e', bdsBit,   false, "u"  },
+      { 'V', qzsBit,   false, "u"  },
+      { 'h', qzsBit,   false, "u"  },
+      { 'i', qzsBit,   false, "u"  },
+      { 'X', irnBit,   false, "u"  },
+      { 'O', irnBit,   false, "u"  },
+      { 'o', irnBit,   false, "u"  }
+   };
+
+   const FieldSpec* findSpec(char id)
+   {
+      for (size_t i = 0; i < sizeof(fieldSpecs)/sizeof(fieldSpecs[0]); i++)
+         if (fieldSpecs[i].id == id)
+            return &fieldSpecs[i];
+      return 0;
+   }
+
+      // Identifiers of the CivilTime scan fast path, in the order of
+      // TimeFormat::civilIndex.
+   const char civilIds[] = "YmdHMSfP";
+
+      // The time in each of the TimeTag classes.
+   struct Tags
+   {
+      ANSITime ansi;
+      CivilTime civil;
+      GPSWeekSecond gpsws;
+      GPSWeekZcount gpswz;
+      JulianDate jd;
+      MJD mjd;
+      UnixTime unixTime;
+      PosixTime posix;
+      YDSTime yds;
+      GALWeekSecond gal;
+      BDSWeekSecond bds;
+      QZSWeekSecond qzs;
+      IRNWeekSecond irn;
+
+         // Convert t to the classes in needed.  Return false if
+         // one of them can't represent t, in which case printTime()
+         // would give the field to another class.
+      bool convert(const CommonTime& t, unsigned needed)
+      {
+         try
+         {
+            if (needed & ansiBit)  ansi.convertFromCommonTime(t);
+            if (needed & civilBit) civil.convertFromCommonTime(t);
+            if (needed & gpswsBit) gpsws.convertFromCommonTime(t);
+            if (needed & gpswzBit) gpswz.convertFromCommonTime(t);
+            if (needed & jdBit)    jd.convertFromCommonTime(t);
+            if (needed & mjdBit)   mjd.convertFromCommonTime(t);
+            if (needed & unixBit)  unixTime.convertFromCommonTime(t);
+            if (needed & posixBit) posix.convertFromCommonTime(t);
+            if (needed & ydsBit)   yds.convertFromCommonTime(t);
+            if (needed & galBit)   gal.convertFromCommonTime(t);
+            if (needed & bdsBit)   bds.convertFromCommonTime(t);
+            if (needed & qzsBit)   qzs.convertFromCommonTime(t);
+            if (needed & irnBit)   irn.convertFromCommonTime(t);
+         }
+         catch (InvalidRequest& ir)
+         {
+            return false;
+         }
+         return true;
+      }
+
+         // sprintf() field id with conversion spec into buf, passing
+         // the same value and type as the TimeTag printf() does.
+      int print(char *buf, char id, const char *spec,
+                const CommonTime& t) const
+      {
+         switch (id)
+         {
+            case 'K': return sprintf(buf, spec, ansi.time);
+            case 'P':
+               return sprintf(buf, spec, t.getTimeSystem().asString().c_str());
+            case 'Y': return sprintf(buf, spec, civil.year);
+            case 'y':
+               return sprintf(buf, spec, static_cast<short>(civil.year % 100));
+            case 'm': return sprintf(buf, spec, civil.month);
+            case 'b':
+               return sprintf(buf, spec,
+                              CivilTime::MonthAbbrevNames[civil.month]);
+            case 'B':
+               return sprintf(buf, spec, CivilTime::MonthNames[civil.month]);
+            case 'd': return sprintf(buf, spec, civil.day);
+            case 'H': return sprintf(buf, spec, civil.hour);
+            case 'M': return sprintf(buf, spec, civil.minute);
+            case 'S':
+               return sprintf(buf, spec, static_cast<short>(civil.second));
+            case 'f': return sprintf(buf, spec, civil.second);
+            case 'E': return sprintf(buf, spec, gpsws.getEpoch());
+            case 'F': return sprintf(buf, spec, gpsws.week);
+            case 'G': return sprintf(buf, spec, gpsws.getModWeek());
+            case 'w': return sprintf(buf, spec, gpsws.getDayOfWeek());
+            case 'g': return sprintf(buf, spec, gpsws.sow);
+            case 'z':
+            case 'Z': return sprintf(buf, spec, gpswz.zcount);
+            case 'c': return sprintf(buf, spec, gpswz.getZcount29());
+            case 'C': return sprintf(buf, spec, gpswz.getZcount32());
+            case 'J': return sprintf(buf, spec, jd.jd);
+            case 'Q': return sprintf(buf, spec, mjd.mjd);
+            case 'U': return sprintf(buf, spec, unixTime.tv.tv_sec);
+            case 'u': return sprintf(buf, spec, unixTime.tv.tv_usec);
+            case 'W': return sprintf(buf, spec, posix.ts.tv_sec);
+            case 'N': return sprintf(buf, spec, posix.ts.tv_nsec);
+            case 'j': return sprintf(buf, spec, yds.doy);
+            case 's': return sprintf(buf, spec, yds.sod);
+            case 'T': return sprintf(buf, spec, gal.getEpoch());
+            case 'L': return sprintf(buf, spec, gal.week);
+            case 'l': return sprintf(buf, spec, gal.getModWeek());
+            case 'R': return sprintf(buf, spec, bds.getEpoch());
+            case 'D': return sprintf(buf, spec, bds.week);
+            case 'e': return sprintf(buf, spec, bds.getModWeek());
+            case 'V': return sprintf(buf, spec, qzs.getEpoch());
+            case 'h': return sprintf(buf, spec, qzs.week);
+            case 'i': return sprintf(buf, spec, qzs.getModWeek());
+            case 'X': return sprintf(buf, spec, irn.getEpoch());
+            case 'O': return sprintf(buf, spec, irn.week);
+            case 'o': return sprintf(buf, spec, irn.getModWeek());
+         }
+         return 0;
+      }
+   };
+
+      // Append n characters of s to buf, keeping room for the
+      // terminating 0.  len counts everything, written or not.
+   inline void append(char *buf, string::size_type size,
+                      string::size_type& len, const char *s,
+                      string::size_type n)
+   {
+      if (len + 1 < size)
+         memcpy(buf + len, s, min(n, size - 1 - len));
+      len += n;
+   }
+
+      // Per-thread cache of compiled formats, direct mapped on a hash
+      // of the format.  Must be a power of 2.
+   const size_t cacheSize = 16;
+
+   struct CacheEntry
+   {
+      CacheEntry() : valid(false) {}
+      bool valid;
+      TimeFormat tf;
+   };
+
+   thread_local CacheEntry formatCache[cacheSize];
+}
+
+namespace gpstk
+{
+   TimeFormat ::
+   TimeFormat()
+         : needed(0), civilScan(false)
+   {
+      for (int i = 0; i < 8; i++)
+         civilIndex[i] = -1;
+   }
+
+
+   TimeFormat ::
+   TimeFormat(const std::string& fmt)
+   {
+      setFormat(fmt);
+   }
+
+
+   void TimeFormat ::
+   setFormat(const std::string& fmt)
+   {
+      format = fmt;
+      printFields.clear();
+      scanFields.clear();
+      needed = 0;
+
+         // Print fields.  The TimeTag printf() functions replace
+         // matches of getFormatPrefixInt() or getFormatPrefixFloat()
+         // followed by an identifier; anything else is left as is.
+      string::size_type n = fmt.size(), i = 0;
+      PrintField lit;
+      lit.id = 0;
+      while (i < n)
+      {
+         if (fmt[i] == '%')
+         {
+            string::size_type j = i + 1;
+            if ((j < n) && (fmt[j] == ' ' || fmt[j] == '0' || fmt[j] == '-'))
+               j++;
+            while ((j < n) && isdigit(fmt[j]))
+               j++;
+            bool precision = false;
+            if ((j + 1 < n) && (fmt[j] == '.') && isdigit(fmt[j+1]))
+            {
+               precision = true;
+               for (j++; (j < n) && isdigit(fmt[j]); j++)
+                  ;
+            }
+            const FieldSpec *spec = (j < n) ? findSpec(fmt[j]) : 0;
+            if (spec && (spec->isFloat || !precision))
+            {
+               if (!lit.text.empty())
+               {
+                  printFields.push_back(lit);
+                  lit.text.clear();
+               }
+               PrintField pf;
+               pf.id = spec->id;
+               pf.text = fmt.substr(i, j - i) + spec->conv;
+               printFields.push_back(pf);
+               needed |= spec->tag;
+               i = j + 1;
+               continue;
+            }
+         }
+         lit.text += fmt[i++];
+      }
+      if (!lit.text.empty())
+         printFields.push_back(lit);
+
+         // Scan fields, following the steps of TimeTag::getInfo()
+         // that depend only on the format.
+      string f(fmt);
+      while (!f.empty())
+      {
+         ScanField sf;
+         sf.id = 0;
+         sf.width = 0;
+         sf.delimiter = 0;
+         sf.skip = f.find('%');
+         if (sf.skip == string::npos)
+         {
+            sf.skip = f.size();
+            sf.end = endOfFormat;
+            scanFields.push_back(sf);
+            break;
+         }
+         f.erase(0, sf.skip + 1);
+         if (f.empty() || !isalpha(f[0]))
+         {
+            sf.width = static_cast<string::size_type>(StringUtils::asInt(f));
+            while (!f.empty() && !isalpha(f[0]))
+               f.erase(0, 1);
+            if (f.empty())
+            {
+               sf.end = endIgnored;
+               scanFields.push_back(sf);
+               break;
+            }
+            sf.end = endWidth;
+         }
+         else if (f.size() > 1)
+         {
+            if (f[1] != '%')
+            {
+               sf.end = endDelimiter;
+               sf.delimiter = f[1];
+            }
+            else
+               sf.end = endOneChar;
+         }
+         else
+            sf.end = endOfString;
+         sf.id = f[0];
+         f.erase(0, (sf.end == endDelimiter) ? 2 : 1);
+         scanFields.push_back(sf);
+      }
+
+         // Can CivilTime be set directly from the fields?
+      for (int k = 0; k < 8; k++)
+         civilIndex[k] = -1;
+      civilScan = (scanFields.size() <= maxFields);
+      for (size_t k = 0; civilScan && (k < scanFields.size()); k++)
+      {
+         if (scanFields[k].id == 0)
+            continue;
+         const char *c = strchr(civilIds, scanFields[k].id);
+         if (c == 0)
+            civilScan = false;
+         else
+            civilIndex[c - civilIds] = k;
+      }
+      civilScan = civilScan && (civilIndex[0] >= 0) &&
+         (civilIndex[1] >= 0) && (civilIndex[2] >= 0);
+   }
+
+
+   std::string::size_type TimeFormat ::
+   print(char *buf, std::string::size_type size, const CommonTime& t) const
+   {
+      string::size_type len = 0;
+      Tags tags;
+      if (!tags.convert(t, needed))
+      {
+         string s(printEach(t, format));
+         append(buf, size, len, s.data(), s.size());
+      }
+      else
+      {
+            // the same size as the buffer of StringUtils::formattedPrint()
+         char field[513];
+         for (size_t i = 0; i < printFields.size(); i++)
+         {
+            const PrintField& pf(printFields[i]);
+            if (pf.id == 0)
+            {
+               append(buf, size, len, pf.text.data(), pf.text.size());
+               continue;
+            }
+            int n = tags.print(field, pf.id, pf.text.c_str(), t);
+            if (n > 0)
+               append(buf, size, len, field, n);
+         }
+      }
+      if (size > 0)
+         buf[min(len, size - 1)] = 0;
+      return len;
+   }
+
+
+   std::string TimeFormat ::
+   print(const CommonTime& t) const
+   {
+      char buf[256];
+      string::size_type len = print(buf, sizeof(buf), t);
+      if (len < sizeof(buf))
+         return string(buf, len);
+      vector<char> big(len + 1);
+      print(&big[0], big.size(), t);
+      return string(&big[0], len);
+   }
+
+
+   std::string::size_type TimeFormat ::
+   split(const std::string& str, Value *values) const
+   {
+      string::size_type n = str.size(), p = 0, count = 0;
+      for (size_t k = 0; k < scanFields.size(); k++)
+      {
+         const ScanField& sf(scanFields[k]);
+         values[k].pos = values[k].len = 0;
+            // getInfo() stops with format left over when the string
+            // runs out
+         if (p == n)
+            break;
+         string::size_type skip = min(sf.skip, n - p);
+         p += skip;
+         if (skip < sf.skip)
+            break;
+         if (sf.end == endOfFormat)
+            return count;
+         if (p == n)
+            break;
+         if (sf.end == endIgnored)
+            return count;
+
+         string::size_type len = string::npos;
+         switch (sf.end)
+         {
+            case endWidth:
+               len = sf.width;
+               break;
+            case endOneChar:
+               len = 1;
+               break;
+            case endDelimiter:
+               while ((p < n) && (str[p] == ' '))
+                  p++;
+               len = str.find(sf.delimiter, p);
+               if (len != string::npos)
+                  len -= p;
+               break;
+            default:
+               break;
+         }
+         len = min(len, n - p);
+         values[k].pos = p;
+         values[k].len = len;
+         count++;
+         p += len;
+         if ((sf.end == endDelimiter) && (p < n))
+            p++;
+         if (k + 1 == scanFields.size())
+            return count;
+      }
+      if (scanFields.empty())
+         return count;
+      StringUtils::StringException exc("Failed to process time string");
+      GPSTK_THROW(exc);
+   }
+
+
+   void TimeFormat ::
+   getInfo(const std::string& str, TimeTag::IdToValue& info) const
+   {
+      if (scanFields.size() <= maxFields)
+      {
+         Value values[maxFields];
+         split(str, values);
+         for (size_t k = 0; k < scanFields.size(); k++)
+         {
+            if (scanFields[k].id != 0)
+               info[scanFields[k].id] = str.substr(values[k].pos,
+                                                   values[k].len);
+         }
+      }
+      else
+         TimeTag::getInfo(str, format, info);
+   }
+
+
+   void TimeFormat ::
+   scanCivil(CommonTime& t, const std::string& str) const
+   {
+      Value values[maxFields];
+      split(str, values);
+      const char *s = str.data();
+      CivilTime tt;
+      for (int k = 0; k < 8; k++)
+      {
+         if (civilIndex[k] < 0)
+            continue;
+         const Value& v(values[civilIndex[k]]);
+         switch (civilIds[k])
+         {
+            case 'Y': tt.year = StringUtils::asInt(s + v.pos, v.len); break;
+            case 'm': tt.month = StringUtils::asInt(s + v.pos, v.len); break;
+            case 'd': tt.day = StringUtils::asInt(s + v.pos, v.len); break;
+            case 'H': tt.hour = StringUtils::asInt(s + v.pos, v.len); break;
+            case 'M': tt.minute = StringUtils::asInt(s + v.pos, v.len); break;
+            case 'S':
+               if (civilIndex[6] < 0)
+                  tt.second = floor(StringUtils::asDouble(s + v.pos, v.len));
+               break;
+            case 'f':
+               tt.second = StringUtils::asDouble(s + v.pos, v.len);
+               break;
+            case 'P':
+               {
+                  TimeSystem ts;
+                  ts.fromString(str.substr(v.pos, v.len));
+                  tt.setTimeSystem(ts);
+                  t.setTimeSystem(ts);
+               }
+               break;
+         }
+      }
+      t = tt.convertToCommonTime();
+   }
+
+
+   void TimeFormat ::
+   scan(CommonTime& t, const std::string& str) const
+   {
+      if (civilScan)
+      {
+         scanCivil(t, str);
+         return;
+      }
+      TimeTag::IdToValue info;
+      getInfo(str, info);
+      scanInfo(t, info);
+   }
+
+
+   void TimeFormat ::
+   scan(TimeTag& btime, const std::string& str) const
+   {
+      TimeTag::IdToValue info;
+      getInfo(str, info);
+      if (btime.setFromInfo(info))
+         return;
+
+         // Convert to CommonTime, and try to set using all formats.
+      CommonTime ct(btime.convertToCommonTime());
+      scanInfo(ct, info);
+
+         // Convert the CommonTime into the requested format.
+      btime.convertFromCommonTime(ct);
+   }
+
+
+   const TimeFormat& TimeFormat ::
+   get(const std::string& fmt)
+   {
+         // FNV-1a
+      unsigned long h = 2166136261UL;
+      for (string::size_type i = 0; i < fmt.size(); i++)
+         h = (h ^ static_cast<unsigned char>(fmt[i])) * 16777619UL;
+      CacheEntry& entry(formatCache[h & (cacheSize - 1)]);
+      if (!entry.valid || (entry.tf.format != fmt))
+      {
+         entry.valid = false;
+         entry.tf.setFormat(fmt);
+         entry.valid = true;
+      }
+      return entry.tf;
+   }
+
+
+   std::string TimeFormat ::
+   printEach(const CommonTime& t, const std::string& fmt)
+   {
+      try
+      {
+         string rv( fmt );
+         try {rv = ANSITime(t).printf( rv );} catch (gpstk::InvalidRequest e){};
+         try {rv = CivilTime(t).printf( rv );} catch (gpstk::InvalidRequest e){};
+         try {rv = GPSWeekSecond(t).printf( rv );} catch (gpstk::InvalidRequest e){};
+         try {rv = GPSWeekZcount(t).printf( rv );} catch (gpstk::InvalidRequest e){};
+         try {rv = JulianDate(t).printf( rv );} catch (gpstk::InvalidRequest e){};
+         try {rv = MJD(t).printf( rv );} catch (gpstk::InvalidRequest e){};
+         try {rv = UnixTime(t).printf( rv );} catch (gpstk::InvalidRequest e){};
+         try {rv = PosixTime(t).printf( rv );} catch (gpstk::InvalidRequest e){};
+         try {rv = YDSTime(t).printf( rv );} catch (gpstk::InvalidRequest e){};
+         try {rv = GALWeekSecond(t).printf( rv );} catch (gpstk::InvalidRequest e){};
+         try {rv = BDSWeekSecond(t).printf( rv );} catch (gpstk::InvalidRequest e){};
+         try {rv = QZSWeekSecond(t).printf( rv );} catch (gpstk::InvalidRequest e){};
+         try {rv = IRNWeekSecond(t).printf( rv );} catch (gpstk::InvalidRequest e){};
+         return rv;
+      }
+      catch( gpstk::StringUtils::StringException& se )
+      {
+         GPSTK_RETHROW( se );
+      }
+   }
+
+
+   void TimeFormat ::
+   scanInfo(CommonTime& t, TimeTag::IdToValue& info)
+   {
+      try
+      {
+         using namespace gpstk::StringUtils;
+
+            // These indicate which information has been found.
+         bool hmjd( false ), hsow( false ), hweek( false ), hfullweek( false ),
+            hdow( false ), hyear( false ), hmonth( false ), hday( false ),
+            hzcount( false ), hdoy( false ), hzcount29( false ), 
+            hzcount32( false ), hhour( false ), hmin( false ), hsec( false ),
+            hsod( false ), hunixsec( false ), hunixusec( false ), 
+            hepoch( false ), hansi( false ), hjulian( false ),
+            hbdsw( false ), hqzsw( false ), hgalw( false ), hirnw( false ),
+            hbdsfw( false ), hqzsfw( false ), hgalfw( false ), hirnfw( false ),
+            hbdse( false ), hqzse( false ), hgale( false), hirne( false ),
+            hposixsec( false ), hposixnsec( false );
+
+            // These are to hold data that no one parses.
+         int idow(0);
+         TimeSystem ts;
+
+         for( TimeTag::IdToValue::iterator itr = info.begin();
+              itr != info.end(); itr++ )
+         {
+            switch( itr->first )
+            {
+               case 'P':
+                  ts.fromString(itr->second);
+                  t.setTimeSystem(ts);
+                  break;
+
+               case 'Q':
+                  hmjd = true;
+                  break;
+
+               case 'Z':
+               case 'z':
+                  hzcount = true;
+                  break;
+
+               case 's':
+                  hsod = true;
+                  break;
+
+               case 'g':
+                  hsow = true;
+                  break;
+
+               case 'w':
+                  idow = asInt( itr->second );
+                  hdow = true;
+                  break;
+
+               case 'G':
+                  hweek = true;
+                  break;
+
+               case 'F':
+                  hfullweek = true;
+                  break;
+
+               case 'j':
+                  hdoy = true;
+                  break;
+
+               case 'b':
+               case 'B':
+                  hmonth = true;
+                  break;
+
+               case 'Y':
+               case 'y':
+                  hyear = true;
+                  break;
+
+               case 'a':
+               case 'A':
+                  {
+                     hdow = true;
+                     string thisDay = firstWord( itr->second );
+                     lowerCase(thisDay);
+                     if (isLike(thisDay, "sun.*")) idow = 0;
+                     else if (isLike(thisDay, "mon.*")) idow = 1;
+                     else if (isLike(thisDay, "tue.*")) idow = 2;
+                     else if (isLike(thisDay, "wed.*")) idow = 3;
+                     else if (isLike(thisDay, "thu.*")) idow = 4;
+                     else if (isLike(thisDay, "fri.*")) idow = 5;
+                     else if (isLike(thisDay, "sat.*")) idow = 6;
+                     else
+                     {
+                        hdow = false;
+                     }
+                  }
+                  break;
+                  
+               case 'm':
+                  hmonth = true;
+                  break;
+
+               case 'd':
+                  hday = true;
+                  break;
+
+               case 'H':
+                  hhour = true;
+                  break;
+
+               case 'M':
+                  hmin = true;
+                  break;
+
+               case 'S':
+                  hsec = true;
+                  break;
+
+               case 'f':
+                  hsec = true;
+                  // a small hack to make fractional seconds work
+                  info['S'] = info['f'];
+                  break;
+
+               case 'U':
+                  hunixsec = true;
+                  break;
+
+               case 'u':
+                  hunixusec = true;
+                  break;
+
+               case 'W':
+                  hposixsec = true;
+                  break;
+
+               case 'N':
+                  hposixnsec = true;
+                  break;
+                  
+               case 'c':
+                  hzcount29 = true;
+                  break;
+
+               case 'C':
+                  hzcount32 = true;
+                  break;
+
+               case 'J':
+                  hjulian = true;
+                  break;
+                  
+               case 'K':
+                  hansi = true;
+                  break;
+                  
+               case 'E':
+                  hepoch = true;
+                  break;
+
+               case 'R': hepoch = hbdse = true; break;
+               case 'T': hepoch = hgale = true; break;
+               case 'V': hepoch = hqzse = true; break;
+               case 'X': hepoch = hirne = true; break;
+
+               case 'D': hfullweek = hbdsfw = true; break;
+               case 'e': hweek = hbdsw = true; break;
+               case 'L': hfullweek = hgalfw = true; break;
+               case 'l': hweek = hgalw = true; break;
+               case 'h': hfullweek = hqzsfw = true; break;
+               case 'i': hweek = hqzsw = true; break;
+               case 'O': hfullweek = hirnfw = true; break;
+               case 'o': hweek = hirnw = true; break;
+
+
+               default:
+                  {
+                     // do nothing
+                  }
+                  break;
+
+            };
+         }     // end loop over Id/Value pairs
+
+         if( hyear )
+         {
+            if( hmonth && hday )
+            {
+               CivilTime tt;
+               tt.setFromInfo( info );
+               if( hsod )
+               {
+                  convertSODtoTime( asDouble( info['s'] ), 
+                                    tt.hour, tt.minute, tt.second );
+               }
+               t = tt.convertToCommonTime();
+               return;
+            }
+            else  // use YDSTime as default
+            {
+               YDSTime tt;
+               tt.setFromInfo( info );
+               if( hhour && hmin && hsec )
+               {
+                  tt.sod = convertTimeToSOD( asInt( info['H'] ), 
+                                             asInt( info['M'] ), 
+                                             asDouble( info['S'] ) );
+               }
+               t = tt.convertToCommonTime();
+               return;
+            }
+
+         } // end of if( hyear )
+
+         if( hzcount32 ||
+             (hfullweek && (hzcount || hzcount29)) ||
+             (hepoch && (hzcount29 || 
+                         (hweek && hzcount))) )
+         {
+            GPSWeekZcount tt;
+            tt.setFromInfo( info );
+            t = tt.convertToCommonTime();
+            return;
+         }
+
+         if ( (hepoch && hweek) || hfullweek )
+         {
+            WeekSecond* ptt;
+            if(hbdse || hbdsfw || hbdsw) ptt = new BDSWeekSecond();
+            else if(hqzse || hqzsfw || hqzsw) ptt = new QZSWeekSecond();
+            else if(hgale || hgalfw || hgalw) ptt = new GALWeekSecond();
+            else if(hirne || hirnfw || hirnw) ptt = new IRNWeekSecond();
+            else ptt = new GPSWeekSecond();
+            ptt->setFromInfo(info);
+            if( hdow && !hsow )
+            {
+               ptt->sow = asInt( info['w'] ) * SEC_PER_DAY;
+               if( hsod )
+               {
+                  ptt->sow += asDouble( info['s'] );
+               }
+               else if( hhour && hmin && hsec )
+               {
+                  ptt->sow += convertTimeToSOD( asInt( info['H'] ), 
+                                              asInt( info['M'] ), 
+                                              asDouble( info['S'] ) );
+               }
+            }
+
+            t = ptt->convertToCommonTime();
+            delete ptt;
+            return;
+         }
+
+         if( hmjd )
+         {
+            MJD tt;
+            tt.setFromInfo( info );
+            t = tt.convertToCommonTime();
+            return;
+         }
+
+         if( hjulian )
+         {
+            JulianDate tt;
+            tt.setFromInfo( info );
+            t = tt.convertToCommonTime();
+            return;
+         }
+
+         if( hansi )
+         {
+            ANSITime tt;
+            tt.setFromInfo( info );
+            t = tt.convertToCommonTime();
+            return;
+         } 
+         
+         if( hunixsec || hunixusec )
+         {
+            UnixTime tt;
+            tt.setFromInfo( info );
+            t = tt.convertToCommonTime();
+            return;
+         }
+
+         if( hposixsec || hposixnsec )
+         {
+            PosixTime tt;
+            tt.setFromInfo( info );
+            t = tt.convertToCommonTime();
+            return;
+         }
+
+         InvalidRequest ir("Incomplete time specification for readTime");
+         GPSTK_THROW( ir );
+      }
+      catch( gpstk::StringUtils::StringException& se )
+      {
+         GPSTK_RETHROW( se );
+      }
+   }
+
+} // namespace
@@ -0,0 +1,210 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/// @file TimeFormat.hpp  Precompiled time format for printing and scanning.
+
+#ifndef GPSTK_TIMEFORMAT_HPP
+#define GPSTK_TIMEFORMAT_HPP
+
+#include <string>
+#include <vector>
+
+#include "TimeTag.hpp"
+#include "CommonTime.hpp"
+
+namespace gpstk
+{
+      /// @ingroup TimeHandling
+      //@{
+
+      /**
+       * A time format string, parsed once, for printTime() and
+       * scanTime() style conversions of many times.
+       *
+       * printTime() hands the whole format to the printf() of every
+       * TimeTag class in turn, and each of those runs a regular
+       * expression search for each of its identifiers.  A TimeFormat
+       * instead splits the format into literal text and fields when
+       * it is constructed, notes which TimeTag classes the fields
+       * belong to, and then prints a time by converting it to just
+       * those classes and formatting each field into a caller
+       * supplied buffer.  The identifiers, their flags and widths, and
+       * the output are the same as for printTime(); see
+       * TimeString.hpp for the list.
+       *
+       * Scanning likewise precomputes how getInfo() splits a string
+       * into fields.  Formats made of the CivilTime fields %Y %m %d
+       * %H %M %S %f and %P are parsed straight into a CivilTime;
+       * other formats go through the same logic as scanTime().
+       *
+       * printTime() and scanTime() use a small per-thread cache of
+       * TimeFormat objects, so a caller that uses the same few formats
+       * gets the benefit without changes.
+       *
+       * @code
+       * TimeFormat tf("%04Y/%02m/%02d %02H:%02M:%06.3f %P");
+       * char buf[64];
+       * tf.print(buf, sizeof(buf), t);
+       * @endcode
+       */
+   class TimeFormat
+   {
+   public:
+         /// Empty format; prints nothing.
+      TimeFormat();
+
+         /// Parse the format \a fmt.
+      explicit TimeFormat(const std::string& fmt);
+
+         /// Replace the format with \a fmt.
+      void setFormat(const std::string& fmt);
+
+      const std::string& getFormat() const
+      { return format; }
+
+         /**
+          * Print \a t into \a buf, as printTime(t, getFormat()) would.
+          * No memory is allocated unless one of the TimeTag
+          * conversions fails and the printTime() path must be used.
+          * @param[out] buf the output, always terminated with a 0
+          *   if \a size > 0 and truncated to fit.
+          * @param[in] size size of \a buf.
+          * @param[in] t the time to print.
+          * @return the length of the complete output, not counting
+          *   the terminating 0, like snprintf().
+          */
+      std::string::size_type print(char *buf, std::string::size_type size,
+                                   const CommonTime& t) const;
+
+         /// Return \a t printed as printTime(t, getFormat()) would.
+      std::string print(const CommonTime& t) const;
+
+         /**
+          * Set \a t from \a str as scanTime(t, str, getFormat()) would.
+          * @throw StringException if \a str does not match the format.
+          * @throw InvalidRequest if the time specification is
+          *   incomplete or invalid.
+          */
+      void scan(CommonTime& t, const std::string& str) const;
+
+         /// Set \a btime from \a str as scanTime(btime, str, getFormat())
+         /// would.
+      void scan(TimeTag& btime, const std::string& str) const;
+
+         /**
+          * Return the TimeFormat for \a fmt from the cache of the
+          * calling thread, parsing \a fmt if it isn't there.  The
+          * reference is only good until the next call.
+          */
+      static const TimeFormat& get(const std::string& fmt);
+
+   private:
+         /// One piece of the format for printing.
+      struct PrintField
+      {
+            /// identifier, or 0 for literal text
+         char id;
+            /// the literal text, or the sprintf() conversion of the field
+         std::string text;
+      };
+
+         /// How a scanned field ends, as decided by TimeTag::getInfo().
+      enum FieldEnd
+      {
+         endOfFormat,   ///< no field, only text to skip
+         endIgnored,    ///< format ends in a width with no identifier
+         endWidth,      ///< fixed width
+         endDelimiter,  ///< up to the delimiter character
+         endOneChar,    ///< followed by another field, one character
+         endOfString    ///< last field, the rest of the string
+      };
+
+         /// One field of the format for scanning.
+      struct ScanField
+      {
+            /// characters of the string skipped before the field
+         std::string::size_type skip;
+         FieldEnd end;
+         char id;
+         std::string::size_type width;
+         char delimiter;
+      };
+
+         /// Start and length of one scanned value.
+      struct Value
+      {
+         std::string::size_type pos, len;
+      };
+
+         /// Fill \a values with the field positions in \a str.
+         /// @return the number of fields found.
+      std::string::size_type split(const std::string& str, Value *values)
+         const;
+
+         /// Scan using the CivilTime fast path.
+      void scanCivil(CommonTime& t, const std::string& str) const;
+
+         /// Build the map of identifier to value that getInfo() makes.
+      void getInfo(const std::string& str, TimeTag::IdToValue& info) const;
+
+         /// printTime() done by the printf() of each TimeTag.
+      static std::string printEach(const CommonTime& t,
+                                   const std::string& fmt);
+
+         /// The part of scanTime() that picks a TimeTag from the fields.
+      static void scanInfo(CommonTime& t, TimeTag::IdToValue& info);
+
+         /// Most fields in a format for the fixed size scan buffers.
+      static const std::string::size_type maxFields = 32;
+
+      std::string format;
+      std::vector<PrintField> printFields;
+         /// TimeTag classes used by printFields, bits of TagBits
+      unsigned needed;
+      std::vector<ScanField> scanFields;
+         /// True if the CivilTime fast path can be used.
+      bool civilScan;
+         /// Index in scanFields of the last field with each identifier
+         /// used by the CivilTime fast path, or -1.
+      int civilIndex[8];
+   }; // class TimeFormat
+
+      //@}
+
+} // namespace
+
+#endif // GPSTK_TIMEFORMAT_HPP
@@ -37,6 +37,7 @@
 /// @file TimeString.cpp  print and scan using all TimeTag derived classes.
 
 #include "TimeString.hpp"
+#include "TimeFormat.hpp"
 
 #include "ANSITime.hpp"
 #include "CivilTime.hpp"
@@ -64,21 +65,7 @@ namespace gpstk
    {
       try
       {
-         string rv( fmt );
-         try {rv = ANSITime(t).printf( rv );} catch (gpstk::InvalidRequest e){};
-         try {rv = CivilTime(t).printf( rv );} catch (gpstk::InvalidRequest e){};
-         try {rv = GPSWeekSecond(t).printf( rv );} catch (gpstk::InvalidRequest e){};
-         try {rv = GPSWeekZcount(t).printf( rv );} catch (gpstk::InvalidRequest e){};
-         try {rv = JulianDate(t).printf( rv );} catch (gpstk::InvalidRequest e){};
-         try {rv = MJD(t).printf( rv );} catch (gpstk::InvalidRequest e){};
-         try {rv = UnixTime(t).printf( rv );} catch (gpstk::InvalidRequest e){};
-         try {rv = PosixTime(t).printf( rv );} catch (gpstk::InvalidRequest e){};
-         try {rv = YDSTime(t).printf( rv );} catch (gpstk::InvalidRequest e){};
-         try {rv = GALWeekSecond(t).printf( rv );} catch (gpstk::InvalidRequest e){};
-         try {rv = BDSWeekSecond(t).printf( rv );} catch (gpstk::InvalidRequest e){};
-         try {rv = QZSWeekSecond(t).printf( rv );} catch (gpstk::InvalidRequest e){};
-         try {rv = IRNWeekSecond(t).printf( rv );} catch (gpstk::InvalidRequest e){};
-         return rv;
+         return TimeFormat::get( fmt ).print( t );
       }
       catch( gpstk::StringUtils::StringException& se )
       {
@@ -94,21 +81,7 @@ namespace gpstk
    {
       try
       {
-            // Get the mapping of character (from fmt) to value (from str).
-         TimeTag::IdToValue info;
-         TimeTag::getInfo( str, fmt, info );
-         
-         if( btime.setFromInfo( info ) )
-         {
-            return;
-         }
-         
-            // Convert to CommonTime, and try to set using all formats.
-         CommonTime ct( btime.convertToCommonTime() );
-         scanTime( ct, str, fmt );
-
-            // Convert the CommonTime into the requested format.
-         btime.convertFromCommonTime( ct );
+         TimeFormat::get( fmt ).scan( btime, str );
       }
       catch( gpstk::InvalidRequest& ir )
       {
@@ -126,300 +99,7 @@ namespace gpstk
    {
       try
       {
-         using namespace gpstk::StringUtils;
-
-            // Get the mapping of character (from fmt) to value (from str).
-         TimeTag::IdToValue info;
-         TimeTag::getInfo( str, fmt, info );
-         
-            // These indicate which information has been found.
-         bool hmjd( false ), hsow( false ), hweek( false ), hfullweek( false ),
-            hdow( false ), hyear( false ), hmonth( false ), hday( false ),
-            hzcount( false ), hdoy( false ), hzcount29( false ), 
-            hzcount32( false ), hhour( false ), hmin( false ), hsec( false ),
-            hsod( false ), hunixsec( false ), hunixusec( false ), 
-            hepoch( false ), hansi( false ), hjulian( false ),
-            hbdsw( false ), hqzsw( false ), hgalw( false ), hirnw( false ),
-            hbdsfw( false ), hqzsfw( false ), hgalfw( false ), hirnfw( false ),
-            hbdse( false ), hqzse( false ), hgale( false), hirne( false ),
-            hposixsec( false ), hposixnsec( false );
-
-            // These are to hold data that no one parses.
-         int idow(0);
-         TimeSystem ts;
-
-         for( TimeTag::IdToValue::iterator itr = info.begin();
-              itr != info.end(); itr++ )
-         {
-            switch( itr->first )
-            {
-               case 'P':
-                  ts.fromString(itr->second);
-                  t.setTimeSystem(ts);
-                  break;
-
-               case 'Q':
-                  hmjd = true;
-                  break;
-
-               case 'Z':
-               case 'z':
-                  hzcount = true;
-                  break;
-
-               case 's':
-                  hsod = true;
-                  break;
-
-               case 'g':
-                  hsow = true;
-                  break;
-
-               case 'w':
-                  idow = asInt( itr->second );
-                  hdow = true;
-                  break;
-
-               case 'G':
-                  hweek = true;
-                  break;
-
-               case 'F':
-                  hfullweek = true;
-                  break;
-
-               case 'j':
-                  hdoy = true;
-                  break;
-
-               case 'b':
-               case 'B':
-                  hmonth = true;
-                  break;
-
-               case 'Y':
-               case 'y':
-                  hyear = true;
-                  break;
-
-               case 'a':
-               case 'A':
-                  {
-                     hdow = true;
-                     string thisDay = firstWord( itr->second );
-                     lowerCase(thisDay);
-                     if (isLike(thisDay, "sun.*")) idow = 0;
-                     else if (isLike(thisDay, "mon.*")) idow = 1;
-                     else if (isLike(thisDay, "tue.*")) idow = 2;
-                     else if (isLike(thisDay, "wed.*")) idow = 3;
-                     else if (isLike(thisDay, "thu.*")) idow = 4;
-                     else if (isLike(thisDay, "fri.*")) idow = 5;
-                     else if (isLike(thisDay, "sat.*")) idow = 6;
-                     else
-                     {
-                        hdow = false;
-                     }
-                  }
-                  break;
-                  
-               case 'm':
-                  hmonth = true;
-                  break;
-
-               case 'd':
-                  hday = true;
-                  break;
-
-               case 'H':
-                  hhour = true;
-                  break;
-
-               case 'M':
-                  hmin = true;
-                  break;
-
-               case 'S':
-                  hsec = true;
-                  break;
-
-               case 'f':
-                  hsec = true;
-                  // a small hack to make fractional seconds work
-                  info['S'] = info['f'];
-                  break;
-
-               case 'U':
-                  hunixsec = true;
-                  break;
-
-               case 'u':
-                  hunixusec = true;
-                  break;
-
-               case 'W':
-                  hposixsec = true;
-                  break;
-
-               case 'N':
-                  hposixnsec = true;
-                  break;
-                  
-               case 'c':
-                  hzcount29 = true;
-                  break;
-
-               case 'C':
-                  hzcount32 = true;
-                  break;
-
-               case 'J':
-                  hjulian = true;
-                  break;
-                  
-               case 'K':
-                  hansi = true;
-                  break;
-                  
-               case 'E':
-                  hepoch = true;
-                  break;
-
-               case 'R': hepoch = hbdse = true; break;
-               case 'T': hepoch = hgale = true; break;
-               case 'V': hepoch = hqzse = true; break;
-               case 'X': hepoch = hirne = true; break;
-
-               case 'D': hfullweek = hbdsfw = true; break;
-               case 'e': hweek = hbdsw = true; break;
-               case 'L': hfullweek = hgalfw = true; break;
-               case 'l': hweek = hgalw = true; break;
-               case 'h': hfullweek = hqzsfw = true; break;
-               case 'i': hweek = hqzsw = true; break;
-               case 'O': hfullweek = hirnfw = true; break;
-               case 'o': hweek = hirnw = true; break;
-
-
-               default:
-                  {
-                     // do nothing
-                  }
-                  break;
-
-            };
-         }     // end loop over Id/Value pairs
-
-         if( hyear )
-         {
-            if( hmonth && hday )
-            {
-               CivilTime tt;
-               tt.setFromInfo( info );
-               if( hsod )
-               {
-                  convertSODtoTime( asDouble( info['s'] ), 
-                                    tt.hour, tt.minute, tt.second );
-               }
-               t = tt.convertToCommonTime();
-               return;
-            }
-            else  // use YDSTime as default
-            {
-               YDSTime tt;
-               tt.setFromInfo( info );
-               if( hhour && hmin && hsec )
-               {
-                  tt.sod = convertTimeToSOD( asInt( info['H'] ), 
-                                             asInt( info['M'] ), 
-                                             asDouble( info['S'] ) );
-               }
-               t = tt.convertToCommonTime();
-               return;
-            }
-
-         } // end of if( hyear )
-
-         if( hzcount32 ||
-             (hfullweek && (hzcount || hzcount29)) ||
-             (hepoch && (hzcount29 || 
-                         (hweek && hzcount))) )
-         {
-            GPSWeekZcount tt;
-            tt.setFromInfo( info );
-            t = tt.convertToCommonTime();
-            return;
-         }
-
-         if ( (hepoch && hweek) || hfullweek )
-         {
-            WeekSecond* ptt;
-            if(hbdse || hbdsfw || hbdsw) ptt = new BDSWeekSecond();
-            else if(hqzse || hqzsfw || hqzsw) ptt = new QZSWeekSecond();
-            else if(hgale || hgalfw || hgalw) ptt = new GALWeekSecond();
-            else if(hirne || hirnfw || hirnw) ptt = new IRNWeekSecond();
-            else ptt = new GPSWeekSecond();
-            ptt->setFromInfo(info);
-            if( hdow && !hsow )
-            {
-               ptt->sow = asInt( info['w'] ) * SEC_PER_DAY;
-               if( hsod )
-               {
-                  ptt->sow += asDouble( info['s'] );
-               }
-               else if( hhour && hmin && hsec )
-               {
-                  ptt->sow += convertTimeToSOD( asInt( info['H'] ), 
-                                              asInt( info['M'] ), 
-                                              asDouble( info['S'] ) );
-               }
-            }
-
-            t = ptt->convertToCommonTime();
-            delete ptt;
-            return;
-         }
-
-         if( hmjd )
-         {
-            MJD tt;
-            tt.setFromInfo( info );
-            t = tt.convertToCommonTime();
-            return;
-         }
-
-         if( hjulian )
-         {
-            JulianDate tt;
-            tt.setFromInfo( info );
-            t = tt.convertToCommonTime();
-            return;
-         }
-
-         if( hansi )
-         {
-            ANSITime tt;
-            tt.setFromInfo( info );
-            t = tt.convertToCommonTime();
-            return;
-         } 
-         
-         if( hunixsec || hunixusec )
-         {
-            UnixTime tt;
-            tt.setFromInfo( info );
-            t = tt.convertToCommonTime();
-            return;
-         }
-
-         if( hposixsec || hposixnsec )
-         {
-            PosixTime tt;
-            tt.setFromInfo( info );
-            t = tt.convertToCommonTime();
-            return;
-         }
-
-         InvalidRequest ir("Incomplete time specification for readTime");
-         GPSTK_THROW( ir );
+         TimeFormat::get( fmt ).scan( t, str );
       }
       catch( gpstk::StringUtils::StringException& se )
       {
@@ -50,6 +50,8 @@
 #include <vector>
 #include <cstdio>   /// @todo Get rid of the stdio.h dependency if possible.
 #include <cctype>
+#include <cstdlib>
+#include <algorithm>
 #include <limits>
 
 #ifdef _WIN32
@@ -746,6 +748,53 @@ namespace gpstk
       inline long double asLongDouble(const std::string& s)
          throw(StringException);
 
+         /**
+          * Convert a fixed-width field to a double precision floating
+          * point number without copying it.  The result is the same
+          * as asDouble(const std::string&) of the same characters,
+          * except that FORTRAN exponents ('D' or 'd') are accepted
+          * as well.  A blank field is zero.  Numbers of up to 15
+          * significant digits with a decimal exponent of at most 22
+          * are converted directly (and exactly); others are given
+          * to strtod().
+          * @param p start of the field.
+          * @param n width of the field.
+          * @return double representation of the field.
+          */
+      inline double asDouble(const char *p, std::string::size_type n);
+
+         /**
+          * Convert the \a n character field at \a pos in \a s to a
+          * double, like asDouble(s.substr(pos, n)) but without the
+          * copy and accepting FORTRAN exponents.
+          * @see asDouble(const char*, std::string::size_type)
+          * @throw StringException if \a pos is past the end of \a s.
+          */
+      inline double asDouble(const std::string& s,
+                             std::string::size_type pos,
+                             std::string::size_type n)
+         throw(StringException);
+
+         /**
+          * Convert a fixed-width field to an integer without copying
+          * it.  The result is the same as asInt(const std::string&) of
+          * the same characters.
+          * @param p start of the field.
+          * @param n width of the field.
+          * @return long integer representation of the field.
+          */
+      inline long asInt(const char *p, std::string::size_type n);
+
+         /**
+          * Convert the \a n character field at \a pos in \a s to an
+          * integer, like asInt(s.substr(pos, n)) but without the copy.
+          * @throw StringException if \a pos is past the end of \a s.
+          */
+      inline long asInt(const std::string& s,
+                        std::string::size_type pos,
+                        std::string::size_type n)
+         throw(StringException);
+
          /**
           * Convert a value in a string to a type specified by the template
           * class.  The template class type must have stream operators
@@ -1617,6 +1666,177 @@ namespace gpstk
          }
       }
 
+         /// Whitespace as strtod() and strtol() see it in the C locale.
+      inline bool isFieldSpace(char c)
+      {
+         return ((c == ' ') || (c == '\t') || (c == '\n') || (c == '\v') ||
+                 (c == '\f') || (c == '\r'));
+      }
+
+
+      inline double asDouble(const char *p, std::string::size_type n)
+      {
+            // Powers of ten that are exact doubles.  A correctly
+            // rounded multiply or divide of an integer below 2^53 by
+            // one of them is the correctly rounded result that
+            // strtod() gives.
+         static const double exactPow10[] =
+         {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9, 1e10,
+            1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+            1e21, 1e22
+         };
+
+         std::string::size_type i = 0;
+         while ((i < n) && isFieldSpace(p[i]))
+            i++;
+         if (i == n)
+            return 0.;
+         bool neg = false;
+         if ((p[i] == '-') || (p[i] == '+'))
+         {
+            neg = (p[i] == '-');
+            i++;
+         }
+         unsigned long long mant = 0;
+         int digits = 0, sigDigits = 0, exp10 = 0;
+         for ( ; (i < n) && (p[i] >= '0') && (p[i] <= '9'); i++, digits++)
+         {
+            mant = mant * 10 + (p[i] - '0');
+            if (mant)
+               sigDigits++;
+            if (sigDigits > 15)
+               break;
+         }
+         if ((i < n) && (p[i] == '.') && (sigDigits <= 15))
+         {
+            for (i++; (i < n) && (p[i] >= '0') && (p[i] <= '9');
+                 i++, digits++, exp10--)
+            {
+               mant = mant * 10 + (p[i] - '0');
+               if (mant)
+                  sigDigits++;
+               if (sigDigits > 15)
+                  break;
+            }
+         }
+         bool simple = (digits > 0) && (sigDigits <= 15);
+         if (simple && (i < n) && (p[i] != ' ') && !isFieldSpace(p[i]))
+         {
+               // the only other ending understood here is an exponent
+            simple = false;
+            if ((p[i] == 'E') || (p[i] == 'e') ||
+                (p[i] == 'D') || (p[i] == 'd'))
+            {
+               std::string::size_type j = i + 1;
+               bool expNeg = false;
+               if ((j < n) && ((p[j] == '-') || (p[j] == '+')))
+               {
+                  expNeg = (p[j] == '-');
+                  j++;
+               }
+               int expVal = 0, expDigits = 0;
+               for ( ; (j < n) && (p[j] >= '0') && (p[j] <= '9') &&
+                        (expDigits < 4); j++, expDigits++)
+                  expVal = expVal * 10 + (p[j] - '0');
+               if ((expDigits > 0) &&
+                   ((j == n) || isFieldSpace(p[j])))
+               {
+                  exp10 += expNeg ? -expVal : expVal;
+                  simple = true;
+               }
+            }
+         }
+         if (simple && (mant == 0))
+            return neg ? -0. : 0.;
+         if (simple && (exp10 >= -22) && (exp10 <= 22))
+         {
+            double val = static_cast<double>(mant);
+            if (exp10 < 0)
+               val /= exactPow10[-exp10];
+            else
+               val *= exactPow10[exp10];
+            return neg ? -val : val;
+         }
+
+            // Long mantissas, large exponents, infinities, junk: let
+            // strtod() decide, after turning FORTRAN exponents into C.
+         char buf[64];
+         std::string big;
+         char *q = buf;
+         if (n >= sizeof(buf))
+         {
+            big.assign(p, n);
+            q = &big[0];
+         }
+         else
+         {
+            std::copy(p, p + n, buf);
+            buf[n] = 0;
+         }
+         for (std::string::size_type k = 0; k < n; k++)
+         {
+            if ((q[k] == 'D') || (q[k] == 'd'))
+               q[k] = 'E';
+         }
+         return strtod(q, 0);
+      }
+
+
+      inline double asDouble(const std::string& s,
+                             std::string::size_type pos,
+                             std::string::size_type n)
+         throw(StringException)
+      {
+         if (pos > s.size())
+         {
+            StringException e("Field position is past the end of the string");
+            GPSTK_THROW(e);
+         }
+         if (n > s.size() - pos)
+            n = s.size() - pos;
+         return asDouble(s.data() + pos, n);
+      }
+
+
+      inline long asInt(const char *p, std::string::size_type n)
+      {
+         std::string::size_type i = 0;
+         while ((i < n) && isFieldSpace(p[i]))
+            i++;
+         bool neg = false;
+         if ((i < n) && ((p[i] == '-') || (p[i] == '+')))
+         {
+            neg = (p[i] == '-');
+            i++;
+         }
+         long val = 0;
+         int digits = 0;
+         for ( ; (i < n) && (p[i] >= '0') && (p[i] <= '9'); i++, digits++)
+            val = val * 10 + (p[i] - '0');
+         if (digits <= std::numeric_limits<long>::digits10)
+            return neg ? -val : val;
+            // could overflow, let strtol() saturate as it would
+         return strtol(std::string(p, n).c_str(), 0, 10);
+      }
+
+
+      inline long asInt(const std::string& s,
+                        std::string::size_type pos,
+                        std::string::size_type n)
+         throw(StringException)
+      {
+         if (pos > s.size())
+         {
+            StringException e("Field position is past the end of the string");
+            GPSTK_THROW(e);
+         }
+         if (n > s.size() - pos)
+            n = s.size() - pos;
+         return asInt(s.data() + pos, n);
+      }
+
+
       template <class X>
       inline X asData(const std::string& s)
          throw(StringException)
@@ -2666,33 +2886,7 @@ namespace gpstk
                              const std::string::size_type startPos,
                              const std::string::size_type length)
       {
-         std::string s(aStr, startPos, length);
-         strip(s);
-
-            // you can blame Rinex for these special checks
-         if (s.empty())
-         {
-            return 0;
-         }
-
-         std::string::size_type pos = s.find_first_of("EDd");
-         if (pos != std::string::npos)
-         {
-            s[pos] = 'e';
-         }
-         else
-         {
-               // just treat it like a double
-            return asDouble(aStr.substr(startPos, length));
-         }
-
-         std::stringstream st;
-         st << s;
-
-         double d;
-         st >> d;
-
-         return d;
+         return asDouble(aStr, startPos, length);
       }
 
       inline std::string printable(const std::string& aStr)
@@ -0,0 +1,130 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file ThreadPool.cpp
+ * A fixed-size pool of worker threads executing queued tasks.
+ */
+
+#include "ThreadPool.hpp"
+
+namespace gpstk
+{
+   ThreadPool ::
+   ThreadPool(unsigned numThreads)
+         : running(0), stopping(false)
+   {
+      if (numThreads == 0)
+         numThreads = defaultThreads();
+      workers.reserve(numThreads);
+      for (unsigned i = 0; i < numThreads; i++)
+         workers.push_back(std::thread(&ThreadPool::workerLoop, this));
+   }
+
+
+   ThreadPool ::
+   ~ThreadPool()
+   {
+      wait();
+      {
+         std::lock_guard<std::mutex> lock(mtx);
+         stopping = true;
+      }
+      taskReady.notify_all();
+      for (size_t i = 0; i < workers.size(); i++)
+         workers[i].join();
+   }
+
+
+   void ThreadPool ::
+   submit(const Task& task)
+   {
+      {
+         std::lock_guard<std::mutex> lock(mtx);
+         tasks.push_back(task);
+      }
+      taskReady.notify_one();
+   }
+
+
+   void ThreadPool ::
+   wait()
+   {
+      std::unique_lock<std::mutex> lock(mtx);
+      while (!tasks.empty() || running)
+         idle.wait(lock);
+   }
+
+
+   unsigned ThreadPool ::
+   defaultThreads()
+   {
+      unsigned n = std::thread::hardware_concurrency();
+      return n ? n : 1;
+   }
+
+
+   void ThreadPool ::
+   workerLoop()
+   {
+      std::unique_lock<std::mutex> lock(mtx);
+      while (true)
+      {
+         while (tasks.empty() && !stopping)
+            taskReady.wait(lock);
+         if (tasks.empty())
+            return;
+         Task task(tasks.front());
+         tasks.pop_front();
+         running++;
+         lock.unlock();
+         try
+         {
+            task();
+         }
+         catch (...)
+         {
+               // see class documentation
+         }
+         lock.lock();
+         running--;
+         if (tasks.empty() && !running)
+            idle.notify_all();
+      }
+   }
+
+} // namespace gpstk
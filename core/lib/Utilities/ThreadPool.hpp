@@ -0,0 +1,124 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file ThreadPool.hpp
+ * A fixed-size pool of worker threads executing queued tasks.
+ */
+
+#ifndef GPSTK_THREADPOOL_HPP
+#define GPSTK_THREADPOOL_HPP
+
+#include <deque>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace gpstk
+{
+      /// @ingroup Utilities
+      //@{
+
+      /**
+       * A fixed set of worker threads that execute tasks submitted
+       * to a shared FIFO queue.  Tasks are arbitrary callables
+       * taking no arguments.  A task must not let an exception
+       * escape; any that does is caught and discarded by the worker
+       * so that it can't terminate the process, so tasks that can
+       * fail should record their errors themselves.
+       *
+       * @code
+       * ThreadPool pool(4);
+       * for (size_t i = 0; i < jobs.size(); i++)
+       *    pool.submit(std::bind(&Job::run, &jobs[i]));
+       * pool.wait();
+       * @endcode
+       */
+   class ThreadPool
+   {
+   public:
+         /// Type of the work items.
+      typedef std::function<void()> Task;
+
+         /** Start the worker threads.
+          * @param[in] numThreads number of workers; 0 selects
+          *   defaultThreads(). */
+      explicit ThreadPool(unsigned numThreads = 0);
+
+         /// Wait for all queued tasks to complete, then join the workers.
+      ~ThreadPool();
+
+         /// Queue a task for execution by one of the workers.
+      void submit(const Task& task);
+
+         /// Block until the queue is empty and no task is running.
+      void wait();
+
+         /// Number of worker threads.
+      unsigned getNumThreads() const
+      { return workers.size(); }
+
+         /// Number of hardware threads, or 1 if that can't be determined.
+      static unsigned defaultThreads();
+
+   private:
+         /// Body of each worker thread.
+      void workerLoop();
+
+      std::vector<std::thread> workers;
+      std::deque<Task> tasks;
+      std::mutex mtx;
+         /// signalled when a task is queued or the pool is stopping
+      std::condition_variable taskReady;
+         /// signalled when the pool becomes idle
+      std::condition_variable idle;
+         /// number of tasks currently executing
+      unsigned running;
+      bool stopping;
+
+         // not copyable
+      ThreadPool(const ThreadPool&);
+      ThreadPool& operator=(const ThreadPool&);
+   }; // class ThreadPool
+
+      //@}
+
+} // namespace gpstk
+
+#endif // GPSTK_THREADPOOL_HPP
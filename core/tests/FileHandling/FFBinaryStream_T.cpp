@@ -264,11 +264,7 @@ testStream(const std::string& outfn, const std::string& reffn,
    
    StreamType testStrmIn(outfn.c_str(), ios::in);
 
-   #ifdef WIN32
    testFramework.assert(bool(testStrmIn), "Couldn't open " + outfn + " for input", __LINE__);
-   #else
-   testFramework.assert(testStrmIn, "Couldn't open " + outfn + " for input", __LINE__);
-   #endif
 
       // check file size
    testStrmIn.seekg(0, testStrmIn.end);
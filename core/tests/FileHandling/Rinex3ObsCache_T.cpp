@@ -0,0 +1,274 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "Rinex3ObsCache.hpp"
+#include "TestUtil.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <utime.h>
+
+using namespace std;
+using namespace gpstk;
+
+class Rinex3ObsCache_T
+{
+public:
+   Rinex3ObsCache_T();
+
+      /// read files through the cache and compare with plain reads
+   int roundTripTest();
+      /// make sure stale and damaged caches are not used
+   int validityTest();
+
+private:
+      /** Read a file, optionally through the cache, and return a
+       * text rendering of every record. */
+   static string readFile(const string& fn, bool useCache, bool except);
+      /// Copy a file, return false on failure.
+   static bool copyFile(const string& from, const string& to);
+      /// Return the contents of a file.
+   static string getContents(const string& fn);
+      /// Return the RINEX header text of a file.
+   static string getHeaderText(const string& fn);
+
+   vector<string> files;
+   string dataFilePath, tempFilePath;
+};
+
+
+Rinex3ObsCache_T ::
+Rinex3ObsCache_T()
+{
+   dataFilePath = gpstk::getPathData() + gpstk::getFileSep();
+   tempFilePath = gpstk::getPathTestTemp() + gpstk::getFileSep();
+      // RINEX 2 and 3, the RINEX 3 files have event records
+   files.push_back("arlm200a.15o");
+   files.push_back("test_input_rinex2_obs_SystemMixed.06o");
+   files.push_back("test_input_rinex3_obs_RinexObsFile.15o");
+   files.push_back("test_input_rinex3_76193040.14o");
+}
+
+
+bool Rinex3ObsCache_T ::
+copyFile(const string& from, const string& to)
+{
+   ifstream in(from.c_str(), ios::in | ios::binary);
+   ofstream out(to.c_str(), ios::out | ios::binary | ios::trunc);
+   out << in.rdbuf();
+   return in && out;
+}
+
+
+string Rinex3ObsCache_T ::
+getContents(const string& fn)
+{
+   ifstream in(fn.c_str(), ios::in | ios::binary);
+   ostringstream s;
+   s << in.rdbuf();
+   return s.str();
+}
+
+
+string Rinex3ObsCache_T ::
+getHeaderText(const string& fn)
+{
+   string text(getContents(fn));
+   size_t pos = text.find("END OF HEADER");
+   return text.substr(0, text.find('\n', pos) + 1);
+}
+
+
+string Rinex3ObsCache_T ::
+readFile(const string& fn, bool useCache, bool except)
+{
+   ostringstream s;
+   try
+   {
+      Rinex3ObsStream strm(fn.c_str());
+      Rinex3ObsHeader hdr;
+      Rinex3ObsData rod;
+      strm.useCache = useCache;
+      if (except)
+         strm.exceptions(ios::failbit);
+      strm >> hdr;
+      while (strm >> rod)
+      {
+         s << rod.time.asString() << " " << rod.epochFlag << " "
+           << rod.numSVs << " " << setprecision(17) << rod.clockOffset
+           << endl;
+         Rinex3ObsData::DataMap::const_iterator i;
+         for (i = rod.obs.begin(); i != rod.obs.end(); i++)
+         {
+            s << i->first;
+            for (size_t j = 0; j < i->second.size(); j++)
+            {
+               const RinexDatum& rd(i->second[j]);
+               s << " " << rd.data << "/" << rd.lli << "/" << rd.ssi << "/"
+                 << rd.dataBlank << rd.lliBlank << rd.ssiBlank;
+            }
+            s << endl;
+         }
+         for (size_t j = 0; j < rod.auxHeader.commentList.size(); j++)
+            s << rod.auxHeader.commentList[j] << endl;
+      }
+      s << "records " << strm.recordNumber << endl;
+   }
+   catch (Exception& e)
+   {
+      s << "Exception: " << e.getText() << endl;
+   }
+   catch (std::exception& e)
+   {
+      s << "End" << endl;
+   }
+   return s.str();
+}
+
+
+int Rinex3ObsCache_T ::
+roundTripTest()
+{
+   TUDEF("Rinex3ObsStream", "useCache");
+
+   for (size_t f = 0; f < files.size(); f++)
+   {
+      string fn(tempFilePath + "test_output_cache_" + files[f]);
+      string cn(Rinex3ObsCache::cacheName(fn));
+      TUASSERT(copyFile(dataFilePath + files[f], fn));
+      std::remove(cn.c_str());
+
+      for (int except = 0; except < 2; except++)
+      {
+         string expected(readFile(fn, false, except));
+         TUASSERT(expected.find("Exception") == string::npos);
+         TUASSERTE(string, "", getContents(cn));
+            // the first read parses the file and writes the cache
+         TUASSERTE(string, expected, readFile(fn, true, except));
+         string cache(getContents(cn));
+         TUASSERT(!cache.empty());
+         TUASSERT(Rinex3ObsCache().openRead(fn, getHeaderText(fn)));
+            // the second comes from the cache
+         TUASSERTE(string, expected, readFile(fn, true, except));
+         TUASSERTE(string, cache, getContents(cn));
+         std::remove(cn.c_str());
+      }
+   }
+   TURETURN();
+}
+
+
+int Rinex3ObsCache_T ::
+validityTest()
+{
+   TUDEF("Rinex3ObsCache", "openRead");
+
+   string fn(tempFilePath + "test_output_cache_" + files[2]);
+   string cn(Rinex3ObsCache::cacheName(fn));
+   TUASSERT(copyFile(dataFilePath + files[2], fn));
+   std::remove(cn.c_str());
+   string hdr(getHeaderText(fn));
+   string expected(readFile(fn, false, false));
+
+   TUASSERT(!Rinex3ObsCache().openRead(fn, hdr));
+   readFile(fn, true, false);
+   string cache(getContents(cn));
+   TUASSERT(Rinex3ObsCache().openRead(fn, hdr));
+
+      // different header text
+   string hdr2(hdr);
+   hdr2[hdr2.size()/2] = (hdr2[hdr2.size()/2] == 'X') ? 'Y' : 'X';
+   TUASSERT(!Rinex3ObsCache().openRead(fn, hdr2));
+
+      // damaged payload
+   string bad(cache);
+   bad[bad.size()-10] ^= 0x40;
+   ofstream(cn.c_str(), ios::out | ios::binary | ios::trunc) << bad;
+   TUASSERT(!Rinex3ObsCache().openRead(fn, hdr));
+      // it's ignored and replaced
+   TUASSERTE(string, expected, readFile(fn, true, false));
+   TUASSERTE(string, cache, getContents(cn));
+
+      // truncated
+   ofstream(cn.c_str(), ios::out | ios::binary | ios::trunc)
+      << cache.substr(0, cache.size()/2);
+   TUASSERT(!Rinex3ObsCache().openRead(fn, hdr));
+   TUASSERTE(string, expected, readFile(fn, true, false));
+   TUASSERTE(string, cache, getContents(cn));
+
+      // source modified after the cache was written
+   struct stat st;
+   TUASSERT(stat(fn.c_str(), &st) == 0);
+   struct utimbuf times;
+   times.actime = st.st_atime;
+   times.modtime = st.st_mtime - 100;
+   TUASSERT(utime(fn.c_str(), &times) == 0);
+   TUASSERT(!Rinex3ObsCache().openRead(fn, hdr));
+   TUASSERTE(string, expected, readFile(fn, true, false));
+   TUASSERT(Rinex3ObsCache().openRead(fn, hdr));
+
+      // a file that can't be parsed leaves no cache
+   fn = tempFilePath + "test_output_cache_BadEpochFlag.15o";
+   cn = Rinex3ObsCache::cacheName(fn);
+   TUASSERT(copyFile(dataFilePath + "test_input_rinex3_obs_BadEpochFlag.15o",
+                     fn));
+   std::remove(cn.c_str());
+   TUASSERTE(string, readFile(fn, false, true), readFile(fn, true, true));
+   TUASSERTE(string, "", getContents(cn));
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   Rinex3ObsCache_T testClass;
+
+   errorTotal += testClass.roundTripTest();
+   errorTotal += testClass.validityTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
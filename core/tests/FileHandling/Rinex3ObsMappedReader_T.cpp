@@ -0,0 +1,217 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "Rinex3ObsMappedReader.hpp"
+#include "TestUtil.hpp"
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace gpstk;
+
+class Rinex3ObsMappedReader_T
+{
+public:
+   Rinex3ObsMappedReader_T();
+
+      /// compare the mapped reader with Rinex3ObsStream on valid files
+   int compareTest();
+      /// make sure malformed records and RINEX 2 input are rejected
+   int errorTest();
+
+private:
+      /// read a file with Rinex3ObsStream and with the mapped reader
+      /// and compare every record.
+   void compareFile(const string& fn, TestUtil& testFramework);
+
+   string dataFilePath;
+};
+
+
+Rinex3ObsMappedReader_T ::
+Rinex3ObsMappedReader_T()
+{
+   dataFilePath = gpstk::getPathData() + gpstk::getFileSep();
+}
+
+
+void Rinex3ObsMappedReader_T ::
+compareFile(const string& fn, TestUtil& testFramework)
+{
+   vector<Rinex3ObsData> expData;
+   Rinex3ObsStream strm(fn.c_str());
+   Rinex3ObsHeader expHdr;
+   Rinex3ObsData rod;
+   strm >> expHdr;
+   while (strm >> rod)
+      expData.push_back(rod);
+
+   Rinex3ObsMappedReader rdr;
+   TUCATCH(rdr.open(fn));
+   TUASSERTFE(expHdr.version, rdr.header.version);
+   TUASSERTE(string, expHdr.markerName, rdr.header.markerName);
+   TUASSERT(expHdr.mapObsTypes == rdr.header.mapObsTypes);
+   TUASSERTE(TimeSystem, strm.timesystem, rdr.timesystem);
+
+   unsigned count = 0;
+   bool same = true;
+   try
+   {
+      while (rdr.getRecord(rod))
+      {
+         if (count >= expData.size())
+         {
+            same = false;
+            count++;
+            break;
+         }
+         const Rinex3ObsData& exp = expData[count++];
+         same = same && (exp.time == rod.time) &&
+            (exp.epochFlag == rod.epochFlag) &&
+            (exp.numSVs == rod.numSVs) &&
+            (exp.clockOffset == rod.clockOffset) &&
+            (exp.obs.size() == rod.obs.size());
+         Rinex3ObsData::DataMap::const_iterator ei, gi;
+         for (ei = exp.obs.begin(), gi = rod.obs.begin();
+              same && (ei != exp.obs.end()); ei++, gi++)
+         {
+            same = (ei->first == gi->first) &&
+               (ei->second.size() == gi->second.size());
+            for (size_t i = 0; same && (i < ei->second.size()); i++)
+            {
+               const RinexDatum& e = ei->second[i];
+               const RinexDatum& g = gi->second[i];
+                  // exact comparison, the parsed values must be identical
+               same = (e.data == g.data) && (e.dataBlank == g.dataBlank) &&
+                  (e.lli == g.lli) && (e.lliBlank == g.lliBlank) &&
+                  (e.ssi == g.ssi) && (e.ssiBlank == g.ssiBlank);
+            }
+         }
+         if (!same)
+            break;
+      }
+   }
+   catch (Exception& exc)
+   {
+      cerr << exc << endl;
+      same = false;
+   }
+   testFramework.assert(same, "Record mismatch in " + fn + " record " +
+                        StringUtils::asString(count), __LINE__);
+   TUASSERTE(size_t, expData.size(), count);
+}
+
+
+int Rinex3ObsMappedReader_T ::
+compareTest()
+{
+   TUDEF("Rinex3ObsMappedReader", "getRecord");
+   const char *files[] =
+   {
+      "test_input_rinex3_obs_RinexObsFile.15o",
+      "test_input_rinex3_76193040.14o",
+      "test_input_rinex3_obs_FilterTest1.15o",
+      "inputs/igs/nrmg0150.16o",
+      "inputs/igs/solo0150.16o",
+      "inputs/igs/sptu0150.16o",
+      "inputs/igs/FAA100PYF_R_20161700100_15M_01S_MO",
+      "inputs/igs/UCAL00CAN_S_20161700100_15M_01S_MO"
+   };
+   for (unsigned i = 0; i < sizeof(files)/sizeof(files[0]); i++)
+   {
+      compareFile(dataFilePath + files[i], testFramework);
+   }
+   TURETURN();
+}
+
+
+int Rinex3ObsMappedReader_T ::
+errorTest()
+{
+   TUDEF("Rinex3ObsMappedReader", "getRecord");
+   Rinex3ObsMappedReader rdr;
+   Rinex3ObsData rod;
+
+   try
+   {
+      rdr.open(dataFilePath + "test_input_rinex2_obs_RinexObsFile.06o");
+      TUFAIL("RINEX 2 input was accepted");
+   }
+   catch (FFStreamError& e)
+   {
+      TUPASS("RINEX 2 input rejected");
+   }
+
+   const char *badFiles[] =
+   {
+      "test_input_rinex3_obs_BadEpochFlag.15o",
+      "test_input_rinex3_obs_InvalidTimeFormat.15o"
+   };
+   for (unsigned i = 0; i < sizeof(badFiles)/sizeof(badFiles[0]); i++)
+   {
+      bool threw = false;
+      try
+      {
+         rdr.open(dataFilePath + badFiles[i]);
+         while (rdr.getRecord(rod))
+            ;
+      }
+      catch (FFStreamError& e)
+      {
+         threw = true;
+      }
+      testFramework.assert(threw, string("No error reading ") + badFiles[i],
+                           __LINE__);
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   Rinex3ObsMappedReader_T testClass;
+
+   errorTotal += testClass.compareTest();
+   errorTotal += testClass.errorTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
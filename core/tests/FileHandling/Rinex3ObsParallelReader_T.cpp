@@ -0,0 +1,201 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "Rinex3ObsParallelReader.hpp"
+#include "TestUtil.hpp"
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace gpstk;
+
+class Rinex3ObsParallelReader_T
+{
+public:
+   Rinex3ObsParallelReader_T();
+
+      /// merge several files and compare with serial reads
+   int mergeTest(unsigned numThreads, size_t queueSize);
+      /// make sure a bad record is reported and the merge goes on
+   int errorTest();
+
+private:
+   vector<string> files;
+   string dataFilePath;
+};
+
+
+Rinex3ObsParallelReader_T ::
+Rinex3ObsParallelReader_T()
+{
+   dataFilePath = gpstk::getPathData() + gpstk::getFileSep();
+   files.push_back(dataFilePath + "arlm200a.15o");
+   files.push_back(dataFilePath + "arlm200b.15o");
+   files.push_back(dataFilePath + "test_input_rinex3_76193040.14o");
+   files.push_back(dataFilePath + "test_input_rinex3_obs_RinexObsFile.15o");
+   files.push_back(dataFilePath + "inputs/igs/nrmg0150.16o");
+}
+
+
+int Rinex3ObsParallelReader_T ::
+mergeTest(unsigned numThreads, size_t queueSize)
+{
+   TUDEF("Rinex3ObsParallelReader", "getRecord");
+
+      // serial reference
+   vector<vector<Rinex3ObsData> > expData(files.size());
+   for (size_t i = 0; i < files.size(); i++)
+   {
+      Rinex3ObsStream strm(files[i].c_str());
+      Rinex3ObsHeader hdr;
+      Rinex3ObsData rod;
+      strm >> hdr;
+      while (strm >> rod)
+         expData[i].push_back(rod);
+   }
+
+   Rinex3ObsParallelReader rdr(numThreads, queueSize);
+   for (size_t i = 0; i < files.size(); i++)
+      TUASSERTE(size_t, i, rdr.addFile(files[i]));
+   TUCATCH(rdr.open());
+   TUASSERTE(size_t, files.size(), rdr.getNumSources());
+
+   vector<size_t> count(files.size(), 0);
+   bool ordered = true, same = true;
+   CommonTime prev = CommonTime::BEGINNING_OF_TIME;
+   prev.setTimeSystem(TimeSystem::Any);
+   size_t src;
+   Rinex3ObsData rod;
+   try
+   {
+      while (rdr.getRecord(src, rod))
+      {
+         CommonTime t(rod.time);
+         t.setTimeSystem(TimeSystem::Any);
+         ordered = ordered && (prev <= t);
+         prev = t;
+         if ((src >= files.size()) || (count[src] >= expData[src].size()))
+         {
+            same = false;
+            break;
+         }
+         const Rinex3ObsData& exp = expData[src][count[src]++];
+         same = same && (exp.time == rod.time) &&
+            (exp.numSVs == rod.numSVs) &&
+            (exp.epochFlag == rod.epochFlag) &&
+            (exp.obs.size() == rod.obs.size());
+         Rinex3ObsData::DataMap::const_iterator ei, gi;
+         for (ei = exp.obs.begin(), gi = rod.obs.begin();
+              same && (ei != exp.obs.end()); ei++, gi++)
+         {
+            same = (ei->first == gi->first) &&
+               (ei->second.size() == gi->second.size());
+            for (size_t j = 0; same && (j < ei->second.size()); j++)
+               same = (ei->second[j].data == gi->second[j].data);
+         }
+      }
+   }
+   catch (Exception& e)
+   {
+      cerr << e << endl;
+      same = false;
+   }
+   TUASSERT(ordered);
+   TUASSERT(same);
+   for (size_t i = 0; i < files.size(); i++)
+      TUASSERTE(size_t, expData[i].size(), count[i]);
+   TURETURN();
+}
+
+
+int Rinex3ObsParallelReader_T ::
+errorTest()
+{
+   TUDEF("Rinex3ObsParallelReader", "getRecord");
+   Rinex3ObsParallelReader rdr(2, 4);
+   rdr.addFile(dataFilePath + "test_input_rinex3_obs_RinexObsFile.15o");
+   rdr.addFile(dataFilePath + "test_input_rinex3_obs_BadEpochFlag.15o");
+   TUCATCH(rdr.open());
+   size_t src, good = 0;
+   unsigned errors = 0;
+   Rinex3ObsData rod;
+   while (true)
+   {
+      try
+      {
+         if (!rdr.getRecord(src, rod))
+            break;
+         if (src == 0)
+            good++;
+      }
+      catch (FFStreamError& e)
+      {
+         errors++;
+      }
+   }
+   TUASSERTE(unsigned, 1, errors);
+   TUASSERTE(size_t, 37, good);
+
+   try
+   {
+      rdr.addFile(dataFilePath + "arlm200a.15o");
+      TUFAIL("addFile after open() was accepted");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("addFile after open() rejected");
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   Rinex3ObsParallelReader_T testClass;
+
+   errorTotal += testClass.mergeTest(1, 1);
+   errorTotal += testClass.mergeTest(3, 2);
+   errorTotal += testClass.mergeTest(0, 64);
+   errorTotal += testClass.errorTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,186 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file Rinex3ObsReadTiming.cpp
+ * Compare the read speed of Rinex3ObsStream, Rinex3ObsMappedReader
+ * and Rinex3ObsStream reading through its binary cache.
+ *
+ * Usage: Rinex3ObsReadTiming [-n repeat] [file ...]
+ *
+ * With no files given, the RINEX 3 observation files in the test
+ * data directory are used.  Each file is read \c repeat times
+ * (default 20) with each reader and the CPU time is reported.  For
+ * the cached reads the file is copied to the test temporary
+ * directory, where its cache is written by a first untimed read. */
+
+#include <ctime>
+#include <cstdio>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "Rinex3ObsMappedReader.hpp"
+#include "Rinex3ObsCache.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+   /// Read a file with Rinex3ObsStream, return the number of epochs read.
+static unsigned long readStream(const string& fn, bool useCache = false)
+{
+   Rinex3ObsStream strm(fn.c_str());
+   Rinex3ObsHeader hdr;
+   Rinex3ObsData rod;
+   unsigned long count = 0;
+   strm.useCache = useCache;
+   strm >> hdr;
+   while (strm >> rod)
+      count++;
+   return count;
+}
+
+
+   /// Read a file with Rinex3ObsMappedReader, return the number of
+   /// epochs read.
+static unsigned long readMapped(const string& fn)
+{
+   Rinex3ObsMappedReader rdr(fn);
+   Rinex3ObsData rod;
+   unsigned long count = 0;
+   while (rdr.getRecord(rod))
+      count++;
+   return count;
+}
+
+
+int main(int argc, char *argv[])
+{
+   int repeat = 20;
+   vector<string> files;
+   for (int i = 1; i < argc; i++)
+   {
+      if ((strcmp(argv[i], "-n") == 0) && (i+1 < argc))
+         repeat = atoi(argv[++i]);
+      else
+         files.push_back(argv[i]);
+   }
+   if (files.empty())
+   {
+      string dp = getPathData() + getFileSep();
+      files.push_back(dp + "test_input_rinex3_76193040.14o");
+      files.push_back(dp + "test_input_rinex3_obs_RinexObsFile.15o");
+      files.push_back(dp + "inputs/igs/nrmg0150.16o");
+      files.push_back(dp + "inputs/igs/solo0150.16o");
+      files.push_back(dp + "inputs/igs/sptu0150.16o");
+      files.push_back(dp + "inputs/igs/FAA100PYF_R_20161700100_15M_01S_MO");
+      files.push_back(dp + "inputs/igs/UCAL00CAN_S_20161700100_15M_01S_MO");
+   }
+
+   double totStream = 0, totMapped = 0, totCached = 0;
+   cout << setw(40) << left << "file" << right << setw(8) << "epochs"
+        << setw(12) << "stream s" << setw(12) << "mapped s"
+        << setw(9) << "ratio" << setw(12) << "cached s"
+        << setw(9) << "ratio" << endl;
+   try
+   {
+      for (size_t f = 0; f < files.size(); f++)
+      {
+         string copy(getPathTestTemp() + getFileSep() +
+                     "test_output_timing_" + StringUtils::asString(f) + ".obs");
+         {
+            ifstream in(files[f].c_str(), ios::in | ios::binary);
+            ofstream out(copy.c_str(), ios::out | ios::binary | ios::trunc);
+            out << in.rdbuf();
+         }
+         readStream(copy, true);
+
+         unsigned long nStream = 0, nMapped = 0, nCached = 0;
+         clock_t t0 = clock();
+         for (int r = 0; r < repeat; r++)
+            nStream = readStream(files[f]);
+         clock_t t1 = clock();
+         for (int r = 0; r < repeat; r++)
+            nMapped = readMapped(files[f]);
+         clock_t t2 = clock();
+         for (int r = 0; r < repeat; r++)
+            nCached = readStream(copy, true);
+         clock_t t3 = clock();
+         std::remove(Rinex3ObsCache::cacheName(copy).c_str());
+         std::remove(copy.c_str());
+
+         double ts = double(t1 - t0) / CLOCKS_PER_SEC;
+         double tm = double(t2 - t1) / CLOCKS_PER_SEC;
+         double tc = double(t3 - t2) / CLOCKS_PER_SEC;
+         totStream += ts;
+         totMapped += tm;
+         totCached += tc;
+         string name(files[f]);
+         if (name.size() > 39)
+            name = name.substr(name.size() - 39);
+         cout << setw(40) << left << name << right << setw(8) << nStream
+              << fixed << setprecision(4) << setw(12) << ts
+              << setw(12) << tm << setprecision(2) << setw(9)
+              << (tm > 0 ? ts/tm : 0.) << setprecision(4) << setw(12) << tc
+              << setprecision(2) << setw(9) << (tc > 0 ? ts/tc : 0.) << endl;
+         if ((nStream != nMapped) || (nStream != nCached))
+         {
+            cerr << "Epoch count mismatch in " << files[f] << ": "
+                 << nStream << " vs " << nMapped << " vs " << nCached << endl;
+            return 1;
+         }
+      }
+   }
+   catch (Exception& e)
+   {
+      cerr << e << endl;
+      return 1;
+   }
+   cout << setw(48) << left << "total (" + StringUtils::asString(repeat)
+      + " passes)" << right << fixed << setprecision(4) << setw(12)
+        << totStream << setw(12) << totMapped << setprecision(2) << setw(9)
+        << (totMapped > 0 ? totStream/totMapped : 0.) << setprecision(4)
+        << setw(12) << totCached << setprecision(2) << setw(9)
+        << (totCached > 0 ? totStream/totCached : 0.) << endl;
+   return 0;
+}
@@ -0,0 +1,247 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "Rinex3ObsTable.hpp"
+#include "TestUtil.hpp"
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace gpstk;
+
+class Rinex3ObsTable_T
+{
+public:
+   Rinex3ObsTable_T();
+
+      /// load files and convert every epoch back to Rinex3ObsData
+   int roundTripTest();
+      /// check the column counting functions
+   int countTest();
+      /// check the error handling
+   int errorTest();
+
+private:
+      /// Compare two records, including blank flags.
+   static bool same(const Rinex3ObsData& a, const Rinex3ObsData& b);
+
+   vector<string> files;
+   string dataFilePath;
+};
+
+
+Rinex3ObsTable_T ::
+Rinex3ObsTable_T()
+{
+   dataFilePath = gpstk::getPathData() + gpstk::getFileSep();
+      // RINEX 2 and RINEX 3
+   files.push_back(dataFilePath + "test_input_rinex2_obs_SystemMixed.06o");
+   files.push_back(dataFilePath + "arlm200a.15o");
+   files.push_back(dataFilePath + "test_input_rinex3_obs_RinexObsFile.15o");
+   files.push_back(dataFilePath + "test_input_rinex3_76193040.14o");
+}
+
+
+bool Rinex3ObsTable_T ::
+same(const Rinex3ObsData& a, const Rinex3ObsData& b)
+{
+   if ((a.time != b.time) || (a.epochFlag != b.epochFlag) ||
+       (a.numSVs != b.numSVs) || (a.clockOffset != b.clockOffset) ||
+       (a.obs.size() != b.obs.size()) ||
+       (a.auxHeader.commentList != b.auxHeader.commentList))
+      return false;
+   Rinex3ObsData::DataMap::const_iterator ai, bi;
+   for (ai = a.obs.begin(), bi = b.obs.begin(); ai != a.obs.end(); ai++, bi++)
+   {
+      if ((ai->first != bi->first) || (ai->second.size() != bi->second.size()))
+         return false;
+      for (size_t i = 0; i < ai->second.size(); i++)
+      {
+         const RinexDatum& x(ai->second[i]);
+         const RinexDatum& y(bi->second[i]);
+         if ((x.data != y.data) || (x.lli != y.lli) || (x.ssi != y.ssi) ||
+             (x.dataBlank != y.dataBlank) || (x.lliBlank != y.lliBlank) ||
+             (x.ssiBlank != y.ssiBlank))
+            return false;
+      }
+   }
+   return true;
+}
+
+
+int Rinex3ObsTable_T ::
+roundTripTest()
+{
+   TUDEF("Rinex3ObsTable", "getEpoch");
+
+   for (size_t f = 0; f < files.size(); f++)
+   {
+      vector<Rinex3ObsData> expData;
+      Rinex3ObsStream strm(files[f].c_str());
+      Rinex3ObsHeader hdr;
+      Rinex3ObsData rod;
+      strm >> hdr;
+      size_t rows = 0;
+      while (strm >> rod)
+      {
+         expData.push_back(rod);
+         rows += rod.obs.size();
+      }
+
+      Rinex3ObsTable table;
+      TUCATCH(table.load(files[f]));
+      TUASSERTE(size_t, expData.size(), table.getNumEpochs());
+      TUASSERTE(size_t, rows, table.getNumRows());
+      TUASSERTE(size_t, hdr.mapObsTypes.size(),
+                table.header.mapObsTypes.size());
+
+      bool allSame = true;
+      for (size_t i = 0; allSame && (i < table.getNumEpochs()); i++)
+      {
+         table.getEpoch(i, rod);
+         allSame = same(expData[i], rod);
+      }
+      testFramework.assert(allSame, "Round trip differs for " + files[f],
+                           __LINE__);
+   }
+   TURETURN();
+}
+
+
+int Rinex3ObsTable_T ::
+countTest()
+{
+   TUDEF("Rinex3ObsTable", "countNonZero");
+
+   Rinex3ObsTable table;
+   TUCATCH(table.load(dataFilePath + "arlm200a.15o"));
+
+      // count the hard way for one satellite
+   RinexSatID sat("G05");
+   const Rinex3ObsTable::SatColumns& sc(table.getSat(sat));
+   vector<size_t> expNonZero(sc.data.size(), 0), expLLI(sc.data.size(), 0);
+   for (size_t e = 0; e < table.getNumEpochs(); e++)
+   {
+      Rinex3ObsData rod;
+      table.getEpoch(e, rod);
+      Rinex3ObsData::DataMap::const_iterator it = rod.obs.find(sat);
+      if (it == rod.obs.end())
+         continue;
+      for (size_t i = 0; i < it->second.size(); i++)
+      {
+         expNonZero[i] += (it->second[i].data != 0);
+         expLLI[i] += (it->second[i].lli > 0);
+      }
+   }
+   TUASSERT(sc.size() > 0);
+   for (size_t i = 0; i < sc.data.size(); i++)
+   {
+      TUASSERTE(size_t, expNonZero[i], Rinex3ObsTable::countNonZero(sc.data[i]));
+      TUASSERTE(size_t, expLLI[i], Rinex3ObsTable::countLossOfLock(sc.lli[i]));
+   }
+
+      // rows are in epoch order
+   bool ordered = true;
+   for (size_t r = 1; r < sc.size(); r++)
+      ordered = ordered && (sc.epoch[r-1] < sc.epoch[r]);
+   TUASSERT(ordered);
+   TURETURN();
+}
+
+
+int Rinex3ObsTable_T ::
+errorTest()
+{
+   TUDEF("Rinex3ObsTable", "load");
+
+   Rinex3ObsTable table;
+   try
+   {
+      table.load(dataFilePath + "test_input_rinex3_obs_BadEpochFlag.15o");
+      TUFAIL("Bad epoch flag was not detected");
+   }
+   catch (FFStreamError& e)
+   {
+      TUPASS("Bad epoch flag detected");
+   }
+   try
+   {
+      table.load(dataFilePath + "no_such_file.15o");
+      TUFAIL("Missing file was not detected");
+   }
+   catch (FFStreamError& e)
+   {
+      TUPASS("Missing file detected");
+   }
+
+   table.load(dataFilePath + "test_input_rinex3_obs_RinexObsFile.15o");
+   Rinex3ObsData rod;
+   try
+   {
+      table.getEpoch(table.getNumEpochs(), rod);
+      TUFAIL("Epoch index out of range was accepted");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("Epoch index out of range rejected");
+   }
+   try
+   {
+      table.getSat(RinexSatID("E30"));
+      TUFAIL("Missing satellite was accepted");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("Missing satellite rejected");
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   Rinex3ObsTable_T testClass;
+
+   errorTotal += testClass.roundTripTest();
+   errorTotal += testClass.countTest();
+   errorTotal += testClass.errorTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
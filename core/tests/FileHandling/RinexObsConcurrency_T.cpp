@@ -0,0 +1,321 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "RinexObsStream.hpp"
+#include "RinexObsData.hpp"
+#include "ThreadPool.hpp"
+#include "TestUtil.hpp"
+#include <functional>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace gpstk;
+
+   /** Make sure that RINEX observation files can be read from several
+    * threads at once, i.e. that no parse state is shared between
+    * streams. */
+class RinexObsConcurrency_T
+{
+public:
+   RinexObsConcurrency_T();
+
+      /// read two RINEX 2 files alternately in a single thread
+   int interleaveTest();
+      /// read many files in parallel and compare with serial reads
+   int stressTest(unsigned numThreads, unsigned repeat);
+
+      /** Read a file with Rinex3ObsStream (or RinexObsStream if \a v2
+       * is true) and return a text rendering of every record. */
+   static string readFile(const string& fn, bool v2);
+
+private:
+      /// One unit of work for the stress test
+   struct Job
+   {
+      string filename;
+      bool v2;
+      string output;
+      void run()
+      { output = readFile(filename, v2); }
+   };
+
+   static void format(ostream& s, const Rinex3ObsData& rod);
+   static void format(ostream& s, const RinexObsData& rod);
+
+   vector<string> files2, files3;
+   string dataFilePath;
+};
+
+
+RinexObsConcurrency_T ::
+RinexObsConcurrency_T()
+{
+   dataFilePath = gpstk::getPathData() + gpstk::getFileSep();
+   string igs = dataFilePath + "inputs" + gpstk::getFileSep() + "igs" +
+      gpstk::getFileSep();
+      // RinexContData has an event record with no epoch time
+   files2.push_back(dataFilePath + "test_input_rinex2_obs_RinexContData.06o");
+   files2.push_back(dataFilePath + "test_input_rinex2_obs_RinexObsFile.06o");
+   files2.push_back(dataFilePath + "test_input_rinex2_obs_SystemMixed.06o");
+   files2.push_back(dataFilePath + "test_input_rinex2_obs_BadEpochLine.06o");
+   files2.push_back(dataFilePath + "arlm200a.15o");
+   files2.push_back(dataFilePath + "arlm200b.15o");
+   files2.push_back(igs + "cags1700.16o");
+   files2.push_back(igs + "faa1170b00.16o");
+   files2.push_back(igs + "kerg1700.16o");
+   files2.push_back(igs + "nklg170b00.16o");
+   files2.push_back(igs + "osn31700.16o");
+   files3.push_back(dataFilePath + "test_input_rinex3_obs_RinexObsFile.15o");
+   files3.push_back(dataFilePath + "test_input_rinex3_obs_BadEpochFlag.15o");
+   files3.push_back(dataFilePath + "test_input_rinex3_76193040.14o");
+   files3.push_back(igs + "nrmg0150.16o");
+   files3.push_back(igs + "solo0150.16o");
+   files3.push_back(igs + "sptu0150.16o");
+}
+
+
+void RinexObsConcurrency_T ::
+format(ostream& s, const Rinex3ObsData& rod)
+{
+   s << rod.time.asString() << " " << rod.epochFlag << " " << rod.numSVs
+     << " " << setprecision(17) << rod.clockOffset << endl;
+   Rinex3ObsData::DataMap::const_iterator i;
+   for (i = rod.obs.begin(); i != rod.obs.end(); i++)
+   {
+      s << i->first;
+      for (size_t j = 0; j < i->second.size(); j++)
+         s << " " << i->second[j].data << "/" << i->second[j].lli
+           << "/" << i->second[j].ssi;
+      s << endl;
+   }
+   for (size_t j = 0; j < rod.auxHeader.commentList.size(); j++)
+      s << rod.auxHeader.commentList[j] << endl;
+}
+
+
+void RinexObsConcurrency_T ::
+format(ostream& s, const RinexObsData& rod)
+{
+   s << rod.time.asString() << " " << rod.epochFlag << " " << rod.numSvs
+     << " " << setprecision(17) << rod.clockOffset << endl;
+   RinexObsData::RinexSatMap::const_iterator i;
+   for (i = rod.obs.begin(); i != rod.obs.end(); i++)
+   {
+      s << i->first;
+      RinexObsData::RinexObsTypeMap::const_iterator j;
+      for (j = i->second.begin(); j != i->second.end(); j++)
+         s << " " << j->first.type << "=" << j->second.data << "/"
+           << j->second.lli << "/" << j->second.ssi;
+      s << endl;
+   }
+   for (size_t j = 0; j < rod.auxHeader.commentList.size(); j++)
+      s << rod.auxHeader.commentList[j] << endl;
+}
+
+
+string RinexObsConcurrency_T ::
+readFile(const string& fn, bool v2)
+{
+   ostringstream s;
+   try
+   {
+      if (v2)
+      {
+         RinexObsStream strm(fn.c_str());
+         RinexObsHeader hdr;
+         RinexObsData rod;
+         strm.exceptions(ios::failbit);
+         strm >> hdr;
+         while (strm >> rod)
+            format(s, rod);
+      }
+      else
+      {
+         Rinex3ObsStream strm(fn.c_str());
+         Rinex3ObsHeader hdr;
+         Rinex3ObsData rod;
+         strm.exceptions(ios::failbit);
+         strm >> hdr;
+         while (strm >> rod)
+            format(s, rod);
+      }
+   }
+   catch (Exception& e)
+   {
+      s << "Exception: " << e.getText() << endl;
+   }
+   catch (std::exception& e)
+   {
+         // end of file with failbit exceptions enabled
+      s << "End: " << e.what() << endl;
+   }
+   return s.str();
+}
+
+
+int RinexObsConcurrency_T ::
+interleaveTest()
+{
+   TUDEF("Rinex3ObsStream", "operator>>");
+
+      // With parse state shared between streams, the event record
+      // without an epoch time in strmA would get its time from the
+      // last epoch read from strmB.
+   string fnA(dataFilePath + "test_input_rinex2_obs_RinexContData.06o");
+   string fnB(dataFilePath + "arlm200a.15o");
+   vector<Rinex3ObsData> expA;
+   {
+      Rinex3ObsStream strm(fnA.c_str());
+      Rinex3ObsHeader hdr;
+      Rinex3ObsData rod;
+      strm >> hdr;
+      while (strm >> rod)
+         expA.push_back(rod);
+   }
+   bool sawEvent = false;
+   for (size_t i = 1; i < expA.size(); i++)
+   {
+      if (expA[i].epochFlag == 3)
+      {
+         sawEvent = true;
+         TUASSERTE(CommonTime, expA[i-1].time, expA[i].time);
+      }
+   }
+   TUASSERT(sawEvent);
+
+   Rinex3ObsStream strmA(fnA.c_str()), strmB(fnB.c_str());
+   Rinex3ObsHeader hdrA, hdrB;
+   Rinex3ObsData rodA, rodB;
+   strmA >> hdrA;
+   strmB >> hdrB;
+   size_t count = 0;
+   while (strmA >> rodA)
+   {
+      if (count >= expA.size())
+      {
+         TUFAIL("too many records");
+         break;
+      }
+      TUASSERTE(CommonTime, expA[count].time, rodA.time);
+      TUASSERTE(short, expA[count].epochFlag, rodA.epochFlag);
+      count++;
+      strmB >> rodB;
+   }
+   TUASSERTE(size_t, expA.size(), count);
+   TURETURN();
+}
+
+
+int RinexObsConcurrency_T ::
+stressTest(unsigned numThreads, unsigned repeat)
+{
+   TUDEF("Rinex3ObsStream", "operator>>");
+
+      // serial reference output
+   vector<Job> expected;
+   for (size_t i = 0; i < files2.size(); i++)
+   {
+      Job job;
+      job.filename = files2[i];
+         // RINEX 2 through both RinexObsStream and Rinex3ObsStream
+      job.v2 = true;
+      expected.push_back(job);
+      job.v2 = false;
+      expected.push_back(job);
+   }
+   for (size_t i = 0; i < files3.size(); i++)
+   {
+      Job job;
+      job.filename = files3[i];
+      job.v2 = false;
+      expected.push_back(job);
+   }
+   for (size_t i = 0; i < expected.size(); i++)
+   {
+      expected[i].run();
+      TUASSERT(!expected[i].output.empty());
+   }
+
+      // Each round submits every file, so different files are being
+      // parsed at the same time.
+   vector<Job> jobs;
+   for (unsigned r = 0; r < repeat; r++)
+      jobs.insert(jobs.end(), expected.begin(), expected.end());
+   for (size_t i = 0; i < jobs.size(); i++)
+      jobs[i].output.clear();
+
+   {
+      ThreadPool pool(numThreads);
+      for (size_t i = 0; i < jobs.size(); i++)
+         pool.submit(std::bind(&Job::run, &jobs[i]));
+      pool.wait();
+   }
+
+   size_t mismatch = 0;
+   for (size_t i = 0; i < jobs.size(); i++)
+   {
+      if (jobs[i].output != expected[i % expected.size()].output)
+      {
+         mismatch++;
+         cerr << "output differs for " << jobs[i].filename
+              << (jobs[i].v2 ? " (RinexObsStream)" : " (Rinex3ObsStream)")
+              << endl;
+      }
+   }
+   TUASSERTE(size_t, 0, mismatch);
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   RinexObsConcurrency_T testClass;
+
+   errorTotal += testClass.interleaveTest();
+   errorTotal += testClass.stressTest(2, 4);
+   errorTotal += testClass.stressTest(8, 8);
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
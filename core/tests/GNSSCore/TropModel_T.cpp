@@ -1,15 +1,305 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "TropModel.hpp"
+#include "SimpleTropModel.hpp"
+#include "SaasTropModel.hpp"
+#include "NeillTropModel.hpp"
+#include "GlobalTropModel.hpp"
+#include "GCATTropModel.hpp"
+#include "MOPSTropModel.hpp"
+#include "CivilTime.hpp"
 #include "TestUtil.hpp"
 #include <iostream>
+#include <cmath>
+
+using namespace gpstk;
+using namespace std;
 
 class TropModel_T
 {
-        public: 
-		TropModel_T(){}// Default Constructor, set the precision value
-		~TropModel_T() {} // Default Desructor
+public:
+   TropModel_T();
+
+      /// batchCorrection(batch) against the scalar functions
+   int batchElevationTest();
+      /// batchCorrection(RX,SV,tt,batch) against correction(RX,SV,tt)
+   int batchGeometryTest();
+      /// site and day caches follow changes of receiver and time
+   int cacheTest();
+
+private:
+      /// Compare the batch with the scalar functions of model.
+   void checkBatch(TestUtil& testFramework, const TropModel& model,
+                   const TropBatch& batch);
+      /// Compare one value, allowing for the infinite maps at zero elevation.
+   void checkValue(TestUtil& testFramework, double exp, double got);
+
+   vector<double> elevations;
+   Position rx, rx2;
+   vector<Position> svs;
+   CommonTime time, time2;
+   double eps;
 };
 
 
-int main() //Main function to initialize and run all tests above
+TropModel_T ::
+TropModel_T()
+      : eps(1e-12)
+{
+      // below and around the cutoffs of the different models
+   double elev[] = { -10., 0., 1., 2.99, 3., 4., 5., 7.5, 10., 15., 30.,
+                     45., 60., 75., 89.9, 90. };
+   elevations.assign(elev, elev + sizeof(elev)/sizeof(elev[0]));
+
+   rx.setGeodetic(40.4, -3.7, 650.);
+   rx2.setGeodetic(-33.9, 151.2, 40.);
+   time = CivilTime(2016, 6, 18, 12, 34, 56.0, TimeSystem::GPS);
+   time2 = CivilTime(2016, 12, 31, 23, 0, 0.0, TimeSystem::GPS);
+
+      // satellites around the sky, some below the horizon
+   for (int i = 0; i < 12; i++)
+   {
+      Position sv;
+      sv.setGeodetic(rx.getGeodeticLatitude() + 20.*((i%5)-2),
+                     rx.getLongitude() + 30.*i, 20200.e3);
+      svs.push_back(sv);
+   }
+}
+
+
+void TropModel_T ::
+checkValue(TestUtil& testFramework, double exp, double got)
+{
+   if (isinf(exp))
+   {
+      TUASSERTE(double, exp, got);
+   }
+   else
+   {
+      TUASSERTFEPS(exp, got, eps);
+   }
+}
+
+
+void TropModel_T ::
+checkBatch(TestUtil& testFramework, const TropModel& model,
+           const TropBatch& batch)
+{
+   TUASSERTE(size_t, batch.elevation.size(), batch.corr.size());
+   TUASSERTE(size_t, batch.elevation.size(), batch.dryMap.size());
+   TUASSERTE(size_t, batch.elevation.size(), batch.wetMap.size());
+   TUASSERTFEPS(model.dry_zenith_delay(), batch.dryZenith, eps);
+   TUASSERTFEPS(model.wet_zenith_delay(), batch.wetZenith, eps);
+   for (size_t i = 0; i < batch.elevation.size(); i++)
+   {
+      double el = batch.elevation[i];
+      checkValue(testFramework, model.correction(el), batch.corr[i]);
+      checkValue(testFramework, model.dry_mapping_function(el),
+                 batch.dryMap[i]);
+      checkValue(testFramework, model.wet_mapping_function(el),
+                 batch.wetMap[i]);
+   }
+}
+
+
+int TropModel_T ::
+batchElevationTest()
+{
+   TUDEF("TropModel", "batchCorrection");
+
+   TropBatch batch;
+   batch.elevation = elevations;
+
+   SimpleTropModel simple(20., 1013., 50.);
+   simple.batchCorrection(batch);
+   checkBatch(testFramework, simple, batch);
+
+   SaasTropModel saas(rx.getGeodeticLatitude(), 170, 20., 1013., 50.);
+   saas.setReceiverHeight(rx.getHeight());
+   saas.batchCorrection(batch);
+   checkBatch(testFramework, saas, batch);
+
+   NeillTropModel neill;
+   neill.setReceiverHeight(rx.getAltitude());
+   neill.setReceiverLatitude(rx.getGeodeticLatitude());
+   neill.setDayOfYear(170);
+   neill.batchCorrection(batch);
+   checkBatch(testFramework, neill, batch);
+
+   GlobalTropModel global(rx, time);
+   global.batchCorrection(batch);
+   checkBatch(testFramework, global, batch);
+
+   GCATTropModel gcat(rx.getAltitude());
+   gcat.batchCorrection(batch);
+   checkBatch(testFramework, gcat, batch);
+
+   MOPSTropModel mops(rx, time);
+   mops.batchCorrection(batch);
+   checkBatch(testFramework, mops, batch);
+
+      // through the base class
+   TropModel *ptm = &neill;
+   TropBatch batch2;
+   batch2.elevation = elevations;
+   ptm->batchCorrection(batch2);
+   checkBatch(testFramework, neill, batch2);
+
+   ZeroTropModel zero;
+   zero.batchCorrection(batch);
+   checkBatch(testFramework, zero, batch);
+
+      // an empty batch still gives the zenith delays
+   TropBatch empty;
+   global.batchCorrection(empty);
+   TUASSERTE(size_t, 0, empty.corr.size());
+   TUASSERTFEPS(global.dry_zenith_delay(), empty.dryZenith, eps);
+
+      // invalid models throw as the scalar functions do
+   try
+   {
+      NeillTropModel bad;
+      bad.batchCorrection(batch);
+      TUFAIL("Invalid model did not throw");
+   }
+   catch (InvalidTropModel& e)
+   {
+      TUPASS("Invalid model threw");
+   }
+   TURETURN();
+}
+
+
+int TropModel_T ::
+batchGeometryTest()
 {
-	return 0; //Return the total number of errors
+   TUDEF("TropModel", "batchCorrection");
+
+   TropModel *batchModels[] = { new SaasTropModel(0., 1, 20., 1013., 50.),
+                                new NeillTropModel(),
+                                new GlobalTropModel(),
+                                new GCATTropModel(),
+                                new MOPSTropModel() };
+   TropModel *scalarModels[] = { new SaasTropModel(0., 1, 20., 1013., 50.),
+                                 new NeillTropModel(),
+                                 new GlobalTropModel(),
+                                 new GCATTropModel(),
+                                 new MOPSTropModel() };
+   const size_t nModels = sizeof(batchModels)/sizeof(batchModels[0]);
+
+   for (size_t m = 0; m < nModels; m++)
+   {
+      TropBatch batch;
+      batchModels[m]->batchCorrection(rx, svs, time, batch);
+      TUASSERTE(size_t, svs.size(), batch.elevation.size());
+      for (size_t i = 0; i < svs.size(); i++)
+      {
+         double exp = scalarModels[m]->correction(rx, svs[i], time);
+         TUASSERTFEPS(exp, batch.corr[i], eps);
+      }
+      checkBatch(testFramework, *batchModels[m], batch);
+   }
+
+      // elevations as the scalar models compute them
+   TropBatch batch;
+   batchModels[2]->batchCorrection(rx, svs, time, batch);
+   for (size_t i = 0; i < svs.size(); i++)
+      TUASSERTFEPS(rx.elevationGeodetic(svs[i]), batch.elevation[i], eps);
+   batchModels[0]->batchCorrection(rx, svs, time, batch);
+   for (size_t i = 0; i < svs.size(); i++)
+      TUASSERTFEPS(rx.elevation(svs[i]), batch.elevation[i], eps);
+
+   for (size_t m = 0; m < nModels; m++)
+   {
+      delete batchModels[m];
+      delete scalarModels[m];
+   }
+   TURETURN();
+}
+
+
+int TropModel_T ::
+cacheTest()
+{
+   TUDEF("TropModel", "batchCorrection");
+
+   TropBatch batch;
+
+      // move one model between receivers and times; it must agree with
+      // a model set up from scratch each time
+   GlobalTropModel global;
+   MOPSTropModel mops;
+   Position rxs[] = { rx, rx2, rx, rx };
+   CommonTime times[] = { time, time, time2, time };
+   for (int k = 0; k < 4; k++)
+   {
+      global.batchCorrection(rxs[k], svs, times[k], batch);
+      GlobalTropModel fresh;
+      TUASSERTFEPS(fresh.correction(rxs[k], svs[0], times[k]),
+                   batch.corr[0], eps);
+      checkBatch(testFramework, fresh, batch);
+      double P, T, U, P2, T2, U2;
+      global.getGPT(P, T, U);
+      fresh.getGPT(P2, T2, U2);
+      TUASSERTFEPS(P2, P, eps);
+      TUASSERTFEPS(T2, T, eps);
+      TUASSERTFEPS(U2, U, eps);
+
+      mops.batchCorrection(rxs[k], svs, times[k], batch);
+      MOPSTropModel freshMops;
+      TUASSERTFEPS(freshMops.correction(rxs[k], svs[0], times[k]),
+                   batch.corr[0], eps);
+      checkBatch(testFramework, freshMops, batch);
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   TropModel_T testClass;
+
+   errorTotal += testClass.batchElevationTest();
+   errorTotal += testClass.batchGeometryTest();
+   errorTotal += testClass.cacheTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
 }
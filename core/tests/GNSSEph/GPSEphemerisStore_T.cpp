@@ -2,6 +2,9 @@
 #include "CivilTime.hpp"
 #include "TimeString.hpp"
 #include "TestUtil.hpp"
+#include "Rinex3NavStream.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavData.hpp"
 
 using namespace std;
 
@@ -234,6 +237,147 @@ public:
 
       TURETURN();
    }
+
+
+      /** Make sure that lookups with the flat index give the same
+       * ephemerides as lookups in the maps, with both search methods
+       * and with times in increasing, decreasing and jumping order. */
+   unsigned doIndexTests()
+   {
+      TUDEF("GPSEphemerisStore","buildIndex");
+      try
+      {
+         string fn(gpstk::getPathData() + gpstk::getFileSep() +
+                   "arlm200a.15n");
+         gpstk::GPSEphemerisStore store, indexed, other;
+         gpstk::Rinex3NavStream strm(fn.c_str());
+         gpstk::Rinex3NavHeader hdr;
+         gpstk::Rinex3NavData rnd;
+         strm >> hdr;
+         while (strm >> rnd)
+         {
+            gpstk::GPSEphemeris eph(rnd);
+            store.addEphemeris(eph);
+            indexed.addEphemeris(eph);
+            other.addEphemeris(eph);
+         }
+         store.rationalize();
+         indexed.rationalize();
+         other.rationalize();
+         TUASSERT(!indexed.isIndexed());
+         indexed.buildIndex();
+         TUASSERT(indexed.isIndexed());
+         TUASSERT(store.size() > 20);
+
+            // times from before the first to after the last
+            // ephemeris, every 5 minutes, plus the exact beginnings
+            // of validity
+         vector<gpstk::CommonTime> times;
+         for (gpstk::CommonTime t = store.getInitialTime() - 7200.;
+              t <= store.getFinalTime() + 7200.; t += 300.)
+            times.push_back(t);
+         list<gpstk::OrbitEph*> ephList;
+         store.OrbitEphStore::addToList(ephList);
+         for (list<gpstk::OrbitEph*>::iterator i = ephList.begin();
+              i != ephList.end(); i++)
+         {
+            times.push_back((*i)->beginValid);
+            delete *i;
+         }
+         vector<gpstk::CommonTime> order(times);
+         sort(order.begin(), order.end());
+         vector<gpstk::CommonTime> reverse(order.rbegin(), order.rend());
+         vector<gpstk::CommonTime> jumps;
+         for (size_t i = 0; i < order.size(); i++)
+            jumps.push_back(order[(i * 37) % order.size()]);
+
+         size_t mismatch = 0, found = 0;
+         for (int method = 0; method < 2; method++)
+         {
+            if (method == 0)
+            {
+               store.SearchUser();
+               indexed.SearchUser();
+            }
+            else
+            {
+               store.SearchNear();
+               indexed.SearchNear();
+            }
+            const vector<gpstk::CommonTime>* lists[] =
+               { &order, &reverse, &jumps };
+            for (int l = 0; l < 3; l++)
+            {
+               for (int prn = 1; prn <= 33; prn++)
+               {
+                  gpstk::SatID sat(prn, gpstk::SatID::systemGPS);
+                  for (size_t i = 0; i < lists[l]->size(); i++)
+                  {
+                     const gpstk::CommonTime& t((*lists[l])[i]);
+                     const gpstk::OrbitEph *exp = store.findOrbitEph(sat, t);
+                     const gpstk::OrbitEph *got = indexed.findOrbitEph(sat, t);
+                     if (exp != NULL)
+                        found++;
+                     if ((exp == NULL) != (got == NULL) ||
+                         ((exp != NULL) && (exp->ctToe != got->ctToe)))
+                        mismatch++;
+                  }
+               }
+            }
+         }
+         TUASSERT(found > 0);
+         TUASSERTE(size_t, 0, mismatch);
+
+            // two indexed stores searched alternately, each keeping
+            // its own position
+         other.buildIndex();
+         store.SearchUser();
+         indexed.SearchUser();
+         other.SearchUser();
+         mismatch = 0;
+         for (int prn = 1; prn <= 33; prn++)
+         {
+            gpstk::SatID sat(prn, gpstk::SatID::systemGPS);
+            for (size_t i = 0; i < order.size(); i++)
+            {
+               const gpstk::CommonTime& t(order[i]);
+               const gpstk::CommonTime& tr(reverse[i]);
+               const gpstk::OrbitEph *exp = store.findOrbitEph(sat, t);
+               const gpstk::OrbitEph *expr = store.findOrbitEph(sat, tr);
+               const gpstk::OrbitEph *got = indexed.findOrbitEph(sat, t);
+               const gpstk::OrbitEph *gotr = other.findOrbitEph(sat, tr);
+               if ((exp == NULL) != (got == NULL) ||
+                   ((exp != NULL) && (exp->ctToe != got->ctToe)))
+                  mismatch++;
+               if ((expr == NULL) != (gotr == NULL) ||
+                   ((expr != NULL) && (expr->ctToe != gotr->ctToe)))
+                  mismatch++;
+            }
+         }
+         TUASSERTE(size_t, 0, mismatch);
+
+            // changing the store drops the index
+         TUCSM("isIndexed");
+         indexed.edit(store.getInitialTime(), store.getFinalTime());
+         TUASSERT(!indexed.isIndexed());
+         indexed.buildIndex();
+         indexed.clear();
+         TUASSERT(!indexed.isIndexed());
+         TUASSERT(indexed.findOrbitEph(gpstk::SatID(1, gpstk::SatID::systemGPS),
+                                       order[0]) == NULL);
+      }
+      catch (gpstk::Exception &exc)
+      {
+         cerr << exc << endl;
+         TUFAIL("Unexpected exception");
+      }
+      catch (...)
+      {
+         TUFAIL("Unexpected exception");
+      }
+
+      TURETURN();
+   }
 };
 
 
@@ -242,6 +386,7 @@ int main(int argc, char *argv[])
    unsigned total = 0;
    GPSEphemerisStore_T testClass;
    total += testClass.doGetPrnXvtTests();
+   total += testClass.doIndexTests();
 
    cout << "Total Failures for " << __FILE__ << ": " << total << endl;
    return total;
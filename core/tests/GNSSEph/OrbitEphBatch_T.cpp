@@ -0,0 +1,268 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "OrbitEphBatch.hpp"
+#include "GPSEphemeris.hpp"
+#include "Rinex3NavStream.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavData.hpp"
+#include "TestUtil.hpp"
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace gpstk;
+
+class OrbitEphBatch_T
+{
+public:
+   OrbitEphBatch_T();
+
+      /// evaluate each ephemeris at many times and compare with svXvt
+   int timesTest();
+      /// evaluate all ephemerides at one time and compare with svXvt
+   int epochTest();
+      /// CNAV-style ephemerides with non-zero Adot and dndot
+   int modernizedTest();
+      /// check the error handling
+   int errorTest();
+
+private:
+      /// Count the values of \a batch that differ at all from \a exp.
+   static size_t countDiff(const Xvt& exp, const Xvt& batch);
+
+   vector<GPSEphemeris> ephs;
+};
+
+
+OrbitEphBatch_T ::
+OrbitEphBatch_T()
+{
+   string dataFilePath = gpstk::getPathData() + gpstk::getFileSep();
+   vector<string> files;
+   files.push_back(dataFilePath + "arlm200a.15n");
+   files.push_back(dataFilePath + "test_input_rinex3_76193040.14n");
+   for (size_t f = 0; f < files.size(); f++)
+   {
+      Rinex3NavStream strm(files[f].c_str());
+      Rinex3NavHeader hdr;
+      Rinex3NavData rnd;
+      strm >> hdr;
+      while (strm >> rnd)
+      {
+         if (rnd.satSys == "G")
+            ephs.push_back(GPSEphemeris(rnd));
+      }
+   }
+}
+
+
+size_t OrbitEphBatch_T ::
+countDiff(const Xvt& exp, const Xvt& batch)
+{
+   size_t count = 0;
+   for (int i = 0; i < 3; i++)
+   {
+      count += (exp.x[i] != batch.x[i]);
+      count += (exp.v[i] != batch.v[i]);
+   }
+   count += (exp.clkbias != batch.clkbias);
+   count += (exp.clkdrift != batch.clkdrift);
+   count += (exp.relcorr != batch.relcorr);
+   count += (exp.frame != batch.frame);
+   return count;
+}
+
+
+int OrbitEphBatch_T ::
+timesTest()
+{
+   TUDEF("OrbitEphBatch", "svXvt");
+
+   TUASSERT(ephs.size() > 10);
+   OrbitEphBatch batch;
+   for (size_t i = 0; i < ephs.size(); i++)
+      TUASSERTE(size_t, i, batch.add(ephs[i]));
+   TUASSERTE(size_t, ephs.size(), batch.size());
+
+      // 97 times, so the last block is a partial one
+   size_t diff = 0;
+   for (size_t i = 0; i < ephs.size(); i++)
+   {
+      vector<CommonTime> times;
+      for (double dt = -14400.; dt <= 14400.; dt += 300.)
+         times.push_back(ephs[i].ctToe + dt);
+      vector<Xvt> xvt;
+      batch.svXvt(i, times, xvt);
+      TUASSERTE(size_t, times.size(), xvt.size());
+      TUASSERTE(SatID, ephs[i].satID, batch.getSatID(i));
+      for (size_t k = 0; k < times.size(); k++)
+         diff += countDiff(ephs[i].svXvt(times[k]), xvt[k]);
+   }
+   TUASSERTE(size_t, 0, diff);
+   TURETURN();
+}
+
+
+int OrbitEphBatch_T ::
+epochTest()
+{
+   TUDEF("OrbitEphBatch", "svXvt");
+
+      // more than one block of ephemerides
+   OrbitEphBatch batch;
+   while (batch.size() <= OrbitEphBatch::blockSize)
+      for (size_t i = 0; i < ephs.size(); i++)
+         batch.add(ephs[i]);
+
+   CommonTime t(ephs[0].ctToe + 1234.5);
+   vector<Xvt> xvt;
+   batch.svXvt(t, xvt);
+   TUASSERTE(size_t, batch.size(), xvt.size());
+   size_t diff = 0;
+   for (size_t k = 0; k < xvt.size(); k++)
+      diff += countDiff(ephs[k % ephs.size()].svXvt(t), xvt[k]);
+   TUASSERTE(size_t, 0, diff);
+
+   batch.clear();
+   TUASSERTE(size_t, 0, batch.size());
+   batch.svXvt(t, xvt);
+   TUASSERTE(size_t, 0, xvt.size());
+   TURETURN();
+}
+
+
+int OrbitEphBatch_T ::
+modernizedTest()
+{
+   TUDEF("OrbitEphBatch", "svXvt");
+
+      // Mix ephemerides with and without the CNAV rate terms, which
+      // need a separate Kepler solution for the relativity correction.
+   vector<GPSEphemeris> mod(ephs);
+   for (size_t i = 0; i < mod.size(); i += 2)
+   {
+      mod[i].Adot = 0.01 * (i+1);
+      mod[i].dndot = -1.5e-13 * (i+1);
+   }
+   OrbitEphBatch batch;
+   for (size_t i = 0; i < mod.size(); i++)
+      batch.add(mod[i]);
+
+   size_t diff = 0;
+   for (double dt = -7200.; dt <= 7200.; dt += 900.)
+   {
+      CommonTime t(mod[0].ctToe + dt);
+      vector<Xvt> xvt;
+      batch.svXvt(t, xvt);
+      for (size_t k = 0; k < mod.size(); k++)
+         diff += countDiff(mod[k].svXvt(t), xvt[k]);
+   }
+   TUASSERTE(size_t, 0, diff);
+   TURETURN();
+}
+
+
+int OrbitEphBatch_T ::
+errorTest()
+{
+   TUDEF("OrbitEphBatch", "add");
+
+   OrbitEphBatch batch;
+   try
+   {
+      batch.add(GPSEphemeris());
+      TUFAIL("Empty ephemeris was accepted");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("Empty ephemeris rejected");
+   }
+
+   OrbitEph geo(ephs[0]);
+   geo.satID = SatID(3, SatID::systemBeiDou);
+   try
+   {
+      batch.add(geo);
+      TUFAIL("BeiDou GEO ephemeris was accepted");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("BeiDou GEO ephemeris rejected");
+   }
+
+   TUCSM("svXvt");
+   batch.add(ephs[0]);
+   vector<CommonTime> times(1, ephs[0].ctToe);
+   vector<Xvt> xvt;
+   try
+   {
+      batch.svXvt(1, times, xvt);
+      TUFAIL("Index out of range was accepted");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("Index out of range rejected");
+   }
+   try
+   {
+      times[0].setTimeSystem(TimeSystem::GLO);
+      batch.svXvt(0, times, xvt);
+      TUFAIL("Incompatible time system was accepted");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("Incompatible time system rejected");
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   OrbitEphBatch_T testClass;
+
+   errorTotal += testClass.timesTest();
+   errorTotal += testClass.epochTest();
+   errorTotal += testClass.modernizedTest();
+   errorTotal += testClass.errorTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,185 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file PositionSatStoreTiming.cpp
+ * Time SP3 orbit interpolation over a full day at 1 Hz.
+ *
+ * Usage: PositionSatStoreTiming [-s step] [file ...]
+ *
+ * With no files given, a full day of 15-minute SP3 data from the
+ * test data directory is used.  Every satellite in the store is
+ * interpolated at every \c step seconds (default 1) from the first
+ * to the last epoch, through SP3EphemerisStore::getXvt().  The same
+ * Lagrange interpolation of position and velocity is then repeated
+ * with one call of LagrangeInterpolation() per component, the way
+ * PositionSatStore used to do it, and with LagrangeWeights, and the
+ * CPU times and the largest difference are reported. */
+
+#include <ctime>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+
+#include "SP3EphemerisStore.hpp"
+#include "LagrangeWeights.hpp"
+#include "MiscMath.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+int main(int argc, char *argv[])
+{
+   double step = 1.0;
+   vector<string> files;
+   for (int i = 1; i < argc; i++)
+   {
+      if ((strcmp(argv[i], "-s") == 0) && (i+1 < argc))
+         step = atof(argv[++i]);
+      else
+         files.push_back(argv[i]);
+   }
+   if (files.empty())
+      files.push_back(getPathData() + getFileSep() +
+                      "test_input_sp3_nav_ephemerisData.sp3");
+
+   try
+   {
+      SP3EphemerisStore store;
+      for (size_t f = 0; f < files.size(); f++)
+         store.loadFile(files[f]);
+
+      vector<SatID> sats(store.getSatList());
+      CommonTime t0(store.getPositionInitialTime()),
+         t1(store.getPositionFinalTime());
+      cout << "Interpolating " << sats.size() << " satellites every "
+           << step << " s over " << (t1-t0)/3600.0 << " hours" << endl;
+
+         // through the store
+      unsigned long count = 0, fails = 0;
+      clock_t c0 = clock();
+      for (CommonTime t = t0; t <= t1; t += step)
+      {
+         for (size_t s = 0; s < sats.size(); s++)
+         {
+            try
+            {
+               Xvt xvt(store.getXvt(sats[s], t));
+               count++;
+            }
+            catch (InvalidRequest& e)
+            {
+               fails++;
+            }
+         }
+      }
+      clock_t c1 = clock();
+      double ts = double(c1 - c0) / CLOCKS_PER_SEC;
+      cout << "getXvt: " << count << " positions (" << fails
+           << " not available) in " << fixed << setprecision(3) << ts
+           << " s, " << setprecision(2)
+           << (count > 0 ? 1.e6*ts/count : 0.) << " us each" << endl;
+
+         // the interpolation kernels alone, on a 10-point 900 s grid
+         // with synthetic orbit-like data
+      const int N = 10;
+      const double dt = 900.0;
+      vector<double> X(N), Y[3];
+      for (int i = 0; i < N; i++)
+      {
+         X[i] = dt*i;
+         for (int k = 0; k < 3; k++)
+            Y[k].push_back(26560.0*sin(1.4584e-4*X[i] + 2.1*k));
+      }
+      unsigned long nk = 0;
+      double sum1 = 0.0, sum2 = 0.0, maxdiff = 0.0;
+      c0 = clock();
+      for (double x = 4*dt; x < 5*dt; x += step)
+      {
+         for (size_t s = 0; s < sats.size(); s++)
+         {
+            for (int k = 0; k < 3; k++)
+            {
+               double p, v;
+               LagrangeInterpolation(X, Y[k], x, p, v);
+               sum1 += p + v;
+            }
+            nk++;
+         }
+      }
+      c1 = clock();
+      LagrangeWeights lw;
+      for (double x = 4*dt; x < 5*dt; x += step)
+      {
+         for (size_t s = 0; s < sats.size(); s++)
+         {
+            lw.computeRegular(N, dt, x);
+            for (int k = 0; k < 3; k++)
+            {
+               double p(lw.interpolate(Y[k])), v(lw.derivative(Y[k]));
+               sum2 += p + v;
+               if (s == 0)
+               {
+                  double pp, vv;
+                  LagrangeInterpolation(X, Y[k], x, pp, vv);
+                  maxdiff = max(maxdiff, max(fabs(p-pp), fabs(v-vv)));
+               }
+            }
+         }
+      }
+      clock_t c2 = clock();
+      double tl = double(c1 - c0) / CLOCKS_PER_SEC;
+      double tw = double(c2 - c1) / CLOCKS_PER_SEC;
+      cout << "per-component LagrangeInterpolation: " << setprecision(3)
+           << tl << " s for " << nk << " satellite positions" << endl
+           << "LagrangeWeights:                     " << tw << " s, ratio "
+           << setprecision(2) << (tw > 0 ? tl/tw : 0.) << endl
+           << "largest difference " << scientific << setprecision(2)
+           << maxdiff << " (sums " << setprecision(15) << sum1 << " "
+           << sum2 << ")" << endl;
+   }
+   catch (Exception& e)
+   {
+      cerr << e << endl;
+      return 1;
+   }
+   return 0;
+}
@@ -1,15 +1,304 @@
+#include "XvtStore.hpp"
+#include "GPSEphemerisStore.hpp"
+#include "SP3EphemerisStore.hpp"
+#include "Rinex3EphemerisStore.hpp"
+#include "Rinex3NavStream.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavData.hpp"
+#include "ThreadPool.hpp"
 #include "TestUtil.hpp"
+#include <functional>
 #include <iostream>
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace gpstk;
 
 class XvtStore_T
 {
 public:
-   XvtStore_T() {} // Default Constructor, set the precision value
-   ~XvtStore_T() {} // Default Desructor
+   XvtStore_T();
+
+      /// check that a frozen store refuses to be changed
+   int freezeTest();
+      /** call getXvt from many threads at once on a frozen store
+       * and compare with single-threaded results */
+   int concurrencyTest(XvtStore<SatID>& store, const string& name,
+                       unsigned numThreads, unsigned numJobs);
+
+   GPSEphemerisStore gpsStore;
+   SP3EphemerisStore sp3Store;
+   Rinex3EphemerisStore rinStore;
+
+private:
+      /// One (satellite, time) lookup
+   struct Query
+   {
+      SatID sat;
+      CommonTime time;
+   };
+
+      /// Result of a lookup; ok is false if getXvt threw
+   struct Result
+   {
+      Result() : ok(false) {}
+      bool ok;
+      Xvt xvt;
+      bool operator==(const Result& r) const
+      {
+         return (ok == r.ok) &&
+            (!ok || ((xvt.x == r.xvt.x) && (xvt.v == r.xvt.v) &&
+                     (xvt.clkbias == r.xvt.clkbias) &&
+                     (xvt.clkdrift == r.xvt.clkdrift) &&
+                     (xvt.relcorr == r.xvt.relcorr)));
+      }
+   };
+
+      /** One worker: evaluate every query, starting at query #start
+       * and going forward or backward, so that the threads are
+       * looking at different times and satellites. */
+   struct Job
+   {
+      const XvtStore<SatID> *store;
+      const vector<Query> *queries;
+      size_t start;
+      bool reverse;
+      vector<Result> results;
+      void run()
+      {
+         size_t n = queries->size();
+         results.resize(n);
+         for (size_t k = 0; k < n; k++)
+         {
+            size_t i = (start + (reverse ? n-k : k)) % n;
+            results[i] = lookup(*store, (*queries)[i]);
+         }
+      }
+   };
+
+   static Result lookup(const XvtStore<SatID>& store, const Query& q);
+
+   string dataFilePath;
 };
 
 
-int main() //Main function to initialize and run all tests above
+XvtStore_T ::
+XvtStore_T()
+{
+   dataFilePath = gpstk::getPathData() + gpstk::getFileSep();
+   string navFile(dataFilePath + "arlm200a.15n");
+   Rinex3NavStream strm(navFile.c_str());
+   Rinex3NavHeader hdr;
+   Rinex3NavData rnd;
+   strm >> hdr;
+   while (strm >> rnd)
+      gpsStore.addEphemeris(GPSEphemeris(rnd));
+   gpsStore.rationalize();
+   sp3Store.loadFile(dataFilePath + "test_input_sp3_nav_2015_200.sp3");
+   rinStore.loadFile(navFile);
+}
+
+
+XvtStore_T::Result XvtStore_T ::
+lookup(const XvtStore<SatID>& store, const Query& q)
+{
+   Result r;
+   try
+   {
+      r.xvt = store.getXvt(q.sat, q.time);
+      r.ok = true;
+   }
+   catch (InvalidRequest& e)
+   {
+   }
+   return r;
+}
+
+
+int XvtStore_T ::
+freezeTest()
+{
+   TUDEF("XvtStore", "freeze");
+
+   GPSEphemerisStore gps;
+   Rinex3NavStream strm((dataFilePath + "arlm200a.15n").c_str());
+   Rinex3NavHeader hdr;
+   Rinex3NavData rnd;
+   strm >> hdr;
+   strm >> rnd;
+   GPSEphemeris eph(rnd);
+   gps.addEphemeris(eph);
+   TUASSERT(!gps.isFrozen());
+   gps.freeze();
+   TUASSERT(gps.isFrozen());
+   TUASSERT(gps.isIndexed());
+   TUASSERT(gps.findOrbitEph(eph.satID, eph.ctToe) != NULL);
+   try
+   {
+      strm >> rnd;
+      gps.addEphemeris(GPSEphemeris(rnd));
+      TUFAIL("addEphemeris on a frozen store");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("addEphemeris refused");
+   }
+   try
+   {
+      gps.edit(eph.ctToe);
+      TUFAIL("edit on a frozen store");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("edit refused");
+   }
+   try
+   {
+      gps.SearchNear();
+      TUFAIL("SearchNear on a frozen store");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("SearchNear refused");
+   }
+   TUASSERTE(unsigned, 1, gps.size());
+   gps.thaw();
+   TUASSERT(!gps.isFrozen());
+   gps.SearchNear();
+   gps.freeze();
+   gps.clear();
+   TUASSERT(!gps.isFrozen());
+
+   SP3EphemerisStore sp3;
+   sp3.freeze();
+   try
+   {
+      sp3.loadFile(dataFilePath + "test_input_sp3_nav_2015_200.sp3");
+      TUFAIL("loadFile on a frozen store");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("loadFile refused");
+   }
+   try
+   {
+      sp3.addClockBias(SatID(1, SatID::systemGPS), eph.ctToe, 0.);
+      TUFAIL("addClockBias on a frozen store");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("addClockBias refused");
+   }
+
+   Rinex3EphemerisStore rin;
+   rin.freeze();
+   try
+   {
+      rin.loadFile(dataFilePath + "arlm200a.15n");
+      TUFAIL("loadFile on a frozen store");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("loadFile refused");
+   }
+   try
+   {
+      rin.SearchNear();
+      TUFAIL("SearchNear on a frozen store");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("SearchNear refused");
+   }
+   rin.thaw();
+   rin.SearchNear();
+   TUPASS("thaw");
+   TURETURN();
+}
+
+
+int XvtStore_T ::
+concurrencyTest(XvtStore<SatID>& store, const string& name,
+                unsigned numThreads, unsigned numJobs)
 {
-   return 0; //Return the total number of errors
+   TUDEF(name, "getXvt");
+
+      // every GPS satellite every 450 seconds, from an hour before
+      // to an hour after the data, so some lookups fail
+   vector<Query> queries;
+   for (CommonTime t = store.getInitialTime() - 3600.;
+        t <= store.getFinalTime() + 3600.; t += 450.)
+   {
+      for (int prn = 1; prn <= 32; prn++)
+      {
+         Query q;
+         q.sat = SatID(prn, SatID::systemGPS);
+         q.time = t;
+         q.time.setTimeSystem(TimeSystem::GPS);
+         queries.push_back(q);
+      }
+   }
+
+      // single-threaded reference, before freezing
+   vector<Result> expected;
+   size_t numOK = 0;
+   for (size_t i = 0; i < queries.size(); i++)
+   {
+      expected.push_back(lookup(store, queries[i]));
+      numOK += expected.back().ok;
+   }
+   TUASSERT(numOK > 0);
+   TUASSERT(numOK < queries.size());
+
+   store.freeze();
+   vector<Job> jobs(numJobs);
+   for (unsigned j = 0; j < numJobs; j++)
+   {
+      jobs[j].store = &store;
+      jobs[j].queries = &queries;
+      jobs[j].start = (j * queries.size()) / numJobs;
+      jobs[j].reverse = (j % 2 == 1);
+   }
+   {
+      ThreadPool pool(numThreads);
+      for (unsigned j = 0; j < numJobs; j++)
+         pool.submit(std::bind(&Job::run, &jobs[j]));
+      pool.wait();
+   }
+
+   size_t mismatch = 0;
+   for (unsigned j = 0; j < numJobs; j++)
+   {
+      for (size_t i = 0; i < queries.size(); i++)
+      {
+         if (!(jobs[j].results[i] == expected[i]))
+            mismatch++;
+      }
+   }
+   TUASSERTE(size_t, 0, mismatch);
+   store.thaw();
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   XvtStore_T testClass;
+
+   errorTotal += testClass.freezeTest();
+   errorTotal += testClass.concurrencyTest(testClass.gpsStore,
+                                           "GPSEphemerisStore", 4, 8);
+   testClass.gpsStore.SearchNear();
+   errorTotal += testClass.concurrencyTest(testClass.gpsStore,
+                                           "GPSEphemerisStore", 4, 8);
+   errorTotal += testClass.concurrencyTest(testClass.sp3Store,
+                                           "SP3EphemerisStore", 4, 8);
+   errorTotal += testClass.concurrencyTest(testClass.rinStore,
+                                           "Rinex3EphemerisStore", 4, 8);
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
 }
@@ -0,0 +1,274 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "FixedMatrix.hpp"
+#include "TestUtil.hpp"
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+using namespace gpstk;
+
+   // count the calls of operator new, to show that fixed-size
+   // arithmetic does not allocate
+static size_t allocCount = 0;
+
+void* operator new(size_t n)
+{
+   allocCount++;
+   void *p = malloc(n ? n : 1);
+   if (!p)
+      throw bad_alloc();
+   return p;
+}
+
+void operator delete(void *p) throw()
+{
+   free(p);
+}
+
+
+class FixedMatrix_T
+{
+public:
+   FixedMatrix_T();
+
+      /// results must equal those of Matrix and Vector
+   int operatorsTest();
+      /// conversions to and from Matrix and Vector
+   int interoperabilityTest();
+      /// inverseChol() must agree with the Matrix version
+   int inverseCholTest();
+      /// none of the above may allocate
+   int allocationTest();
+
+private:
+   FixedMatrix<double,4,3> A;
+   FixedMatrix<double,3,3> S;
+   FixedVector<double,3> x, y;
+};
+
+
+FixedMatrix_T ::
+FixedMatrix_T()
+{
+   for (size_t i = 0; i < 4; i++)
+      for (size_t j = 0; j < 3; j++)
+         A(i,j) = 1.0 + i - 0.5*j + 0.1*i*j;
+      // symmetric positive definite
+   S(0,0) = 4.0; S(0,1) = 1.0; S(0,2) = 0.5;
+   S(1,0) = 1.0; S(1,1) = 3.0; S(1,2) = -0.2;
+   S(2,0) = 0.5; S(2,1) = -0.2; S(2,2) = 2.0;
+   x(0) = 1.0; x(1) = -2.0; x(2) = 0.25;
+   y(0) = 0.5; y(1) = 3.0; y(2) = -1.0;
+}
+
+
+int FixedMatrix_T ::
+operatorsTest()
+{
+   TUDEF("FixedMatrix", "operators");
+
+   Matrix<double> mA(A), mS(S);
+   Vector<double> vx(x), vy(y);
+
+   Matrix<double> expProd(mA * mS), expSum(mS + transpose(mS) - 2.0*mS);
+   Vector<double> expMV(mS * vx), expVec(2.0*vx - vy + vx/4.0);
+   FixedMatrix<double,4,3> prod(A * S);
+   FixedMatrix<double,3,3> sum(S + transpose(S) - 2.0*S);
+   FixedVector<double,3> mv(S * x), vec(2.0*x - y + x/4.0), neg(-x);
+   for (size_t i = 0; i < 4; i++)
+      for (size_t j = 0; j < 3; j++)
+         TUASSERTFE(expProd(i,j), prod(i,j));
+   for (size_t i = 0; i < 3; i++)
+   {
+      TUASSERTFE(expMV(i), mv(i));
+      TUASSERTFE(expVec(i), vec(i));
+      TUASSERTFE(-vx(i), neg(i));
+      for (size_t j = 0; j < 3; j++)
+         TUASSERTFE(expSum(i,j), sum(i,j));
+   }
+
+      // normal matrix
+   Matrix<double> expATA(transpose(mA) * mA);
+   FixedMatrix<double,3,3> ata(transpose(A) * A);
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 3; j++)
+         TUASSERTFE(expATA(i,j), ata(i,j));
+
+      // outer products, accumulated
+   FixedMatrix<double,3,3> op(0.0);
+   op += outer(x, y);
+   op -= outer(y, x);
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 3; j++)
+         TUASSERTFE(x(i)*y(j) - y(i)*x(j), op(i,j));
+
+   TUASSERTFE(dot(vx, vy), dot(x, y));
+   TUASSERTFE(norm(vx), norm(x));
+
+      // a transpose assigned to its own argument
+   FixedMatrix<double,3,3> t(op);
+   t = transpose(t);
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 3; j++)
+         TUASSERTFE(op(j,i), t(i,j));
+
+   FixedMatrix<double,3,3> I(FixedMatrix<double,3,3>::identity());
+   FixedMatrix<double,3,3> SI(S * I);
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 3; j++)
+         TUASSERTFE(S(i,j), SI(i,j));
+   TURETURN();
+}
+
+
+int FixedMatrix_T ::
+interoperabilityTest()
+{
+   TUDEF("FixedMatrix", "FixedMatrix");
+
+      // mixed arithmetic gives Matrix and Vector
+   Matrix<double> mA(A);
+   Matrix<double> m(mA * S);
+   Vector<double> v(mA * x);
+   TUASSERTE(size_t, 4, m.rows());
+   TUASSERTE(size_t, 3, m.cols());
+   TUASSERTE(size_t, 4, v.size());
+   TUASSERTFE((A*S)(3,2), m(3,2));
+   TUASSERTFE((A*x)(2), v(2));
+
+      // copies from Matrix and Vector check the size
+   FixedMatrix<double,4,3> B(m);
+   TUASSERTFE(m(1,1), B(1,1));
+   FixedVector<double,4> w(v);
+   TUASSERTFE(v(3), w(3));
+   try
+   {
+      FixedMatrix<double,3,4> bad(m);
+      TUFAIL("Wrong dimensions were accepted");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("Wrong dimensions rejected");
+   }
+   try
+   {
+      FixedVector<double,3> bad;
+      bad = v;
+      TUFAIL("Wrong size was accepted");
+   }
+   catch (VectorException& e)
+   {
+      TUPASS("Wrong size rejected");
+   }
+
+      // Matrix functions take fixed matrices
+   Matrix<double> inv(inverseSVD(S));
+   FixedMatrix<double,3,3> check(S * FixedMatrix<double,3,3>(inv));
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 3; j++)
+         TUASSERTFEPS(i == j ? 1.0 : 0.0, check(i,j), 1.e-14);
+   TURETURN();
+}
+
+
+int FixedMatrix_T ::
+inverseCholTest()
+{
+   TUDEF("FixedMatrix", "inverseChol");
+
+   Matrix<double> exp(inverseChol(Matrix<double>(S)));
+   FixedMatrix<double,3,3> inv(inverseChol(S));
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 3; j++)
+         TUASSERTFE(exp(i,j), inv(i,j));
+
+   FixedMatrix<double,3,3> notPD(S);
+   notPD(2,2) = -1.0;
+   try
+   {
+      inv = inverseChol(notPD);
+      TUFAIL("Matrix that is not positive definite was inverted");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("Matrix that is not positive definite rejected");
+   }
+   TURETURN();
+}
+
+
+int FixedMatrix_T ::
+allocationTest()
+{
+   TUDEF("FixedMatrix", "allocation");
+
+   size_t before = allocCount;
+   FixedMatrix<double,3,3> N(0.0), C;
+   FixedVector<double,3> b(0.0), p;
+   for (size_t i = 0; i < 4; i++)
+   {
+      for (size_t j = 0; j < 3; j++)
+         p(j) = A(i,j);
+      N += outer(p, p);
+      b += (0.5*i) * p;
+   }
+   C = inverseChol(N + S);
+   FixedVector<double,3> sol(C * b - transpose(S) * x);
+   double d = dot(sol, x) + norm(sol);
+   size_t count = allocCount - before;
+   TUASSERTE(size_t, 0, count);
+   TUASSERT(d == d);
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   FixedMatrix_T testClass;
+
+   errorTotal += testClass.operatorsTest();
+   errorTotal += testClass.interoperabilityTest();
+   errorTotal += testClass.inverseCholTest();
+   errorTotal += testClass.allocationTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
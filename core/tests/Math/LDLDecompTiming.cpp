@@ -0,0 +1,172 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file LDLDecompTiming.cpp
+ * Measure the time to solve the normal equations of one epoch with
+ * inverseSVD(), inverseChol() and LDLDecomp.
+ *
+ * Usage: LDLDecompTiming [-n epochs]
+ *
+ * For 8 to 40 satellites, two systems are solved: the position and
+ * clock solution (4 unknowns, one pseudorange per satellite), and a
+ * float solution with an ambiguity per satellite (4+n unknowns,
+ * pseudorange and phase for each satellite).  Each method computes
+ * the covariance and the solution from AT*A and AT*y; the times
+ * reported are microseconds per epoch. */
+
+#include <ctime>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+
+#include "Matrix.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+   /** Design matrix of nsat satellites at pseudo-random positions
+    * above the horizon, with an ambiguity column per satellite if
+    * \a amb is true. */
+static Matrix<double> designMatrix(size_t nsat, bool amb, unsigned& seed)
+{
+   size_t rows = (amb ? 2*nsat : nsat), cols = (amb ? 4+nsat : 4);
+   Matrix<double> A(rows, cols, 0.);
+   for (size_t i = 0; i < nsat; i++)
+   {
+      seed = seed * 1103515245u + 12345u;
+      double az = double((seed >> 8) & 0xffff) / 65536. * 2. * M_PI;
+      seed = seed * 1103515245u + 12345u;
+      double el = (5. + double((seed >> 8) & 0xffff) / 65536. * 85.) * M_PI/180.;
+      double u[3] = { cos(el)*sin(az), cos(el)*cos(az), sin(el) };
+      for (size_t j = 0; j < 3; j++)
+      {
+         A(i,j) = -u[j];
+         if (amb)
+            A(nsat+i,j) = -u[j];
+      }
+      A(i,3) = 1.;
+      if (amb)
+      {
+            // phase is 100 times more precise than the pseudorange
+         for (size_t j = 0; j < 4; j++)
+            A(nsat+i,j) *= 100.;
+         A(nsat+i,3) = 100.;
+         A(nsat+i,4+i) = 100.;
+      }
+   }
+   return A;
+}
+
+
+   /// Time the three methods for one system, and print a line.
+static void timeSystem(size_t nsat, bool amb, unsigned long epochs)
+{
+   unsigned seed = 12345;
+   Matrix<double> A(designMatrix(nsat, amb, seed)), AT(transpose(A));
+   Matrix<double> N(AT*A), Cov;
+   Vector<double> y(A.rows()), b, x;
+   for (size_t i = 0; i < y.size(); i++)
+      y(i) = double(i % 7) - 3.;
+   b = AT*y;
+
+   double sum[3] = { 0., 0., 0. }, usec[3];
+   clock_t t0 = clock();
+   for (unsigned long e = 0; e < epochs; e++)
+   {
+      Cov = inverseSVD(N);
+      x = Cov*b;
+      sum[0] += x(0);
+   }
+   usec[0] = double(clock() - t0) / CLOCKS_PER_SEC / epochs * 1e6;
+
+   t0 = clock();
+   for (unsigned long e = 0; e < epochs; e++)
+   {
+      Cov = inverseChol(N);
+      x = Cov*b;
+      sum[1] += x(0);
+   }
+   usec[1] = double(clock() - t0) / CLOCKS_PER_SEC / epochs * 1e6;
+
+   LDLDecomp<double> ldl;
+   t0 = clock();
+   for (unsigned long e = 0; e < epochs; e++)
+   {
+      ldl(N);
+      ldl.inverse(Cov);
+      x = b;
+      ldl.backSub(x);
+      sum[2] += x(0);
+   }
+   usec[2] = double(clock() - t0) / CLOCKS_PER_SEC / epochs * 1e6;
+
+   cout << setw(6) << nsat << setw(6) << N.rows() << fixed
+        << setprecision(2) << setw(12) << usec[0] << setw(12) << usec[1]
+        << setw(12) << usec[2] << setprecision(3) << setw(10)
+        << usec[0]/usec[2] << setw(12) << scientific << setprecision(2)
+        << ldl.condition() << (ldl.usedSVD() ? "  SVD" : "")
+        << (fabs(sum[0]-sum[2]) > 1.e-6*fabs(sum[0]) ? "  MISMATCH" : "")
+        << endl;
+}
+
+
+int main(int argc, char *argv[])
+{
+   unsigned long epochs = 2000;
+   for (int i = 1; i < argc; i++)
+   {
+      if ((strcmp(argv[i], "-n") == 0) && (i+1 < argc))
+         epochs = strtoul(argv[++i], 0, 10);
+   }
+
+   size_t nsats[] = { 8, 12, 16, 24, 32, 40 };
+   const size_t nn = sizeof(nsats)/sizeof(nsats[0]);
+   for (int amb = 0; amb < 2; amb++)
+   {
+      cout << (amb ? "Float ambiguity solution" : "Position and clock")
+           << ", microseconds per epoch" << endl
+           << setw(6) << "nsat" << setw(6) << "dim" << setw(12) << "SVD"
+           << setw(12) << "Chol" << setw(12) << "LDL" << setw(10)
+           << "SVD/LDL" << setw(12) << "cond" << endl;
+      for (size_t i = 0; i < nn; i++)
+         timeSystem(nsats[i], amb != 0, amb ? epochs/10+1 : epochs);
+   }
+   return 0;
+}
@@ -0,0 +1,216 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "LagrangeWeights.hpp"
+#include "MiscMath.hpp"
+#include "TestUtil.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+class LagrangeWeights_T
+{
+public:
+      /// weights must reproduce polynomials of degree N-1 and their slopes
+   int polynomialTest();
+      /// compare with LagrangeInterpolation() in MiscMath
+   int miscMathTest();
+      /// the interpolant must equal the data at the nodes
+   int nodeTest();
+      /// computeRegular() must agree with compute(), cached or not
+   int regularTest();
+
+private:
+      /// a polynomial of degree 9 and its derivative
+   static double poly(double x);
+   static double polyDot(double x);
+};
+
+
+double LagrangeWeights_T ::
+poly(double x)
+{
+   double p(0.0);
+   for(int k=9; k>=0; k--)
+      p = p*x + (k+1)*(k%2 ? -0.5 : 1.0);
+   return p;
+}
+
+
+double LagrangeWeights_T ::
+polyDot(double x)
+{
+   double p(0.0);
+   for(int k=9; k>=1; k--)
+      p = p*x + k*(k+1)*(k%2 ? -0.5 : 1.0);
+   return p;
+}
+
+
+int LagrangeWeights_T ::
+polynomialTest()
+{
+   TUDEF("LagrangeWeights", "compute");
+
+   vector<double> X, Y;
+   for(int i=0; i<10; i++) {
+      X.push_back(-1.0 + 0.2*i + 0.01*i*i);
+      Y.push_back(poly(X.back()));
+   }
+   LagrangeWeights lw;
+   for(double x=-1.0; x<=1.2; x+=0.0137) {
+      lw.compute(X, x, true);
+      TUASSERTFEPS(poly(x), lw.interpolate(Y), 1.e-10);
+      TUASSERTFEPS(polyDot(x), lw.derivative(Y), 1.e-8);
+   }
+
+      // without derivative weights
+   lw.compute(X, 0.5);
+   TUASSERTE(size_t, 10, lw.weights().size());
+   TUASSERTE(size_t, 0, lw.derivativeWeights().size());
+   TURETURN();
+}
+
+
+int LagrangeWeights_T ::
+miscMathTest()
+{
+   TUDEF("LagrangeWeights", "interpolate");
+
+      // a satellite-like coordinate, km, on a 900 s grid
+   vector<double> X, Y;
+   for(int i=0; i<10; i++) {
+      X.push_back(900.0*i);
+      Y.push_back(26560.0*sin(1.4584e-4*X.back() + 0.3));
+   }
+   LagrangeWeights lw;
+   for(double x=3600.0; x<=4500.0; x+=1.0) {
+      double err, val, dval;
+      lw.compute(X, x, true);
+      TUASSERTFEPS(LagrangeInterpolation(X, Y, x, err),
+                   lw.interpolate(Y), 1.e-9);
+      LagrangeInterpolation(X, Y, x, val, dval);
+      TUASSERTFEPS(val, lw.interpolate(Y), 1.e-9);
+      TUASSERTFEPS(dval, lw.derivative(Y), 1.e-10);
+   }
+   TURETURN();
+}
+
+
+int LagrangeWeights_T ::
+nodeTest()
+{
+   TUDEF("LagrangeWeights", "compute");
+
+   vector<double> X, Y;
+   for(int i=0; i<8; i++) {
+      X.push_back(30.0*i*i + 7.0*i);
+      Y.push_back(1.e4*cos(0.01*X.back()) + 0.125*i);
+   }
+   LagrangeWeights lw;
+   for(size_t i=0; i<X.size(); i++) {
+      lw.compute(X, X[i], true);
+      TUASSERTE(double, Y[i], lw.interpolate(Y));
+   }
+   TURETURN();
+}
+
+
+int LagrangeWeights_T ::
+regularTest()
+{
+   TUDEF("LagrangeWeights", "computeRegular");
+
+   double step;
+   vector<double> X, Y;
+   for(int i=0; i<10; i++) {
+      X.push_back(300.0*i);
+      Y.push_back(poly(X.back()/2700.0 - 0.5));
+   }
+   TUASSERT(LagrangeWeights::isRegular(X, step));
+   TUASSERTE(double, 300.0, step);
+   X[7] += 1.0;
+   TUASSERT(!LagrangeWeights::isRegular(X, step));
+   X[7] -= 1.0;
+   vector<double> shifted(X);
+   for(size_t i=0; i<shifted.size(); i++)
+      shifted[i] += 10.0;
+   TUASSERT(!LagrangeWeights::isRegular(shifted, step));
+
+   LagrangeWeights lw, lwr;
+   bool same(true);
+      // twice, so that the second pass comes from the cache
+   for(int pass=0; pass<2; pass++) {
+      for(double x=1200.0; x<=1500.0; x+=1.0) {
+         lw.compute(X, x, true);
+         lwr.computeRegular(X.size(), 300.0, x);
+         same = same && (lw.weights() == lwr.weights())
+                     && (lw.derivativeWeights() == lwr.derivativeWeights());
+      }
+   }
+   TUASSERT(same);
+
+      // different grids at the same offset must not share weights
+   lwr.computeRegular(10, 300.0, 1234.0);
+   double v1(lwr.interpolate(Y));
+   lwr.computeRegular(8, 300.0, 1234.0);
+   TUASSERTE(size_t, 8, lwr.weights().size());
+   lwr.computeRegular(10, 900.0, 1234.0);
+   lw.compute(X, 1234.0/3.0, true);
+   TUASSERTFEPS(lw.interpolate(Y), lwr.interpolate(Y), 1.e-12);
+   lwr.computeRegular(10, 300.0, 1234.0);
+   TUASSERTE(double, v1, lwr.interpolate(Y));
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   LagrangeWeights_T testClass;
+
+   errorTotal += testClass.polynomialTest();
+   errorTotal += testClass.miscMathTest();
+   errorTotal += testClass.nodeTest();
+   errorTotal += testClass.regularTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
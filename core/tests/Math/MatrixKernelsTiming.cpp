@@ -0,0 +1,155 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file MatrixKernelsTiming.cpp
+ * Measure the speed of the Matrix products at the sizes of network
+ * PPP solutions.
+ *
+ * Usage: MatrixKernelsTiming [-max n] [-naive]
+ *
+ * For n parameters (100 to 2000, up to -max) and 2n observations,
+ * time the normal matrix AT*W*A and a covariance propagation
+ * F*P*transpose(F), computed as before with transpose() and the
+ * general operator* (only up to 500 parameters, unless -naive is
+ * given), and with transposeTimes()/timesTranspose() and the blocked
+ * kernels.  Times are in seconds; GFLOPS counts the multiply-adds of
+ * the products as two operations. */
+
+#include <ctime>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+
+#include "Matrix.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+   /// Matrix with pseudo-random elements
+static Matrix<double> randomMatrix(size_t r, size_t c, unsigned& seed)
+{
+   Matrix<double> m(r, c);
+   for (size_t j = 0; j < c; j++)
+   {
+      for (size_t i = 0; i < r; i++)
+      {
+         seed = seed * 1103515245u + 12345u;
+         m(i,j) = double((seed >> 8) & 0xffff) / 32768. - 1.;
+      }
+   }
+   return m;
+}
+
+
+   /// The general operator*, as used for every product before.
+static Matrix<double> general(const Matrix<double>& l, const Matrix<double>& r)
+{
+   const ConstMatrixBase<double, Matrix<double> >& lb(l);
+   return lb * r;
+}
+
+
+static double seconds(clock_t t0)
+{
+   return double(clock() - t0) / CLOCKS_PER_SEC;
+}
+
+
+int main(int argc, char *argv[])
+{
+   size_t maxN = 2000, maxNaive = 500;
+   for (int i = 1; i < argc; i++)
+   {
+      if ((strcmp(argv[i], "-max") == 0) && (i+1 < argc))
+         maxN = strtoul(argv[++i], 0, 10);
+      else if (strcmp(argv[i], "-naive") == 0)
+         maxNaive = 100000;
+   }
+
+   cout << "BLAS: " << (MatrixKernels::haveBLAS() ? "yes" : "no") << endl
+        << setw(6) << "n" << setw(14) << "ATWA before" << setw(12)
+        << "ATWA now" << setw(10) << "GFLOPS" << setw(14) << "FPFT before"
+        << setw(12) << "FPFT now" << setw(10) << "GFLOPS" << endl;
+
+   size_t sizes[] = { 100, 200, 500, 1000, 1500, 2000 };
+   for (size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++)
+   {
+      size_t n = sizes[s], m = 2*n;
+      if (n > maxN)
+         break;
+      unsigned seed = 42;
+      Matrix<double> A(randomMatrix(m, n, seed)), W(m, m, 0.),
+         F(randomMatrix(n, n, seed)), P(randomMatrix(n, n, seed)), N1, N2;
+      for (size_t i = 0; i < m; i++)
+         W(i,i) = 1. + double(i % 5);
+
+      cout << setw(6) << n << fixed << setprecision(3);
+      clock_t t0;
+      double t;
+      if (n <= maxNaive)
+      {
+         t0 = clock();
+         N1 = general(general(transpose(A), W), A);
+         cout << setw(14) << seconds(t0);
+      }
+      else
+         cout << setw(14) << "-";
+      t0 = clock();
+      N2 = transposeTimes(A, W) * A;
+      t = seconds(t0);
+      cout << setw(12) << t << setw(10) << setprecision(2)
+           << 2.*(double(n)*m*m + double(n)*n*m) / t / 1e9
+           << setprecision(3);
+
+      if (n <= maxNaive)
+      {
+         t0 = clock();
+         N1 = general(general(F, P), transpose(F));
+         cout << setw(14) << seconds(t0);
+      }
+      else
+         cout << setw(14) << "-";
+      t0 = clock();
+      N2 = timesTranspose(F*P, F);
+      t = seconds(t0);
+      cout << setw(12) << t << setw(10) << setprecision(2)
+           << 4.*double(n)*n*n / t / 1e9 << endl;
+   }
+   return 0;
+}
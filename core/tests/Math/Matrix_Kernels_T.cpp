@@ -0,0 +1,235 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "Matrix.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class Matrix_Kernels_T
+{
+public:
+      /// Matrix * Matrix must agree with the naive product
+   int multiplyTest();
+      /// transposeTimes, timesTranspose and transposeWeighted
+   int transposeTest();
+      /// the kernel for other element types and both transposes
+   int gemmTest();
+
+      /// Matrix with pseudo-random elements
+   static Matrix<double> randomMatrix(size_t r, size_t c, unsigned& seed);
+      /// l * r with the naive triple loop
+   static Matrix<double> naive(const Matrix<double>& l,
+                               const Matrix<double>& r);
+      /** Tolerance: the products are identical to the naive ones
+       * unless a BLAS is used (TUASSERTFEPS needs a non-zero value) */
+   static double tolerance()
+   { return MatrixKernels::haveBLAS() ? 1.e-12 : DBL_MIN; }
+};
+
+
+Matrix<double> Matrix_Kernels_T ::
+randomMatrix(size_t r, size_t c, unsigned& seed)
+{
+   Matrix<double> m(r, c);
+   for (size_t j = 0; j < c; j++)
+   {
+      for (size_t i = 0; i < r; i++)
+      {
+         seed = seed * 1103515245u + 12345u;
+         m(i,j) = double((seed >> 8) & 0xffff) / 32768. - 1.;
+      }
+   }
+   return m;
+}
+
+
+Matrix<double> Matrix_Kernels_T ::
+naive(const Matrix<double>& l, const Matrix<double>& r)
+{
+   Matrix<double> m(l.rows(), r.cols(), 0.);
+   for (size_t i = 0; i < m.rows(); i++)
+      for (size_t j = 0; j < m.cols(); j++)
+         for (size_t k = 0; k < l.cols(); k++)
+            m(i,j) += l(i,k) * r(k,j);
+   return m;
+}
+
+
+int Matrix_Kernels_T ::
+multiplyTest()
+{
+   TUDEF("Matrix", "operator*");
+   unsigned seed = 1;
+   double eps = tolerance();
+
+      // odd sizes, and sizes across the cache blocks
+   size_t dims[][3] = { {1,1,1}, {3,3,3}, {1,7,5}, {7,1,5}, {5,7,1},
+                        {4,4,4}, {9,6,11}, {130,5,257}, {129,131,3},
+                        {200,150,140} };
+   for (size_t d = 0; d < sizeof(dims)/sizeof(dims[0]); d++)
+   {
+      Matrix<double> l(randomMatrix(dims[d][0], dims[d][2], seed)),
+         r(randomMatrix(dims[d][2], dims[d][1], seed));
+      TUASSERTFEPS(naive(l, r), l * r, eps);
+   }
+
+      // the general version, given a slice
+   Matrix<double> l(randomMatrix(6, 4, seed)), r(randomMatrix(4, 5, seed));
+   MatrixSlice<double> ls(l, 0, 0, 6, 4);
+   TUASSERTFEPS(naive(l, r), ls * r, eps);
+
+      // empty inner dimension
+   Matrix<double> e1(3, 0), e2(0, 2);
+   Matrix<double> z(e1 * e2);
+   TUASSERTE(size_t, 3, z.rows());
+   TUASSERTE(size_t, 2, z.cols());
+   TUASSERTFE(0., z(2,1));
+
+   try
+   {
+      l * l;
+      TUFAIL("Incompatible dimensions were accepted");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("Incompatible dimensions rejected");
+   }
+   TURETURN();
+}
+
+
+int Matrix_Kernels_T ::
+transposeTest()
+{
+   TUDEF("Matrix", "transposeTimes");
+   unsigned seed = 2;
+   double eps = tolerance();
+
+   size_t dims[][3] = { {1,1,1}, {5,3,4}, {130,7,260}, {150,140,200} };
+   for (size_t d = 0; d < sizeof(dims)/sizeof(dims[0]); d++)
+   {
+      size_t m = dims[d][0], n = dims[d][1], k = dims[d][2];
+      Matrix<double> a(randomMatrix(k, m, seed)), b(randomMatrix(k, n, seed));
+      testFramework.changeSourceMethod("transposeTimes");
+      TUASSERTFEPS(naive(transpose(a), b), transposeTimes(a, b), eps);
+
+      Matrix<double> c(randomMatrix(m, k, seed)), e(randomMatrix(n, k, seed));
+      testFramework.changeSourceMethod("timesTranspose");
+      TUASSERTFEPS(naive(c, transpose(e)), timesTranspose(c, e), eps);
+   }
+
+   testFramework.changeSourceMethod("transposeWeighted");
+   Matrix<double> a(randomMatrix(40, 9, seed)), w(randomMatrix(40, 40, seed));
+   Vector<double> wd(40);
+   Matrix<double> wm(40, 40, 0.);
+   for (size_t i = 0; i < 40; i++)
+      wm(i,i) = wd(i) = 1. + double(i);
+   Matrix<double> ref(naive(naive(transpose(a), w), a));
+   TUASSERTFEPS(ref, transposeWeighted(a, w), 1.e-12);
+   ref = naive(naive(transpose(a), wm), a);
+   TUASSERTFEPS(ref, transposeWeighted(a, wd), 1.e-12);
+   TUASSERTFEPS(ref, transposeWeighted(a, wm), 1.e-12);
+
+   try
+   {
+      transposeTimes(a, Matrix<double>(39, 2));
+      TUFAIL("Incompatible dimensions were accepted");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("Incompatible dimensions rejected");
+   }
+   try
+   {
+      transposeWeighted(a, Vector<double>(39));
+      TUFAIL("Incompatible dimensions were accepted");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("Incompatible dimensions rejected");
+   }
+   TURETURN();
+}
+
+
+int Matrix_Kernels_T ::
+gemmTest()
+{
+   TUDEF("MatrixKernels", "gemm");
+
+      // float goes to the template kernel; both transposes, and the
+      // result is accumulated
+   size_t m = 133, n = 7, k = 150;
+   Matrix<float> a(k, m), b(n, k), c(m, n, 1.f), ref(m, n, 1.f);
+   for (size_t i = 0; i < k; i++)
+   {
+      for (size_t j = 0; j < m; j++)
+         a(i,j) = float((i*7 + j*3) % 11) - 5.f;
+      for (size_t j = 0; j < n; j++)
+         b(j,i) = float((i + j*5) % 7) - 3.f;
+   }
+   for (size_t i = 0; i < m; i++)
+      for (size_t j = 0; j < n; j++)
+         for (size_t p = 0; p < k; p++)
+            ref(i,j) += a(p,i) * b(j,p);
+   MatrixKernels::gemm(true, true, m, n, k, a.begin(), a.rows(),
+                       b.begin(), b.rows(), c.begin(), c.rows());
+      // small integers, so the sums are exact
+   bool same = true;
+   for (size_t i = 0; i < m; i++)
+      for (size_t j = 0; j < n; j++)
+         same = same && (ref(i,j) == c(i,j));
+   TUASSERT(same);
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   Matrix_Kernels_T testClass;
+
+   errorTotal += testClass.multiplyTest();
+   errorTotal += testClass.transposeTest();
+   errorTotal += testClass.gemmTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
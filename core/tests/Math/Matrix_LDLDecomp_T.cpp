@@ -0,0 +1,355 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "Matrix.hpp"
+#include "TestUtil.hpp"
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+using namespace gpstk;
+
+   // count the calls of operator new, to show that a repeated
+   // decomposition reuses its storage
+static size_t allocCount = 0;
+
+void* operator new(size_t n)
+{
+   allocCount++;
+   void *p = malloc(n ? n : 1);
+   if (!p)
+      throw bad_alloc();
+   return p;
+}
+
+void operator delete(void *p) throw()
+{
+   free(p);
+}
+
+
+class Matrix_LDLDecomp_T
+{
+public:
+      /// solutions of small systems with known answers
+   int solveTest();
+      /// inverse() and backSub() must agree with inverseSVD(), for any
+      /// block size
+   int blockTest();
+      /// condition estimate and the optional SVD fallback
+   int conditionTest();
+      /// an ill-conditioned covariance is inverted without editing
+   int covarianceTest();
+      /// repeated decompositions of the same size do not allocate
+   int allocationTest();
+
+      /** Normal matrix AT*A of a pseudo-random design matrix with
+       * \a rows rows and \a cols columns. */
+   static Matrix<double> normalMatrix(size_t rows, size_t cols);
+};
+
+
+Matrix<double> Matrix_LDLDecomp_T ::
+normalMatrix(size_t rows, size_t cols)
+{
+   Matrix<double> A(rows, cols);
+   unsigned seed = 12345;
+   for (size_t i = 0; i < rows; i++)
+   {
+      for (size_t j = 0; j < cols; j++)
+      {
+         seed = seed * 1103515245u + 12345u;
+         A(i,j) = double((seed >> 8) & 0xffff) / 32768. - 1.;
+      }
+   }
+   return transpose(A) * A;
+}
+
+
+int Matrix_LDLDecomp_T ::
+solveTest()
+{
+   TUDEF("LDLDecomp", "backSub");
+   double eps = 10*DBL_EPSILON;
+
+   double a33[9] = {2,-1,0,-1,2,-1,0,-1,2};
+   double b3[3] = {7,-3,2};
+   double bs3[3] = {4.25,1.5,1.75};
+   double a44[16] = {2,-1,0,0,-1,2,-1,0,0,-1,2,-1,0,0,-1,2};
+   double b4[4] = {5,1,-2,6};
+   double bs4[4] = {5,5,4,5};
+
+   Matrix<double> A3(3,3), A4(4,4);
+   Vector<double> B3(3), BS3(3), B4(4), BS4(4);
+   A3 = a33; B3 = b3; BS3 = bs3;
+   A4 = a44; B4 = b4; BS4 = bs4;
+
+   LDLDecomp<double> ldl;
+   ldl(A3);
+   TUASSERT(!ldl.usedSVD());
+   ldl.backSub(B3);
+   TUASSERTFEPS(BS3, B3, eps);
+   ldl(A4);
+   TUASSERT(!ldl.usedSVD());
+   ldl.backSub(B4);
+   TUASSERTFEPS(BS4, B4, eps);
+
+      // L*D*transpose(L) reproduces the matrix
+   Matrix<double> L(4,4,0.), D(4,4,0.);
+   for (size_t j = 0; j < 4; j++)
+   {
+      L(j,j) = 1.;
+      D(j,j) = ldl.LD(j,j);
+      for (size_t i = j+1; i < 4; i++)
+         L(i,j) = ldl.LD(i,j);
+   }
+   TUASSERTFEPS(A4, L * D * transpose(L), eps);
+
+   testFramework.changeSourceMethod("inverse");
+   Matrix<double> inv;
+   ldl.inverse(inv);
+   TUASSERTFEPS(ident<double>(4), A4 * inv, eps);
+
+   testFramework.changeSourceMethod("operator()");
+   try
+   {
+      ldl(Matrix<double>(3,4,1.));
+      TUFAIL("Non-square matrix was accepted");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("Non-square matrix rejected");
+   }
+   try
+   {
+      ldl(Matrix<double>(3,3,0.));
+      TUFAIL("Zero matrix was accepted");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("Zero matrix rejected");
+   }
+   TURETURN();
+}
+
+
+int Matrix_LDLDecomp_T ::
+blockTest()
+{
+   TUDEF("LDLDecomp", "inverse");
+   double eps = 1.e-10;
+
+      // more columns than one block, so the trailing update is used
+   size_t N = 45;
+   Matrix<double> M(normalMatrix(80, N)), ref(inverseSVD(M)), inv;
+   Vector<double> b(N), x(N), ref2(N);
+   for (size_t i = 0; i < N; i++)
+      b(i) = double(i) - 20.;
+   ref2 = ref * b;
+
+   size_t blocks[] = { 1, 2, 7, 32, 64 };
+   for (size_t k = 0; k < sizeof(blocks)/sizeof(blocks[0]); k++)
+   {
+      LDLDecomp<double> ldl(1.e8, blocks[k]);
+      ldl(M);
+      TUASSERT(!ldl.usedSVD());
+      ldl.inverse(inv);
+      TUASSERTFEPS(ref, inv, eps);
+      x = b;
+      ldl.backSub(x);
+      TUASSERTFEPS(ref2, x, eps);
+   }
+   TURETURN();
+}
+
+
+int Matrix_LDLDecomp_T ::
+conditionTest()
+{
+   TUDEF("LDLDecomp", "condition");
+
+      // the estimate is exact for a diagonal matrix
+   Matrix<double> M(5,5,0.);
+   for (size_t i = 0; i < 5; i++)
+      M(i,i) = pow(10., double(i));
+   LDLDecomp<double> ldl;
+   ldl(M);
+   TUASSERTFEPS(1.e4, ldl.condition(), 1.e-8);
+   TUASSERT(!ldl.usedSVD());
+
+      // ... and a lower bound otherwise, that is seldom far off
+   M = normalMatrix(12, 6);
+   Matrix<double> inv(inverseSVD(M));
+   double n1 = 0., ni1 = 0.;
+   for (size_t j = 0; j < 6; j++)
+   {
+      double s = 0., si = 0.;
+      for (size_t i = 0; i < 6; i++)
+      {
+         s += fabs(M(i,j));
+         si += fabs(inv(i,j));
+      }
+      n1 = std::max(n1, s);
+      ni1 = std::max(ni1, si);
+   }
+   ldl(M);
+   TUASSERT(ldl.condition() <= n1*ni1*(1.+1.e-10));
+   TUASSERT(ldl.condition() >= n1*ni1/3.);
+
+      // ill-conditioned; the result is not changed
+   testFramework.changeSourceMethod("usedSVD");
+   M = Matrix<double>(5,5,0.);
+   for (size_t i = 0; i < 5; i++)
+      M(i,i) = pow(10., 3.*double(i));
+   ldl(M);
+   TUASSERT(!ldl.usedSVD());
+   TUASSERTFEPS(1.e12, ldl.condition(), 1.);
+   ldl.inverse(inv);
+   TUASSERTFEPS(inverseChol(M), inv, 1.e-15);
+   TUASSERTFE(1., inv(0,0));
+
+      // with allowSVD, the SVD inverse is used, as inverseSVD()
+   LDLDecomp<double> svd(1.e8, 32, true);
+   svd(M);
+   TUASSERT(svd.usedSVD());
+   svd.inverse(inv);
+   TUASSERTFEPS(inverseSVD(M), inv, 1.e-20);
+   TUASSERTFE(0., inv(0,0));
+
+      // a lower limit sends the first matrix to SVD too
+   LDLDecomp<double> strict(1.e3, 32, true);
+   M = 0.;
+   for (size_t i = 0; i < 5; i++)
+      M(i,i) = pow(10., double(i));
+   strict(M);
+   TUASSERT(strict.usedSVD());
+
+      // indefinite; rejected as by inverseChol()
+   double a22[4] = {1,2,2,1};
+   Matrix<double> A(2,2);
+   A = a22;
+   try
+   {
+      ldl(A);
+      TUFAIL("Indefinite matrix was accepted");
+   }
+   catch (SingularMatrixException& e)
+   {
+      TUPASS("Indefinite matrix rejected");
+   }
+
+      // ... unless allowSVD
+   svd(A);
+   TUASSERT(svd.usedSVD());
+   TUASSERTFE(0., svd.condition());
+   svd.inverse(inv);
+   TUASSERTFEPS(ident<double>(2), A * inv, 10*DBL_EPSILON);
+   Vector<double> b(2,3.);
+   svd.backSub(b);
+   TUASSERTFEPS(1., b(0), 10*DBL_EPSILON);
+   TUASSERTFEPS(1., b(1), 10*DBL_EPSILON);
+   TURETURN();
+}
+
+
+int Matrix_LDLDecomp_T ::
+covarianceTest()
+{
+   TUDEF("LDLDecomp", "inverse");
+
+      // the default a priori covariance of CodeKalmanSolver, condition 9e8;
+      // an edited SVD inverse would drop the position terms
+   Matrix<double> P(4,4,0.), inv;
+   P(0,0) = P(1,1) = P(2,2) = 100.;
+   P(3,3) = 9.e10;
+   LDLDecomp<double> ldl;
+   ldl(P);
+   TUASSERT(!ldl.usedSVD());
+   TUASSERTFEPS(9.e8, ldl.condition(), 1.e-2);
+   ldl.inverse(inv);
+   Matrix<double> ref(inverseChol(P));
+   TUASSERTFEPS(ref, inv, 1.e-15);
+   TUASSERTFE(0.01, inv(0,0));
+   TUASSERTFEPS(1./9.e10, inv(3,3), 1.e-25);
+
+   Vector<double> b(4,1.), x(b);
+   ldl.backSub(x);
+   TUASSERTFEPS(ref * b, x, 1.e-16);
+   TURETURN();
+}
+
+
+int Matrix_LDLDecomp_T ::
+allocationTest()
+{
+   TUDEF("LDLDecomp", "operator()");
+
+   Matrix<double> M(normalMatrix(40, 8)), inv;
+   Vector<double> b(8, 1.);
+   LDLDecomp<double> ldl;
+   ldl(M);
+   ldl.inverse(inv);
+   ldl.backSub(b);
+
+   size_t before = allocCount;
+   for (unsigned i = 0; i < 10; i++)
+   {
+      ldl(M);
+      ldl.inverse(inv);
+      ldl.backSub(b);
+   }
+   size_t count = allocCount - before;
+   TUASSERTE(size_t, 0, count);
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   Matrix_LDLDecomp_T testClass;
+
+   errorTotal += testClass.solveTest();
+   errorTotal += testClass.blockTest();
+   errorTotal += testClass.conditionTest();
+   errorTotal += testClass.covarianceTest();
+   errorTotal += testClass.allocationTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
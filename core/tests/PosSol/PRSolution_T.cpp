@@ -0,0 +1,363 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "PRSolution.hpp"
+#include "SP3EphemerisStore.hpp"
+#include "RinexObsStream.hpp"
+#include "RinexObsHeader.hpp"
+#include "RinexObsData.hpp"
+#include "TropModel.hpp"
+#include "SaasTropModel.hpp"
+#include "TestUtil.hpp"
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace gpstk;
+
+   // count the calls of operator new, to show that a solution does
+   // not allocate
+static size_t allocCount = 0;
+
+void* operator new(size_t n)
+{
+   allocCount++;
+   void *p = malloc(n ? n : 1);
+   if (!p)
+      throw bad_alloc();
+   return p;
+}
+
+void operator delete(void *p) throw()
+{
+   free(p);
+}
+
+class PRSolution_T
+{
+public:
+   PRSolution_T();
+
+      /** Compare RAIMCompute() with and without IncrementalRAIM on
+       * real data with outliers added, rejecting up to \a nReject
+       * satellites. */
+   int incrementalTest(int nReject, unsigned numThreads);
+      /** Find where the exhaustive search switches between two
+       * subsets of one epoch, so that they nearly tie for the best of
+       * stage 1, and check that RAIMCompute() with IncrementalRAIM
+       * picks the same satellites on both sides of the tie. */
+   int tieTest(TropModel& trop);
+      /** Repeated SimplePRSolution() calls of the same size must not
+       * allocate, weighted or not. */
+   int allocationTest();
+
+private:
+      /// Pseudoranges of one epoch
+   struct Epoch
+   {
+      CommonTime time;
+      vector<SatID> sats;
+      vector<double> ranges;
+   };
+
+      /** RAIMCompute() for the first epoch with \a ranges, rejecting
+       * at most one satellite; \a sats is replaced by the result. */
+   int raimFirst(PRSolution& prs, vector<SatID>& sats,
+                 const vector<double>& ranges, TropModel& trop);
+
+   vector<Epoch> epochs;
+   SP3EphemerisStore eph;
+};
+
+
+PRSolution_T ::
+PRSolution_T()
+{
+   string dp(gpstk::getPathData() + gpstk::getFileSep());
+   eph.loadFile(dp + "test_input_sp3_nav_2015_200.sp3");
+
+   RinexObsStream strm((dp + "arlm200b.15o").c_str());
+   RinexObsHeader hdr;
+   RinexObsData rod;
+   strm >> hdr;
+      // the first half hour is enough
+   while((strm >> rod) && epochs.size() < 60)
+   {
+      Epoch ep;
+      ep.time = rod.time;
+      ep.time.setTimeSystem(TimeSystem::GPS);
+      RinexObsData::RinexSatMap::const_iterator it;
+      for(it = rod.obs.begin(); it != rod.obs.end(); it++)
+      {
+         RinexObsData::RinexObsTypeMap::const_iterator jt =
+            it->second.find(RinexObsHeader::C1);
+         if(jt == it->second.end() || jt->second.data == 0.0)
+            continue;
+         ep.sats.push_back(it->first);
+         ep.ranges.push_back(jt->second.data);
+      }
+         // outliers: one satellite on every epoch, a second on every
+         // other epoch and a third on every fourth
+      size_t n(epochs.size()), ns(ep.sats.size());
+      if(ns > 6)
+      {
+         ep.ranges[n % ns] += 500.0;
+         if(n % 2) ep.ranges[(n+3) % ns] -= 250.0 + n;
+         if(n % 4 == 1) ep.ranges[(n+5) % ns] += 90.0;
+      }
+      epochs.push_back(ep);
+   }
+}
+
+
+int PRSolution_T ::
+incrementalTest(int nReject, unsigned numThreads)
+{
+   TUDEF("PRSolution", "RAIMCompute");
+
+   PRSolution full, incr;
+   full.IncrementalRAIM = false;
+   incr.IncrementalRAIM = true;
+   incr.RAIMThreads = numThreads;
+   full.NSatsReject = incr.NSatsReject = nReject;
+      // no ionosphere correction is made
+   full.RMSLimit = incr.RMSLimit = 3.0;
+   ZeroTropModel trop;
+   Matrix<double> invMC;
+
+   int nSolvedFull(0), nSolvedIncr(0), nRejected(0);
+   size_t mismatch(0);
+   for(size_t e=0; e<epochs.size(); e++)
+   {
+      vector<SatID> satsFull(epochs[e].sats), satsIncr(epochs[e].sats);
+      vector<SatID::SatelliteSystem> sysFull, sysIncr;
+      int iretFull = full.RAIMCompute(epochs[e].time, satsFull, sysFull,
+                                      epochs[e].ranges, invMC, &eph, &trop);
+      int iretIncr = incr.RAIMCompute(epochs[e].time, satsIncr, sysIncr,
+                                      epochs[e].ranges, invMC, &eph, &trop);
+      nSolvedFull += full.Timing.nSolved;
+      nSolvedIncr += incr.Timing.nSolved;
+      for(size_t i=0; i<satsFull.size(); i++)
+         nRejected += (satsFull[i].id < 0);
+
+         // everything must be exactly the same
+      bool same = (iretFull == iretIncr) && (satsFull == satsIncr) &&
+         (full.isValid() == incr.isValid()) &&
+         (full.Solution.size() == incr.Solution.size()) &&
+         (full.RMSResidual == incr.RMSResidual) &&
+         (full.MaxSlope == incr.MaxSlope) &&
+         (full.NIterations == incr.NIterations) &&
+         (full.Nsvs == incr.Nsvs);
+      for(size_t i=0; same && i<full.Solution.size(); i++)
+         same = (full.Solution(i) == incr.Solution(i));
+      if(!same)
+      {
+         mismatch++;
+         cerr << "Epoch " << e << " differs: " << full.outputString("FULL",
+            iretFull) << endl << incr.outputString("INCR", iretIncr) << endl;
+      }
+   }
+   TUASSERTE(size_t, 0, mismatch);
+      // outliers were found, with fewer full solutions
+   TUASSERT(nRejected > int(epochs.size()));
+   TUASSERT(nSolvedIncr < nSolvedFull);
+   TUASSERT(incr.Timing.nScreened > 0);
+   TUASSERTE(int, 0, full.Timing.nScreened);
+   TURETURN();
+}
+
+
+int PRSolution_T ::
+raimFirst(PRSolution& prs, vector<SatID>& sats, const vector<double>& ranges,
+          TropModel& trop)
+{
+   Matrix<double> invMC;
+   vector<SatID::SatelliteSystem> syss;
+   prs.NSatsReject = 1;
+   prs.RMSLimit = 3.0;
+   return prs.RAIMCompute(epochs[0].time, sats, syss, ranges, invMC, &eph,
+                          &trop);
+}
+
+
+int PRSolution_T ::
+tieTest(TropModel& trop)
+{
+   TUDEF("PRSolution", "RAIMCompute");
+
+      // the first epoch, with its outlier on satellite 0 removed,
+      // without satellite 2 (PRN 6, which is off by some 800m), and
+      // with an outlier on satellite 1; a second outlier on satellite
+      // 3, from 0 to 200m, changes the best subset of stage 1
+   const size_t b(3);
+   vector<SatID> sats(epochs[0].sats);
+   sats[2].id = -sats[2].id;
+   vector<double> ranges(epochs[0].ranges), test;
+   ranges[0] -= 500.0;
+   ranges[1] += 40.0;
+
+   double lo(0.0), hi(200.0);
+   vector<SatID> satsLo(sats), satsHi(sats);
+   test = ranges;
+   {
+      PRSolution prs;
+      prs.IncrementalRAIM = false;
+      raimFirst(prs, satsLo, test, trop);
+   }
+   test[b] = ranges[b] + hi;
+   {
+      PRSolution prs;
+      prs.IncrementalRAIM = false;
+      raimFirst(prs, satsHi, test, trop);
+   }
+   TUASSERT(satsLo != satsHi);
+
+      // bisect on the selection of the exhaustive search
+   for(int i=0; i<50 && satsLo != satsHi; i++)
+   {
+      double mid(0.5*(lo+hi));
+      vector<SatID> satsMid(sats);
+      PRSolution prs;
+      prs.IncrementalRAIM = false;
+      test[b] = ranges[b] + mid;
+      raimFirst(prs, satsMid, test, trop);
+      if(satsMid == satsLo)
+         lo = mid;
+      else
+      {
+         hi = mid;
+         satsHi = satsMid;
+      }
+   }
+   TUASSERT(hi-lo < 1.e-10);
+
+   double offsets[] = { -1.e-2, -1.e-4, 0.0, 1.e-4, 1.e-2 };
+   for(size_t k=0; k<sizeof(offsets)/sizeof(offsets[0]); k++)
+   {
+      test[b] = ranges[b] + 0.5*(lo+hi) + offsets[k];
+      PRSolution full, incr;
+      full.IncrementalRAIM = false;
+      incr.IncrementalRAIM = true;
+      vector<SatID> satsFull(sats), satsIncr(sats);
+      int iretFull = raimFirst(full, satsFull, test, trop);
+      int iretIncr = raimFirst(incr, satsIncr, test, trop);
+
+         // the two subsets on either side of the tie
+      if(offsets[k] < 0.0)
+         TUASSERT(satsFull == satsLo);
+      if(offsets[k] > 0.0)
+         TUASSERT(satsFull == satsHi);
+
+      TUASSERTE(int, iretFull, iretIncr);
+      TUASSERT(satsFull == satsIncr);
+      TUASSERTFE(full.RMSResidual, incr.RMSResidual);
+      TUASSERTE(size_t, full.Solution.size(), incr.Solution.size());
+      for(size_t i=0; i<full.Solution.size() && i<incr.Solution.size(); i++)
+         TUASSERTFE(full.Solution(i), incr.Solution(i));
+         // the other subsets were not solved
+      TUASSERT(incr.Timing.nSolved < full.Timing.nSolved);
+   }
+   TURETURN();
+}
+
+
+int PRSolution_T ::
+allocationTest()
+{
+   TUDEF("PRSolution", "SimplePRSolution");
+
+   PRSolution prs;
+   ZeroTropModel trop;
+   Matrix<double> invMC, SVP;
+   Vector<double> resids, slopes;
+   const Epoch& ep(epochs[1]);
+   vector<SatID> sats(ep.sats);
+   vector<SatID::SatelliteSystem> syss;
+   TUASSERT(prs.PreparePRSolution(ep.time, sats, syss, ep.ranges, &eph,
+                                  SVP) >= 4);
+
+   for(int weighted=0; weighted<2; weighted++)
+   {
+      if(weighted)
+         invMC = ident<double>(sats.size());
+         // the first solution sizes the workspace
+      int iret = prs.SimplePRSolution(ep.time, sats, SVP, invMC, &trop,
+                                      prs.MaxNIterations, prs.ConvergenceLimit,
+                                      syss, resids, slopes);
+      TUASSERTE(int, 0, iret);
+      Vector<double> sol(prs.Solution);
+      double rms(prs.RMSResidual), slope(prs.MaxSlope);
+
+      size_t before(allocCount);
+      for(int i=0; i<10; i++)
+         iret = prs.SimplePRSolution(ep.time, sats, SVP, invMC, &trop,
+                                     prs.MaxNIterations, prs.ConvergenceLimit,
+                                     syss, resids, slopes);
+      size_t count(allocCount - before);
+      TUASSERTE(size_t, 0, count);
+      TUASSERTE(int, 0, iret);
+      TUASSERTFE(rms, prs.RMSResidual);
+      TUASSERTFE(slope, prs.MaxSlope);
+      for(size_t i=0; i<sol.size(); i++)
+         TUASSERTFE(sol(i), prs.Solution(i));
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   PRSolution_T testClass;
+
+   errorTotal += testClass.incrementalTest(-1, 0);
+   errorTotal += testClass.incrementalTest(2, 1);
+   errorTotal += testClass.incrementalTest(2, 4);
+
+   ZeroTropModel zero;
+   errorTotal += testClass.tieTest(zero);
+   SaasTropModel saas;
+   saas.setWeather(20.0, 1013.0, 50.0);
+   errorTotal += testClass.tieTest(saas);
+   errorTotal += testClass.allocationTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,222 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "FastTime.hpp"
+#include "CivilTime.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+#include <cmath>
+
+using namespace gpstk;
+using namespace std;
+
+class FastTime_T
+{
+public:
+      /// CommonTime -> FastTime -> CommonTime must be exact
+   int conversionTest();
+      /// arithmetic must agree with CommonTime
+   int arithmeticTest();
+      /// comparison operators and time system checks
+   int compareTest();
+};
+
+
+int FastTime_T ::
+conversionTest()
+{
+   TUDEF("FastTime", "convertToCommonTime");
+
+   CommonTime times[6];
+   times[0] = CommonTime::BEGINNING_OF_TIME;
+   times[1] = CommonTime::END_OF_TIME;
+   times[2].setInternal(2457000, 43200123, 0.000123456789012, TimeSystem::GPS);
+   times[3].setInternal(2457000, 86399999, 0.000999999999999, TimeSystem::UTC);
+   times[4] = CivilTime(2016, 2, 29, 23, 59, 59.9999999, TimeSystem::GPS);
+   times[5].setInternal(1, 0, 1e-18, TimeSystem::Any);
+
+   for (int i = 0; i < 6; i++)
+   {
+      FastTime ft(times[i]);
+      CommonTime ct(ft.convertToCommonTime());
+      long day1, msod1, day2, msod2;
+      double fsod1, fsod2;
+      TimeSystem ts1, ts2;
+      times[i].getInternal(day1, msod1, fsod1, ts1);
+      ct.getInternal(day2, msod2, fsod2, ts2);
+      TUASSERTE(long, day1, day2);
+      TUASSERTE(long, msod1, msod2);
+         // exact, not within a tolerance
+      TUASSERT(fsod1 == fsod2);
+      TUASSERTE(TimeSystem, ts1, ts2);
+      TUASSERTE(string, times[i].asString(), ft.asString());
+      TUASSERTFE(times[i].getSecondOfDay(), ft.getSecondOfDay());
+      TUASSERTFE(times[i].getDays(), ft.getDays());
+   }
+
+      // out of range
+   FastTime ft(CommonTime::END_OF_TIME);
+   ft.addDays(1);
+   try
+   {
+      ft.convertToCommonTime();
+      TUFAIL("Time after END_OF_TIME was converted");
+   }
+   catch (InvalidParameter& e)
+   {
+      TUPASS("Time after END_OF_TIME rejected");
+   }
+   TURETURN();
+}
+
+
+int FastTime_T ::
+arithmeticTest()
+{
+   TUDEF("FastTime", "addSeconds");
+
+   CommonTime ct, start;
+   ct.setInternal(2457000, 100, 0.0004, TimeSystem::GPS);
+   start = ct;
+   FastTime ft(ct);
+
+      // steps of varying size and sign, crossing day boundaries,
+      // checked against a long double sum of the steps
+   unsigned long long seed = 7;
+   int badFrac = 0;
+   long double ref = 0;
+   double maxErr = 0, maxDiff = 0;
+   FastTime fstart(start);
+   for (int i = 0; i < 20000; i++)
+   {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      double u = double(seed >> 11) / double(1ULL << 53);
+      double step = (u - 0.45) * ((i % 3) == 0 ? 200000. : 31.);
+      ct += step;
+      ft += step;
+      ref += step;
+      if (ft.getFractionalSeconds() < 0 || ft.getFractionalSeconds() >= 1e-3)
+         badFrac++;
+      long double elapsed =
+         (ft.getMilliseconds() - fstart.getMilliseconds()) * 1e-3L +
+         (ft.getFractionalSeconds() - fstart.getFractionalSeconds());
+      maxErr = max(maxErr, double(fabsl(elapsed - ref)));
+      maxDiff = max(maxDiff, fabs(ft.convertToCommonTime() - ct));
+   }
+   TUASSERTE(int, 0, badFrac);
+      // each step rounds to the resolution of a double of its size
+   TUASSERT(maxErr < 1e-9);
+   TUASSERT(maxDiff < 1e-9);
+      // the difference is a double of 7e7 seconds
+   TUASSERTFEPS(ct - start, ft - fstart, 1e-7);
+
+      // integer steps are exact
+   FastTime ft2(start);
+   ft2.addSeconds(86400L * 3 + 7);
+   ft2.addMilliseconds(-5);
+   ft2.addDays(-3);
+   TUASSERTFE(7 - 0.005, ft2 - FastTime(start));
+
+      // operator forms
+   FastTime a(start);
+   TUASSERTFE(1.25, (a + 1.25) - a);
+   TUASSERTFE(-1.25, (a - 1.25) - a);
+   a -= 0.0001;
+   TUASSERTFEPS(-0.0001, a - FastTime(start), 1e-15);
+   TURETURN();
+}
+
+
+int FastTime_T ::
+compareTest()
+{
+   TUDEF("FastTime", "operator<");
+
+   CommonTime ct;
+   ct.setInternal(2457000, 100, 0.0004, TimeSystem::GPS);
+   FastTime a(ct), b(ct);
+   b += 1e-6;
+   TUASSERT(a < b);
+   TUASSERT(a <= b);
+   TUASSERT(b > a);
+   TUASSERT(b >= a);
+   TUASSERT(a != b);
+   TUASSERT(!(b < a));
+   TUASSERT(a == FastTime(ct));
+
+   FastTime any(a);
+   any.setTimeSystem(TimeSystem::Any);
+   TUASSERT(any == a);
+
+   FastTime utc(a);
+   utc.setTimeSystem(TimeSystem::UTC);
+   TUASSERT(utc != a);
+   try
+   {
+      a < utc;
+      TUFAIL("Comparison of different time systems succeeded");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("Comparison of different time systems rejected");
+   }
+   try
+   {
+      a - utc;
+      TUFAIL("Difference of different time systems succeeded");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("Difference of different time systems rejected");
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   FastTime_T testClass;
+
+   errorTotal += testClass.conversionTest();
+   errorTotal += testClass.arithmeticTest();
+   errorTotal += testClass.compareTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
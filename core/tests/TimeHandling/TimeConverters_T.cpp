@@ -161,6 +161,41 @@ class xTimeConverters
 				testFramework.assert(relativeError < eps, "The Time to SOD conversion found an incorrect SOD", __LINE__ );
 			}
 
+			return testFramework.countFails();
+		}
+
+//==========================================================================================================================
+//	Cached conversion tests
+//==========================================================================================================================
+		int CacheTest()
+		{
+			TestUtil testFramework( "TimeConverters", "convertCalendarToJD (cached)", __FILE__, __LINE__ );
+
+			int year, month, day, year2, month2, day2;
+			int fails = 0;
+			//---------------------------------------------------------------------
+			//Repeated and alternating conversions must give the same answer as
+			//a conversion of a day that was not seen before
+			//---------------------------------------------------------------------
+			for (long jd = 2299150; jd < 2470000; jd += 97)
+			{
+				convertJDtoCalendar(jd, year, month, day);
+				convertJDtoCalendar(jd, year2, month2, day2);
+				if (year != year2 || month != month2 || day != day2)
+					fails++;
+				if (convertCalendarToJD(year, month, day) != jd ||
+				    convertCalendarToJD(year, month, day) != jd)
+					fails++;
+				convertJDtoCalendar(jd+1, year2, month2, day2);
+				if (convertCalendarToJD(year2, month2, day2) != jd+1 ||
+				    convertCalendarToJD(year, 1, 1) > jd)
+					fails++;
+				convertJDtoCalendar(jd, year2, month2, day2);
+				if (year != year2 || month != month2 || day != day2)
+					fails++;
+			}
+			testFramework.assert(fails == 0, "A repeated conversion gave a different result", __LINE__);
+
 			return testFramework.countFails();
 		}
 	private:
@@ -183,6 +218,9 @@ int main() //Main function to initialize and run all tests above
 
 	check = testClass.TimetoSODTest(); 
 	errorCounter += check;
+
+	check = testClass.CacheTest();
+	errorCounter += check;
 	
 	std::cout << "Total Errors for " << __FILE__<<": "<< errorCounter << std::endl;
 
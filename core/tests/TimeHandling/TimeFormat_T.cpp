@@ -0,0 +1,346 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "TimeFormat.hpp"
+#include "TimeString.hpp"
+#include "ANSITime.hpp"
+#include "CivilTime.hpp"
+#include "GPSWeekSecond.hpp"
+#include "BDSWeekSecond.hpp"
+#include "GALWeekSecond.hpp"
+#include "QZSWeekSecond.hpp"
+#include "IRNWeekSecond.hpp"
+#include "GPSWeekZcount.hpp"
+#include "JulianDate.hpp"
+#include "MJD.hpp"
+#include "UnixTime.hpp"
+#include "PosixTime.hpp"
+#include "YDSTime.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+#include <cstring>
+
+using namespace gpstk;
+using namespace std;
+
+class TimeFormat_T
+{
+public:
+   TimeFormat_T();
+
+      /// compare print() with the printf() of each TimeTag
+   int printTest();
+      /// print into a short buffer
+   int bufferTest();
+      /// compare scan() with TimeTag::scanf()
+   int scanTest();
+      /// mismatched strings must throw as TimeTag::getInfo() does
+   int scanErrorTest();
+      /// reuse of the per-thread cache
+   int cacheTest();
+
+      /// printTime() as done before TimeFormat
+   static string printEach(const CommonTime& t, const string& fmt);
+
+private:
+   vector<string> formats;
+   vector<CommonTime> times;
+};
+
+
+TimeFormat_T ::
+TimeFormat_T()
+{
+   formats.push_back("%04Y/%02m/%02d %02H:%02M:%02S %P");
+   formats.push_back("%4Y %2m %2d %2H %2M %10.7f");
+   formats.push_back("%Y %j %s");
+   formats.push_back("%5.0s %03j %y");
+   formats.push_back("%F %g %w %G %E");
+   formats.push_back("%04F %10.3g %Z %z %c %C");
+   formats.push_back("%.9J %15.6Q %K %U %u %W %N");
+   formats.push_back("%b %B %d, %Y");
+   formats.push_back("GAL %T %L %l BDS %R %D %e QZS %V %h %i IRN %X %O %o");
+   formats.push_back("%-6Y|% 5m|%05d");
+      // not fields: precision on an integer, unknown identifier,
+      // percent signs
+   formats.push_back("%.3Y %q %% %%Y 100% %5%m %");
+   formats.push_back("");
+   formats.push_back("no fields at all");
+
+   times.push_back(CivilTime(2016, 6, 18, 12, 34, 56.789012345,
+                             TimeSystem::GPS));
+   times.push_back(CivilTime(2000, 2, 29, 0, 0, 0.0, TimeSystem::UTC));
+   times.push_back(CivilTime(1999, 12, 31, 23, 59, 59.999999,
+                             TimeSystem::GAL));
+      // before the GPS epoch, so some TimeTag conversions fail
+   times.push_back(CivilTime(1975, 1, 2, 3, 4, 5.5, TimeSystem::Any));
+      // before 1970
+   times.push_back(CivilTime(1969, 7, 20, 20, 17, 40.0, TimeSystem::UTC));
+}
+
+
+string TimeFormat_T ::
+printEach(const CommonTime& t, const string& fmt)
+{
+   string rv(fmt);
+   try {rv = ANSITime(t).printf( rv );} catch (InvalidRequest& e){};
+   try {rv = CivilTime(t).printf( rv );} catch (InvalidRequest& e){};
+   try {rv = GPSWeekSecond(t).printf( rv );} catch (InvalidRequest& e){};
+   try {rv = GPSWeekZcount(t).printf( rv );} catch (InvalidRequest& e){};
+   try {rv = JulianDate(t).printf( rv );} catch (InvalidRequest& e){};
+   try {rv = MJD(t).printf( rv );} catch (InvalidRequest& e){};
+   try {rv = UnixTime(t).printf( rv );} catch (InvalidRequest& e){};
+   try {rv = PosixTime(t).printf( rv );} catch (InvalidRequest& e){};
+   try {rv = YDSTime(t).printf( rv );} catch (InvalidRequest& e){};
+   try {rv = GALWeekSecond(t).printf( rv );} catch (InvalidRequest& e){};
+   try {rv = BDSWeekSecond(t).printf( rv );} catch (InvalidRequest& e){};
+   try {rv = QZSWeekSecond(t).printf( rv );} catch (InvalidRequest& e){};
+   try {rv = IRNWeekSecond(t).printf( rv );} catch (InvalidRequest& e){};
+   return rv;
+}
+
+
+int TimeFormat_T ::
+printTest()
+{
+   TUDEF("TimeFormat", "print");
+
+   for (size_t f = 0; f < formats.size(); f++)
+   {
+      TimeFormat tf(formats[f]);
+      for (size_t i = 0; i < times.size(); i++)
+      {
+         string exp(printEach(times[i], formats[f]));
+         TUASSERTE(string, exp, tf.print(times[i]));
+         TUASSERTE(string, exp, printTime(times[i], formats[f]));
+      }
+   }
+   TURETURN();
+}
+
+
+int TimeFormat_T ::
+bufferTest()
+{
+   TUDEF("TimeFormat", "print");
+
+   TimeFormat tf("%04Y/%02m/%02d %02H:%02M:%02S");
+   string exp("2016/06/18 12:34:56");
+   char buf[32];
+   memset(buf, 'x', sizeof(buf));
+   TUASSERTE(size_t, exp.size(), tf.print(buf, sizeof(buf), times[0]));
+   TUASSERTE(string, exp, string(buf));
+
+      // truncated but still terminated, and the full length returned
+   memset(buf, 'x', sizeof(buf));
+   TUASSERTE(size_t, exp.size(), tf.print(buf, 8, times[0]));
+   TUASSERTE(string, exp.substr(0, 7), string(buf));
+   TUASSERTE(char, 'x', buf[8]);
+   TUASSERTE(size_t, exp.size(), tf.print(buf, 0, times[0]));
+
+      // longer than the internal buffer of print(const CommonTime&)
+   string longFmt;
+   for (int i = 0; i < 40; i++)
+      longFmt += "%04Y/%02m/%02d ";
+   TUASSERTE(string, printEach(times[0], longFmt),
+             TimeFormat(longFmt).print(times[0]));
+   TURETURN();
+}
+
+
+int TimeFormat_T ::
+scanTest()
+{
+   TUDEF("TimeFormat", "scan");
+
+   struct
+   {
+      const char *fmt, *str;
+      int type;   // 0 CivilTime, 1 YDSTime, 2 GPSWeekSecond
+   } cases[] =
+   {
+      { "%Y %m %d %H %M %S", "2016 6 18 12 34 56.7", 0 },
+      { "%Y %m %d %H %M %f", "2016 6 18 12 34 56.7", 0 },
+      { "%4Y%2m%2d%2H%2M%5f", "2016061812345.123", 0 },
+      { "%04Y/%02m/%02d %02H:%02M:%09.6f %P",
+        "2016/06/18 12:34:56.789012 GPS", 0 },
+      { "%Y,%m,%d,%H,%M,%f", "  2016,  6, 18, 1, 2,   3.25", 0 },
+      { "%Y%m%d", "2016618", 0 },
+      { "%m/%d/%y %H:%M", "12/31/99 23:59", 0 },
+      { "%b %d %Y", "Jun 18 2016", 0 },
+      { "xx%Y yy%m zz%d", "ab2016 cd6 ef18", 0 },
+      { "%Y %j %s", "2016 170 45296.5", 1 },
+      { "%4Y%3j%7s", "2016170  45296", 1 },
+      { "%F %g", "1901 561296.25", 2 },
+      { "%F %g %P", "1901 561296.25 UTC", 2 }
+   };
+
+   for (size_t c = 0; c < sizeof(cases)/sizeof(cases[0]); c++)
+   {
+      string fmt(cases[c].fmt), str(cases[c].str);
+      CommonTime exp;
+      if (cases[c].type == 0)
+      {
+         CivilTime tt;
+         tt.scanf(str, fmt);
+         exp = tt.convertToCommonTime();
+      }
+      else if (cases[c].type == 1)
+      {
+         YDSTime tt;
+         tt.scanf(str, fmt);
+         exp = tt.convertToCommonTime();
+      }
+      else
+      {
+         GPSWeekSecond tt;
+         tt.scanf(str, fmt);
+         exp = tt.convertToCommonTime();
+      }
+
+      CommonTime got;
+      TimeFormat(fmt).scan(got, str);
+      TUASSERTE(CommonTime, exp, got);
+      CommonTime got2;
+      scanTime(got2, str, fmt);
+      TUASSERTE(CommonTime, exp, got2);
+   }
+
+      // into a TimeTag
+   CivilTime civ;
+   TimeFormat("%Y %m %d %H %M %f").scan(civ, "2016 6 18 12 34 56.75");
+   TUASSERTE(CivilTime, CivilTime(2016, 6, 18, 12, 34, 56.75), civ);
+   YDSTime yds;
+   TimeFormat("%Y %j %s").scan(yds, "2016 170 45296.5");
+   TUASSERTE(YDSTime, YDSTime(2016, 170, 45296.5), yds);
+   TURETURN();
+}
+
+
+int TimeFormat_T ::
+scanErrorTest()
+{
+   TUDEF("TimeFormat", "scan");
+
+   const char *cases[][2] =
+   {
+      { "%Y %m %d %H %M %S", "2016 6 18" },
+      { "abc%Y", "ab" },
+      { "%Y %j %s", "" }
+   };
+   for (size_t c = 0; c < sizeof(cases)/sizeof(cases[0]); c++)
+   {
+      bool refThrew = false, threw = false;
+      TimeTag::IdToValue info;
+      try
+      {
+         TimeTag::getInfo(cases[c][1], cases[c][0], info);
+      }
+      catch (StringUtils::StringException& e)
+      {
+         refThrew = true;
+      }
+      try
+      {
+         CommonTime t;
+         TimeFormat(cases[c][0]).scan(t, cases[c][1]);
+      }
+      catch (StringUtils::StringException& e)
+      {
+         threw = true;
+      }
+      catch (InvalidRequest& e)
+      {
+      }
+      TUASSERTE(bool, refThrew, threw);
+   }
+
+   try
+   {
+      CommonTime t;
+      TimeFormat("%H:%M").scan(t, "12:34");
+      TUFAIL("Incomplete time was accepted");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("Incomplete time rejected");
+   }
+   TURETURN();
+}
+
+
+int TimeFormat_T ::
+cacheTest()
+{
+   TUDEF("TimeFormat", "get");
+
+      // more formats than cache entries, used round robin
+   for (int pass = 0; pass < 3; pass++)
+   {
+      for (size_t f = 0; f < formats.size(); f++)
+      {
+         const TimeFormat& tf(TimeFormat::get(formats[f]));
+         TUASSERTE(string, formats[f], tf.getFormat());
+         for (int i = 0; i < 40; i++)
+         {
+            ostringstream s;
+            s << "%Y " << i;
+            TimeFormat::get(s.str());
+         }
+         TUASSERTE(string, printEach(times[0], formats[f]),
+                   TimeFormat::get(formats[f]).print(times[0]));
+      }
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   TimeFormat_T testClass;
+
+   errorTotal += testClass.printTest();
+   errorTotal += testClass.bufferTest();
+   errorTotal += testClass.scanTest();
+   errorTotal += testClass.scanErrorTest();
+   errorTotal += testClass.cacheTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
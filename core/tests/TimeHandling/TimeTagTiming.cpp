@@ -0,0 +1,179 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file TimeTagTiming.cpp
+ * Measure the speed of conversions between CommonTime and each of
+ * the TimeTag classes, and of CommonTime and FastTime arithmetic.
+ *
+ * Usage: TimeTagTiming [-n conversions]
+ *
+ * Each TimeTag is converted to and from CommonTime for a set of
+ * epochs 30 seconds apart within one day ("same day"), and for a
+ * set of epochs that are all on different days ("new day").  The
+ * calendar conversions cache the last day converted, so the
+ * difference between the two columns of CivilTime and YDSTime is the
+ * effect of that cache.  The number of conversions per second is
+ * reported, in millions. */
+
+#include <ctime>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+
+#include "ANSITime.hpp"
+#include "BDSWeekSecond.hpp"
+#include "CivilTime.hpp"
+#include "FastTime.hpp"
+#include "GALWeekSecond.hpp"
+#include "GPSWeekSecond.hpp"
+#include "GPSWeekZcount.hpp"
+#include "IRNWeekSecond.hpp"
+#include "JulianDate.hpp"
+#include "MJD.hpp"
+#include "PosixTime.hpp"
+#include "QZSWeekSecond.hpp"
+#include "UnixTime.hpp"
+#include "YDSTime.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+static double rate(unsigned long count, clock_t t)
+{
+   double sec = double(t) / CLOCKS_PER_SEC;
+   return (sec > 0 ? count / sec / 1e6 : 0.);
+}
+
+
+   /// Time convertFromCommonTime and convertToCommonTime for one type.
+template <class TimeType>
+static void timeTag(const string& name, const vector<CommonTime>& sameDay,
+                    const vector<CommonTime>& newDay)
+{
+   const vector<CommonTime> *sets[2] = { &sameDay, &newDay };
+   double from[2], to[2];
+   double sum = 0;
+   for (int s = 0; s < 2; s++)
+   {
+      const vector<CommonTime>& times(*sets[s]);
+      vector<TimeType> tags(times.size());
+      clock_t t0 = clock();
+      for (size_t i = 0; i < times.size(); i++)
+         tags[i].convertFromCommonTime(times[i]);
+      from[s] = rate(times.size(), clock() - t0);
+
+      t0 = clock();
+      for (size_t i = 0; i < tags.size(); i++)
+         sum += tags[i].convertToCommonTime().getSecondOfDay();
+      to[s] = rate(tags.size(), clock() - t0);
+   }
+   cout << setw(16) << left << name << right << fixed << setprecision(2)
+        << setw(12) << from[0] << setw(12) << from[1]
+        << setw(12) << to[0] << setw(12) << to[1]
+        << "   (" << setprecision(0) << sum << ")" << endl;
+}
+
+
+int main(int argc, char *argv[])
+{
+   unsigned long num = 1000000;
+   for (int i = 1; i < argc; i++)
+   {
+      if ((strcmp(argv[i], "-n") == 0) && (i+1 < argc))
+         num = strtoul(argv[++i], 0, 10);
+   }
+
+   CommonTime start(CivilTime(2016, 6, 18, 0, 0, 0.0, TimeSystem::GPS));
+   vector<CommonTime> sameDay(num), newDay(num);
+   for (unsigned long i = 0; i < num; i++)
+   {
+      sameDay[i] = start + double((i * 30) % 86400) + 0.125;
+      newDay[i] = start + double(i % 5000) * 86430. + 0.125;
+   }
+
+   cout << "Mconversions/s" << endl
+        << setw(16) << left << "class" << right
+        << setw(12) << "from/same" << setw(12) << "from/new"
+        << setw(12) << "to/same" << setw(12) << "to/new" << endl;
+
+   timeTag<ANSITime>("ANSITime", sameDay, newDay);
+   timeTag<CivilTime>("CivilTime", sameDay, newDay);
+   timeTag<GPSWeekSecond>("GPSWeekSecond", sameDay, newDay);
+   timeTag<GPSWeekZcount>("GPSWeekZcount", sameDay, newDay);
+   timeTag<GALWeekSecond>("GALWeekSecond", sameDay, newDay);
+   timeTag<BDSWeekSecond>("BDSWeekSecond", sameDay, newDay);
+   timeTag<QZSWeekSecond>("QZSWeekSecond", sameDay, newDay);
+   timeTag<IRNWeekSecond>("IRNWeekSecond", sameDay, newDay);
+   timeTag<JulianDate>("JulianDate", sameDay, newDay);
+   timeTag<MJD>("MJD", sameDay, newDay);
+   timeTag<PosixTime>("PosixTime", sameDay, newDay);
+   timeTag<UnixTime>("UnixTime", sameDay, newDay);
+   timeTag<YDSTime>("YDSTime", sameDay, newDay);
+   timeTag<FastTime>("FastTime", sameDay, newDay);
+
+      // stepping and differencing
+   cout << endl << "Moperations/s" << endl;
+   double sum = 0;
+   CommonTime ct(start);
+   clock_t t0 = clock();
+   for (unsigned long i = 0; i < num; i++)
+   {
+      ct += 30.000001;
+      sum += ct - start;
+   }
+   cout << setw(16) << left << "CommonTime" << right << fixed
+        << setprecision(2) << setw(12) << rate(num, clock() - t0)
+        << "   (" << setprecision(3) << sum << ")" << endl;
+
+   sum = 0;
+   FastTime ft(start), fstart(start);
+   t0 = clock();
+   for (unsigned long i = 0; i < num; i++)
+   {
+      ft += 30.000001;
+      sum += ft - fstart;
+   }
+   cout << setw(16) << left << "FastTime" << right << fixed
+        << setprecision(2) << setw(12) << rate(num, clock() - t0)
+        << "   (" << setprecision(3) << sum << ")" << endl;
+
+   return 0;
+}
@@ -0,0 +1,185 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file StringUtilsTiming.cpp
+ * Measure the speed of the fixed-width field parsers in StringUtils.
+ *
+ * Usage: StringUtilsTiming [-n lines]
+ *
+ * A set of RINEX-like lines (16 character observation fields and 19
+ * character navigation fields with FORTRAN exponents) is parsed with
+ * the copying string conversions (asDouble(line.substr(...)) and a
+ * for2doub done with a std::stringstream, as it was implemented
+ * before) and with the in-place ones (asDouble(line, pos, n) and
+ * for2doub(line, pos, n)).  The number of fields converted per
+ * second is reported. */
+
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <string>
+
+#include "StringUtils.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+   /// for2doub as it was before the in-place parser.
+static double oldFor2doub(const string& aStr, string::size_type startPos,
+                          string::size_type length)
+{
+   string s(aStr, startPos, length);
+   StringUtils::strip(s);
+   if (s.empty())
+      return 0;
+   string::size_type pos = s.find_first_of("EDd");
+   if (pos != string::npos)
+      s[pos] = 'e';
+   else
+      return StringUtils::asDouble(aStr.substr(startPos, length));
+   stringstream st;
+   st << s;
+   double d;
+   st >> d;
+   return d;
+}
+
+
+   /// Report one result line.
+static void report(const string& name, unsigned long fields, clock_t t,
+                   double sum)
+{
+   double sec = double(t) / CLOCKS_PER_SEC;
+   cout << setw(34) << left << name << right << fixed << setprecision(4)
+        << setw(10) << sec << setprecision(2) << setw(10)
+        << (sec > 0 ? fields / sec / 1e6 : 0.) << "   (" << setprecision(6)
+        << sum << ")" << endl;
+}
+
+
+int main(int argc, char *argv[])
+{
+   unsigned long numLines = 200000;
+   for (int i = 1; i < argc; i++)
+   {
+      if ((strcmp(argv[i], "-n") == 0) && (i+1 < argc))
+         numLines = strtoul(argv[++i], 0, 10);
+   }
+
+      // observation lines: 5 fields of F14.3,I1,I1
+      // navigation lines: 4 fields of D19.12
+   vector<string> obsLines, navLines;
+   unsigned long long seed = 42;
+   for (unsigned long l = 0; l < numLines; l++)
+   {
+      string obs, nav;
+      char buf[32];
+      for (int f = 0; f < 5; f++)
+      {
+         seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+         double x = double(seed >> 11) / double(1ULL << 53) * 4e7 - 2e7;
+         sprintf(buf, "%14.3f%1d%1d", x, int(seed % 3), int(seed % 10));
+         obs += buf;
+      }
+      nav = "   ";
+      for (int f = 0; f < 4; f++)
+      {
+         seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+         double x = double(seed >> 11) / double(1ULL << 53) - 0.5;
+         sprintf(buf, "%19.12E", x * 1e-5);
+         buf[15] = 'D';
+         nav += buf;
+      }
+      obsLines.push_back(obs);
+      navLines.push_back(nav);
+   }
+
+   cout << setw(34) << left << "method" << right << setw(10) << "sec"
+        << setw(10) << "Mfield/s" << endl;
+
+   unsigned long fields = numLines * 15;
+   double sum = 0;
+   clock_t t0 = clock();
+   for (unsigned long l = 0; l < numLines; l++)
+   {
+      const string& line(obsLines[l]);
+      for (int f = 0; f < 5; f++)
+      {
+         sum += StringUtils::asDouble(line.substr(f*16, 14));
+         sum += StringUtils::asInt(line.substr(f*16+14, 1));
+         sum += StringUtils::asInt(line.substr(f*16+15, 1));
+      }
+   }
+   report("obs asDouble(substr)", fields, clock() - t0, sum);
+
+   sum = 0;
+   t0 = clock();
+   for (unsigned long l = 0; l < numLines; l++)
+   {
+      const string& line(obsLines[l]);
+      for (int f = 0; f < 5; f++)
+      {
+         sum += StringUtils::asDouble(line, f*16, 14);
+         sum += StringUtils::asInt(line, f*16+14, 1);
+         sum += StringUtils::asInt(line, f*16+15, 1);
+      }
+   }
+   report("obs asDouble(line, pos, n)", fields, clock() - t0, sum);
+
+   fields = numLines * 4;
+   sum = 0;
+   t0 = clock();
+   for (unsigned long l = 0; l < numLines; l++)
+      for (int f = 0; f < 4; f++)
+         sum += oldFor2doub(navLines[l], 3 + f*19, 19);
+   report("nav for2doub (stringstream)", fields, clock() - t0, sum);
+
+   sum = 0;
+   t0 = clock();
+   for (unsigned long l = 0; l < numLines; l++)
+      for (int f = 0; f < 4; f++)
+         sum += StringUtils::for2doub(navLines[l], 3 + f*19, 19);
+   report("nav for2doub(line, pos, n)", fields, clock() - t0, sum);
+
+   return 0;
+}
@@ -38,6 +38,10 @@
 #include <string>
 #include <sstream>
 #include <iterator>
+#include <iomanip>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
 #include "StringUtils.hpp"
 #include "TestUtil.hpp"
 
@@ -410,6 +414,111 @@ public:
    }
 
 
+      /**
+       * Tests for the fixed-width field to number methods.  The
+       * results must be bit-for-bit those of strtod()/strtol() on a
+       * copy of the field (with FORTRAN exponents made into C ones).
+       */
+   unsigned fieldToNumberTest()
+   {
+      TUDEF("StringUtils", "asDouble(const char*,size_type)");
+
+      const char *fixed[] =
+      {
+         "", "              ", "  23619095.450", " -0.000", "-0.0", "+12.5",
+         "0.1", "0.3", "1e23", "9007199254740993", "123456789012345.6",
+         "  .15636D6", "  .15636d+06", " 1.234567890123D-09",
+         "-0.123456789012D+02", "1.5E", "1.5D", "1.5X", "12 34", "   -",
+         ".", "inf", "nan", "1e-400", "1e400", "4.9406564584124654e-324",
+         "0.000000000000000000000000001234", "  1.0000000000000002"
+      };
+      unsigned bad = 0;
+      for (size_t i = 0; i < sizeof(fixed)/sizeof(fixed[0]); i++)
+      {
+         string f(fixed[i]), c(f);
+         for (size_t k = 0; k < c.size(); k++)
+            if ((c[k] == 'D') || (c[k] == 'd'))
+               c[k] = 'E';
+         double exp = strtod(c.c_str(), 0), got = asDouble(f.data(), f.size());
+         if ((memcmp(&exp, &got, sizeof(double)) != 0) &&
+             !((exp != exp) && (got != got)))
+         {
+            bad++;
+            cerr << "asDouble(\"" << f << "\") " << setprecision(17) << got
+                 << " != " << exp << endl;
+         }
+      }
+      TUASSERTE(unsigned, 0, bad);
+
+         // RINEX-style fields with random digits
+      unsigned long long seed = 12345;
+      bad = 0;
+      for (int i = 0; i < 200000; i++)
+      {
+         seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+         double x = double(seed >> 11) / double(1ULL << 53);
+         int scale = int((seed >> 3) % 16) - 6;
+         x = (x - 0.5) * pow(10., scale);
+         char buf[32];
+         switch (i % 4)
+         {
+            case 0: sprintf(buf, "%14.3f", x); break;
+            case 1: sprintf(buf, "%19.12E", x); break;
+            case 2: sprintf(buf, "%18.11E", x); buf[14] = 'D'; break;
+            default: sprintf(buf, "%.17g", x); break;
+         }
+         string f(buf), c(f);
+         for (size_t k = 0; k < c.size(); k++)
+            if (c[k] == 'D')
+               c[k] = 'E';
+         double exp = strtod(c.c_str(), 0), got = asDouble(f.data(), f.size());
+         if (memcmp(&exp, &got, sizeof(double)) != 0)
+         {
+            if (bad++ < 10)
+               cerr << "asDouble(\"" << f << "\") " << setprecision(17)
+                    << got << " != " << exp << endl;
+         }
+      }
+      TUASSERTE(unsigned, 0, bad);
+
+         // fields inside a line
+      string line("  23619095.450  -353.176 1 ");
+      TUASSERTE(double, asDouble(line.substr(0, 14)), asDouble(line, 0, 14));
+      TUASSERTE(double, asDouble(line.substr(16, 14)), asDouble(line, 16, 14));
+      TUASSERTE(double, 0., asDouble(line, line.size(), 5));
+      try
+      {
+         asDouble(line, line.size() + 1, 2);
+         TUFAIL("position past the end was accepted");
+      }
+      catch (gpstk::StringUtils::StringException& e)
+      {
+         TUPASS("position past the end rejected");
+      }
+
+      TUCSM("asInt(const char*,size_type)");
+      const char *ints[] =
+      {
+         "", "  ", "7", " -12", "+3", "4x", " 1 2", "-", "123456789012345678901"
+      };
+      for (size_t i = 0; i < sizeof(ints)/sizeof(ints[0]); i++)
+      {
+         string f(ints[i]);
+         TUASSERTE(long, strtol(f.c_str(), 0, 10), asInt(f.data(), f.size()));
+      }
+      TUASSERTE(long, 1, asInt(line, 25, 1));
+      TUASSERTE(long, 0, asInt(line, 26, 3));
+      TUASSERTE(long, 95, asInt(line, 8, 2));
+
+      TUCSM("for2doub");
+      TUASSERTE(double, 156360., for2doub("  .15636D6"));
+      TUASSERTE(double, 156360., for2doub("xx.15636D+06", 2, 10));
+      TUASSERTE(double, 0., for2doub("     "));
+
+      TURETURN();
+   }
+
+
       /**
        * Tests for the number to string method.
        * Given numbers of various types, convert them to a string and
@@ -1201,6 +1310,7 @@ int main() // Main function to initialize and run all tests above
    errorTotal += testClass.stripTrailingTest();
    errorTotal += testClass.stripTest();
    errorTotal += testClass.stringToNumberTest();
+   errorTotal += testClass.fieldToNumberTest();
    errorTotal += testClass.numberToStringTest();
    errorTotal += testClass.hexConversionTest();
    errorTotal += testClass.stringReplaceTest();
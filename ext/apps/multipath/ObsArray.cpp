@@ -53,9 +53,8 @@
 #include "ExtractPC.hpp"
 #include "GGTropModel.hpp"
 
-#include "RinexObsStream.hpp"
 #include "RinexObsHeader.hpp"
-#include "RinexObsData.hpp"
+#include "Rinex3ObsTable.hpp"
 #include "FileUtils.hpp"
 #include "StringUtils.hpp"
 #include "ObsArray.hpp"
@@ -121,35 +120,48 @@ namespace gpstk
       Triple antPos;
       double dR;
 
+         // Each file is read once, into columns per satellite
+      std::vector<Rinex3ObsTable> tables(obsList.size());
+
       for (size_t i=0; i< obsList.size(); i++)
       {
-         //RinexObsHeader roh;
-         long numEpochsObs = 0;
-         double dataRate;
+         tables[i].load(obsList[i]);
+         const Rinex3ObsHeader& roh(tables[i].header);
+            // The data types are looked up through their RINEX 2 names
+         if (roh.version >= 3)
+         {
+            ObsArrayException oae("Obs file " + obsList[i] +
+                                  " is not RINEX 2");
+            GPSTK_THROW(oae);
+         }
+         long numEpochsObs = tables[i].getNumRows();
+            // As before, the interval of the header is not used
+         double dataRate = RinexObsHeader::intervalValid;
          Triple antennaPos;
 
-         scanObsFile(obsList[i], numEpochsObs, dataRate, antennaPos);
+         if ( (roh.valid & Rinex3ObsHeader::validAntennaPosition) &&
+              (roh.antennaPosition.mag() != 0) )
+         {
+            antennaPos = roh.antennaPosition;
+         }
+
          if (i==0)
          {
             antPos=antennaPos;
             dR=dataRate;
 
-            if (antennaPos.mag()<1) // A reported antenna position near the
-                                    // center of the Earth. REcompute.
+            if ((antennaPos.mag()<1) && (tables[i].getNumEpochs() > 0))
+               // A reported antenna position near the
+               // center of the Earth. REcompute.
 	    {
 	       PRSolution2 prSolver;
                prSolver.RMSLimit = 400;
                GGTropModel ggTropModel;
 	       ggTropModel.setWeather(20., 1000., 50.); // A default model for sea level.
 
-          // NOTE: The following section is partially adapted to Rinex3, but
-          //       more work is needed here
-               RinexObsStream tempObsStream(obsList[i]);
                Rinex3ObsData   tempObsData;
-               Rinex3ObsHeader tempObsHeader;
-
-               tempObsStream >> tempObsHeader;
-               tempObsStream >> tempObsData;
+               Rinex3ObsHeader tempObsHeader(roh);
+               tables[i].getEpoch(0, tempObsData);
 
                ExtractPC ifObs;
                ifObs.getData(tempObsData, tempObsHeader);
@@ -174,12 +186,6 @@ namespace gpstk
                antPos[0] = prSolver.Solution[0];
                antPos[1] = prSolver.Solution[1];
                antPos[2] = prSolver.Solution[2];
-	       /*
-	       std::cout << "Position resolved at "
-			 << antPos[0] << ", " << antPos[1] << ", "
-		         << antPos[2] << std::endl;
-	       */
-
 	    }
          }
 
@@ -216,70 +222,67 @@ namespace gpstk
 
 // totalEpochsObs calculated correctly! Now, we need to fill in the valarrays.
 
-      for (size_t i=0 ; i<obsList.size() ; i++)
+      for (size_t i=0 ; i<tables.size() ; i++)
       {
-         RinexObsStream robs(obsList[i]);
-         RinexObsHeader roh;
-
-         //robs >> roh;
-
-         RinexObsData rod;
-         RinexObsData::RinexSatMap::const_iterator it;
-
-         while (robs >> rod)
+         const Rinex3ObsTable& table(tables[i]);
+         const size_t numSats = table.sats.size();
+
+            // The columns of each satellite, in satellite order, and
+            // the index in the arrays here of each of their rows.
+         std::vector<RinexSatID> sats;
+         std::vector<const Rinex3ObsTable::SatColumns*> cols;
+         std::vector<std::vector<long> > dest(numSats);
+         std::vector<size_t> nextRow(numSats, 0);
+         Rinex3ObsTable::SatMap::const_iterator sit;
+         for (sit = table.sats.begin(); sit != table.sats.end(); sit++)
          {
-            // Second step through the obs for each SV
+            sats.push_back(sit->first);
+            cols.push_back(&sit->second);
+         }
 
-            for (it = rod.obs.begin(); it!=rod.obs.end(); it++)
+            // Walk the epochs in time order and satellite order within
+            // each epoch, so that the arrays keep their layout.
+         for (size_t e=0; e<table.getNumEpochs(); e++)
+         {
+            const CommonTime& t(table.time[e]);
+            for (size_t s=0; s<numSats; s++)
             {
+               const Rinex3ObsTable::SatColumns& sc(*cols[s]);
+               size_t row = nextRow[s];
+               if ((row >= sc.size()) || (sc.epoch[row] != e))
+                  continue;
+               nextRow[s]++;
+               dest[s].push_back(satEpochIdx);
 
-               it2 = lastObsTime.find((*it).first);
+               SatID sat(sats[s]);
+               it2 = lastObsTime.find(sat);
 
                // Step through obs to see if loss of lock is true
                bool thislli=false;
-               RinexObsData::RinexObsTypeMap::const_iterator i_rotm;
-
-               for (i_rotm = it->second.begin(); i_rotm!= it->second.end(); i_rotm++)
-               {
-                  thislli = thislli || (i_rotm->second.lli > 0);
-               }
+               for (size_t c=0; c<sc.lli.size(); c++)
+                  thislli = thislli || (sc.lli[c][row] > 0);
                lli[satEpochIdx]=thislli;
 
-
-               if (  (it2==lastObsTime.end()) || (thislli) || ( (rod.time-lastObsTime[(*it).first]) > 1.1*RinexObsHeader::intervalValid) )
+               if (  (it2==lastObsTime.end()) || (thislli) || ( (t-lastObsTime[sat]) > 1.1*RinexObsHeader::intervalValid) )
                {
                   thisPassNo = highestPass;
-                  lastObsTime[(*it).first]=rod.time;
-                  currPass[(*it).first]=highestPass++;
+                  lastObsTime[sat]=t;
+                  currPass[sat]=highestPass++;
                }
                else
                {
-                  thisPassNo = currPass[(*it).first];
-                  lastObsTime[(*it).first]=rod.time;
+                  thisPassNo = currPass[sat];
+                  lastObsTime[sat]=t;
                }
 
                pass[satEpochIdx]=thisPassNo;
-
-               for (int idx=0; idx<numObsTypes; idx++)
-               {
-                  if (isBasic[idx])
-                  {
-                     observation[satEpochIdx*numObsTypes+idx] = rod.obs[it->first][basicTypeMap[idx]].data;
-                  }
-                  else
-                  {
-                     expressionMap[idx].setRinexObs(rod.obs[it->first]);
-                     observation[satEpochIdx*numObsTypes+idx] = expressionMap[idx].evaluate();
-                  }
-
-                  satellite[satEpochIdx]  = it->first;
-               } // end of walk through observations to record
+               satellite[satEpochIdx]=sat;
 
             // Get topocentric coords for given sat
 
                try
                {
-                  Xvt svPos = ephStore.getXvt(it->first,rod.time); // Divide by 0 error occurs somewhere in here
+                  Xvt svPos = ephStore.getXvt(sat,t); // Divide by 0 error occurs somewhere in here
                   elevation[satEpochIdx]= antPos.elvAngle(svPos.x); // antennaPosition --> antennaPos.blah1
                   azimuth[satEpochIdx]  = antPos.azAngle(svPos.x); // antennaPosition --> antennaPos.blah2
                }
@@ -287,52 +290,68 @@ namespace gpstk
                {
                   validAzEl[satEpochIdx]=false;
                }
-               //std::cout << "i: (" << satEpochIdx << ")" << rod.time << std::endl;
-
-            epoch[satEpochIdx]=rod.time;
-
-//std::cout << lli[satEpochIdx] << " " << pass[satEpochIdx] << " " << observation[satEpochIdx] << " " << satellite[satEpochIdx] << " " << elevation[satEpochIdx] << " " << azimuth[satEpochIdx] << " " << epoch[satEpochIdx] << "\n";
 
-            satEpochIdx++;
+               epoch[satEpochIdx]=t;
+               satEpochIdx++;
             }
          }
-      }
-
-   numSatEpochs = totalEpochsObs;
-   }
-
-   void ObsArray::scanObsFile(const std::string& obsfilename, long& numEpochsObs, double& dataRate, Triple& antennaPos)
-   {
-      RinexObsStream robs(obsfilename.c_str());
-      RinexObsHeader roh;
-
-      robs >> roh;
 
-      RinexObsData rod;
+            // Fill in the observations one satellite column at a time
+         for (size_t s=0; s<numSats; s++)
+         {
+            const Rinex3ObsTable::SatColumns& sc(*cols[s]);
+            const std::vector<long>& d(dest[s]);
+            const size_t numRows = d.size();
+
+               // RINEX 2 obs type names and their columns for this system
+            std::map<std::string, size_t> r2cols;
+            std::string sys(1, sats[s].systemChar());
+            Rinex3ObsHeader::VersionObsMap::const_iterator vit;
+            vit = table.header.mapSysR2toR3ObsID.find(sys);
+            if (vit != table.header.mapSysR2toR3ObsID.end())
+            {
+               std::map<std::string, RinexObsID>::const_iterator oit;
+               for (oit = vit->second.begin(); oit != vit->second.end(); oit++)
+               {
+                  try
+                  {
+                     size_t c = table.header.getObsIndex(sys, oit->second);
+                     if (c < sc.data.size())
+                        r2cols[oit->first] = c;
+                  }
+                  catch(InvalidRequest)
+                  {
+                  }
+               }
+            }
 
-      if ( (roh.valid & RinexObsHeader::antennaPositionValid) == RinexObsHeader::antennaPositionValid)
-      {
-         if ( ! ((roh.antennaPosition[0]==roh.antennaPosition[1]) && (roh.antennaPosition[0]==roh.antennaPosition[2]) && (roh.antennaPosition[0]==0)) )
-	 {
-            antennaPos = roh.antennaPosition;
+            for (int idx=0; idx<numObsTypes; idx++)
+            {
+               if (isBasic[idx])
+               {
+                  std::map<std::string, size_t>::const_iterator ci;
+                  ci = r2cols.find(basicTypeMap[idx].type);
+                  const double *col = ((ci == r2cols.end()) || !numRows) ?
+                     0 : &sc.data[ci->second][0];
+                  for (size_t r=0; r<numRows; r++)
+                     observation[d[r]*numObsTypes+idx] = col ? col[r] : 0.;
+               }
+               else
+               {
+                  Expression& expr(expressionMap[idx]);
+                  std::map<std::string, size_t>::const_iterator ci;
+                  for (size_t r=0; r<numRows; r++)
+                  {
+                     for (ci = r2cols.begin(); ci != r2cols.end(); ci++)
+                        expr.set(ci->first, sc.data[ci->second][r]);
+                     observation[d[r]*numObsTypes+idx] = expr.evaluate();
+                  }
+               }
+            }
          }
       }
 
-/* this if loop never seems to be entered
-      if ( (roh.valid & RinexObsHeader::intervalValid) == RinexObsHeader::intervalValid)
-      {
-         dataRate = roh.interval;
-      }
-*/
-
-      ///// Using this because the loops used before were not being entered into, can investigate that later and maybe reinsert them.
-      dataRate=RinexObsHeader::intervalValid;
-      /////
-
-      while ( robs >> rod )
-      {
-         numEpochsObs += rod.obs.size();
-      }
+   numSatEpochs = totalEpochsObs;
    }
 
    void ObsArray::edit(const std::valarray<bool> strikeList)
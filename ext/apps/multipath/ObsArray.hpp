@@ -117,7 +117,9 @@ namespace gpstk
 
          /**
           * This functions loads a RINEX obs and nav file. Both files
-          * should be from the same period.
+          * should be from the same period. The obs files must be RINEX 2,
+          * since the data types are RINEX 2 ones; an ObsArrayException
+          * is thrown for a RINEX 3 file.
           */
       void load(const std::string& obsfilename,
                 const std::string& navfilename);
@@ -129,11 +131,6 @@ namespace gpstk
       void load(const std::vector<std::string>& obsList,
                 const std::vector<std::string>& navList);
 
-      void scanObsFile(const std::string& obsfilename,
-                       long& numEpochsObs,
-                       double& dataRate,
-                       Triple& antennaPos);
-
          /**
           * This function removes observations which the input
           * vallarray is "true".
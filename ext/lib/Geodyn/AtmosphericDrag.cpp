@@ -147,7 +147,7 @@ namespace gpstk
       
    
       // Get the J2000 to TOD transformation
-      Matrix<double> N = ReferenceFrames::J2kToTODMatrix(utc);
+      Matrix<double> N = rb.j2kToTODMatrix(utc);
 
       // Transform r from J2000 to TOD
       Vector<double> r_tod = N * r;
@@ -43,6 +43,8 @@
 
 #include "EarthBody.hpp"
 #include "ASConstant.hpp"
+#include "ReferenceFrames.hpp"
+#include "IERS.hpp"
 
 namespace gpstk
 {
@@ -73,4 +75,178 @@ namespace gpstk
    }  // End of method 'EarthBody::getSpinRate()'
 
 
+      // Returns the rotation matrix from J2000 to ECEF.
+   Matrix<double> EarthBody::j2kToECEFMatrix(const UTCTime& utc)
+   {
+      std::lock_guard<std::mutex> lock(epochMutex);
+
+      EpochTerms& terms = epochTerms(utc);
+      if(!terms.hasC2T)
+      {
+         terms.c2t = ReferenceFrames::J2kToECEFMatrix(utc);
+         terms.hasC2T = true;
+      }
+
+      return terms.c2t;
+
+   }  // End of method 'EarthBody::j2kToECEFMatrix()'
+
+
+      // Returns the J2000 position of the Sun, in meters.
+   Vector<double> EarthBody::sunJ2kPosition(const UTCTime& utc)
+   {
+      std::lock_guard<std::mutex> lock(epochMutex);
+
+      EpochTerms& terms = epochTerms(utc);
+      if(!terms.hasSun)
+      {
+         terms.sun = ReferenceFrames::getJ2kPosition(UTCTime(utc).asTDB(),
+                                                     SolarSystem::idSun);
+         terms.sun = terms.sun * 1000.0;         // from km to m
+         terms.hasSun = true;
+      }
+
+      return terms.sun;
+
+   }  // End of method 'EarthBody::sunJ2kPosition()'
+
+
+      // Returns the J2000 position of the Moon, in meters.
+   Vector<double> EarthBody::moonJ2kPosition(const UTCTime& utc)
+   {
+      std::lock_guard<std::mutex> lock(epochMutex);
+
+      EpochTerms& terms = epochTerms(utc);
+      if(!terms.hasMoon)
+      {
+         terms.moon = ReferenceFrames::getJ2kPosition(UTCTime(utc).asTDB(),
+                                                      SolarSystem::idMoon);
+         terms.moon = terms.moon * 1000.0;       // from km to m
+         terms.hasMoon = true;
+      }
+
+      return terms.moon;
+
+   }  // End of method 'EarthBody::moonJ2kPosition()'
+
+
+      // Returns the rotation matrix from J2000 to true of date.
+   Matrix<double> EarthBody::j2kToTODMatrix(const UTCTime& utc)
+   {
+      std::lock_guard<std::mutex> lock(epochMutex);
+
+      EpochTerms& terms = epochTerms(utc);
+      if(!terms.hasTOD)
+      {
+         terms.tod = ReferenceFrames::J2kToTODMatrix(utc);
+         terms.hasTOD = true;
+      }
+
+      return terms.tod;
+
+   }  // End of method 'EarthBody::j2kToTODMatrix()'
+
+
+      // Returns the polar motion, in arcsec.
+   void EarthBody::polarMotion(const UTCTime& utc, double& xp, double& yp)
+   {
+      std::lock_guard<std::mutex> lock(epochMutex);
+
+      EpochTerms& terms = epochTerms(utc);
+      if(!terms.hasPole)
+      {
+         double mjdUtc = UTCTime(utc).mjdUTC();
+         terms.xp = IERS::xPole(mjdUtc);
+         terms.yp = IERS::yPole(mjdUtc);
+         terms.hasPole = true;
+      }
+
+      xp = terms.xp;
+      yp = terms.yp;
+
+   }  // End of method 'EarthBody::polarMotion()'
+
+
+      // Returns the Greenwich mean sidereal time, in radians.
+   double EarthBody::gmst(const UTCTime& utc)
+   {
+      std::lock_guard<std::mutex> lock(epochMutex);
+
+      EpochTerms& terms = epochTerms(utc);
+      if(!terms.hasGMST)
+      {
+         UTCTime t(utc);
+         terms.gmst = ReferenceFrames::iauGmst00(t.asUT1(), t.asTT());
+         terms.hasGMST = true;
+      }
+
+      return terms.gmst;
+
+   }  // End of method 'EarthBody::gmst()'
+
+
+      // Returns the Doodson arguments and the fundamental arguments of
+      // nutation.
+   void EarthBody::doodsonArguments(const UTCTime& utc,
+                                    double BETA[6],
+                                    double FNUT[5])
+   {
+      std::lock_guard<std::mutex> lock(epochMutex);
+
+      EpochTerms& terms = epochTerms(utc);
+      if(!terms.hasDoodson)
+      {
+         UTCTime t(utc);
+         ReferenceFrames::doodsonArguments(t.asUT1(), t.asTT(),
+                                           terms.beta, terms.fnut);
+         terms.hasDoodson = true;
+      }
+
+      for(int i = 0; i < 6; i++)
+      {
+         BETA[i] = terms.beta[i];
+      }
+      for(int i = 0; i < 5; i++)
+      {
+         FNUT[i] = terms.fnut[i];
+      }
+
+   }  // End of method 'EarthBody::doodsonArguments()'
+
+
+   void EarthBody::clearEpochs()
+   {
+      std::lock_guard<std::mutex> lock(epochMutex);
+      epochs.clear();
+   }
+
+
+      // Returns the terms at an epoch, adding them if needed.
+   EarthBody::EpochTerms& EarthBody::epochTerms(const UTCTime& utc)
+   {
+      std::map<CommonTime, EpochTerms>::iterator it = epochs.find(utc);
+      if(it != epochs.end())
+      {
+         return it->second;
+      }
+
+         // Drop the epoch farthest from the new one; orbits are usually
+         // integrated in one direction.
+      if(epochs.size() >= maxEpochs)
+      {
+         if(utc < epochs.begin()->first)
+         {
+            epochs.erase(--epochs.end());
+         }
+         else
+         {
+            epochs.erase(epochs.begin());
+         }
+      }
+
+      return epochs[utc];
+
+   }  // End of method 'EarthBody::epochTerms()'
+
+
 }  // End of namespace 'gpstk'
@@ -44,7 +44,12 @@
 #ifndef GPSTK_EARTH_BODY_HPP
 #define GPSTK_EARTH_BODY_HPP
 
+#include <map>
+#include <mutex>
+
 #include "UTCTime.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
 
 namespace gpstk
 {
@@ -53,12 +58,30 @@ namespace gpstk
 
       /** Class to handle earth planet, it'll be taken as the central
        * body of the spacecraft.
+       *
+       * It also provides the terms of the force models that depend only
+       * on time: the J2000 to ECEF and J2000 to TOD rotations, the
+       * positions of the Sun and the Moon, the polar motion, the
+       * Greenwich mean sidereal time and the Doodson arguments. Each
+       * term is computed when first asked for at an epoch, and kept for
+       * the most recent epochs. So it is computed once for all of the
+       * force models evaluated at an epoch, once for the stages of the
+       * integrator that fall on the same epoch, and once for all of the
+       * orbits sharing this object (see SatOrbit::setEarthBody()).
+       * These methods may be called from several threads at once.
        */
    class EarthBody
    {
    public:
          /// Default constructor
-      EarthBody() {}
+      EarthBody() : maxEpochs(64) {}
+
+         /// Copy constructor; the stored epochs are not copied.
+      EarthBody(const EarthBody& right) : maxEpochs(right.maxEpochs) {}
+
+         /// Assignment operator; the stored epochs are cleared.
+      EarthBody& operator=(const EarthBody& right)
+      { clearEpochs(); maxEpochs = right.maxEpochs; return (*this); }
 
          /// Default destructor
       virtual ~EarthBody() {}
@@ -68,10 +91,80 @@ namespace gpstk
           * @t   epoch in UTC
           */
       virtual double getSpinRate(UTCTime t);
-   
+
+         /// Returns the rotation matrix from J2000 to ECEF at \a utc.
+      virtual Matrix<double> j2kToECEFMatrix(const UTCTime& utc);
+
+         /// Returns the J2000 position of the Sun at \a utc, in meters.
+      virtual Vector<double> sunJ2kPosition(const UTCTime& utc);
+
+         /// Returns the J2000 position of the Moon at \a utc, in meters.
+      virtual Vector<double> moonJ2kPosition(const UTCTime& utc);
+
+         /// Returns the rotation matrix from J2000 to true of date at
+         /// \a utc.
+      virtual Matrix<double> j2kToTODMatrix(const UTCTime& utc);
+
+         /** Returns the polar motion at \a utc.
+          *
+          * @param utc  epoch
+          * @param xp   x pole, in arcsec
+          * @param yp   y pole, in arcsec
+          */
+      virtual void polarMotion(const UTCTime& utc, double& xp, double& yp);
+
+         /// Returns the Greenwich mean sidereal time at \a utc, by the
+         /// IAU 2000 model, in radians.
+      virtual double gmst(const UTCTime& utc);
+
+         /// Returns the Doodson arguments and the fundamental arguments of
+         /// nutation at \a utc, see ReferenceFrames::doodsonArguments().
+      virtual void doodsonArguments(const UTCTime& utc,
+                                    double BETA[6],
+                                    double FNUT[5]);
+
+         /// Forget the stored terms, e.g. after loading other earth
+         /// orientation parameters or ephemeris.
+      void clearEpochs();
+
+         /// Sets the number of epochs whose terms are kept.
+      EarthBody& setMaxEpochs(size_t n)
+      { maxEpochs = (n > 0) ? n : 1; return (*this); }
 
    protected:
 
+         /// Time dependent terms at one epoch, each computed on demand.
+      struct EpochTerms
+      {
+         EpochTerms()
+            : hasC2T(false), hasTOD(false), hasSun(false), hasMoon(false),
+              hasPole(false), hasGMST(false), hasDoodson(false)
+         {}
+
+         Matrix<double> c2t;
+         Matrix<double> tod;
+         Vector<double> sun;
+         Vector<double> moon;
+         double xp, yp;
+         double gmst;
+         double beta[6];
+         double fnut[5];
+         bool hasC2T, hasTOD, hasSun, hasMoon, hasPole, hasGMST, hasDoodson;
+      };
+
+         /// Returns the terms at \a utc, adding them if needed.
+         /// 'epochMutex' must be held by the caller.
+      EpochTerms& epochTerms(const UTCTime& utc);
+
+         /// Terms of the most recent epochs
+      std::map<CommonTime, EpochTerms> epochs;
+
+         /// Maximum size of 'epochs'
+      size_t maxEpochs;
+
+         /// Protects 'epochs'
+      std::mutex epochMutex;
+
          /// Earth's rotation rate in rad/s.
       static const double omegaEarth;
 
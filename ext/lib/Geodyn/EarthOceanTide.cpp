@@ -177,6 +177,23 @@ namespace gpstk
        *    C20 C21 C22 C30 C31 C32 C33 C40 C41 C42 C43 C44
        */
    void EarthOceanTide::getOceanTide(double mjdUtc, double dC[], double dS[] )
+   {
+      EarthBody rb;
+      getOceanTide(rb, UTCTime(mjdUtc), dC, dS);
+   }
+
+
+      /* Ocean pole tide to normalized earth potential coefficients, with
+       * the terms depending on time from an EarthBody
+       *
+       * @param rb     EarthBody providing the terms depending on time
+       * @param utc    UTC time
+       * @param dC     Correction to normalized coefficients dC
+       * @param dS     Correction to normalized coefficients dS
+       *    C20 C21 C22 C30 C31 C32 C33 C40 C41 C42 C43 C44
+       */
+   void EarthOceanTide::getOceanTide(EarthBody& rb, const UTCTime& utc,
+                                     double dC[], double dS[] )
    {
       try
       {
@@ -196,14 +213,11 @@ namespace gpstk
          return;
       }
       
-      UTCTime utc;
-      utc=mjdUtc;
-
       //   CC PURPOSE    :  COMPUTE DOODSON'S FUNDAMENTAL ARGUMENTS (BETA)
       //  CC               AND FUNDAMENTAL ARGUMENTS FOR NUTATION (FNUT)
       double BETA[6]={0.0};
       double FNUT[5] ={0.0};
-      ReferenceFrames::doodsonArguments(utc.asUT1(), utc.asTT(), BETA,FNUT);
+      rb.doodsonArguments(utc, BETA, FNUT);
 
       for(int i=0;i<tideData.NTACT;i++)
       {
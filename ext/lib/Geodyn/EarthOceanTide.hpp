@@ -45,6 +45,8 @@
 
 #include <string>
 
+#include "EarthBody.hpp"
+
 
 namespace gpstk
 {
@@ -94,6 +96,18 @@ namespace gpstk
           */
       void getOceanTide(double mjdUtc, double dC[], double dS[] );
 
+         /** Ocean tide to normalized earth potential coefficients, with
+          *  the terms depending on time from an EarthBody
+          *
+          * @param rb     EarthBody providing the terms depending on time
+          * @param utc    UTC time
+          * @param dC     Correction to normalized coefficients dC
+          * @param dS     Correction to normalized coefficients dS
+          *    C20 C21 C22 C30 C31 C32 C33 C40 C41 C42 C43 C44
+          */
+      void getOceanTide(EarthBody& rb, const UTCTime& utc,
+                        double dC[], double dS[] );
+
       void setTideFile(std::string file)
       {
          fileName = file;
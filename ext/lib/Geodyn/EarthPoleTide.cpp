@@ -54,6 +54,22 @@ namespace gpstk
        * @param dS21     correction to normalized coefficients dS21
        */
    void EarthPoleTide::getPoleTide(double mjdUtc, double& dC21, double& dS21 )
+   {
+      EarthBody rb;
+      getPoleTide(rb, UTCTime(mjdUtc), dC21, dS21);
+   }
+
+
+      /* Solid pole tide to normalized earth potential coefficients, with
+       * the polar motion from an EarthBody
+       *
+       * @param rb       EarthBody providing the polar motion
+       * @param utc      UTC time
+       * @param dC21     correction to normalized coefficients dC21
+       * @param dS21     correction to normalized coefficients dS21
+       */
+   void EarthPoleTide::getPoleTide(EarthBody& rb, const UTCTime& utc,
+                                   double& dC21, double& dS21 )
    {
       // See IERS Conventions 2003 section 7.1.4, P84
 
@@ -66,13 +82,14 @@ namespace gpstk
       const double dyp0 = 0.00395;   // in arcsec/year
 
       // UTC time
+      double mjdUtc = UTCTime(utc).mjdUTC();
       double leapYear = (mjdUtc-ASConstant::MJD_J2000)/365.25;
       
       double xpm = xp0 + leapYear * dxp0;
       double ypm = yp0 + leapYear * dyp0;
       
-      double xp = IERS::xPole(mjdUtc);   // in arcsec
-      double yp = IERS::yPole(mjdUtc);    // in arcsec
+      double xp, yp;
+      rb.polarMotion(utc, xp, yp);   // in arcsec
       
       double m1 =  xp - xpm;
       double m2 = -yp + ypm;
@@ -43,6 +43,8 @@
 #ifndef GPSTK_POLE_TIDE_HPP
 #define GPSTK_POLE_TIDE_HPP
 
+#include "EarthBody.hpp"
+
 namespace gpstk
 {
       /// @ingroup GeoDynamics 
@@ -70,6 +72,17 @@ namespace gpstk
           */
       void getPoleTide(double mjdUtc, double& dC21, double& dS21 );
 
+         /** Solid pole tide to normalized earth potential coefficients,
+          *  with the polar motion from an EarthBody
+          *
+          * @param rb       EarthBody providing the polar motion
+          * @param utc      UTC time
+          * @param dC21     correction to normalized coefficients dC21
+          * @param dS21     correction to normalized coefficients dS21
+          */
+      void getPoleTide(EarthBody& rb, const UTCTime& utc,
+                       double& dC21, double& dS21 );
+
 
    }; // End of class 'EarthPoleTide'
 
@@ -154,12 +154,26 @@ namespace gpstk
        */
    void EarthSolidTide::getSolidTide(double mjdUtc, double dC[], double dS[] )
    {
-      UTCTime utc(mjdUtc);
-          
-      Matrix<double> E = ReferenceFrames::J2kToECEFMatrix(utc);
+      EarthBody rb;
+      getSolidTide(rb, UTCTime(mjdUtc), dC, dS);
+   }
+
+
+      /* Solid tide to normalized earth potential coefficients, with the
+       * terms depending on time from an EarthBody
+       *
+       * @param rb      EarthBody providing the terms depending on time
+       * @param utc     UTC time
+       * @param dC      correction to normalized coefficients dC
+       * @param dS      correction to normalized coefficients dS
+       */
+   void EarthSolidTide::getSolidTide(EarthBody& rb, const UTCTime& utc,
+                                     double dC[], double dS[] )
+   {
+      Matrix<double> E = rb.j2kToECEFMatrix(utc);
       
-      Vector<double> moonReci = ReferenceFrames::getJ2kPosition(utc.asTDB(),SolarSystem::idMoon)*1000.0;
-      Vector<double> sunReci = ReferenceFrames::getJ2kPosition(utc.asTDB(),SolarSystem::idSun)*1000.0;
+      Vector<double> moonReci = rb.moonJ2kPosition(utc);   // in m
+      Vector<double> sunReci = rb.sunJ2kPosition(utc);     // in m
 
       Vector<double> moonR = E * moonReci;         // in ecef m
       Vector<double> sunR = E * sunReci;           // in ecef m
@@ -262,8 +276,8 @@ namespace gpstk
       //   COMPUTE DOODSON'S FUNDAMENTAL ARGUMENTS (BETA) 
       double BETA[6] = {0.0};
       double Dela[5] = {0.0};
-      ReferenceFrames::doodsonArguments(utc.asUT1(),utc.asTT(),BETA,Dela);
-      double GMST = ReferenceFrames::iauGmst00(utc.asUT1(), utc.asTT());
+      rb.doodsonArguments(utc,BETA,Dela);
+      double GMST = rb.gmst(utc);
       
 
       for(int i=0;i<48;i++)
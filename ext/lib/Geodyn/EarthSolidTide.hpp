@@ -43,6 +43,8 @@
 #ifndef GPSTK_SOLID_TIDE_HPP
 #define GPSTK_SOLID_TIDE_HPP
 
+#include "EarthBody.hpp"
+
 namespace gpstk
 {
       /// @ingroup GeoDynamics 
@@ -70,6 +72,18 @@ namespace gpstk
           */
       void getSolidTide(double mjdUtc, double dC[], double dS[] );
 
+         /**
+          * Solid tide to normalized earth potential coefficients, with
+          * the terms depending on time from an EarthBody
+          *
+          * @param rb      EarthBody providing the terms depending on time
+          * @param utc     UTC time
+          * @param dC      correction to normalized coefficients dC
+          * @param dS      correction to normalized coefficients dS
+          */
+      void getSolidTide(EarthBody& rb, const UTCTime& utc,
+                        double dC[], double dS[] );
+
 
       void test();
 
@@ -808,7 +808,7 @@ namespace gpstk
       double density = 0.0;
       
       // Get the J2000 to TOD transformation
-      Matrix<double> N = ReferenceFrames::J2kToTODMatrix(utc);
+      Matrix<double> N = rb.j2kToTODMatrix(utc);
 
       // Debuging
       /*
@@ -843,8 +843,7 @@ namespace gpstk
          //GPSTK_THROW(e);
       }
 
-      Vector<double> r_Sun = ReferenceFrames::getJ2kPosition( utc.asTDB(),
-                                                              SolarSystem::idSun);
+      Vector<double> r_Sun = rb.sunJ2kPosition(utc);     // in m
 
       // get coefficients for this F107
       //updateF107(std::pow(149597870.0/norm(r_Sun),2)*dailyF107);
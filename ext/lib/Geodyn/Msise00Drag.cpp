@@ -318,13 +318,13 @@ namespace gpstk
       struct nrlmsise_flags flags;
 
          //* Get the J2000 to TOD transformation
-      Matrix<double> N = ReferenceFrames::J2kToTODMatrix(utc);
+      Matrix<double> N = rb.j2kToTODMatrix(utc);
 
          //* Transform r from J2000 to TOD
       Vector<double> r_tod = N * r;
 
 
-      Matrix<double> eci2ecef = ReferenceFrames::J2kToECEFMatrix(utc);
+      Matrix<double> eci2ecef = rb.j2kToECEFMatrix(utc);
 
       Vector<double> r_ecef = eci2ecef * r;
       
@@ -57,6 +57,8 @@ namespace gpstk
       // Objects to handle JPL ephemeris 405 
    SolarSystem ReferenceFrames::solarPlanets;
 
+   std::mutex ReferenceFrames::ephMutex;
+
       // Reference epoch (J2000), Julian Date
    const double ReferenceFrames::DJ00 = 2451545.0;
 
@@ -138,6 +140,7 @@ namespace gpstk
       try
       {
          double rvState[6] = {0.0};
+         std::lock_guard<std::mutex> lock(ephMutex);
          solarPlanets.RelativeInertialPositionVelocity(
             static_cast<Epoch>(TT).MJD(),
             entity,
@@ -324,6 +327,30 @@ namespace gpstk
    }
 
 
+      // GCRS to ECEF using EarthOrientation conventions and EarthRotationCache
+   Matrix<double> ReferenceFrames::GCRSToECEFMatrix(UTCTime UTC,
+                                                    EarthRotationCache& cache,
+                                                    IERSConvention iers)
+      throw(Exception)
+   {
+      try
+      {
+         EarthOrientation eo;
+         eo.xp = UTC.xPole();                // arcsec
+         eo.yp = UTC.yPole();
+         eo.UT1mUTC = UTC.UT1mUTC();
+         eo.convention = iers;
+
+         return transpose(cache.ECEFtoInertial(eo, EphTime(UTC)));
+      }
+      catch(Exception& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+
+   }  // End of method 'ReferenceFrames::GCRSToECEFMatrix()'
+
+
    Vector<double> ReferenceFrames::J2kPosVelToECEF(UTCTime UTC, Vector<double> j2kPosVel)
       throw(Exception)
    {
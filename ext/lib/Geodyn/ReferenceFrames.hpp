@@ -44,9 +44,12 @@
 #ifndef GPSTK_REFERENCE_FRAMES_HPP
 #define GPSTK_REFERENCE_FRAMES_HPP
 
+#include <mutex>
+
 #include "Vector.hpp"
 #include "Matrix.hpp"
 #include "SolarSystem.hpp"
+#include "EarthRotationCache.hpp"
 #include "UTCTime.hpp"
 
 namespace gpstk
@@ -71,6 +74,7 @@ namespace gpstk
       static int setJPLEphFile(std::string filename) 
          throw(Exception)
       {
+         std::lock_guard<std::mutex> lock(ephMutex);
          return solarPlanets.initializeWithBinaryFile(filename);
       }
 
@@ -161,6 +165,17 @@ namespace gpstk
          /// NP TOD - TrueOfDate
       static Matrix<double> J2kToTODMatrix(UTCTime UTC);
 
+         /** Get the transform matrix from the conventional inertial frame
+          *  (GCRS) to ECEF following the IERS 2003 or 2010 conventions, with
+          *  the EOPs of UTC and the nutation / CIO series interpolated by
+          *  cache. Unlike J2kToECEFMatrix() (IAU 1976/1980) this includes the
+          *  frame bias, about 0.02 arcsec.
+          */
+      static Matrix<double> GCRSToECEFMatrix(UTCTime UTC,
+                                             EarthRotationCache& cache,
+               IERSConvention iers = IERSConvention::IERS2010)
+         throw(Exception);
+
          /// Convert position and velocity from J2000 to ECEF.
       static Vector<double> J2kPosVelToECEF(UTCTime UTC, Vector<double> j2kPosVel)
          throw(Exception);
@@ -294,6 +309,10 @@ namespace gpstk
          /// Objects to handle the JPL Ephemeris
       static SolarSystem solarPlanets;
 
+         /// Serializes the use of 'solarPlanets', which reads the records
+         /// of the ephemeris on demand
+      static std::mutex ephMutex;
+
       // Constant Variables
       //-------------------------------------------------
 
@@ -63,9 +63,46 @@ namespace gpstk
 
       UTCTime utc = utc0;
       utc += t;
-      return forceList.getDerivatives(utc, earthBody, sc);
+      return forceList.getDerivatives(utc, *pEarthBody, sc);
    }
 
+   SatOrbit::SatOrbit(const SatOrbit& right)
+      : EquationOfMotion(right), pEarthBody(&earthBody), fmlPrepared(false)
+   {
+      (*this) = right;
+
+   }  // End of copy constructor 'SatOrbit::SatOrbit()'
+
+
+   SatOrbit& SatOrbit::operator=(const SatOrbit& right)
+   {
+      if(this == &right) return (*this);
+
+      deleteFMObjects(forceConfig);
+      fmlPrepared = false;
+      // ForceModelList::clear() keeps the pointers, so start over
+      forceList = ForceModelList();
+
+      utc0 = right.utc0;
+      sc = right.sc;
+      earthBody = right.earthBody;
+      pEarthBody = (right.pEarthBody == &right.earthBody) ? &earthBody
+                                                          : right.pEarthBody;
+
+      // settings only, the objects of 'right' stay with it
+      forceConfig = right.forceConfig;
+      forceConfig.pGeoEarth = NULL;
+      forceConfig.pGeoSun = NULL;
+      forceConfig.pGeoMoon = NULL;
+      forceConfig.pAtmDrag = NULL;
+      forceConfig.pSolarPressure = NULL;
+      forceConfig.pRelEffect = NULL;
+
+      return (*this);
+
+   }  // End of method 'SatOrbit::operator=()'
+
+
    void SatOrbit::init()
    {
       setSpacecraftData("sc-test01",1000.0,20.0,20.0,1.0,2.2);
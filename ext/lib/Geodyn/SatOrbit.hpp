@@ -154,9 +154,19 @@ namespace gpstk
    public:
 
          /// Default constructor
-      SatOrbit() : fmlPrepared(false)
+      SatOrbit() : pEarthBody(&earthBody), fmlPrepared(false)
       { reset(); }
 
+         /** Copy constructor. The force model settings are copied, but
+          *  not the force model objects, which are created again on
+          *  first use. If 'right' uses its own EarthBody this object
+          *  uses its own too, otherwise the same shared one.
+          */
+      SatOrbit(const SatOrbit& right);
+
+         /// Assignment operator, as the copy constructor
+      SatOrbit& operator=(const SatOrbit& right);
+
          /// Default destructor
       virtual ~SatOrbit()
       { deleteFMObjects(forceConfig); }
@@ -178,6 +188,21 @@ namespace gpstk
       { return utc0; }
 
 
+         /** Use another EarthBody object, so that the terms of the force
+          *  models that depend only on time are shared with other orbits
+          *  using it.
+          *
+          * @param pBody  EarthBody to use, or NULL to use the own one.
+          *               It must outlive this object.
+          */
+      SatOrbit& setEarthBody(EarthBody* pBody)
+      { pEarthBody = pBody ? pBody : &earthBody; return (*this); }
+
+         /// get the EarthBody in use
+      EarthBody* getEarthBody() const
+      { return pEarthBody; }
+
+
          /// set spacecraft physical parameters
       SatOrbit& setSpacecraftData(std::string name = "sc-test01",
                                   const double& mass = 1000.0,
@@ -245,6 +270,9 @@ namespace gpstk
       ///  Earth Body
       EarthBody  earthBody;     
 
+         /// Earth Body in use, by default 'earthBody'
+      EarthBody* pEarthBody;
+
          /// Object holding force model consiguration
       FMCData forceConfig;
   
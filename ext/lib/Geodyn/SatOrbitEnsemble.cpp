@@ -0,0 +1,192 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file SatOrbitEnsemble.cpp
+ * Propagate the orbits of many satellites together.
+ */
+
+#include <functional>
+
+#include "SatOrbitEnsemble.hpp"
+#include "StringUtils.hpp"
+
+namespace gpstk
+{
+
+      // Common constructor
+   SatOrbitEnsemble::SatOrbitEnsemble(const UTCTime& utc,
+                                      unsigned numThreads)
+      : utc0(utc),
+        curT(0.0),
+        stepSize(10.0),
+        pool(numThreads)
+   {
+   }
+
+
+   SatOrbitEnsemble::~SatOrbitEnsemble()
+   {
+      for(size_t i = 0; i < members.size(); i++)
+      {
+         members[i]->prop.getSatOrbitPointer()->setEarthBody(
+                                                      members[i]->prevBody);
+         delete members[i];
+      }
+      members.clear();
+   }
+
+
+      // Adds a satellite at the initial epoch
+   size_t SatOrbitEnsemble::addSatellite(SatOrbit& orbit,
+                                         const Vector<double>& rv0)
+   {
+      if(curT != 0.0)
+      {
+         Exception e("SatOrbitEnsemble: satellites must be added at the "
+                     "initial epoch");
+         GPSTK_THROW(e);
+      }
+
+      Member* m = new Member;
+      m->prevBody = orbit.getEarthBody();
+      m->failed = false;
+      orbit.setEarthBody(&earthBody);
+      m->prop.setOrbit(&orbit);
+      m->prop.setStepSize(stepSize);
+      m->prop.setInitState(utc0, rv0);
+
+      members.push_back(m);
+
+      return members.size() - 1;
+
+   }  // End of method 'SatOrbitEnsemble::addSatellite()'
+
+
+   SatOrbitEnsemble& SatOrbitEnsemble::setStepSize(double step)
+   {
+      stepSize = step;
+      for(size_t i = 0; i < members.size(); i++)
+      {
+         members[i]->prop.setStepSize(step);
+      }
+
+      return (*this);
+
+   }  // End of method 'SatOrbitEnsemble::setStepSize()'
+
+
+      // Advance all of the satellites
+   bool SatOrbitEnsemble::integrateTo(double tf)
+   {
+      if(members.size() == 1 || pool.getNumThreads() == 1)
+      {
+         for(size_t i = 0; i < members.size(); i++)
+         {
+            members[i]->run(tf);
+         }
+      }
+      else
+      {
+         for(size_t i = 0; i < members.size(); i++)
+         {
+            pool.submit( std::bind(&Member::run, members[i], tf) );
+         }
+         pool.wait();
+      }
+
+      curT = tf;
+
+      for(size_t i = 0; i < members.size(); i++)
+      {
+         if(members[i]->failed)
+         {
+            Exception e( "SatOrbitEnsemble: satellite "
+                         + StringUtils::asString(i) + ": "
+                         + members[i]->error );
+            GPSTK_THROW(e);
+         }
+      }
+
+      return true;
+
+   }  // End of method 'SatOrbitEnsemble::integrateTo()'
+
+
+   SatOrbitPropagator& SatOrbitEnsemble::propagator(size_t i)
+   {
+      if(i >= members.size())
+      {
+         InvalidRequest e("SatOrbitEnsemble: no satellite "
+                          + StringUtils::asString(i));
+         GPSTK_THROW(e);
+      }
+
+      return members[i]->prop;
+
+   }  // End of method 'SatOrbitEnsemble::propagator()'
+
+
+      // Integrate one satellite, recording any error
+   void SatOrbitEnsemble::Member::run(double tf)
+   {
+      failed = false;
+      error.clear();
+
+      try
+      {
+         prop.integrateTo(tf);
+      }
+      catch(Exception& e)
+      {
+         failed = true;
+         error = e.getText();
+      }
+      catch(std::exception& e)
+      {
+         failed = true;
+         error = e.what();
+      }
+      catch(...)
+      {
+         failed = true;
+         error = "unknown exception";
+      }
+
+   }  // End of method 'SatOrbitEnsemble::Member::run()'
+
+
+}  // End of namespace 'gpstk'
@@ -0,0 +1,212 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file SatOrbitEnsemble.hpp
+ * Propagate the orbits of many satellites together.
+ */
+
+#ifndef GPSTK_SAT_ORBIT_ENSEMBLE_HPP
+#define GPSTK_SAT_ORBIT_ENSEMBLE_HPP
+
+#include <string>
+#include <vector>
+
+#include "SatOrbitPropagator.hpp"
+#include "ThreadPool.hpp"
+
+
+namespace gpstk
+{
+      /// @ingroup GeoDynamics 
+      //@{
+
+      /**
+       * Propagate the orbits of many satellites from a common initial
+       * epoch, such as a constellation or perturbed copies of a state
+       * used to check its transition matrix.
+       *
+       * Each satellite has its own SatOrbit, with its own force models
+       * and spacecraft data, and its own SatOrbitPropagator. All of the
+       * orbits use the same EarthBody, so the terms of the force models
+       * that depend only on time (the J2000 to ECEF rotation with the
+       * earth orientation parameters, the positions of the Sun and the
+       * Moon) are computed once per epoch for the whole ensemble. The
+       * integrators use the same fixed step, so they meet the same
+       * epochs.
+       *
+       * integrateTo() advances every satellite as one task on a pool of
+       * threads, and returns when all of them are done. The results
+       * are the same as with one SatOrbitPropagator per satellite, and
+       * don't depend on the number of threads.
+       *
+       * @code
+       *   SatOrbitEnsemble ens(utc0);
+       *   ens.setStepSize(60.0);
+       *   for(int i = 0; i < numSats; i++)
+       *   {
+       *      orbit[i].enableGeopotential(SatOrbit::GM_JGM3, 20, 20);
+       *      ens.addSatellite(orbit[i], rv0[i]);
+       *   }
+       *
+       *   for(double t = 60.0; t <= 86400.0; t += 60.0)
+       *   {
+       *      ens.integrateTo(t);
+       *      for(int i = 0; i < numSats; i++)
+       *         cout << ens.rvState(i) << endl;
+       *   }
+       * @endcode
+       *
+       * \warning The satellites are integrated concurrently, so a
+       * SatOrbit (and its force models) must be added only once.
+       */
+   class SatOrbitEnsemble
+   {
+   public:
+
+         /** Common constructor.
+          *
+          * @param utc0       Initial epoch of all the satellites.
+          * @param numThreads Number of threads; 0 selects one per
+          *                   hardware thread.
+          */
+      explicit SatOrbitEnsemble(const UTCTime& utc0,
+                                unsigned numThreads = 0);
+
+         /// Default destructor
+      virtual ~SatOrbitEnsemble();
+
+
+         /** Adds a satellite at the initial epoch.
+          *
+          * @param orbit   Equation of motion of the satellite, with its
+          *                force models configured. It is used by
+          *                reference and must outlive this object.
+          *                While it is in the ensemble it uses the
+          *                EarthBody of the ensemble; the one it used
+          *                before is set again by the destructor.
+          * @param rv0     J2000 position and velocity, in m and m/s.
+          * @return        index of the satellite.
+          */
+      virtual size_t addSatellite(SatOrbit& orbit,
+                                  const Vector<double>& rv0);
+
+
+         /// Set the step size of the integrators, in seconds.
+      virtual SatOrbitEnsemble& setStepSize(double step);
+
+
+         /** Advance all of the satellites.
+          *
+          * @param tf    Time since the initial epoch, in seconds.
+          * @return      true on success.
+          *
+          * @throw Exception if the integration of any satellite failed.
+          * All of the satellites are integrated first, and the exception
+          * reports the first failed one; the others are left at \a tf.
+          */
+      virtual bool integrateTo(double tf);
+
+
+         /// Number of satellites.
+      size_t numSatellites() const
+      { return members.size(); }
+
+         /// Number of threads.
+      unsigned getNumThreads() const
+      { return pool.getNumThreads(); }
+
+         /// Return the current epoch.
+      UTCTime getCurTime() const
+      { UTCTime utc = utc0; utc += curT; return utc; }
+
+         /// Return the position and velocity of satellite \a i.
+      Vector<double> rvState(size_t i, bool bJ2k = true)
+      { return propagator(i).rvState(bJ2k); }
+
+         /// Return the 6*6 state transition matrix of satellite \a i.
+      Matrix<double> transitionMatrix(size_t i)
+      { return propagator(i).transitionMatrix(); }
+
+         /// Return the propagator of satellite \a i.
+      SatOrbitPropagator& propagator(size_t i);
+
+         /// Return the EarthBody shared by the satellites.
+      EarthBody& getEarthBody()
+      { return earthBody; }
+
+   private:
+
+         /// Propagator of one satellite and the result of its last step.
+      struct Member
+      {
+         SatOrbitPropagator prop;
+            /// EarthBody of the orbit before it was added
+         EarthBody* prevBody;
+         bool failed;
+         std::string error;
+
+            /// Integrate to tf, recording any error.
+         void run(double tf);
+      };
+
+         /// Initial epoch.
+      UTCTime utc0;
+
+         /// Current time since the initial epoch.
+      double curT;
+
+         /// Step size of the integrators.
+      double stepSize;
+
+         /// Shared by the orbits of all the members.
+      EarthBody earthBody;
+
+      std::vector<Member*> members;
+
+      ThreadPool pool;
+
+         // not copyable
+      SatOrbitEnsemble(const SatOrbitEnsemble&);
+      SatOrbitEnsemble& operator=(const SatOrbitEnsemble&);
+
+   }; // End of class 'SatOrbitEnsemble'
+
+      // @}
+
+}  // End of namespace 'gpstk'
+
+#endif   // GPSTK_SAT_ORBIT_ENSEMBLE_HPP
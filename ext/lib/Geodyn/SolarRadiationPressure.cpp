@@ -265,12 +265,9 @@ namespace gpstk
       dryMass = sc.getDryMass();
       reflectCoeff = sc.getReflectCoeff();
 
-      Vector<double> r_sun = ReferenceFrames::getJ2kPosition(utc.asTDB(),SolarSystem::idSun);
-      Vector<double> r_moon = ReferenceFrames::getJ2kPosition(utc.asTDB(),SolarSystem::idMoon);
-      
-      // from km to m
-      r_sun = r_sun*1000.0;
-      r_moon = r_moon*1000.0;
+      // in m
+      Vector<double> r_sun = rb.sunJ2kPosition(utc);
+      Vector<double> r_moon = rb.moonJ2kPosition(utc);
 
       // a
       a = accelSRP(sc.R(),r_sun)*getShadowFunction(sc.R(),r_sun,r_moon,SM_CONICAL);
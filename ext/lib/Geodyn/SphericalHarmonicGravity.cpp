@@ -58,7 +58,8 @@ namespace gpstk
            desiredOrder(m),
            correctSolidTide(false),
            correctPoleTide(false),
-           correctOceanTide(false)
+           correctOceanTide(false),
+           useWorkspace(true)
    {
       const int size = desiredDegree;
 
@@ -67,13 +68,32 @@ namespace gpstk
 
          //Sn0.resize(gmData.maxDegree, 0.0);
 
+      ws.degree = ws.order = -1;
+      ws.dim = 0;
+
    }
 
+
+      // Set the degree and order, resizing the harmonic functions.
+   SphericalHarmonicGravity& SphericalHarmonicGravity::setDesiredDegree(
+                                                   const int& n, const int& m)
+   {
+      desiredDegree = n;
+      desiredOrder = m;
+
+      V.resize( n + 3, n + 3, 0.0);
+      W.resize( n + 3, n + 3, 0.0);
+
+      return (*this);
+
+   }  // End of method 'SphericalHarmonicGravity::setDesiredDegree()'
+
       /* Evaluates the two harmonic functions V and W.
        * @param r ECI position vector.
        * @param E ECI to ECEF transformation matrix.
        */
-   void SphericalHarmonicGravity::computeVW(Vector<double> r, Matrix<double> E)
+   void SphericalHarmonicGravity::computeVW(const Vector<double>& r,
+                                            const Matrix<double>& E)
    {   
          // dimension should be checked here
          // I'll do it latter...
@@ -149,7 +169,8 @@ namespace gpstk
        * @param E ECI to ECEF transformation matrix.
        * @return ECI acceleration in m/s^2.
        */
-   Vector<double> SphericalHarmonicGravity::gravity(Vector<double> r, Matrix<double> E)
+   Vector<double> SphericalHarmonicGravity::gravity(const Vector<double>& r,
+                                                    const Matrix<double>& E)
    {
          // dimension should be checked here
          // I'll do it latter...
@@ -159,7 +180,7 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
-      Matrix<double> cs = gmData.unnormalizedCS;
+      const Matrix<double>& cs = gmData.unnormalizedCS;
 
    
          // Calculate accelerations ax,ay,az
@@ -214,7 +235,8 @@ namespace gpstk
        * @param r ECI position vector.
        * @param E ECI to ECEF transformation matrix.
        */
-   Matrix<double> SphericalHarmonicGravity::gravityGradient(gpstk::Vector<double> r, gpstk::Matrix<double> E)
+   Matrix<double> SphericalHarmonicGravity::gravityGradient(const Vector<double>& r,
+                                                            const Matrix<double>& E)
    {
          // dimension should be checked here
          // I'll do it latter...
@@ -224,7 +246,7 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
-      Matrix<double> cs = gmData.unnormalizedCS;
+      const Matrix<double>& cs = gmData.unnormalizedCS;
 
    
       double xx = 0.0;     
@@ -312,6 +334,231 @@ namespace gpstk
 
    }  // End of 'SphericalHarmonicGravity::gravityGradient()'
 
+
+      // Build the workspace for the desired degree and order, if it was
+      // not built for them already.
+   void SphericalHarmonicGravity::prepareWorkspace()
+   {
+      if( (ws.degree == desiredDegree) && (ws.order == desiredOrder) )
+      {
+         return;
+      }
+
+      const int dim = desiredDegree + 3;
+      ws.dim = dim;
+      ws.V.assign(dim * dim, 0.0);
+      ws.W.assign(dim * dim, 0.0);
+
+         // V(n,m) = ra(n,m)*z0*V(n-1,m) - rb(n,m)*rho*V(n-2,m), n >= m+2
+      ws.ra.assign(dim * dim, 0.0);
+      ws.rb.assign(dim * dim, 0.0);
+      for(int m = 0; m < dim; m++)
+      {
+         for(int n = m + 2; n < dim; n++)
+         {
+            ws.ra[n*dim + m] = double(2*n - 1) / double(n - m);
+            ws.rb[n*dim + m] = double(n + m - 1) / double(n - m);
+         }
+      }
+
+         // C_n,m = CS[n][m], S_n,m = CS[m-1][n]
+      const Matrix<double>& cs = gmData.unnormalizedCS;
+      const int nc = desiredDegree + 1;
+      ws.C.assign(nc * nc, 0.0);
+      ws.S.assign(nc * nc, 0.0);
+      for(int n = 0; n <= desiredDegree; n++)
+      {
+         for(int m = 0; (m <= n) && (m <= desiredOrder); m++)
+         {
+            ws.C[n*nc + m] = cs(n, m);
+            if(m > 0) ws.S[n*nc + m] = cs(m-1, n);
+         }
+      }
+
+      ws.degree = desiredDegree;
+      ws.order = desiredOrder;
+
+   }  // End of method 'SphericalHarmonicGravity::prepareWorkspace()'
+
+
+      /* Computes the acceleration due to gravity and its partial derivative
+       * with respect to position in a single pass.
+       * @param r ECI position vector.
+       * @param E ECI to ECEF transformation matrix.
+       * @param acc ECI acceleration in m/s^2.
+       * @param grad ECI gravity gradient matrix.
+       */
+   void SphericalHarmonicGravity::gravityAndGradient(const Vector<double>& r,
+                                                     const Matrix<double>& E,
+                                                     Vector<double>& acc,
+                                                     Matrix<double>& grad)
+   {
+      if((r.size()!=3) || (E.rows()!=3) || (E.cols()!=3))
+      {
+         Exception e("Wrong input for gravityAndGradient");
+         GPSTK_THROW(e);
+      }
+
+      prepareWorkspace();
+
+      const int N = desiredDegree;
+      const int M = desiredOrder;
+      const int dim = ws.dim;
+      const int nc = N + 1;
+
+      double* V = &ws.V[0];
+      double* W = &ws.W[0];
+      const double* ra = &ws.ra[0];
+      const double* rb = &ws.rb[0];
+
+         // Rotate from ECI to ECEF
+      double r_bf[3];
+      for(int i = 0; i < 3; i++)
+      {
+         r_bf[i] = E(i,0)*r(0) + E(i,1)*r(1) + E(i,2)*r(2);
+      }
+
+      const double R_ref = gmData.refDistance;
+
+         // Auxiliary quantities
+      double r_sqr = r_bf[0]*r_bf[0] + r_bf[1]*r_bf[1] + r_bf[2]*r_bf[2];
+      double rho   = R_ref * R_ref / r_sqr;
+
+         // Normalized coordinates
+      double x0 = R_ref * r_bf[0] / r_sqr;
+      double y0 = R_ref * r_bf[1] / r_sqr;
+      double z0 = R_ref * r_bf[2] / r_sqr;
+
+         // Harmonic functions as in computeVW(), V(n,m) at V[n*dim+m]
+      V[0] = R_ref / std::sqrt(r_sqr);
+      W[0] = 0.0;
+
+      V[dim] = z0 * V[0];
+      W[dim] = 0.0;
+
+      for(int n = 2; n <= (N+2); n++)
+      {
+         const int k = n*dim;
+         V[k] = ra[k]*z0*V[k-dim] - rb[k]*rho*V[k-2*dim];
+         W[k] = 0.0;
+      }
+
+      for(int m = 1; (m <= (M+2)) && (m <= (N+2)); m++)
+      {
+         const int k = m*dim + m;         // (m,m)
+         const int p = k - dim - 1;       // (m-1,m-1)
+
+         V[k] = (2 * m - 1) * ( x0 * V[p] - y0 * W[p] );
+         W[k] = (2 * m - 1) * ( x0 * W[p] + y0 * V[p] );
+
+         if (m <= (N+1))
+         {
+            V[k+dim] = (2 * m + 1) * z0 * V[k];
+            W[k+dim] = (2 * m + 1) * z0 * W[k];
+         }
+
+         for(int n = (m+2); n <= (N+2); n++)
+         {
+            const int j = n*dim + m;
+            V[j] = ra[j]*z0*V[j-dim] - rb[j]*rho*V[j-2*dim];
+            W[j] = ra[j]*z0*W[j-dim] - rb[j]*rho*W[j-2*dim];
+         }
+      }
+
+         // Sums of gravity() and gravityGradient() in one loop; degree
+         // n+1 terms give the acceleration and degree n+2 the gradient
+      double ax(0.0), ay(0.0), az(0.0);
+      double xx(0.0), xy(0.0), xz(0.0), yz(0.0), zz(0.0);
+
+      for(int m = 0; m <= M; m++)
+      {
+         for(int n = m; n <= N; n++)
+         {
+            const double C = ws.C[n*nc + m];
+            const double S = ws.S[n*nc + m];
+            const int i1 = (n+1)*dim + m;    // (n+1,m)
+            const int i2 = (n+2)*dim + m;    // (n+2,m)
+
+            double Fac = (n-m+2)*(n-m+1);
+            zz += Fac*(C*V[i2] + S*W[i2]);
+
+            if(m == 0)
+            {
+               ax -=       C * V[i1+1];
+               ay -=       C * W[i1+1];
+               az -= (n+1)*C * V[i1];
+
+               Fac = (n+2)*(n+1);
+               xx += 0.5 * (C*V[i2+2] - Fac*C*V[i2]);
+               xy += 0.5 * C * W[i2+2];
+
+               Fac = n + 1;
+               xz += Fac * C * V[i2+1];
+               yz += Fac * C * W[i2+1];
+            }
+            else
+            {
+               Fac = 0.5 * (n-m+1) * (n-m+2);
+
+               ax += 0.5*(-C*V[i1+1] - S*W[i1+1]) + Fac*(C*V[i1-1] + S*W[i1-1]);
+               ay += 0.5*(-C*W[i1+1] + S*V[i1+1]) + Fac*(-C*W[i1-1] + S*V[i1-1]);
+               az += (n-m+1)*(-C*V[i1] - S*W[i1]);
+
+               double f1 = 0.5*(n-m+1);
+               double f2 = (n-m+3)*(n-m+2)*f1;
+
+               xz += f1*(C*V[i2+1]+S*W[i2+1])-f2*(C*V[i2-1]+S*W[i2-1]);
+               yz += f1*(C*W[i2+1]-S*V[i2+1])+f2*(C*W[i2-1]-S*V[i2-1]);
+
+               if (m == 1)
+               {
+                  Fac = (n+1)*n;
+                  xx += 0.25*(C*V[i2+2]+S*W[i2+2]-Fac*(3.0*C*V[i2]+S*W[i2]));
+                  xy += 0.25*(C*W[i2+2]-S*V[i2+2]-Fac*(C*W[i2]+S*V[i2]));
+               }
+               else
+               {
+                  f1 = 2.0*(n-m+2)*(n-m+1);
+                  f2 = (n-m+4)*(n-m+3)*f1*0.5;
+                  xx += 0.25*(C*V[i2+2]+S*W[i2+2]-f1*(C*V[i2]+S*W[i2])+f2*(C*V[i2-2]+S*W[i2-2]));
+                  xy += 0.25*(C*W[i2+2]-S*V[i2+2]+f2*(-C*W[i2-2]+S*V[i2-2]));
+               }
+            }
+         }
+      }
+
+      const double fa = gmData.GM / (R_ref * R_ref);
+      const double fg = gmData.GM / (R_ref * R_ref * R_ref);
+
+      double a_bf[3] = { ax*fa, ay*fa, az*fa };
+      double g_bf[3][3] = { { xx, xy, xz },
+                            { xy, -xx - zz, yz },
+                            { xz, yz, zz } };
+
+         // Rotate to ECI: E^T * a, E^T * (G * E)
+      if(acc.size() != 3) acc.resize(3);
+      if((grad.rows() != 3) || (grad.cols() != 3)) grad.resize(3, 3);
+
+      double ge[3][3];
+      for(int i = 0; i < 3; i++)
+      {
+         acc(i) = E(0,i)*a_bf[0] + E(1,i)*a_bf[1] + E(2,i)*a_bf[2];
+         for(int j = 0; j < 3; j++)
+         {
+            ge[i][j] = fg * ( g_bf[i][0]*E(0,j) + g_bf[i][1]*E(1,j)
+                            + g_bf[i][2]*E(2,j) );
+         }
+      }
+      for(int i = 0; i < 3; i++)
+      {
+         for(int j = 0; j < 3; j++)
+         {
+            grad(i,j) = E(0,i)*ge[0][j] + E(1,i)*ge[1][j] + E(2,i)*ge[2][j];
+         }
+      }
+
+   }  // End of method 'SphericalHarmonicGravity::gravityAndGradient()'
+
    
       
       /** Call the relevant methods to compute the acceleration.
@@ -323,7 +570,7 @@ namespace gpstk
    void SphericalHarmonicGravity::doCompute(UTCTime utc, EarthBody& rb, Spacecraft& sc)
    {
 
-      Matrix<double> C2T = ReferenceFrames::J2kToECEFMatrix(utc);
+      Matrix<double> C2T = rb.j2kToECEFMatrix(utc);
 
          /*
             // debuging
@@ -343,17 +590,33 @@ namespace gpstk
             C2T(2,1) = 3.7310272463024317e-005;
             C2T(2,2) = 0.99999966885906000;*/
       
-         // corrcet earth tides
-      correctCSTides(utc, correctSolidTide, correctOceanTide, correctPoleTide);
+      if(useWorkspace)
+      {
+            // corrcet earth tides, only if some are enabled
+         if(correctSolidTide || correctOceanTide || correctPoleTide)
+         {
+            correctCSTides(rb, utc, correctSolidTide, correctOceanTide,
+                           correctPoleTide);
+         }
 
-         // Evaluate harmonic functions
-      computeVW(sc.R(), C2T);         // update VM
+            // a and da_dr
+         gravityAndGradient(sc.R(), C2T, a, da_dr);
+      }
+      else
+      {
+            // corrcet earth tides
+         correctCSTides(rb, utc, correctSolidTide, correctOceanTide,
+                        correctPoleTide);
 
-         // a
-      a = gravity(sc.R(), C2T);
-      
-         // da_dr
-      da_dr = gravityGradient(sc.R(), C2T);
+            // Evaluate harmonic functions
+         computeVW(sc.R(), C2T);         // update VM
+
+            // a
+         a = gravity(sc.R(), C2T);
+
+            // da_dr
+         da_dr = gravityGradient(sc.R(), C2T);
+      }
       
          //da_dv
       da_dv.resize(3,3,0.0);
@@ -363,7 +626,7 @@ namespace gpstk
    }
 
       // Correct tides to coefficients 
-   void SphericalHarmonicGravity::correctCSTides(UTCTime t,bool solidFlag,bool oceanFlag,bool poleFlag)
+   void SphericalHarmonicGravity::correctCSTides(EarthBody& rb,UTCTime t,bool solidFlag,bool oceanFlag,bool poleFlag)
    {
          // lower-case because 1) upper case is ugly and 2) name
          // collisions with macros.
@@ -389,7 +652,7 @@ namespace gpstk
             // C20 C21 C22 C30 C31 C32 C33 C40 C41 C42
          double dc[10] = {0.0};
          double ds[10] = {0.0};
-         solidTide.getSolidTide(t.mjdUTC(),dc,ds);
+         solidTide.getSolidTide(rb,t,dc,ds);
 
             // c
          cs(2,0) += normFactor(2,0)*dc[0];
@@ -422,7 +685,7 @@ namespace gpstk
             // C20 C21 C22 C30 C31 C32 C33 C40 C41 C42 C43 C44
          double dc[12] = {0.0};
          double ds[12] = {0.0};
-         oceanTide.getOceanTide(t.mjdUTC(),dc,ds);
+         oceanTide.getOceanTide(rb,t,dc,ds);
          
             // c
          cs(2,0) += normFactor(2,0)*dc[0];
@@ -460,7 +723,7 @@ namespace gpstk
       {
          double dC21=0.0;
          double dS21=0.0;
-         poleTide.getPoleTide(t.mjdUTC(),dC21,dS21);
+         poleTide.getPoleTide(rb,t,dC21,dS21);
 
          cs(2,1) += normFactor(2,1)*dC21;
          cs(0,2) += normFactor(2,1)*dS21;
@@ -43,6 +43,7 @@
 #ifndef GPSTK_SPHERICAL_HARMONIC_GRAVITY_HPP
 #define GPSTK_SPHERICAL_HARMONIC_GRAVITY_HPP
 
+#include <vector>
 #include "ForceModel.hpp"
 #include "EarthSolidTide.hpp"
 #include "EarthOceanTide.hpp"
@@ -57,6 +58,12 @@ namespace gpstk
 
       /** This class computes the body fixed acceleration due to the harmonic 
        *  gravity field of the central body
+       *
+       *  By default doCompute() evaluates the acceleration and its gradient
+       *  with gravityAndGradient(), which reuses buffers and recursion
+       *  coefficients built once for the desired degree and order; call
+       *  enableWorkspace(false) to use computeVW(), gravity() and
+       *  gravityGradient() instead.
        */
    class SphericalHarmonicGravity : public ForceModel
    {
@@ -82,7 +89,7 @@ namespace gpstk
           * @param E ECI to ECEF transformation matrix.
           * @return ECI acceleration in m/s^2.
           */
-      Vector<double> gravity(Vector<double> r, Matrix<double> E);
+      Vector<double> gravity(const Vector<double>& r, const Matrix<double>& E);
 
 
          /** Computes the partial derivative of gravity with respect to position.
@@ -90,7 +97,25 @@ namespace gpstk
           * @param r ECI position vector.
           * @param E ECI to ECEF transformation matrix.
           */
-      Matrix<double> gravityGradient(Vector<double> r, Matrix<double> E);
+      Matrix<double> gravityGradient(const Vector<double>& r,
+                                     const Matrix<double>& E);
+
+
+         /** Computes the acceleration due to gravity and its partial
+          *  derivative with respect to position in a single pass, with the
+          *  buffers and recursion coefficients of the workspace. The
+          *  results equal those of computeVW(), gravity() and
+          *  gravityGradient() to rounding, and the outputs are only
+          *  resized if they are not 3 and 3x3 already.
+          * @param r ECI position vector.
+          * @param E ECI to ECEF transformation matrix.
+          * @param acc ECI acceleration in m/s^2.
+          * @param grad ECI gravity gradient matrix.
+          */
+      void gravityAndGradient(const Vector<double>& r,
+                              const Matrix<double>& E,
+                              Vector<double>& acc,
+                              Matrix<double>& grad);
       
 
          /** Call the relevant methods to compute the acceleration.
@@ -102,8 +127,14 @@ namespace gpstk
       virtual void doCompute(UTCTime utc, EarthBody& rb, Spacecraft& sc);
 
 
-      SphericalHarmonicGravity& setDesiredDegree(const int& n, const int& m)
-      { desiredDegree = n; desiredOrder = m; return (*this); }
+         /// Set the degree and order, resizing the harmonic functions.
+      SphericalHarmonicGravity& setDesiredDegree(const int& n, const int& m);
+
+
+         /// Evaluate with gravityAndGradient() (the default) or with
+         /// computeVW(), gravity() and gravityGradient().
+      SphericalHarmonicGravity& enableWorkspace(bool b = true)
+      { useWorkspace = b; return (*this); }
 
 
       /// Methods to enable earth tide correction
@@ -134,14 +165,19 @@ namespace gpstk
           * @param r ECI position vector.
           * @param E ECI to ECEF transformation matrix.
           */
-      void computeVW(Vector<double> r, Matrix<double> E);
+      void computeVW(const Vector<double>& r, const Matrix<double>& E);
 
-         /// Add tides to coefficients 
-      void correctCSTides(UTCTime t,bool solidFlag = false, bool oceanFlag = false, bool poleFlag = false);
+         /// Add tides to coefficients, with the terms depending on time
+         /// from rb
+      void correctCSTides(EarthBody& rb, UTCTime t, bool solidFlag = false, bool oceanFlag = false, bool poleFlag = false);
 
          /// normalized coefficient
       double normFactor(int n, int m);
 
+         /// Build the workspace for the desired degree and order, if it
+         /// was not built for them already.
+      void prepareWorkspace();
+
    protected:
 
       struct GravityModelData
@@ -172,6 +208,27 @@ namespace gpstk
 
          /// Degree and Order of gravity model desired.
       int desiredDegree, desiredOrder;
+
+         /// Buffers and recursion coefficients of gravityAndGradient(),
+         /// row major with rows of dim elements
+      struct GravityWorkspace
+      {
+         int degree, order;         ///< built for this degree and order
+         int dim;                   ///< degree + 3
+
+         std::vector<double> V, W;  ///< harmonic functions up to degree+2
+
+            /// Factors of the column recursion,
+            /// (2n-1)/(n-m) and (n+m-1)/(n-m)
+         std::vector<double> ra, rb;
+
+            /// C_n,m and S_n,m (S_n,0 = 0) up to the degree
+         std::vector<double> C, S;
+
+      } ws;
+
+         /// Use gravityAndGradient() in doCompute()
+      bool useWorkspace;
          
          /// Flags to indicate earth tides correction
       bool   correctSolidTide;
@@ -69,9 +69,7 @@ namespace gpstk
           * da/dr = -GM*( I/norm(r-s)^3 - 3(r-s)transpose(r-s)/norm(r-s)^5)
           */
 
-      Vector<double> r_sun = ReferenceFrames::getJ2kPosition(utc.asTDB(), SolarSystem::idSun);
-
-      r_sun = r_sun * 1000.0;                          // from km to m
+      Vector<double> r_sun = rb.sunJ2kPosition(utc);      // in m
 
       Vector<double> d = sc.R() - r_sun;
       double dmag = norm(d);
@@ -384,6 +384,10 @@ namespace gpstk {
          throw(Exception);
 
    private:
+      /// EarthRotationCache interpolates the series computed by the private
+      /// functions below.
+      friend class EarthRotationCache;
+
       //------------------------------------------------------------------------------
       /// locator s which gives the position of the CIO on the equator of
       /// the CIP, given the coordinate transformation time T and the coordinates X,Y
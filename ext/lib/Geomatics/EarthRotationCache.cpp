@@ -0,0 +1,275 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/// @file EarthRotationCache.cpp
+/// class EarthRotationCache tabulates the IERS 2003 nutation and IERS 2010 CIO
+/// series on a time grid and interpolates them; cf. EarthRotationCache.hpp.
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <cmath>
+#include <system_error>
+// GPSTk
+#include "MiscMath.hpp"
+
+#include "EarthRotationCache.hpp"
+
+//------------------------------------------------------------------------------------
+using namespace std;
+
+namespace gpstk
+{
+   //---------------------------------------------------------------------------------
+   EarthRotationCache::EarthRotationCache(double spacing)
+      throw(Exception)
+   {
+      try { setSpacing(spacing); }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   void EarthRotationCache::setSpacing(double spacing)
+      throw(Exception)
+   {
+      if(!(spacing > 0.0)) {
+         Exception e("EarthRotationCache grid spacing must be positive");
+         GPSTK_THROW(e);
+      }
+      try {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         dt = spacing;
+         nodes2003.clear();
+         nodes2010.clear();
+      }
+      catch(std::system_error& se) {
+         Exception e(string("EarthRotationCache lock failed: ") + se.what());
+         GPSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   double EarthRotationCache::getSpacing(void) const
+      throw(Exception)
+   {
+      try {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         return dt;
+      }
+      catch(std::system_error& se) {
+         Exception e(string("EarthRotationCache lock failed: ") + se.what());
+         GPSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void EarthRotationCache::clear(void)
+      throw(Exception)
+   {
+      try {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         nodes2003.clear();
+         nodes2010.clear();
+      }
+      catch(std::system_error& se) {
+         Exception e(string("EarthRotationCache lock failed: ") + se.what());
+         GPSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   size_t EarthRotationCache::size(void)
+      throw(Exception)
+   {
+      try {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         return (nodes2003.size() + nodes2010.size());
+      }
+      catch(std::system_error& se) {
+         Exception e(string("EarthRotationCache lock failed: ") + se.what());
+         GPSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   // Generate the full transformation matrix (3x3 rotation) relating the ECEF
+   // frame to the conventional inertial frame. This follows
+   // EarthOrientation::ECEFtoInertial2003() and ECEFtoInertial2010(), with the
+   // series replaced by interpolation.
+   Matrix<double> EarthRotationCache::ECEFtoInertial(const EarthOrientation& eo,
+                                                     const EphTime& t, bool reduced)
+      throw(Exception)
+   {
+      try {
+         if(eo.convention != IERSConvention::IERS2003 &&
+            eo.convention != IERSConvention::IERS2010)
+         {
+            EarthOrientation e(eo);
+            return e.ECEFtoInertial(t, reduced);
+         }
+
+         double T(EarthOrientation::CoordTransTime(t));
+         Matrix<double> NPB;
+
+         if(eo.convention == IERSConvention::IERS2003) {
+            double v[3];
+            interpolate(eo.convention, T, v);
+
+            // nutation, with precession rate corrections to the obliquity
+            double dpsipr, depspr;
+            EarthOrientation::PrecessionRateCorrections2003(T, dpsipr, depspr);
+            double eps(EarthOrientation::Obliquity1996(T) + depspr);
+            Matrix<double> N = EarthOrientation::NutationMatrix(eps, v[0], v[1]);
+
+            // precession, including frame bias
+            NPB = N * EarthOrientation::PrecessionMatrix2003(T);
+         }
+         else {
+            double X, Y, s;
+            XYS2010(t, X, Y, s);
+
+            // GCRS-to-CIRS, cf. sofa c2ixys
+            double r2(X*X+Y*Y);
+            double e(r2 != 0.0 ? ::atan2(Y, X) : 0.0);
+            double d(::atan(::sqrt(r2/(1.0-r2))));
+            NPB = rotation(-(e+s),3) * rotation(d, 2) * rotation(e, 3);
+         }
+
+         // Earth rotation angle and polar motion are computed exactly
+         double era(EarthOrientation::EarthRotationAngle(t, eo.UT1mUTC));
+         Matrix<double> R = rotation(era, 3);
+         Matrix<double> W = EarthOrientation::PolarMotionMatrix2003(t, eo.xp, eo.yp);
+
+         return transpose(W*R*NPB);
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   void EarthRotationCache::NutationAngles2003(const EphTime& t,
+                                               double& deps, double& dpsi)
+      throw(Exception)
+   {
+      try {
+         double v[3];
+         interpolate(IERSConvention::IERS2003,
+                     EarthOrientation::CoordTransTime(t), v);
+         dpsi = v[0];
+         deps = v[1];
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   void EarthRotationCache::XYS2010(const EphTime& t,
+                                    double& X, double& Y, double& s)
+      throw(Exception)
+   {
+      try {
+         double v[3];
+         interpolate(IERSConvention::IERS2010,
+                     EarthOrientation::CoordTransTime(t), v);
+         X = v[0];
+         Y = v[1];
+         s = v[2];
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+   //---------------------------------------------------------------------------------
+   // 4-point Lagrange interpolation using nodes k0-1,k0,k0+1,k0+2, where node k0
+   // is at or before T and node k0+1 after it. The lock is held throughout, so
+   // that the weights and the nodes use the same spacing.
+   void EarthRotationCache::interpolate(IERSConvention conv, double T, double v[3])
+      throw(Exception)
+   {
+      try {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+
+         double x(T*36525.0/dt);                // time in units of the spacing
+         long k0(long(::floor(x)));
+         double u(x-double(k0));                 // 0 <= u < 1
+
+         // Lagrange weights for nodes at -1,0,1,2
+         double w[4];
+         w[0] = -u*(u-1.0)*(u-2.0)/6.0;
+         w[1] = (u+1.0)*(u-1.0)*(u-2.0)/2.0;
+         w[2] = -(u+1.0)*u*(u-2.0)/2.0;
+         w[3] = (u+1.0)*u*(u-1.0)/6.0;
+
+         v[0] = v[1] = v[2] = 0.0;
+         for(int i=0; i<4; i++) {
+            const Node& nd(node(conv, k0-1+i));
+            for(int j=0; j<3; j++)
+               v[j] += w[i] * nd.v[j];
+         }
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+      catch(std::system_error& se) {
+         Exception e(string("EarthRotationCache lock failed: ") + se.what());
+         GPSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   const EarthRotationCache::Node& EarthRotationCache::node(IERSConvention conv,
+                                                           long k)
+      throw(Exception)
+   {
+      try {
+         std::map<long, Node>& nodes(conv == IERSConvention::IERS2003 ? nodes2003
+                                                                       : nodes2010);
+         std::map<long, Node>::iterator it(nodes.find(k));
+         if(it != nodes.end())
+            return it->second;
+
+         Node nd;
+         double T(double(k)*dt/36525.0);
+         if(conv == IERSConvention::IERS2003) {
+            EarthOrientation::NutationAngles2003(T, nd.v[1], nd.v[0]);
+            nd.v[2] = 0.0;
+         }
+         else {
+            EarthOrientation::XYCIO(T, nd.v[0], nd.v[1]);
+            nd.v[2] = EarthOrientation::S(T, nd.v[0], nd.v[1],
+                                          IERSConvention::IERS2010);
+         }
+
+         return (nodes[k] = nd);
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+}  // end namespace gpstk
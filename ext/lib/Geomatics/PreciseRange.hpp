@@ -81,7 +81,9 @@ namespace gpstk
       /// @param AntexData& antenna  satellite antenna data;
       ///                               if not valid, no PCO/V correction is done
       /// @param SolarSystem& SolSys SolarSystem object, to get SatelliteAttitude()
-      ///                               for use with antenna.
+      ///                               for use with antenna; when computing many
+      ///                               ranges, SolSys.setRotationCache() avoids
+      ///                               evaluating the IERS series at each one.
       /// @param XvtStore Eph        Ephemeris store
       /// @param bool isCOM          if true, Eph is Center-of-mass,
       ///                               else antenna-phase-center, default false.
@@ -148,8 +148,9 @@ void SRIFilter::measurementUpdate(const Matrix<double>& H, Vector<double>& D,
    try {
          // whiten partials and data
       Matrix<double> P(H);
-      Matrix<double> CHL(lowerCholesky(CM));
+      Matrix<double> CHL;
       if(&CM != &SRINullMatrix) {
+         CHL = lowerCholesky(CM);
          Matrix<double> L(inverseLT(CHL));
          P = L * P;
          D = L * D;
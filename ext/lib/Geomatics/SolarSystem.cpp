@@ -117,7 +117,9 @@ namespace gpstk
          EarthOrientation eo = EOPStore::getEOP(ttag.dMJD(), iersconv);
 
          // get transformation i-to-t = transpose(terrestrial-to-inertial)
-         Matrix<double> Rot = transpose(eo.ECEFtoInertial(time));
+         Matrix<double> Rot = transpose(pRotCache ?
+                                        pRotCache->ECEFtoInertial(eo, time) :
+                                        eo.ECEFtoInertial(time));
 
          // transform inertial to terrestrial
          tPos = Rot * iPos;
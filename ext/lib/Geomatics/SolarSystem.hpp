@@ -85,6 +85,7 @@
 #include "SolarSystemEphemeris.hpp"
 #include "IERSConvention.hpp"
 #include "EarthOrientation.hpp"
+#include "EarthRotationCache.hpp"
 #include "SunEarthSatGeometry.hpp"
 #include "SolidEarthTides.hpp"
 #include "logstream.hpp"
@@ -154,6 +155,7 @@ public:
    /// SolarSystemEphemeris file when initializeWithBinaryFile() is called, otherwise
    /// a warning is issued.
    SolarSystem(IERSConvention inputiers=IERSConvention::NONE) throw()
+      : pRotCache(NULL)
       { iersconv = inputiers; }
 
    /// Choose an IERS Convention. If the input IERS convention is inconsistent with
@@ -168,6 +170,18 @@ public:
    IERSConvention getConvention(void) const throw ()
       { return iersconv; }
 
+   /// Use the EarthRotationCache pointed to by p for the terrestrial / inertial
+   /// transformation in ECEFPositionVelocity(), and so in ECEFPosition(),
+   /// SolarPosition(), LunarPosition(), computeSolidEarthTides() and in
+   /// PreciseRange; NULL (the default) evaluates the IERS series at every call.
+   /// The cache is not owned by this object and may be shared.
+   void setRotationCache(EarthRotationCache *p) throw()
+      { pRotCache = p; }
+
+   /// get the EarthRotationCache in use, or NULL
+   EarthRotationCache *getRotationCache(void) const throw()
+      { return pRotCache; }
+
    /// Overloaded function to load ephemeris file. A check of the ephemeris number
    /// and the IERS convention for this object is made; if the IERS convention is
    /// inconsistent with the ephemeris file then a warning is issued.
@@ -380,6 +394,9 @@ private:
    /// issued at the reading of the ephemeris file or when the assignment is made.
    IERSConvention iersconv;
 
+   /// interpolated terrestrial / inertial transformation, NULL if not used
+   EarthRotationCache *pRotCache;
+
    /// Helper routine to keep the tests in one place
    void testIERSvsEphemeris(const IERSConvention conv, const int ephno) throw()
    {
@@ -0,0 +1,571 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/// @file SparseSRIFilter.cpp  Implementation of class SparseSRIFilter.
+/// class SparseSRIFilter implements the square root information filter with the
+/// SRI matrix stored sparse, for large problems such as network solutions.
+
+//------------------------------------------------------------------------------------
+// system
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+// GPSTk
+#include "StringUtils.hpp"
+// geomatics
+#include "SparseSRIFilter.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+
+using namespace StringUtils;
+
+//------------------------------------------------------------------------------------
+// empty constructor
+SparseSRIFilter::SparseSRIFilter(void)
+   throw()
+{ }
+
+//------------------------------------------------------------------------------------
+// constructor given the dimension N.
+SparseSRIFilter::SparseSRIFilter(const unsigned int N)
+   throw()
+{
+   Reset(N);
+}
+
+//------------------------------------------------------------------------------------
+void SparseSRIFilter::Reset(const int N)
+   throw()
+{
+   if(N > 0) {
+      perm.resize(N);
+      iperm.resize(N);
+      for(int i=0; i<N; i++) perm[i] = iperm[i] = i;
+   }
+   R.assign(perm.size(), SparseRow());
+   Z = Vector<double>(perm.size(), 0.0);
+}
+
+//------------------------------------------------------------------------------------
+unsigned int SparseSRIFilter::datasize(void) const
+   throw()
+{
+   unsigned int n(0);
+   for(size_t k=0; k<R.size(); k++) n += R[k].col.size();
+   return n;
+}
+
+//------------------------------------------------------------------------------------
+// Rotate two sparse rows: out = c*a + s*b, *bout = -s*a + c*b. The column indexes
+// are merged; exact zeros (cancellation, or c or s zero) are not stored.
+void SparseSRIFilter::rotate(const SparseRow& a, const SparseRow& b,
+                             const double c, const double s,
+                             SparseRow& out, SparseRow *bout)
+   throw()
+{
+   size_t i(0), j(0);
+   double va, vb, v;
+   unsigned int col;
+
+   out.clear();
+   if(bout) bout->clear();
+   while(i < a.col.size() || j < b.col.size()) {
+      if(j == b.col.size() || (i < a.col.size() && a.col[i] < b.col[j])) {
+         col = a.col[i]; va = a.val[i++]; vb = 0.0;
+      }
+      else if(i == a.col.size() || b.col[j] < a.col[i]) {
+         col = b.col[j]; va = 0.0; vb = b.val[j++];
+      }
+      else {
+         col = a.col[i]; va = a.val[i++]; vb = b.val[j++];
+      }
+
+      v = c*va + s*vb;
+      if(v != 0.0) { out.col.push_back(col); out.val.push_back(v); }
+      if(bout) {
+         v = c*vb - s*va;
+         if(v != 0.0) { bout->col.push_back(col); bout->val.push_back(v); }
+      }
+   }
+}
+
+//------------------------------------------------------------------------------------
+// Zero the work row w, one element at a time from the left, by Givens rotations
+// with the rows of R. Each rotation touches only the union of the non-zero
+// elements of the two rows, so the cost depends on the fill of R, not on its
+// dimension.
+void SparseSRIFilter::givensUpdate(SparseRow& w, double& wz)
+   throw()
+{
+   while(!w.empty()) {
+      const unsigned int k(w.col[0]);
+      SparseRow& row(R[k]);
+
+      // no information on this state yet - w becomes row k of R
+      if(row.empty()) {
+         row.col.swap(w.col);
+         row.val.swap(w.val);
+         w.clear();
+         Z(k) = wz;
+         wz = 0.0;
+         return;
+      }
+
+      const double d(row.val[0]), a(w.val[0]);
+      const double rho(::sqrt(d*d + a*a));
+      const double c(d/rho), s(a/rho);
+
+      rotate(row, w, c, s, rowtmp, &worktmp);
+      // the element in column k of w is zero by construction; do not keep the
+      // rounding error there
+      if(!worktmp.empty() && worktmp.col[0] == k) {
+         worktmp.col.erase(worktmp.col.begin());
+         worktmp.val.erase(worktmp.val.begin());
+      }
+      rowtmp.val[0] = rho;
+      row.col.swap(rowtmp.col);
+      row.val.swap(rowtmp.val);
+      w.col.swap(worktmp.col);
+      w.val.swap(worktmp.val);
+
+      const double zk(Z(k));
+      Z(k) = c*zk + s*wz;
+      wz = c*wz - s*zk;
+   }
+}
+
+//------------------------------------------------------------------------------------
+void SparseSRIFilter::setOrdering(const vector<unsigned int>& order)
+   throw(MatrixException)
+{
+   const unsigned int n(perm.size());
+   if(order.size() != n) {
+      MatrixException me("Invalid ordering: length " + asString(order.size())
+                           + " but the filter has dimension " + asString(n));
+      GPSTK_THROW(me);
+   }
+
+   vector<unsigned int> newiperm(n, n);
+   for(unsigned int k=0; k<n; k++) {
+      if(order[k] >= n || newiperm[order[k]] != n) {
+         MatrixException me("Invalid ordering: not a permutation at element "
+                              + asString(k));
+         GPSTK_THROW(me);
+      }
+      newiperm[order[k]] = k;
+   }
+
+   // re-factor the information in R into the new order. The rows of R are
+   // simply data equations for the re-ordered states; their residuals are zero.
+   vector<SparseRow> oldR;
+   oldR.swap(R);
+   Vector<double> oldZ(Z);
+   vector<unsigned int> oldperm(perm);
+
+   perm = order;
+   iperm = newiperm;
+   R.assign(n, SparseRow());
+   Z = 0.0;
+
+   vector< pair<unsigned int, double> > elem;
+   for(unsigned int k=n; k-- > 0; ) {          // bottom row first: less fill
+      const SparseRow& row(oldR[k]);
+      if(row.empty()) continue;
+      elem.clear();
+      for(size_t j=0; j<row.col.size(); j++)
+         elem.push_back(make_pair(iperm[oldperm[row.col[j]]], row.val[j]));
+      sort(elem.begin(), elem.end());
+      work.clear();
+      for(size_t j=0; j<elem.size(); j++) {
+         work.col.push_back(elem[j].first);
+         work.val.push_back(elem[j].second);
+      }
+      double wz(oldZ(k));
+      givensUpdate(work, wz);
+   }
+}
+
+//------------------------------------------------------------------------------------
+void SparseSRIFilter::computeOrdering(const SparseMatrix<double>& H,
+                                      const vector<unsigned int>& last)
+   throw(MatrixException)
+{
+   const unsigned int n(perm.size());
+   if(H.cols() != n && H.cols() != n+1) {
+      MatrixException me("Invalid input dimensions: H has " + asString(H.cols())
+                           + " columns but the filter has dimension " + asString(n));
+      GPSTK_THROW(me);
+   }
+
+   vector< vector<unsigned int> > adj(n);
+   vector<unsigned int> states;
+
+   // pattern of transpose(H)*H : each row of H is a clique
+   vector<unsigned int> rows, cols;
+   vector<double> values;
+   H.flatten(rows, cols, values);
+   for(size_t i=0; i<rows.size(); ) {
+      states.clear();
+      size_t j(i);
+      for( ; j<rows.size() && rows[j] == rows[i]; j++)
+         if(cols[j] < n) states.push_back(cols[j]);
+      for(size_t a=0; a<states.size(); a++)
+         for(size_t b=a+1; b<states.size(); b++)
+            adj[states[a]].push_back(states[b]);
+      i = j;
+   }
+
+   // pattern of transpose(R)*R, for the information already in the filter
+   for(size_t k=0; k<R.size(); k++) {
+      const SparseRow& row(R[k]);
+      for(size_t a=0; a<row.col.size(); a++)
+         for(size_t b=a+1; b<row.col.size(); b++)
+            adj[perm[row.col[a]]].push_back(perm[row.col[b]]);
+   }
+
+   setOrdering(minimumDegree(adj, last));
+}
+
+//------------------------------------------------------------------------------------
+// Minimum degree ordering, with an explicit elimination graph. At each step the
+// node of least degree is eliminated and its neighbors are joined into a clique,
+// which is exactly the fill that Givens (or Cholesky) elimination would produce.
+vector<unsigned int> SparseSRIFilter::minimumDegree(
+                                 const vector< vector<unsigned int> >& adj,
+                                 const vector<unsigned int>& last)
+   throw(MatrixException)
+{
+   const unsigned int n(adj.size());
+   vector< set<unsigned int> > graph(n);
+   for(unsigned int i=0; i<n; i++) {
+      for(size_t j=0; j<adj[i].size(); j++) {
+         const unsigned int k(adj[i][j]);
+         if(k >= n) {
+            MatrixException me("Invalid adjacency: node " + asString(k)
+                              + " out of range at node " + asString(i));
+            GPSTK_THROW(me);
+         }
+         if(k == i) continue;
+         graph[i].insert(k);
+         graph[k].insert(i);
+      }
+   }
+
+   vector<bool> isLast(n, false), done(n, false);
+   for(size_t i=0; i<last.size(); i++) {
+      if(last[i] >= n || isLast[last[i]]) {
+         MatrixException me("Invalid list of last nodes at element " + asString(i));
+         GPSTK_THROW(me);
+      }
+      isLast[last[i]] = true;
+   }
+
+   vector<unsigned int> order;
+   order.reserve(n);
+   vector<unsigned int> nbrs;
+   for(unsigned int step=0; step < n-last.size(); step++) {
+      unsigned int best(n);
+      for(unsigned int i=0; i<n; i++) {
+         if(done[i] || isLast[i]) continue;
+         if(best == n || graph[i].size() < graph[best].size()) best = i;
+      }
+
+      done[best] = true;
+      order.push_back(best);
+      nbrs.assign(graph[best].begin(), graph[best].end());
+      graph[best].clear();
+      for(size_t a=0; a<nbrs.size(); a++) {
+         graph[nbrs[a]].erase(best);
+         for(size_t b=a+1; b<nbrs.size(); b++) {
+            graph[nbrs[a]].insert(nbrs[b]);
+            graph[nbrs[b]].insert(nbrs[a]);
+         }
+      }
+   }
+   order.insert(order.end(), last.begin(), last.end());
+
+   return order;
+}
+
+//------------------------------------------------------------------------------------
+void SparseSRIFilter::addAPriori(const vector<unsigned int>& index,
+                                 const Vector<double>& X,
+                                 const Vector<double>& sigma)
+   throw(MatrixException)
+{
+   if(X.size() != index.size() || sigma.size() != index.size()) {
+      MatrixException me("Invalid input dimensions: index has length "
+                           + asString(index.size()) + ", X has length "
+                           + asString(X.size()) + " and sigma has length "
+                           + asString(sigma.size()));
+      GPSTK_THROW(me);
+   }
+
+   for(size_t i=0; i<index.size(); i++) {
+      if(index[i] >= perm.size() || !(sigma(i) > 0.0)) {
+         MatrixException me("Invalid a priori information at element "
+                              + asString(i));
+         GPSTK_THROW(me);
+      }
+      work.clear();
+      work.col.push_back(iperm[index[i]]);
+      work.val.push_back(1.0/sigma(i));
+      double wz(X(i)/sigma(i));
+      givensUpdate(work, wz);
+   }
+}
+
+//------------------------------------------------------------------------------------
+void SparseSRIFilter::measurementUpdate(const SparseMatrix<double>& H,
+                                        Vector<double>& D,
+                                        const SparseMatrix<double>& CM)
+   throw(MatrixException,VectorException)
+{
+   const unsigned int n(perm.size());
+   if(H.cols() != n || H.rows() != D.size() ||
+      (&CM != &SRINullSparseMatrix && (CM.rows() != D.size() ||
+                                       CM.cols() != D.size())) ) {
+      string msg("\nInvalid input dimensions:\n  SRI is "
+                 + asString<int>(n) + "x"
+                 + asString<int>(n) + ",\n  Partials is "
+                 + asString<int>(H.rows()) + "x"
+                 + asString<int>(H.cols()) + ",\n  Data has length "
+                 + asString<int>(D.size()));
+      if(&CM != &SRINullSparseMatrix) msg += ",\n  and Cov is "
+          + asString<int>(CM.rows()) + "x"
+          + asString<int>(CM.cols());
+
+      MatrixException me(msg);
+      GPSTK_THROW(me);
+   }
+
+   try {
+      SparseMatrix<double> A(H || D);
+      SparseMatrix<double> CHL;
+         // whiten partials and data
+      if(&CM != &SRINullSparseMatrix) {
+         CHL = lowerCholesky(CM);
+         SparseMatrix<double> L(inverseLT(CHL));
+         A = L * A;
+      }
+
+         // update R and Z with the whitened information, one row at a time
+      vector<unsigned int> rows, cols;
+      vector<double> values;
+      A.flatten(rows, cols, values);
+
+      Vector<double> res(D.size(), 0.0);
+      vector< pair<unsigned int, double> > elem;
+      for(size_t i=0; i<rows.size(); ) {
+         double wz(0.0);
+         elem.clear();
+         size_t j(i);
+         for( ; j<rows.size() && rows[j] == rows[i]; j++) {
+            if(cols[j] == n) wz = values[j];
+            else elem.push_back(make_pair(iperm[cols[j]], values[j]));
+         }
+         sort(elem.begin(), elem.end());
+         work.clear();
+         for(size_t k=0; k<elem.size(); k++) {
+            work.col.push_back(elem[k].first);
+            work.val.push_back(elem[k].second);
+         }
+         givensUpdate(work, wz);
+         res(rows[i]) = wz;
+         i = j;
+      }
+
+         // copy out D and un-whiten residuals
+      D = res;
+      if(&CM != &SRINullSparseMatrix) {
+         D = CHL * D;
+      }
+   }
+   catch(MatrixException& me) { GPSTK_RETHROW(me); }
+   catch(VectorException& ve) { GPSTK_RETHROW(ve); }
+   catch(Exception& e) {
+      MatrixException me(e);
+      GPSTK_THROW(me);
+   }
+}
+
+//------------------------------------------------------------------------------------
+// Substitute x(k) = (x(k+1) - w)/phi into R*x(k) = Z, and append the noise
+// equation (1/sigma)*w = 0. Then eliminate w with Givens rotations against the
+// noise equation, taking the rows of R that contain the state from the bottom up,
+// so that R stays upper triangular. The final noise equation is not needed for
+// filtering and is dropped.
+void SparseSRIFilter::timeUpdate(const unsigned int index,
+                                 const double phi,
+                                 const double sigma)
+   throw(MatrixException)
+{
+   if(index >= perm.size() || phi == 0.0) {
+      MatrixException me("Invalid time update: index " + asString(index)
+                           + ", phi " + asString(phi));
+      GPSTK_THROW(me);
+   }
+   if(phi == 1.0 && sigma == 0.0) return;
+
+   const unsigned int p(iperm[index]);
+   const double scale(1.0/phi);
+   SparseRow& noise(work);
+   double nw(sigma > 0.0 ? 1.0/sigma : 0.0), nz(0.0);
+   noise.clear();
+
+   for(unsigned int r=p+1; r-- > 0; ) {
+      SparseRow& row(R[r]);
+      if(row.empty()) continue;
+      vector<unsigned int>::iterator it;
+      it = lower_bound(row.col.begin(), row.col.end(), p);
+      if(it == row.col.end() || *it != p) continue;
+
+      double& rp(row.val[it - row.col.begin()]);
+      rp *= scale;
+      if(sigma == 0.0) continue;
+
+      // coefficient of w in this row, zeroed against the noise equation
+      const double b(-rp);
+      const double rho(::sqrt(nw*nw + b*b));
+      const double c(nw/rho), s(b/rho);
+
+      rotate(noise, row, c, s, worktmp, &rowtmp);
+      noise.col.swap(worktmp.col);
+      noise.val.swap(worktmp.val);
+      row.col.swap(rowtmp.col);
+      row.val.swap(rowtmp.val);
+      nw = rho;
+
+      const double zr(Z(r));
+      Z(r) = c*zr - s*nz;
+      nz = c*nz + s*zr;
+      if(row.empty()) Z(r) = 0.0;
+   }
+   noise.clear();
+}
+
+//------------------------------------------------------------------------------------
+void SparseSRIFilter::timeUpdate(const vector<unsigned int>& index,
+                                 const Vector<double>& phi,
+                                 const Vector<double>& sigma)
+   throw(MatrixException)
+{
+   if(phi.size() != index.size() || sigma.size() != index.size()) {
+      MatrixException me("Invalid input dimensions: index has length "
+                           + asString(index.size()) + ", phi has length "
+                           + asString(phi.size()) + " and sigma has length "
+                           + asString(sigma.size()));
+      GPSTK_THROW(me);
+   }
+   for(size_t i=0; i<index.size(); i++)
+      timeUpdate(index[i], phi(i), sigma(i));
+}
+
+//------------------------------------------------------------------------------------
+void SparseSRIFilter::getState(Vector<double>& X) const
+   throw(MatrixException)
+{
+   const unsigned int n(perm.size());
+   Vector<double> Xp(n, 0.0);
+   for(unsigned int k=n; k-- > 0; ) {
+      const SparseRow& row(R[k]);
+      if(row.empty() || row.col[0] != k) {
+         MatrixException me("Singular matrix: no information on state "
+                              + asString(perm[k]));
+         GPSTK_THROW(me);
+      }
+      double sum(Z(k));
+      for(size_t j=1; j<row.col.size(); j++)
+         sum -= row.val[j] * Xp(row.col[j]);
+      Xp(k) = sum / row.val[0];
+   }
+
+   X = Vector<double>(n);
+   for(unsigned int k=0; k<n; k++) X(perm[k]) = Xp(k);
+}
+
+//------------------------------------------------------------------------------------
+void SparseSRIFilter::getStateAndCovariance(Vector<double>& X,
+                                            Matrix<double>& C) const
+   throw(MatrixException)
+{
+   getState(X);
+
+   // inverse of R, by rows from the bottom up:
+   //    Rinv(k,*) = (e(k) - sum(j>k) R(k,j) * Rinv(j,*)) / R(k,k).
+   // L = transpose(Rinv) is stored, so that these rows are contiguous.
+   const unsigned int n(perm.size());
+   Matrix<double> L(n, n, 0.0);
+   for(unsigned int k=n; k-- > 0; ) {
+      const SparseRow& row(R[k]);
+      const double d(1.0/row.val[0]);
+      double *lk(&L(0,k));
+      lk[k] = d;
+      for(size_t j=1; j<row.col.size(); j++) {
+         const unsigned int jj(row.col[j]);
+         const double f(-row.val[j]*d);
+         const double *lj(&L(0,jj));
+         for(unsigned int i=jj; i<n; i++)
+            lk[i] += f * lj[i];
+      }
+   }
+
+   // C = inverse(R) * transpose(inverse(R))
+   Matrix<double> Cp(transposeTimes(L, L));
+   C = Matrix<double>(n, n);
+   for(unsigned int i=0; i<n; i++)
+      for(unsigned int j=0; j<n; j++)
+         C(perm[i],perm[j]) = Cp(i,j);
+}
+
+//------------------------------------------------------------------------------------
+SparseMatrix<double> SparseSRIFilter::getR(void) const
+   throw()
+{
+   const unsigned int n(perm.size());
+   SparseMatrix<double> SR(n, n);
+   for(unsigned int k=0; k<n; k++)
+      for(size_t j=0; j<R[k].col.size(); j++)
+         SR(k, R[k].col[j]) = R[k].val[j];
+   return SR;
+}
+
+}  // end namespace gpstk
@@ -0,0 +1,260 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/// @file SparseSRIFilter.hpp
+/// Include file defining class SparseSRIFilter.
+/// class SparseSRIFilter implements the square root information filter with the
+/// SRI matrix stored sparse, for large problems such as network solutions.
+///
+/// References: "Factorization Methods for Discrete Sequential Estimation,"
+///             G.J. Bierman, Academic Press, 1977.
+///             "Solution of Sparse Linear Least Squares Problems Using Givens
+///             Rotations," A. George and M.T. Heath, Linear Algebra and its
+///             Applications 34, 1980.
+
+//------------------------------------------------------------------------------------
+#ifndef CLASS_SPARSE_SQUAREROOT_INFORMATION_FILTER_INCLUDE
+#define CLASS_SPARSE_SQUAREROOT_INFORMATION_FILTER_INCLUDE
+
+//------------------------------------------------------------------------------------
+// system
+#include <vector>
+// GPSTk
+#include "Vector.hpp"
+#include "Matrix.hpp"
+// geomatics
+#include "SRI.hpp"
+#include "SparseMatrix.hpp"
+
+namespace gpstk
+{
+
+//------------------------------------------------------------------------------------
+/** class SparseSRIFilter is a square root information filter, like SRIFilter,
+ * for problems in which most of the SRI matrix R is zero. In a network solution,
+ * for example, a phase ambiguity is coupled only to the states of its own station
+ * and satellite, so that with 100 or more stations almost all of the dense R held
+ * by SRIFilter is zero, yet the dense Householder updates cost time proportional
+ * to the square of the number of states for every row of data.
+ *
+ * SparseSRIFilter stores only the non-zero elements of each row of R, and updates
+ * R with Givens rotations, one data row at a time, which touch only the non-zero
+ * elements of the rows involved (George and Heath). The number of non-zero
+ * elements of R (the 'fill') depends on the order of the states; this order is
+ * kept separate from the (caller's) state index and may be chosen with
+ * computeOrdering(), which applies the minimum degree heuristic to the pattern of
+ * the partials, or given directly with setOrdering(). The order may be changed at
+ * any time; the information already in R is preserved.
+ *
+ * All input and output (H, the state, the covariance) use the caller's state
+ * index; only getR() and getZ() are in the internal (elimination) order.
+ *
+ * The time update supports the common case in which each state is either constant
+ * or follows its own first order process: x(k+1) = phi * x(k) + w, where w is
+ * white noise. This covers random walk clocks and troposphere, Gauss-Markov
+ * processes and ambiguity resets. States with process noise should be placed
+ * last in the ordering (see computeOrdering()) to limit fill.
+ *
+ * The results agree with SRIFilter to within rounding: X, the covariance and
+ * the sum of squares of the residuals are the same, and in the identity order R
+ * differs at most by the signs of its rows.
+ */
+class SparseSRIFilter {
+public:
+      /// empty constructor
+   SparseSRIFilter(void) throw();
+
+      /// constructor given the dimension N; the order is the identity.
+   SparseSRIFilter(const unsigned int N) throw();
+
+      /// reset the computation, i.e. remove all stored information, and
+      /// optionally change the dimension. If N is not input, the dimension
+      /// (and the order) is not changed.
+      /// @param N new SparseSRIFilter dimension (optional).
+   void Reset(const int N=0) throw();
+
+      /// return the dimension of the filter, which is the number of states
+   unsigned int size(void) const throw()
+   { return perm.size(); }
+
+      /// return the number of non-zero elements stored in R
+   unsigned int datasize(void) const throw();
+
+      /// set the elimination order of the states. Existing information is
+      /// re-factored into the new order.
+      /// @param order permutation of 0..N-1; order[k] is the state index of the
+      ///        k-th row and column of R.
+      /// @throw MatrixException if order is not a permutation of the states.
+   void setOrdering(const std::vector<unsigned int>& order)
+      throw(MatrixException);
+
+      /// get the elimination order; see setOrdering()
+   const std::vector<unsigned int>& getOrdering(void) const throw()
+   { return perm; }
+
+      /// Choose a fill-reducing order for the states, using the minimum degree
+      /// heuristic on the union of the pattern of transpose(H)*H and the pattern
+      /// of the information already in R, and apply it with setOrdering().
+      /// @param H    Partials matrix, N columns (or N+1, the last being ignored),
+      ///             with the pattern of the data to come; e.g. one epoch of data.
+      /// @param last indexes of states to be placed after all others, in the order
+      ///             given; normally these are the states with process noise.
+      /// @throw MatrixException if H or last is inconsistent with the filter.
+   void computeOrdering(const SparseMatrix<double>& H,
+                        const std::vector<unsigned int>& last
+                                             = std::vector<unsigned int>())
+      throw(MatrixException);
+
+      /// Minimum degree ordering of a symmetric graph.
+      /// @param adj  adjacency list of each node (need not be symmetric; the
+      ///             graph is made symmetric, and self-loops are ignored).
+      /// @param last nodes to be ordered after all others, in the order given.
+      /// @return order, a permutation of 0..adj.size()-1; ties are broken by
+      ///         the smaller node index, so the result is deterministic.
+   static std::vector<unsigned int> minimumDegree(
+                           const std::vector< std::vector<unsigned int> >& adj,
+                           const std::vector<unsigned int>& last
+                                             = std::vector<unsigned int>())
+      throw(MatrixException);
+
+      /// Add a priori information on individual states, with no correlation.
+      /// @param index state indexes
+      /// @param X     a priori values of the states
+      /// @param sigma a priori standard deviations, must be positive.
+      /// @throw MatrixException if the input is inconsistent.
+   void addAPriori(const std::vector<unsigned int>& index,
+                   const Vector<double>& X,
+                   const Vector<double>& sigma)
+      throw(MatrixException);
+
+      /// SRIF (Kalman) simple linear measurement update with optional weight
+      /// matrix; the same as the SparseMatrix version of
+      /// SRIFilter::measurementUpdate().
+      /// @param H  Partials matrix, dimension MxN.
+      /// @param D  Data vector, length M; on output D is post-fit residuals, in
+      ///           the sense that their (weighted) sum of squares is the increase
+      ///           in the sum of squares of the residuals of the whole problem.
+      /// @param CM Measurement covariance matrix, dimension MxM.
+      /// @throw if dimension N does not match dimension of the filter, or if
+      ///        other dimensions are inconsistent, or if CM is singular.
+   void measurementUpdate(const SparseMatrix<double>& H, Vector<double>& D,
+                          const SparseMatrix<double>& CM=SRINullSparseMatrix)
+      throw(MatrixException,VectorException);
+
+      /// SRIF (Kalman) time update of a single state
+      ///     x(k+1) = phi * x(k) + w,  with w white noise of standard deviation sigma,
+      /// all other states being constant. This is the same as SRIFilter::timeUpdate()
+      /// with PhiInv the identity except for 1/phi at (index,index), G the column of
+      /// the identity at index, and Rw = 1/sigma; the smoothing quantities Rw, Rwx
+      /// and Zw are not kept.
+      /// @param index state index
+      /// @param phi   state transition, must be non-zero.
+      /// @param sigma standard deviation of the process noise; zero means no noise,
+      ///              and a negative value means infinite noise, i.e. all information
+      ///              on the state is removed (e.g. at a cycle slip).
+      /// @throw MatrixException if index is out of range or phi is zero.
+   void timeUpdate(const unsigned int index, const double phi, const double sigma)
+      throw(MatrixException);
+
+      /// Vector version of timeUpdate(), for several states with independent noise.
+   void timeUpdate(const std::vector<unsigned int>& index,
+                   const Vector<double>& phi,
+                   const Vector<double>& sigma)
+      throw(MatrixException);
+
+      /// Compute the state X, by back substitution in R*X=Z.
+      /// @param X State vector (output)
+      /// @throw MatrixException if R is singular, i.e. some state has no information.
+   void getState(Vector<double>& X) const
+      throw(MatrixException);
+
+      /// Compute the state X and its (dense) covariance matrix C.
+      /// @param X State vector (output)
+      /// @param C Covariance of the state vector (output)
+      /// @throw MatrixException if R is singular.
+   void getStateAndCovariance(Vector<double>& X, Matrix<double>& C) const
+      throw(MatrixException);
+
+      /// return the SRI matrix R, upper triangular in the elimination order.
+   SparseMatrix<double> getR(void) const throw();
+
+      /// return the SRI state vector Z, in the elimination order.
+   Vector<double> getZ(void) const throw()
+   { return Z; }
+
+private:
+      /// one row of R: column indexes (in the elimination order, increasing,
+      /// the first being the diagonal) and values.
+   struct SparseRow
+   {
+      std::vector<unsigned int> col;
+      std::vector<double> val;
+      void clear(void) { col.clear(); val.clear(); }
+      bool empty(void) const { return col.empty(); }
+   };
+
+      /// apply Givens rotations to zero the work row w (elimination order)
+      /// against R and Z; on output w is empty and wz is the residual.
+   void givensUpdate(SparseRow& w, double& wz) throw();
+
+      /// form c*a + s*b into out, and (if bout is non-null) -s*a + c*b into *bout,
+      /// dropping elements that are exactly zero.
+   static void rotate(const SparseRow& a, const SparseRow& b,
+                      const double c, const double s,
+                      SparseRow& out, SparseRow *bout) throw();
+
+      /// rows of the SRI matrix R, in the elimination order
+   std::vector<SparseRow> R;
+
+      /// SRI state vector, in the elimination order
+   Vector<double> Z;
+
+      /// perm[k] is the state index of row/column k of R
+   std::vector<unsigned int> perm;
+
+      /// inverse of perm: iperm[i] is the row/column of R for state i
+   std::vector<unsigned int> iperm;
+
+      /// work space for the Givens rotations
+   SparseRow work, rowtmp, worktmp;
+
+}; // end class SparseSRIFilter
+
+} // end namespace gpstk
+
+//------------------------------------------------------------------------------------
+#endif
@@ -474,10 +474,9 @@ process noise covariance matrix do not match.");
             // Compute the a priori state vector
          xhatminus = phiMatrix*xhat + controlMatrix * controlInput;
 
-         Matrix<double> phiT(transpose(phiMatrix));
-
             // Compute the a priori estimate error covariance matrix
-         Pminus = phiMatrix*P*phiT + processNoiseCovariance;
+         Pminus = timesTranspose(phiMatrix*P, phiMatrix) +
+                  processNoiseCovariance;
       }
       catch(...)
       {
@@ -557,12 +556,13 @@ matrix and a priori state estimation vector do not match.");
          // After checking sizes, let's do the real correction work
       Matrix<double> invR;
       Matrix<double> invPMinus;
-      Matrix<double> measMatrixT( transpose(measurementsMatrix) );
+      Matrix<double> measMatrixTinvR;
 
       try
       {
 
-         invR = inverseChol(measurementsNoiseCovariance);
+         decomp(measurementsNoiseCovariance);
+         decomp.inverse(invR);
 
       }
       catch(...)
@@ -575,7 +575,8 @@ matrix and a priori state estimation vector do not match.");
       try
       {
 
-         invPMinus = inverseChol(Pminus);
+         decomp(Pminus);
+         decomp.inverse(invPMinus);
 
       }
       catch(...)
@@ -588,11 +589,13 @@ matrix and a priori state estimation vector do not match.");
       try
       {
 
-         Matrix<double> invTemp( measMatrixT*invR*measurementsMatrix +
+         measMatrixTinvR = transposeTimes(measurementsMatrix, invR);
+         Matrix<double> invTemp( measMatrixTinvR*measurementsMatrix +
                                  invPMinus );
 
             // Compute the a posteriori error covariance matrix
-         P = inverseChol( invTemp );
+         decomp(invTemp);
+         decomp.inverse(P);
 
       }
       catch(...)
@@ -605,9 +608,11 @@ matrix and a priori state estimation vector do not match.");
       try
       {
 
-            // Compute the a posteriori state estimation
-         xhat = P * ( (measMatrixT * invR * measurements) + 
-                      (invPMinus * xhatminus) );
+            // Compute the a posteriori state estimation, solving with the
+            // decomposition of inverse(P)
+         xhat = (measMatrixTinvR * measurements) + 
+                (invPMinus * xhatminus);
+         decomp.backSub(xhat);
 
       }
       catch(Exception e)
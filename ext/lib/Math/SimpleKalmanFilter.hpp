@@ -390,6 +390,12 @@ namespace gpstk
    private:
 
 
+         /// Decomposition of the symmetric matrices inverted by Correct(),
+         /// kept so that its storage is reused every epoch; without the SVD
+         /// fallback, so covariances of any condition are inverted exactly
+      LDLDecomp<double> decomp;
+
+
          /** Predicts (or "time updates") the a priori estimate of the
           *  system state, as well as the a priori estimate error covariance
           *  matrix.
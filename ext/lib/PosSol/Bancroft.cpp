@@ -45,6 +45,7 @@
 #include "MiscMath.hpp"
 #include "Matrix.hpp"
 #include "Vector.hpp"
+#include "FixedMatrix.hpp"
 
 using namespace std;
 using namespace gpstk;
@@ -73,21 +74,36 @@ namespace gpstk
                           Vector<double>& X )
       throw(Exception)
    {
+      const Matrix<double>& constData(Data);
+
+      return Bancroft::Compute(constData, X);
+
+   }
+
+
+      // The computation uses only fixed-size 4x4 matrices and 4-vectors, so
+      // that it doesn't allocate memory: transpose(B)*B, transpose(B)*tau
+      // and transpose(B)*alpha are accumulated one data row at a time
+      // instead of building the B matrix of good rows.
+   int Bancroft::Compute( const Matrix<double>& Data,
+                          Vector<double>& X )
+      throw(Exception)
+   {
 
       try
       {
 
          int N = Data.rows();
-         Matrix<double> B(0,4);     // Working matrix
+         int nGood = 0;
 
-            // Let's test the input data
-         if( testInput )
-         {
+         FixedMatrix<double,4,4> BTB(0.0), BTBI;
+         FixedVector<double,4> aux, BTtau(0.0), BTalpha(0.0);
 
-            double satRadius = 0.0;
+         for( int i=0; i < N; i++ )
+         {
 
-               // Check each row of B Matrix
-            for( int i=0; i < N; i++ )
+               // Let's test the input data
+            if( testInput )
             {
                   // If Data(i,3) -> Pseudorange is NOT between the allowed
                   // range, then drop line immediately
@@ -98,7 +114,7 @@ namespace gpstk
 
                   // Let's compute distance between Earth center and
                   // satellite position
-               satRadius = RSS(Data(i,0), Data(i,1) , Data(i,2));
+               double satRadius = RSS(Data(i,0), Data(i,1) , Data(i,2));
 
                   // If satRadius is NOT between the allowed range, then drop
                   // line immediately
@@ -107,62 +123,41 @@ namespace gpstk
                   continue;
                }
 
-                  // If everything is ok so far, then extract the good
-                  // data row and add it to working matrix
-               MatrixRowSlice<double> goodRow(Data,i);
-               B = B && goodRow;              
+            }  // End of 'if( testInput )...'
 
-            }
+               // If everything is ok so far, then add the good data row
+               // to the normal equations. Fill auxiliar vector with
+               // corresponding satellite position and pseudorange
+            aux(0) = Data(i,0);
+            aux(1) = Data(i,1);
+            aux(2) = Data(i,2);
+            aux(3) = Data(i,3);
 
-               // Let's redefine "N" and check if we have enough data rows
-               // left in a single step
-            if( (N = B.rows()) < 4 )
-            {
-               return -1;  // We need at least 4 data rows
-            }
+            BTB += outer(aux, aux);
+            BTtau += aux;
+            BTalpha += (0.5 * Minkowski(aux, aux)) * aux;
+            nGood++;
 
-         }  // End of 'if( testInput )...'
-         else
-         {
-               // No input filtering. Working matrix (B) and
-               // input matrix (Data) are equal
-            B = Data;
          }
 
-
-         Matrix<double> BT=transpose(B);
-         Matrix<double> BTBI(4,4), M(4,4,0.0);
-         Vector<double> aux(4), alpha(N), solution1(4), solution2(4);
-
-            // Temporary storage for BT*B. It will be inverted later
-         BTBI = BT * B;
+            // Let's check if we have enough data rows left
+         if( testInput && nGood < 4 )
+         {
+            return -1;  // We need at least 4 data rows
+         }
 
             // Let's try to invert BTB matrix
          try
          {
-            BTBI = inverseChol( BTBI ); 
+            BTBI = inverseChol( BTB );
          }
          catch(...)
          {
             return -2;
          }
 
-            // Now, let's compute alpha vector
-         for( int i=0; i < N; i++ )
-         {
-               // First, fill auxiliar vector with corresponding satellite
-               // position and pseudorange
-            aux(0) = B(i,0);
-            aux(1) = B(i,1);
-            aux(2) = B(i,2);
-            aux(3) = B(i,3);
-            alpha(i) = 0.5 * Minkowski(aux, aux);
-         }
-
-         Vector<double> tau(N,1.0), BTBIBTtau(4), BTBIBTalpha(4);
-
-         BTBIBTtau = BTBI * BT * tau;
-         BTBIBTalpha = BTBI * BT * alpha;
+         FixedVector<double,4> BTBIBTtau(BTBI * BTtau),
+                               BTBIBTalpha(BTBI * BTalpha);
 
             // Now, let's find the coeficients of the second order-equation
          double a(Minkowski(BTBIBTtau, BTBIBTtau));
@@ -181,16 +176,17 @@ namespace gpstk
          double DELTA2 = ( -b - SQRT(discriminant) ) / ( 2.0 * a );
 
             // We need to define M matrix
+         FixedMatrix<double,4,4> M(0.0);
          M(0,0) = 1.0;
          M(1,1) = 1.0;
          M(2,2) = 1.0;
          M(3,3) = - 1.0;
 
             // Find possible position solutions with their implicit radii
-         solution1 = M *  BTBI * ( BT * DELTA1 * tau + BT * alpha );
+         FixedVector<double,4> solution1(M * (BTBI * (DELTA1 * BTtau + BTalpha)));
          double radius1(RSS(solution1(0), solution1(1), solution1(2)));
 
-         solution2 = M *  BTBI * ( BT * DELTA2 * tau + BT * alpha );
+         FixedVector<double,4> solution2(M * (BTBI * (DELTA2 * BTtau + BTalpha)));
          double radius2(RSS(solution2(0), solution2(1), solution2(2)));
 
             // Let's choose the right solution
@@ -220,19 +216,6 @@ namespace gpstk
          GPSTK_RETHROW(e);
       }
    }  // end Bancroft::Compute()
-
-
-      // Another version of Compute method to allow calling it with
-      // const Matrix B.
-   int Bancroft::Compute( const Matrix<double>& Data,
-                          Vector<double>& X )
-      throw(Exception) 
-   {
-      Matrix<double> Datanoconst(Data);
-
-      return Bancroft::Compute(Datanoconst, X);
-
-   }
  
 
 } // namespace gpstk
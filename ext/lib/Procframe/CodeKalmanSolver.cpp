@@ -270,7 +270,8 @@ of qMatrix");
 
       try
       {
-         measNoiseMatrix = inverseChol(weightMatrix);
+         normalDecomp(weightMatrix);
+         normalDecomp.inverse(measNoiseMatrix);
       }
       catch(...)
       {
@@ -74,13 +74,11 @@ namespace gpstk
          for( it = gData.begin(); it != gData.end(); ++it ) 
          {
 
-            try
-            {
-                  // Try to extract the values
-               value1 = (*it).second(type1);
-               value2 = (*it).second(type2);
-            }
-            catch(...)
+               // Try to extract the values
+            const double* pValue1( (*it).second.findValue(type1) );
+            const double* pValue2( (*it).second.findValue(type2) );
+
+            if( (pValue1 == 0) || (pValue2 == 0) )
             {
                   // If some value is missing, schedule this satellite
                   // for removal
@@ -88,6 +86,9 @@ namespace gpstk
                continue;
             }
 
+            value1 = *pValue1;
+            value2 = *pValue2;
+
                // If everything is OK, then get the new value inside
                // the structure
             (*it).second[resultType] = getCombination(value1, value2);
@@ -78,24 +78,18 @@ namespace gpstk
 
                double result(0.0);
 
-                  // Read the information of each linear combination
+                  // Read the information of each linear combination. The
+                  // values of the standard types are in a fixed array, so
+                  // each look-up is a single access.
                typeValueMap::const_iterator iter;
                for(iter = pos->body.begin(); iter != pos->body.end(); ++iter)
                {
-                  double temp(0.0);
+                  const double* value( (*it).second.findValue(iter->first) );
 
-                  TypeID type(iter->first);
-
-                  if( (*it).second.find(type) != (*it).second.end() )
-                  {
-                     temp = (*it).second[type];
-                  }
-                  else
+                  if( value != 0 )
                   {
-                     temp = 0.0;
+                     result = result + (*iter).second * (*value);
                   }
-
-                  result = result + (*iter).second * temp;
                }
 
                   // Store the result in the proper place
@@ -69,6 +69,8 @@ namespace gpstk
       {
 
          SatIDSet satRejectedSet;
+         batch.elevation.clear();
+         batchSats.clear();
 
             // Loop through all the satellites
          satTypeValueMap::iterator stv;
@@ -89,52 +91,55 @@ namespace gpstk
                satRejectedSet.insert( (*stv).first );
                continue;
             }
-            else
-            {
 
-                  // Scalar to hold satellite elevation
-               double elevation( (*stv).second(TypeID::elevation) );
-               double tropoCorr(0.0), dryZDelay(0.0), wetZDelay(0.0);
-               double dryMap(0.0), wetMap(0.0);
+            batchSats.push_back( (*stv).first );
+            batch.elevation.push_back( (*stv).second(TypeID::elevation) );
 
-               try
-               {
-                     // Compute tropospheric slant correction
-                  tropoCorr = pTropModel->correction(elevation);
-                  dryZDelay = pTropModel->dry_zenith_delay();
-                  wetZDelay = pTropModel->wet_zenith_delay();
-                  dryMap = pTropModel->dry_mapping_function(elevation);
-                  wetMap = pTropModel->wet_mapping_function(elevation);
-
-                     // Check validity
-                  if( !(pTropModel->isValid()) )
-                  {
-                     tropoCorr = 0.0;
-                     dryZDelay = 0.0;
-                     wetZDelay = 0.0;
-                     dryMap    = 0.0;
-                     wetMap    = 0.0;
-                  }
+         }  // End of loop 'for(stv = gData.begin()...'
 
-               }
-               catch(InvalidTropModel& e)
-               {
-                     // If some problem appears, then schedule this
-                     // satellite for removal
-                  satRejectedSet.insert( (*stv).first );
-                  continue;    // Skip this SV if problems arise
-               };
+         if( !batchSats.empty() )
+         {
+            bool modelValid(true);
 
-                  // Now we have to add the new values to the data structure
-               (*stv).second[TypeID::tropoSlant] = tropoCorr;
-               (*stv).second[TypeID::dryTropo] = dryZDelay;
-               (*stv).second[TypeID::wetTropo] = wetZDelay;
-               (*stv).second[TypeID::dryMap] = dryMap;
-               (*stv).second[TypeID::wetMap] = wetMap;
+            try
+            {
+                  // Compute all tropospheric values of this epoch at once
+               pTropModel->batchCorrection(batch);
 
+                  // Check validity
+               modelValid = pTropModel->isValid();
+            }
+            catch(InvalidTropModel& e)
+            {
+                  // If some problem appears, then schedule these
+                  // satellites for removal
+               satRejectedSet.insert( batchSats.begin(), batchSats.end() );
+               batchSats.clear();
             }
 
-         }  // End of loop 'for(stv = gData.begin()...'
+            for(size_t i = 0; i < batchSats.size(); i++)
+            {
+               typeValueMap& tvMap( gData[batchSats[i]] );
+
+                  // Now we have to add the new values to the data structure
+               if(modelValid)
+               {
+                  tvMap[TypeID::tropoSlant] = batch.corr[i];
+                  tvMap[TypeID::dryTropo] = batch.dryZenith;
+                  tvMap[TypeID::wetTropo] = batch.wetZenith;
+                  tvMap[TypeID::dryMap] = batch.dryMap[i];
+                  tvMap[TypeID::wetMap] = batch.wetMap[i];
+               }
+               else
+               {
+                  tvMap[TypeID::tropoSlant] = 0.0;
+                  tvMap[TypeID::dryTropo] = 0.0;
+                  tvMap[TypeID::wetTropo] = 0.0;
+                  tvMap[TypeID::dryMap] = 0.0;
+                  tvMap[TypeID::wetMap] = 0.0;
+               }
+            }
+         }
 
             // Remove satellites with missing data
          gData.removeSatID(satRejectedSet);
@@ -96,6 +96,11 @@ namespace gpstk
        * incoming data structure with the extra data inserted along their
        * corresponding satellites.
        *
+       * The model is evaluated once per epoch for all satellites with
+       * TropModel::batchCorrection(), so the zenith delays and the
+       * site dependent terms of the mapping functions are computed
+       * once per epoch rather than once per satellite.
+       *
        * Be warned that if a given satellite does not have the information
        * needed (mainly elevation), it will be summarily deleted from the data
        * structure. This also implies that if you try to use a
@@ -189,6 +194,13 @@ namespace gpstk
          /// data structures.
       TropModel *pTropModel;
 
+         /// Elevations and delays of the current epoch, kept to reuse
+         /// the storage.
+      TropBatch batch;
+
+         /// Satellites of the current epoch, in the order of batch.
+      std::vector<SatID> batchSats;
+
 
    }; // End of class 'ComputeTropModel'
 
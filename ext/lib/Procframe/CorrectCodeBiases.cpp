@@ -124,6 +124,11 @@ namespace gpstk
          for (it = gData.begin(); it != gData.end(); ++it)
          {
             SatID sat = it->first;
+
+               // Find the corrections first, as inserting the new types
+               // while visiting the map would invalidate 'itt'
+            bool hasC1(false), hasC2(false);
+            double instC1(0.0), instC2(0.0);
             for(typeValueMap::iterator itt = it->second.begin();
                 itt != it->second.end();
                 ++itt)
@@ -133,17 +138,20 @@ namespace gpstk
                   
                if( (type == TypeID::C1) || (type == TypeID::P1))
                {
-                  gData[sat][TypeID::instC1] = getDCBCorrection(receiverName,
-                                                                sat, type, usingC1);
+                  hasC1 = true;
+                  instC1 = getDCBCorrection(receiverName, sat, type, usingC1);
                }
                else if(type == TypeID::P2)
                {
-                  gData[sat][TypeID::instC2] = getDCBCorrection(receiverName, 
-                                                                sat, type, usingC1);
+                  hasC2 = true;
+                  instC2 = getDCBCorrection(receiverName, sat, type, usingC1);
                }
 
             }
 
+            if(hasC1) it->second[TypeID::instC1] = instC1;
+            if(hasC2) it->second[TypeID::instC2] = instC2;
+
          }  // End of 'for (it = gData.begin(); it != gData.end(); ++it)'
 
             // Remove satellites with missing data
@@ -2950,7 +2950,7 @@ in matrix and number of types do not match") );
             f.header.epochFlag = rod.epochFlag;
             f.header.epoch = rod.time;
 
-            f.body = satTypeValueMapFromRinexObsData(roh, rod);
+            satTypeValueMapFromRinexObsData(roh, rod, f.body);
 
             return i;
          }
@@ -2980,7 +2980,7 @@ in matrix and number of types do not match") );
          f.header.epochFlag = rod.epochFlag;
          f.header.epoch = rod.time;
 
-         f.body = satTypeValueMapFromRinex3ObsData(roh, rod);
+         satTypeValueMapFromRinex3ObsData(roh, rod, f.body);
 
          return i;
       }
@@ -3195,6 +3195,21 @@ in matrix and number of types do not match") );
 
          // We need to declare a satTypeValueMap
       satTypeValueMap theMap;
+      satTypeValueMapFromRinexObsData(roh, rod, theMap);
+
+      return theMap;
+
+   } // End satTypeValueMapFromRinexObsData(roh, rod)
+
+
+      // Fill a satTypeValueMap with data from RinexObsData, reusing
+      // the storage already held by theMap.
+   void satTypeValueMapFromRinexObsData( const RinexObsHeader& roh,
+                                         const RinexObsData& rod,
+                                         satTypeValueMap& theMap )
+   {
+
+      theMap.clear();
 
          // Let's define the "it" iterator to visit the observations PRN map
          // RinexSatMap is a map from SatID to RinexObsTypeMap:
@@ -3207,10 +3222,12 @@ in matrix and number of types do not match") );
             //   std::map<RinexObsType, RinexDatum>
             // The "second" field of a RinexSatMap (it) is a
             // RinexObsTypeMap (otmap)
-         RinexObsData::RinexObsTypeMap otmap = (*it).second;
-         SatID sat = (*it).first;
+         const RinexObsData::RinexObsTypeMap& otmap = (*it).second;
+         const SatID& sat = (*it).first;
 
-         typeValueMap tvMap;
+            // The typeValueMap comes from the pool of theMap, so it
+            // already has room for the types
+         typeValueMap& tvMap = theMap[sat];
 
          // Let's visit the RinexObsTypeMap (RinexObsType -> RinexDatum)
          for( RinexObsData::RinexObsTypeMap::const_iterator itObs = otmap.begin();
@@ -3268,12 +3285,8 @@ in matrix and number of types do not match") );
             }
 
          }  // End of "for( itObs = otmap.
-
-         theMap[sat] = tvMap;
       }
 
-      return theMap;
-
    } // End FillsatTypeValueMapwithRinexObsData(const RinexObsData& rod)
 
 
@@ -3286,17 +3299,33 @@ in matrix and number of types do not match") );
    {
       // We need to declare a satTypeValueMap
       satTypeValueMap theMap;
+      satTypeValueMapFromRinex3ObsData(roh, rod, theMap);
+
+      return theMap;
+   }
+
+
+      // Fill a satTypeValueMap with data from Rinex3ObsData, reusing
+      // the storage already held by theMap.
+   void satTypeValueMapFromRinex3ObsData( const Rinex3ObsHeader& roh,
+                                          const Rinex3ObsData& rod,
+                                          satTypeValueMap& theMap )
+   {
+      theMap.clear();
+
+      const vector<RinexObsID> noTypes;
 
       Rinex3ObsData::DataMap::const_iterator it;
       for(it=rod.obs.begin(); it != rod.obs.end(); it++)
       {
          RinexSatID sat(it->first);
 
+         typeValueMap& tvMap = theMap[sat];
 
-         typeValueMap tvMap;
-
-         map<std::string,std::vector<RinexObsID> > mapObsTypes(roh.mapObsTypes);
-         const vector<RinexObsID> types = mapObsTypes[sat.toString().substr(0,1)];
+         Rinex3ObsHeader::RinexObsMap::const_iterator itTypes =
+            roh.mapObsTypes.find(string(1, sat.systemChar()));
+         const vector<RinexObsID>& types =
+            (itTypes == roh.mapObsTypes.end()) ? noTypes : itTypes->second;
 
          for(size_t i=0; i<types.size(); i++)
          {
@@ -3346,11 +3375,7 @@ in matrix and number of types do not match") );
                tvMap[ type ] = it->second[i].data;
             }
          }
-
-         theMap[sat] = tvMap;
       }   // End loop over all the satellite
-
-      return theMap;
    }
 
 }  // End of namespace gpstk
@@ -61,6 +61,8 @@
 #include "CivilTime.hpp"
 #include "YDSTime.hpp"
 #include "GNSSconstants.hpp"
+#include "FlatMap.hpp"
+#include "TypeIDTable.hpp"
 
 
 
@@ -185,8 +187,14 @@ namespace gpstk
    typedef std::set<SourceID> SourceIDSet;
 
 
-      /// Map holding TypeID with corresponding numeric value.
-   struct typeValueMap : std::map<TypeID, double>
+      /** Map holding TypeID with corresponding numeric value.
+       *
+       * The values are kept in a TypeIDTable: each standard TypeID has
+       * a fixed slot, so looking a type up is an array access, and the
+       * types created at run time go to an overflow map.  Iterators
+       * return proxies with members 'first' and 'second'.
+       */
+   struct typeValueMap : TypeIDTable<double>
    {
 
          /// Returns the number of different types available.
@@ -342,8 +350,16 @@ namespace gpstk
 
 
 
-      /// Map holding SatID with corresponding typeValueMap.
-   struct satTypeValueMap : std::map<SatID, typeValueMap>
+      /** Map holding SatID with corresponding typeValueMap.
+       *
+       * The satellites are kept in a SlotMap: the typeValueMap of a
+       * satellite that is erased (e.g. by a cycle slip or elevation
+       * filter) goes to a pool and is reused, storage included, by the
+       * next satellite inserted.  References to the typeValueMap of a
+       * satellite stay valid while it is in the map, but iterators are
+       * invalidated by inserting or erasing satellites.
+       */
+   struct satTypeValueMap : SlotMap<SatID, typeValueMap>
    {
 
          /// Returns the number of available satellites.
@@ -1553,6 +1569,16 @@ namespace gpstk
                            const RinexObsHeader& roh, const RinexObsData& rod );
 
 
+      /// Convenience function to fill a satTypeValueMap with data
+      /// from RinexObsData, reusing the storage of an existing map.
+      /// @param roh RinexObsHeader holding the data
+      /// @param rod RinexObsData holding the data.
+      /// @param theMap satTypeValueMap to be cleared and filled.
+   void satTypeValueMapFromRinexObsData( const RinexObsHeader& roh,
+                                         const RinexObsData& rod,
+                                         satTypeValueMap& theMap );
+
+
       /// Convenience function to fill a satTypeValueMap with data
       /// from Rinex3ObsData.
       /// @param roh Rinex3ObsHeader holding the data
@@ -1561,6 +1587,16 @@ namespace gpstk
                          const Rinex3ObsHeader& roh, const Rinex3ObsData& rod );
 
 
+      /// Convenience function to fill a satTypeValueMap with data
+      /// from Rinex3ObsData, reusing the storage of an existing map.
+      /// @param roh Rinex3ObsHeader holding the data
+      /// @param rod Rinex3ObsData holding the data.
+      /// @param theMap satTypeValueMap to be cleared and filled.
+   void satTypeValueMapFromRinex3ObsData( const Rinex3ObsHeader& roh,
+                                          const Rinex3ObsData& rod,
+                                          satTypeValueMap& theMap );
+
+
       /** Stream input for gnssRinex.
        *
        * This handy operator allows to fed a gnssRinex data structure
@@ -64,9 +64,11 @@ namespace gpstk
       try
       {
 
-            // Let's make sure each time we start with clean Vectors
-         availableSV.resize(0);
-         obsData.resize(0);
+            // Let's make sure each time we start with clean Vectors, with
+            // room for every satellite
+         availableSV.resize(rinexData.obs.size());
+         obsData.resize(rinexData.obs.size());
+         size_t numFound(0);
 
             // Create a CheckPRData object with the given limits
          CheckPRData checker(minPRange, maxPRange);
@@ -83,7 +85,7 @@ namespace gpstk
                // The satellites are stored in the first elements of the map...
             SatID sat(it->first);
                // .. and vectors of available obs are in the second elements
-            std::vector<RinexDatum> vecData(it->second);
+            const std::vector<RinexDatum>& vecData(it->second);
 
                // Extract observation value
             double obsValue( (vecData[index]).data );
@@ -94,13 +96,19 @@ namespace gpstk
             {
 
                   // Store all relevant data of this epoch
-               availableSV = availableSV && sat;
-               obsData = obsData && obsValue;
+               availableSV[numFound] = sat;
+               obsData[numFound] = obsValue;
+               numFound++;
 
             }
 
          } // End of data extraction from this epoch
 
+            // Drop the room left by the satellites without data; shrinking
+            // a Vector keeps its contents
+         availableSV.resize(numFound);
+         obsData.resize(numFound);
+
       }
       catch(...)
       {
@@ -0,0 +1,582 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file FlatMap.hpp
+ * Sorted-vector replacements for std::map used by the GNSS data structures.
+ */
+
+#ifndef GPSTK_FLATMAP_HPP
+#define GPSTK_FLATMAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace gpstk
+{
+
+      /// @ingroup DataStructures
+      //@{
+
+      /** Associative container with the interface of std::map, storing
+       * its elements in a std::vector sorted by key.
+       *
+       * Look-up is a binary search over contiguous memory, iteration is
+       * a walk through an array, and clear() keeps the storage, so that
+       * an object that is refilled every epoch stops allocating after
+       * the first one.  This is intended for small maps with cheap
+       * values, such as typeValueMap.
+       *
+       * Differences from std::map: value_type is std::pair<Key, T>
+       * (the key is not const, although it must not be changed through
+       * an iterator), and inserting or erasing elements invalidates
+       * iterators and references to other elements.
+       */
+   template <class Key, class T, class Compare = std::less<Key> >
+   class FlatMap
+   {
+   public:
+      typedef Key key_type;
+      typedef T mapped_type;
+      typedef std::pair<Key, T> value_type;
+      typedef Compare key_compare;
+      typedef std::vector<value_type> storage_type;
+      typedef typename storage_type::size_type size_type;
+      typedef typename storage_type::difference_type difference_type;
+      typedef typename storage_type::reference reference;
+      typedef typename storage_type::const_reference const_reference;
+      typedef typename storage_type::iterator iterator;
+      typedef typename storage_type::const_iterator const_iterator;
+      typedef typename storage_type::reverse_iterator reverse_iterator;
+      typedef typename storage_type::const_reverse_iterator
+         const_reverse_iterator;
+
+         /// Default constructor, an empty map.
+      FlatMap() {}
+
+         /// Construct from a range of values, as std::map does.
+      template <class InputIterator>
+      FlatMap(InputIterator first, InputIterator last)
+      { insert(first, last); }
+
+      iterator begin() { return data.begin(); }
+      const_iterator begin() const { return data.begin(); }
+      iterator end() { return data.end(); }
+      const_iterator end() const { return data.end(); }
+      reverse_iterator rbegin() { return data.rbegin(); }
+      const_reverse_iterator rbegin() const { return data.rbegin(); }
+      reverse_iterator rend() { return data.rend(); }
+      const_reverse_iterator rend() const { return data.rend(); }
+
+      bool empty() const { return data.empty(); }
+      size_type size() const { return data.size(); }
+      size_type max_size() const { return data.max_size(); }
+
+         /// Remove all elements; the storage is kept for reuse.
+      void clear() { data.clear(); }
+
+         /// Reserve storage for \a n elements.
+      void reserve(size_type n) { data.reserve(n); }
+
+      key_compare key_comp() const { return Compare(); }
+
+         /// Return a reference to the value with key \a k, inserting a
+         /// default value if there is none.
+      T& operator[](const Key& k)
+      {
+         iterator it(lower_bound(k));
+         if (it == data.end() || Compare()(k, it->first))
+            it = data.insert(it, value_type(k, T()));
+         return it->second;
+      }
+
+      std::pair<iterator, bool> insert(const value_type& v)
+      {
+         iterator it(lower_bound(v.first));
+         if (it != data.end() && !Compare()(v.first, it->first))
+            return std::make_pair(it, false);
+         return std::make_pair(data.insert(it, v), true);
+      }
+
+         /// Insert with a position hint; appending in key order, the
+         /// usual case, does no search.
+      iterator insert(iterator hint, const value_type& v)
+      {
+         Compare less;
+         if ((hint == data.end() || less(v.first, hint->first)) &&
+             (hint == data.begin() || less((hint-1)->first, v.first)))
+            return data.insert(hint, v);
+         return insert(v).first;
+      }
+
+      template <class InputIterator>
+      void insert(InputIterator first, InputIterator last)
+      {
+         for ( ; first != last; ++first)
+            insert(data.end(), value_type(first->first, first->second));
+      }
+
+      iterator erase(iterator pos)
+      { return data.erase(pos); }
+
+      iterator erase(iterator first, iterator last)
+      { return data.erase(first, last); }
+
+      size_type erase(const Key& k)
+      {
+         iterator it(find(k));
+         if (it == data.end())
+            return 0;
+         data.erase(it);
+         return 1;
+      }
+
+      void swap(FlatMap& other) { data.swap(other.data); }
+
+      iterator find(const Key& k)
+      {
+         iterator it(lower_bound(k));
+         return (it == data.end() || Compare()(k, it->first)) ? data.end() : it;
+      }
+
+      const_iterator find(const Key& k) const
+      {
+         const_iterator it(lower_bound(k));
+         return (it == data.end() || Compare()(k, it->first)) ? data.end() : it;
+      }
+
+      size_type count(const Key& k) const
+      { return (find(k) == data.end()) ? 0 : 1; }
+
+      iterator lower_bound(const Key& k)
+      { return std::lower_bound(data.begin(), data.end(), k, KeyLess()); }
+
+      const_iterator lower_bound(const Key& k) const
+      { return std::lower_bound(data.begin(), data.end(), k, KeyLess()); }
+
+      iterator upper_bound(const Key& k)
+      { return std::upper_bound(data.begin(), data.end(), k, KeyLess()); }
+
+      const_iterator upper_bound(const Key& k) const
+      { return std::upper_bound(data.begin(), data.end(), k, KeyLess()); }
+
+      std::pair<iterator, iterator> equal_range(const Key& k)
+      { return std::make_pair(lower_bound(k), upper_bound(k)); }
+
+      std::pair<const_iterator, const_iterator> equal_range(const Key& k) const
+      { return std::make_pair(lower_bound(k), upper_bound(k)); }
+
+      bool operator==(const FlatMap& right) const
+      { return data == right.data; }
+
+      bool operator!=(const FlatMap& right) const
+      { return !(data == right.data); }
+
+   private:
+         /// Compare an element with a key, in either order.
+      struct KeyLess
+      {
+         bool operator()(const value_type& v, const Key& k) const
+         { return Compare()(v.first, k); }
+         bool operator()(const Key& k, const value_type& v) const
+         { return Compare()(k, v.first); }
+      };
+
+         /// The elements, sorted by key.
+      storage_type data;
+   }; // class FlatMap
+
+
+      /** Associative container with the interface of std::map, for
+       * values that are expensive to create, such as the typeValueMap
+       * of each satellite in a satTypeValueMap.
+       *
+       * The elements are kept in nodes allocated one at a time, like
+       * those of std::map, and a sorted std::vector of pointers to the
+       * nodes gives the order.  Nodes of erased elements are not freed
+       * but kept in a pool owned by the map, and are reused (together
+       * with any storage their values hold) by later insertions, and by
+       * assignment from another map.  An object that is refilled every
+       * epoch therefore allocates nothing after the first few epochs.
+       * As the pool belongs to the object, maps in different threads
+       * share nothing.
+       *
+       * References to elements stay valid until the element is erased,
+       * as with std::map.  Iterators are invalidated by insertion and
+       * erasure, as with FlatMap.
+       *
+       * T must be a container, or anything else with a clear() method
+       * that leaves it equal to T() without releasing its storage.
+       */
+   template <class Key, class T, class Compare = std::less<Key> >
+   class SlotMap
+   {
+   public:
+      typedef Key key_type;
+      typedef T mapped_type;
+      typedef std::pair<Key, T> value_type;
+      typedef Compare key_compare;
+      typedef std::size_t size_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef value_type& reference;
+      typedef const value_type& const_reference;
+
+   private:
+      typedef std::vector<value_type*> NodeVector;
+
+         /// Random access iterator over the sorted node pointers.
+      template <class V, class P>
+      class Iter
+      {
+      public:
+         typedef std::random_access_iterator_tag iterator_category;
+         typedef typename SlotMap::value_type value_type;
+         typedef std::ptrdiff_t difference_type;
+         typedef V* pointer;
+         typedef V& reference;
+
+         Iter() : p(0) {}
+         explicit Iter(P ptr) : p(ptr) {}
+            /// Conversion from iterator to const_iterator
+         template <class V2, class P2>
+         Iter(const Iter<V2, P2>& other) : p(other.p) {}
+
+         reference operator*() const { return **p; }
+         pointer operator->() const { return *p; }
+         reference operator[](difference_type n) const { return *p[n]; }
+         Iter& operator++() { ++p; return *this; }
+         Iter operator++(int) { Iter t(*this); ++p; return t; }
+         Iter& operator--() { --p; return *this; }
+         Iter operator--(int) { Iter t(*this); --p; return t; }
+         Iter& operator+=(difference_type n) { p += n; return *this; }
+         Iter& operator-=(difference_type n) { p -= n; return *this; }
+         Iter operator+(difference_type n) const { return Iter(p + n); }
+         Iter operator-(difference_type n) const { return Iter(p - n); }
+         template <class V2, class P2>
+         difference_type operator-(const Iter<V2, P2>& r) const
+         { return p - r.p; }
+         template <class V2, class P2>
+         bool operator==(const Iter<V2, P2>& r) const { return p == r.p; }
+         template <class V2, class P2>
+         bool operator!=(const Iter<V2, P2>& r) const { return p != r.p; }
+         template <class V2, class P2>
+         bool operator<(const Iter<V2, P2>& r) const { return p < r.p; }
+
+         P p;
+      };
+
+   public:
+      typedef Iter<value_type, value_type* const*> iterator;
+      typedef Iter<const value_type, value_type* const*> const_iterator;
+      typedef std::reverse_iterator<iterator> reverse_iterator;
+      typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+         /// Default constructor, an empty map.
+      SlotMap() {}
+
+         /// Construct from a range of values, as std::map does.
+      template <class InputIterator>
+      SlotMap(InputIterator first, InputIterator last)
+      { insert(first, last); }
+
+         /// Copy constructor, the pool is not copied.
+      SlotMap(const SlotMap& right)
+      { assign(right); }
+
+         /// Assignment, reusing the nodes (and values) of this object.
+      SlotMap& operator=(const SlotMap& right)
+      {
+         if (this != &right)
+            assign(right);
+         return *this;
+      }
+
+      ~SlotMap()
+      {
+         for (size_type i = 0; i < nodes.size(); i++)
+            delete nodes[i];
+         for (size_type i = 0; i < pool.size(); i++)
+            delete pool[i];
+      }
+
+      iterator begin() { return iterator(ptr(0)); }
+      const_iterator begin() const { return const_iterator(ptr(0)); }
+      iterator end() { return iterator(ptr(nodes.size())); }
+      const_iterator end() const { return const_iterator(ptr(nodes.size())); }
+      reverse_iterator rbegin() { return reverse_iterator(end()); }
+      const_reverse_iterator rbegin() const
+      { return const_reverse_iterator(end()); }
+      reverse_iterator rend() { return reverse_iterator(begin()); }
+      const_reverse_iterator rend() const
+      { return const_reverse_iterator(begin()); }
+
+      bool empty() const { return nodes.empty(); }
+      size_type size() const { return nodes.size(); }
+      size_type max_size() const { return nodes.max_size(); }
+
+         /// Remove all elements; their nodes go to the pool.
+      void clear()
+      {
+         for (size_type i = 0; i < nodes.size(); i++)
+            recycle(nodes[i]);
+         nodes.clear();
+      }
+
+      key_compare key_comp() const { return Compare(); }
+
+         /// Return a reference to the value with key \a k, inserting a
+         /// default value if there is none.
+      T& operator[](const Key& k)
+      {
+         size_type i(lowerIndex(k));
+         if (i == nodes.size() || Compare()(k, nodes[i]->first))
+            nodes.insert(nodes.begin() + i, node(k));
+         return nodes[i]->second;
+      }
+
+      std::pair<iterator, bool> insert(const value_type& v)
+      {
+         size_type i(lowerIndex(v.first));
+         if (i != nodes.size() && !Compare()(v.first, nodes[i]->first))
+            return std::make_pair(iterator(ptr(i)), false);
+         nodes.insert(nodes.begin() + i, node(v));
+         return std::make_pair(iterator(ptr(i)), true);
+      }
+
+         /// Insert with a position hint; appending in key order, the
+         /// usual case, does no search.
+      iterator insert(iterator hint, const value_type& v)
+      {
+         Compare less;
+         size_type i(hint.p - ptr(0));
+         if ((i == nodes.size() || less(v.first, nodes[i]->first)) &&
+             (i == 0 || less(nodes[i-1]->first, v.first)))
+         {
+            nodes.insert(nodes.begin() + i, node(v));
+            return iterator(ptr(i));
+         }
+         return insert(v).first;
+      }
+
+      template <class InputIterator>
+      void insert(InputIterator first, InputIterator last)
+      {
+         for ( ; first != last; ++first)
+            insert(end(), value_type(first->first, first->second));
+      }
+
+      iterator erase(iterator pos)
+      {
+         size_type i(pos.p - ptr(0));
+         recycle(nodes[i]);
+         nodes.erase(nodes.begin() + i);
+         return iterator(ptr(i));
+      }
+
+      iterator erase(iterator first, iterator last)
+      {
+         size_type i(first.p - ptr(0)), j(last.p - ptr(0));
+         for (size_type k = i; k < j; k++)
+            recycle(nodes[k]);
+         nodes.erase(nodes.begin() + i, nodes.begin() + j);
+         return iterator(ptr(i));
+      }
+
+      size_type erase(const Key& k)
+      {
+         iterator it(find(k));
+         if (it == end())
+            return 0;
+         erase(it);
+         return 1;
+      }
+
+      void swap(SlotMap& other)
+      {
+         nodes.swap(other.nodes);
+         pool.swap(other.pool);
+      }
+
+      iterator find(const Key& k)
+      { return iterator(ptr(findIndex(k))); }
+
+      const_iterator find(const Key& k) const
+      { return const_iterator(ptr(findIndex(k))); }
+
+      size_type count(const Key& k) const
+      { return (findIndex(k) == nodes.size()) ? 0 : 1; }
+
+      iterator lower_bound(const Key& k)
+      { return iterator(ptr(lowerIndex(k))); }
+
+      const_iterator lower_bound(const Key& k) const
+      { return const_iterator(ptr(lowerIndex(k))); }
+
+      iterator upper_bound(const Key& k)
+      { return iterator(ptr(upperIndex(k))); }
+
+      const_iterator upper_bound(const Key& k) const
+      { return const_iterator(ptr(upperIndex(k))); }
+
+      std::pair<iterator, iterator> equal_range(const Key& k)
+      { return std::make_pair(lower_bound(k), upper_bound(k)); }
+
+      std::pair<const_iterator, const_iterator> equal_range(const Key& k) const
+      { return std::make_pair(lower_bound(k), upper_bound(k)); }
+
+      bool operator==(const SlotMap& right) const
+      {
+         if (nodes.size() != right.nodes.size())
+            return false;
+         for (size_type i = 0; i < nodes.size(); i++)
+            if (!(*nodes[i] == *right.nodes[i]))
+               return false;
+         return true;
+      }
+
+      bool operator!=(const SlotMap& right) const
+      { return !operator==(right); }
+
+   private:
+         /// Pointer to the i-th node pointer (nodes may be empty).
+      value_type* const* ptr(size_type i) const
+      { return nodes.empty() ? 0 : &nodes[0] + i; }
+
+      size_type lowerIndex(const Key& k) const
+      {
+         Compare less;
+         size_type lo(0), hi(nodes.size());
+         while (lo < hi)
+         {
+            size_type mid((lo + hi) / 2);
+            if (less(nodes[mid]->first, k))
+               lo = mid + 1;
+            else
+               hi = mid;
+         }
+         return lo;
+      }
+
+      size_type upperIndex(const Key& k) const
+      {
+         size_type i(lowerIndex(k));
+         if (i != nodes.size() && !Compare()(k, nodes[i]->first))
+            i++;
+         return i;
+      }
+
+      size_type findIndex(const Key& k) const
+      {
+         size_type i(lowerIndex(k));
+         if (i == nodes.size() || Compare()(k, nodes[i]->first))
+            return nodes.size();
+         return i;
+      }
+
+         /// A node holding (k, T()), from the pool if possible.
+      value_type* node(const Key& k)
+      {
+         if (pool.empty())
+         {
+            reservePool();
+            return new value_type(k, T());
+         }
+         value_type* n(pool.back());
+         pool.pop_back();
+         n->first = k;
+         return n;
+      }
+
+         /// A node holding a copy of v, from the pool if possible.
+      value_type* node(const value_type& v)
+      {
+         if (pool.empty())
+         {
+            reservePool();
+            return new value_type(v);
+         }
+         value_type* n(pool.back());
+         pool.pop_back();
+         *n = v;
+         return n;
+      }
+
+         /// Make room in the pool for every node owned by the map and
+         /// one more, so that recycling nodes never allocates.
+      void reservePool()
+      {
+         size_type owned(nodes.size() + pool.size() + 1);
+         if (pool.capacity() < owned)
+            pool.reserve(2 * owned);
+      }
+
+         /// Return a node to the pool, emptying its value with clear()
+         /// so that the value keeps its storage.
+      void recycle(value_type* n)
+      {
+         n->second.clear();
+         pool.push_back(n);
+      }
+
+      void assign(const SlotMap& right)
+      {
+         size_type n(right.nodes.size()), i;
+         for (i = n; i < nodes.size(); i++)
+            recycle(nodes[i]);
+         if (nodes.size() > n)
+            nodes.resize(n);
+         for (i = 0; i < nodes.size(); i++)
+            *nodes[i] = *right.nodes[i];
+         for ( ; i < n; i++)
+            nodes.push_back(node(*right.nodes[i]));
+      }
+
+         /// The elements, sorted by key.
+      NodeVector nodes;
+         /// Nodes of erased elements, for reuse.
+      NodeVector pool;
+   }; // class SlotMap
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif // GPSTK_FLATMAP_HPP
@@ -647,8 +647,8 @@ namespace gpstk
       }
 
       Vector<double> solution = convertMat*vectorOfSolution;
-      Matrix<double> covariance = convertMat*matrixOfCovariance
-                                 *transpose(convertMat);
+      Matrix<double> covariance = timesTranspose(convertMat*matrixOfCovariance,
+                                                 convertMat);
 
       i = 0;
       for(VariableList::const_iterator iti=varList.begin();
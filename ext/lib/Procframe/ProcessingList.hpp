@@ -94,6 +94,10 @@ namespace gpstk
    {
    public:
 
+         /// Iterator over the elements of the list.
+      typedef std::list<ProcessingClass*>::const_iterator const_iterator;
+
+
 
          /// Default constructor.
       ProcessingList()
@@ -165,6 +169,16 @@ namespace gpstk
       { return (proclist.clear()); };
 
 
+         /// Returns an iterator to the first element.
+      const_iterator begin(void) const
+      { return (proclist.begin()); };
+
+
+         /// Returns an iterator past the last element.
+      const_iterator end(void) const
+      { return (proclist.end()); };
+
+
          /// Returns a string identifying this object.
       virtual std::string getClassName(void) const;
 
@@ -94,6 +94,12 @@ namespace gpstk
 
         bool valid;         // true only if results are valid
 
+         /// Decomposition of the normal matrix, kept between calls so
+         /// that its storage is reused every epoch. It has no SVD fallback:
+         /// like inverseChol() it throws if the matrix is not positive
+         /// definite, and it never edits an ill-conditioned one.
+      LDLDecomp<double> normalDecomp;
+
 
    }; // End of class 'SolverBase'
 
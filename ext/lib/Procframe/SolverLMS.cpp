@@ -106,17 +106,15 @@ of designMatrix");
          GPSTK_THROW(e);
       }
 
-      Matrix<double> AT = transpose(designMatrix);
       covMatrix.resize(gCol, gCol);
       solution.resize(gCol);
 
-         // Temporary storage for covMatrix. It will be inverted later
-      covMatrix = AT * designMatrix;
-
-      // Let's try to invert AT*A   matrix
+         // Let's try to invert AT*A matrix. It is symmetric, so LDL is
+         // used; like inverseChol() it throws if AT*A is not positive definite
       try
       {
-         covMatrix = inverseChol( covMatrix );
+         normalDecomp(transposeTimes(designMatrix, designMatrix));
+         normalDecomp.inverse(covMatrix);
       }
       catch(...)
       {
@@ -125,7 +123,8 @@ of designMatrix");
       }
 
          // Now, compute the Vector holding the solution...
-      solution = covMatrix * AT * prefitResiduals;
+      solution = prefitResiduals * designMatrix;   // AT * prefitResiduals
+      normalDecomp.backSub(solution);
 
          // ... and the postfit residuals Vector
       postfitResiduals = prefitResiduals - designMatrix * solution;
@@ -182,17 +182,16 @@ of designMatrix");
          GPSTK_THROW(e);
       }
 
-      Matrix<double> AT = transpose(designMatrix);
       covMatrix.resize(gCol, gCol);
       covMatrixNoWeight.resize(gCol, gCol);
       solution.resize(gCol);
 
-         // Temporary storage for covMatrix. It will be inverted later
-      covMatrix = AT * weightMatrix * designMatrix;
+      Matrix<double> ATW = transposeTimes(designMatrix, weightMatrix);
 
          // Let's try to invert AT*W*A  matrix
       try { 
-         covMatrix = inverseChol( covMatrix );
+         normalDecomp(ATW * designMatrix);
+         normalDecomp.inverse(covMatrix);
       }
       catch(...)
       {
@@ -200,12 +199,15 @@ of designMatrix");
          GPSTK_THROW(e);
       }
 
-         // Temporary storage for covMatrixNoWeight. It will be inverted later
-      covMatrixNoWeight = AT * designMatrix;
+         // Now, compute the Vector holding the solution, while the
+         // decomposition of AT*W*A is at hand...
+      solution = ATW * prefitResiduals;
+      normalDecomp.backSub(solution);
 
          // Let's try to invert AT*A  matrix
       try { 
-         covMatrixNoWeight = inverseChol( covMatrixNoWeight );
+         normalDecomp(transposeTimes(designMatrix, designMatrix));
+         normalDecomp.inverse(covMatrixNoWeight);
       }
       catch(...)
       {
@@ -213,9 +215,6 @@ of designMatrix");
          GPSTK_THROW(e);
       }
 
-         // Now, compute the Vector holding the solution...
-      solution = covMatrix * AT * weightMatrix * prefitResiduals;
-
          // ... and the postfit residuals Vector
       postfitResiduals = prefitResiduals - designMatrix * solution;
 
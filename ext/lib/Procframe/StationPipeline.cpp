@@ -0,0 +1,428 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file StationPipeline.cpp
+ * Run the ProcessingList of each station of a network in parallel.
+ */
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+
+#include "StationPipeline.hpp"
+#include "Decimate.hpp"
+
+
+namespace gpstk
+{
+
+      // Returns a string identifying this object.
+   std::string StationPipeline::getClassName() const
+   { return "StationPipeline"; }
+
+
+
+      // Adds one measurement, in seconds.
+   void StationPipeline::StageStats::add(double seconds)
+   {
+
+      count++;
+      total += seconds;
+      if(seconds > max)
+      {
+         max = seconds;
+      }
+
+         // Bin by the power of two of the time in microseconds
+      unsigned bin(0);
+      double us(seconds * 1.0e6);
+      while( (us >= 2.0) && (bin < numBins-1) )
+      {
+         us *= 0.5;
+         bin++;
+      }
+      bins[bin]++;
+
+   }  // End of method 'StationPipeline::StageStats::add()'
+
+
+
+      // Adds the measurements in another object.
+   void StationPipeline::StageStats::merge(const StageStats& right)
+   {
+
+      count += right.count;
+      total += right.total;
+      if(right.max > max)
+      {
+         max = right.max;
+      }
+      for(unsigned i = 0; i < numBins; i++)
+      {
+         bins[i] += right.bins[i];
+      }
+
+   }  // End of method 'StationPipeline::StageStats::merge()'
+
+
+
+      /* Common constructor.
+       *
+       * @param numThreads    Number of threads; 0 selects one per
+       *                      hardware thread.
+       */
+   StationPipeline::StationPipeline(unsigned numThreads)
+      : pool(numThreads)
+   {
+   }
+
+
+
+      /* Sets the ProcessingList used for a station.
+       *
+       * @param source     SourceID of the station.
+       * @param pList      List to run on the data of the station.
+       */
+   StationPipeline& StationPipeline::addStation( const SourceID& source,
+                                                 ProcessingList& pList )
+   {
+
+      Station& station(stations[source]);
+      if(station.pList != &pList)
+      {
+         station.pList = &pList;
+         station.stats.clear();
+      }
+
+      return (*this);
+
+   }  // End of method 'StationPipeline::addStation()'
+
+
+
+      // Removes a station.
+   StationPipeline& StationPipeline::removeStation(const SourceID& source)
+   {
+
+      stations.erase(source);
+
+      return (*this);
+
+   }  // End of method 'StationPipeline::removeStation()'
+
+
+
+      /* Processes the data of one epoch for all the stations.
+       *
+       * @param gRinVec    gnssRinex objects, processed in place.
+       * @param gdsMap     gnssDataMap where the processed data are added.
+       */
+   gnssDataMap& StationPipeline::Process( std::vector<gnssRinex>& gRinVec,
+                                          gnssDataMap& gdsMap )
+      throw(ProcessingException)
+   {
+
+         // Hand out the data to the stations. Data of one station are
+         // kept in a single task, so its list never runs twice at once.
+      std::map<SourceID, Station>::iterator its;
+      for(its = stations.begin(); its != stations.end(); ++its)
+      {
+         its->second.data.clear();
+         its->second.decimated.clear();
+         its->second.failed = false;
+         its->second.error.clear();
+      }
+
+      std::vector<Station*> busy;
+      for(size_t i = 0; i < gRinVec.size(); i++)
+      {
+         its = stations.find(gRinVec[i].header.source);
+         if(its == stations.end())
+         {
+            continue;
+         }
+
+         if(its->second.data.empty())
+         {
+            busy.push_back(&its->second);
+         }
+         its->second.data.push_back(i);
+      }
+
+         // Run the stations and wait for all of them
+      if(busy.size() == 1)
+      {
+         busy[0]->run(gRinVec);
+      }
+      else
+      {
+         for(size_t i = 0; i < busy.size(); i++)
+         {
+            pool.submit( std::bind( &Station::run, busy[i],
+                                    std::ref(gRinVec) ) );
+         }
+         pool.wait();
+      }
+
+         // Report the first failure in the order of the data
+      Station* failed(0);
+      for(size_t i = 0; i < busy.size(); i++)
+      {
+         if( busy[i]->failed &&
+             ( !failed || (busy[i]->failedIndex < failed->failedIndex) ) )
+         {
+            failed = busy[i];
+         }
+      }
+
+      if(failed)
+      {
+         ProcessingException e( getClassName() + ": station "
+                  + StringUtils::asString(
+                              gRinVec[failed->failedIndex].header.source)
+                  + ": " + failed->error );
+         GPSTK_THROW(e);
+      }
+
+         // Join the results
+      std::vector<bool> keep(gRinVec.size(), true);
+      for(size_t i = 0; i < busy.size(); i++)
+      {
+         for(size_t j = 0; j < busy[i]->decimated.size(); j++)
+         {
+            keep[busy[i]->decimated[j]] = false;
+         }
+      }
+
+      for(size_t i = 0; i < gRinVec.size(); i++)
+      {
+         if(keep[i])
+         {
+            gdsMap.addGnssRinex(gRinVec[i]);
+         }
+      }
+
+      return gdsMap;
+
+   }  // End of method 'StationPipeline::Process()'
+
+
+
+      // Runs the list of a station on the data of this epoch.
+   void StationPipeline::Station::run(std::vector<gnssRinex>& gRinVec)
+   {
+
+      typedef std::chrono::steady_clock Clock;
+
+      for(size_t i = 0; i < data.size(); i++)
+      {
+
+         gnssRinex& gRin(gRinVec[data[i]]);
+
+         size_t stage(0);
+         ProcessingList::const_iterator pos;
+         for( pos = pList->begin(); pos != pList->end(); ++pos, ++stage )
+         {
+
+            if(stats.size() <= stage)
+            {
+               stats.resize(stage+1);
+            }
+            StageStats& st(stats[stage]);
+            if(st.name.empty())
+            {
+               st.name = (*pos)->getClassName();
+            }
+
+            Clock::time_point start(Clock::now());
+
+            try
+            {
+               (*pos)->Process(gRin);
+            }
+            catch(DecimateEpoch& d)
+            {
+               decimated.push_back(data[i]);
+            }
+            catch(Exception& e)
+            {
+               error = (*pos)->getClassName() + ": " + e.getText();
+            }
+            catch(std::exception& e)
+            {
+               error = (*pos)->getClassName() + ": " + e.what();
+            }
+            catch(...)
+            {
+               error = (*pos)->getClassName() + ": unknown exception";
+            }
+
+            st.add( std::chrono::duration<double>(
+                                    Clock::now() - start ).count() );
+
+            if( !error.empty() )
+            {
+               failed = true;
+               failedIndex = data[i];
+               return;
+            }
+
+            if( !decimated.empty() && (decimated.back() == data[i]) )
+            {
+               break;
+            }
+
+         }  // End of 'for( pos = pList->begin(); ...'
+
+      }  // End of 'for(size_t i = 0; i < data.size(); i++)'
+
+   }  // End of method 'StationPipeline::Station::run()'
+
+
+
+      // Returns the statistics of the stages, merged by class name.
+   std::vector<StationPipeline::StageStats>
+   StationPipeline::getStageStats() const
+   {
+
+         // Keep the order in which the classes first appear
+      std::vector<StageStats> result;
+      std::map<std::string, size_t> index;
+
+      std::map<SourceID, Station>::const_iterator its;
+      for(its = stations.begin(); its != stations.end(); ++its)
+      {
+         const std::vector<StageStats>& stats(its->second.stats);
+         for(size_t i = 0; i < stats.size(); i++)
+         {
+            std::map<std::string, size_t>::const_iterator it(
+                                                   index.find(stats[i].name) );
+            if(it == index.end())
+            {
+               index[stats[i].name] = result.size();
+               result.push_back(stats[i]);
+            }
+            else
+            {
+               result[it->second].merge(stats[i]);
+            }
+         }
+      }
+
+      return result;
+
+   }  // End of method 'StationPipeline::getStageStats()'
+
+
+
+      // Returns the statistics of the stages of one station.
+   std::vector<StationPipeline::StageStats>
+   StationPipeline::getStageStats(const SourceID& source) const
+   {
+
+      std::map<SourceID, Station>::const_iterator its(stations.find(source));
+      if(its == stations.end())
+      {
+         return std::vector<StageStats>();
+      }
+
+      return its->second.stats;
+
+   }  // End of method 'StationPipeline::getStageStats()'
+
+
+
+      // Clears the statistics.
+   void StationPipeline::resetStats()
+   {
+
+      std::map<SourceID, Station>::iterator its;
+      for(its = stations.begin(); its != stations.end(); ++its)
+      {
+         its->second.stats.clear();
+      }
+
+   }  // End of method 'StationPipeline::resetStats()'
+
+
+
+      // Prints the stage statistics.
+   std::ostream& StationPipeline::dumpStats(std::ostream& s) const
+   {
+
+      std::vector<StageStats> stats(getStageStats());
+
+      std::ios::fmtflags oldFlags(s.flags());
+      std::streamsize oldPrecision(s.precision());
+
+      s << "# stage, calls, mean [us], max [us], "
+        << "calls per bin of 2^i to 2^(i+1) us" << std::endl;
+
+      for(size_t i = 0; i < stats.size(); i++)
+      {
+         const StageStats& st(stats[i]);
+         double mean( st.count ? st.total/st.count : 0.0 );
+
+            // Trailing empty bins are not printed
+         unsigned last(StageStats::numBins);
+         while( (last > 1) && (st.bins[last-1] == 0) )
+         {
+            last--;
+         }
+
+         s << std::left << std::setw(24) << st.name << std::right
+           << " " << std::setw(8) << st.count
+           << std::fixed << std::setprecision(1)
+           << " " << std::setw(10) << mean*1.0e6
+           << " " << std::setw(10) << st.max*1.0e6;
+         for(unsigned b = 0; b < last; b++)
+         {
+            s << " " << st.bins[b];
+         }
+         s << std::endl;
+      }
+
+      s.flags(oldFlags);
+      s.precision(oldPrecision);
+
+      return s;
+
+   }  // End of method 'StationPipeline::dumpStats()'
+
+
+}  // End of namespace gpstk
@@ -0,0 +1,280 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file StationPipeline.hpp
+ * Run the ProcessingList of each station of a network in parallel.
+ */
+
+#ifndef GPSTK_STATIONPIPELINE_HPP
+#define GPSTK_STATIONPIPELINE_HPP
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ProcessingList.hpp"
+#include "ThreadPool.hpp"
+
+
+namespace gpstk
+{
+
+      /// @ingroup GPSsolutions
+      //@{
+
+
+      /** This class runs the preprocessing of a network of stations,
+       * one ProcessingList per station, on a pool of threads.
+       *
+       * Each epoch, the gnssRinex objects of all the stations are given
+       * to Process().  The list of every station is run as one task, so
+       * different stations are processed at the same time while the
+       * stages of a station run in their usual order.  Process() returns
+       * when all the stations are done, after adding their data to a
+       * gnssDataMap in the order they were given, so the result doesn't
+       * depend on the number of threads or on which one finishes first.
+       * The gnssDataMap is then ready for a network solver such as
+       * SolverGeneral.  Single station solvers such as SolverPPP are
+       * simply put at the end of the list of their station.
+       *
+       * A typical way to use this class follows:
+       *
+       * @code
+       *   StationPipeline pipeline;
+       *   for(int i = 0; i < numStations; i++)
+       *   {
+       *      pipeline.addStation(source[i], pList[i]);
+       *   }
+       *
+       *   vector<gnssRinex> gRinVec(numStations);
+       *   while(readEpoch(rinexStreams, gRinVec))
+       *   {
+       *      gnssDataMap gds;
+       *      pipeline.Process(gRinVec, gds);
+       *      solverGen.Process(gds);
+       *   }
+       *
+       *   pipeline.dumpStats(cout);
+       * @endcode
+       *
+       * The time taken by each stage (each element of the lists) is
+       * accumulated in a histogram per class, see getStageStats().
+       *
+       * \warning The lists of different stations run concurrently, so
+       * they must not share ProcessingClass objects that change state
+       * when processing data (cycle slip detectors, smoothers, filters,
+       * ...).  Shared read-only objects, such as ephemeris stores that
+       * are no longer being loaded, are fine.
+       */
+   class StationPipeline
+   {
+   public:
+
+         /// Latency histogram of one processing stage.
+      struct StageStats
+      {
+            /// Number of histogram bins.
+         static const unsigned numBins = 24;
+
+            /// Default constructor.
+         StageStats()
+            : count(0), total(0.0), max(0.0), bins(numBins, 0)
+         {};
+
+            /// Adds one measurement, in seconds.
+         void add(double seconds);
+
+            /// Adds the measurements in another object.
+         void merge(const StageStats& right);
+
+            /// Name of the class of the stage.
+         std::string name;
+
+            /// Number of calls.
+         unsigned long count;
+
+            /// Total time, in seconds.
+         double total;
+
+            /// Longest call, in seconds.
+         double max;
+
+            /// bins[i] counts the calls taking from 2^i to 2^(i+1)
+            /// microseconds; bins[0] also counts shorter calls and the
+            /// last bin longer ones.
+         std::vector<unsigned long> bins;
+      };
+
+
+         /** Common constructor.
+          *
+          * @param numThreads    Number of threads; 0 selects one per
+          *                      hardware thread.
+          */
+      explicit StationPipeline(unsigned numThreads = 0);
+
+
+         /** Sets the ProcessingList used for a station.
+          *
+          * @param source     SourceID of the station.
+          * @param pList      List to run on the data of the station. It
+          *                   is used by reference, and must outlive
+          *                   this object.
+          */
+      virtual StationPipeline& addStation( const SourceID& source,
+                                           ProcessingList& pList );
+
+
+         /// Removes a station.
+      virtual StationPipeline& removeStation(const SourceID& source);
+
+
+         /// Returns the number of stations.
+      virtual size_t numStations(void) const
+      { return stations.size(); };
+
+
+         /// Returns the number of threads.
+      virtual unsigned getNumThreads(void) const
+      { return pool.getNumThreads(); };
+
+
+         /** Processes the data of one epoch for all the stations.
+          *
+          * Each gnssRinex is processed by the list set for its
+          * header.source; data of other sources are left as they are.
+          *
+          * @param gRinVec    gnssRinex objects, processed in place.
+          * @param gdsMap     gnssDataMap where the processed data are
+          *                   added, in the order of gRinVec.  Stations
+          *                   whose list threw DecimateEpoch are left out.
+          *
+          * @throw ProcessingException if any list threw another
+          * exception.  All the stations are processed first, and the
+          * exception reports the first failed station in gRinVec; in
+          * that case nothing is added to gdsMap.
+          */
+      virtual gnssDataMap& Process( std::vector<gnssRinex>& gRinVec,
+                                    gnssDataMap& gdsMap )
+         throw(ProcessingException);
+
+
+         /// Returns the statistics of the stages, merged by class name.
+      virtual std::vector<StageStats> getStageStats(void) const;
+
+
+         /// Returns the statistics of the stages of one station.
+      virtual std::vector<StageStats> getStageStats(
+                                          const SourceID& source ) const;
+
+
+         /// Clears the statistics.
+      virtual void resetStats(void);
+
+
+         /** Prints the stage statistics, one line per class with the
+          * number of calls, mean and maximum time (in microseconds) and
+          * the histogram bins.
+          */
+      virtual std::ostream& dumpStats(std::ostream& s) const;
+
+
+         /// Returns a string identifying this object.
+      virtual std::string getClassName(void) const;
+
+
+         /// Destructor.
+      virtual ~StationPipeline() {};
+
+
+   private:
+
+
+         /// Work of one station in one epoch.
+      struct Station
+      {
+            /// Constructor.
+         Station() : pList(0), failed(false) {};
+
+            /// Runs the list on the data of this epoch.
+         void run(std::vector<gnssRinex>& gRinVec);
+
+            /// Station list.
+         ProcessingList* pList;
+
+            /// Statistics of each stage of the list.
+         std::vector<StageStats> stats;
+
+            /// Indexes in gRinVec of the data of this station.
+         std::vector<size_t> data;
+
+            /// Indexes in gRinVec of the data that were decimated.
+         std::vector<size_t> decimated;
+
+            /// Whether the list threw an exception.
+         bool failed;
+
+            /// Index in gRinVec of the failed data.
+         size_t failedIndex;
+
+            /// Text of the exception.
+         std::string error;
+      };
+
+
+         /// Stations, by SourceID.
+      std::map<SourceID, Station> stations;
+
+
+         /// Threads running the stations.
+      ThreadPool pool;
+
+
+         // not copyable
+      StationPipeline(const StationPipeline&);
+      StationPipeline& operator=(const StationPipeline&);
+
+
+   }; // End of class 'StationPipeline'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_STATIONPIPELINE_HPP
@@ -0,0 +1,476 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file TypeIDTable.hpp
+ * Map from TypeID to values, with a fixed slot for each standard TypeID.
+ */
+
+#ifndef GPSTK_TYPEIDTABLE_HPP
+#define GPSTK_TYPEIDTABLE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "TypeID.hpp"
+#include "FlatMap.hpp"
+
+namespace gpstk
+{
+
+      /// @ingroup DataStructures
+      //@{
+
+      /** Associative container with the interface of std::map, keyed by
+       * TypeID.
+       *
+       * The standard types, TypeID::Unknown to TypeID::Last-1, are
+       * compile-time constants numbered from zero, and are used directly
+       * as indexes in a fixed array of values; a bit mask records which
+       * of them are present.  Finding or inserting one of them is a
+       * single array access, and the values of an object are contiguous
+       * in memory.  Types created at run time with
+       * TypeID::newValueType() or TypeID::regByName() are numbered from
+       * TypeID::Last on, and are kept in an overflow FlatMap.
+       *
+       * Iteration is in TypeID order, as with std::map.  Iterators
+       * return proxies with the members \c first (a copy of the TypeID)
+       * and \c second (a reference to the value), so \c it->first and
+       * \c it->second work as usual, and \c *it converts to value_type.
+       * Inserting or erasing standard types doesn't invalidate
+       * iterators to other elements; inserting or erasing other types
+       * invalidates iterators to types that aren't standard.
+       */
+   template <class T>
+   class TypeIDTable
+   {
+   public:
+      typedef TypeID key_type;
+      typedef T mapped_type;
+      typedef std::pair<TypeID, T> value_type;
+      typedef std::size_t size_type;
+      typedef std::ptrdiff_t difference_type;
+
+         /// Number of standard types, i.e. of fixed slots.
+      static const size_type numSlots = TypeID::Last;
+
+   private:
+      typedef FlatMap<TypeID, T> Overflow;
+      typedef unsigned long long Word;
+      static const size_type wordBits = 64;
+      static const size_type numWords = (numSlots + wordBits - 1) / wordBits;
+
+         /// Bidirectional iterator; positions below numSlots are slots,
+         /// the others index the overflow map.
+      template <class Table, class V>
+      class Iter
+      {
+      public:
+            /// What the iterator points to.
+         struct Ref
+         {
+            Ref(const TypeID& t, V& v) : first(t), second(v) {}
+            operator value_type() const { return value_type(first, second); }
+            TypeID first;
+            V& second;
+         };
+
+            /// Result of operator->
+         struct Arrow
+         {
+            Arrow(const Ref& r) : ref(r) {}
+            Ref* operator->() { return &ref; }
+            Ref ref;
+         };
+
+         typedef std::bidirectional_iterator_tag iterator_category;
+         typedef typename TypeIDTable::value_type value_type;
+         typedef std::ptrdiff_t difference_type;
+         typedef Arrow pointer;
+         typedef Ref reference;
+
+         Iter() : table(0), pos(0) {}
+         Iter(Table *t, size_type p) : table(t), pos(p) {}
+            /// Conversion from iterator to const_iterator
+         template <class T2, class V2>
+         Iter(const Iter<T2, V2>& other) : table(other.table), pos(other.pos) {}
+
+         Ref operator*() const
+         {
+            if (pos < numSlots)
+               return Ref(TypeID(TypeID::ValueType(pos)), table->values[pos]);
+            size_type j(pos - numSlots);
+            return Ref(table->overflow.begin()[j].first,
+                       table->overflow.begin()[j].second);
+         }
+         Arrow operator->() const { return Arrow(operator*()); }
+         Iter& operator++()
+         {
+            pos = (pos < numSlots) ? table->nextSlot(pos+1) : pos+1;
+            return *this;
+         }
+         Iter operator++(int) { Iter t(*this); operator++(); return t; }
+         Iter& operator--()
+         {
+            pos = (pos > numSlots) ? pos-1 : table->prevSlot(pos);
+            return *this;
+         }
+         Iter operator--(int) { Iter t(*this); operator--(); return t; }
+         template <class T2, class V2>
+         bool operator==(const Iter<T2, V2>& r) const { return pos == r.pos; }
+         template <class T2, class V2>
+         bool operator!=(const Iter<T2, V2>& r) const { return pos != r.pos; }
+
+         Table *table;
+         size_type pos;
+      };
+
+   public:
+      typedef Iter<TypeIDTable, T> iterator;
+      typedef Iter<const TypeIDTable, const T> const_iterator;
+      typedef std::reverse_iterator<iterator> reverse_iterator;
+      typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+         /// Default constructor, an empty table.
+      TypeIDTable() : numSet(0)
+      { clearBits(); }
+
+         /// Construct from a range of values, as std::map does.
+      template <class InputIterator>
+      TypeIDTable(InputIterator first, InputIterator last) : numSet(0)
+      {
+         clearBits();
+         insert(first, last);
+      }
+
+         /// Copy constructor; only the slots in use are copied.
+      TypeIDTable(const TypeIDTable& right)
+      { assign(right); }
+
+         /// Assignment; only the slots in use are copied.
+      TypeIDTable& operator=(const TypeIDTable& right)
+      {
+         if (this != &right)
+            assign(right);
+         return *this;
+      }
+
+      iterator begin() { return iterator(this, nextSlot(0)); }
+      const_iterator begin() const { return const_iterator(this, nextSlot(0)); }
+      iterator end() { return iterator(this, numSlots + overflow.size()); }
+      const_iterator end() const
+      { return const_iterator(this, numSlots + overflow.size()); }
+      reverse_iterator rbegin() { return reverse_iterator(end()); }
+      const_reverse_iterator rbegin() const
+      { return const_reverse_iterator(end()); }
+      reverse_iterator rend() { return reverse_iterator(begin()); }
+      const_reverse_iterator rend() const
+      { return const_reverse_iterator(begin()); }
+
+      bool empty() const { return size() == 0; }
+      size_type size() const { return numSet + overflow.size(); }
+      size_type max_size() const { return numSlots + overflow.max_size(); }
+
+         /// Remove all elements; the overflow map keeps its storage.
+      void clear()
+      {
+         clearBits();
+         numSet = 0;
+         overflow.clear();
+      }
+
+         /** Return a pointer to the value of type \a k, or a null
+          * pointer if there is none.  This is the fastest look-up. */
+      T* findValue(const TypeID& k)
+      {
+         size_type i(k.type);
+         if (i < numSlots)
+            return isSet(i) ? &values[i] : 0;
+         typename Overflow::iterator it(overflow.find(k));
+         return (it == overflow.end()) ? 0 : &it->second;
+      }
+
+      const T* findValue(const TypeID& k) const
+      { return const_cast<TypeIDTable*>(this)->findValue(k); }
+
+         /// Return a reference to the value with key \a k, inserting a
+         /// default value if there is none.
+      T& operator[](const TypeID& k)
+      {
+         size_type i(k.type);
+         if (i < numSlots)
+         {
+            if (!isSet(i))
+            {
+               setBit(i);
+               values[i] = T();
+            }
+            return values[i];
+         }
+         return overflow[k];
+      }
+
+      std::pair<iterator, bool> insert(const value_type& v)
+      {
+         size_type i(v.first.type);
+         if (i < numSlots)
+         {
+            if (isSet(i))
+               return std::make_pair(iterator(this, i), false);
+            setBit(i);
+            values[i] = v.second;
+            return std::make_pair(iterator(this, i), true);
+         }
+         std::pair<typename Overflow::iterator, bool> r(overflow.insert(v));
+         return std::make_pair(iterator(this, numSlots + (r.first -
+                                                          overflow.begin())),
+                               r.second);
+      }
+
+         /// Insert with a position hint, which is not needed.
+      iterator insert(iterator hint, const value_type& v)
+      { return insert(v).first; }
+
+      template <class InputIterator>
+      void insert(InputIterator first, InputIterator last)
+      {
+         for ( ; first != last; ++first)
+            insert(value_type(first->first, first->second));
+      }
+
+      iterator erase(iterator pos)
+      {
+         size_type i(pos.pos);
+         if (i < numSlots)
+         {
+            clearBit(i);
+            return iterator(this, nextSlot(i+1));
+         }
+         overflow.erase(overflow.begin() + (i - numSlots));
+         return iterator(this, i);
+      }
+
+      iterator erase(iterator first, iterator last)
+      {
+         size_type n(std::distance(first, last));
+         for (size_type k = 0; k < n; k++)
+            first = erase(first);
+         return first;
+      }
+
+      size_type erase(const TypeID& k)
+      {
+         size_type i(k.type);
+         if (i < numSlots)
+         {
+            if (!isSet(i))
+               return 0;
+            clearBit(i);
+            return 1;
+         }
+         return overflow.erase(k);
+      }
+
+      void swap(TypeIDTable& other)
+      {
+         TypeIDTable tmp(other);
+         other = *this;
+         *this = tmp;
+      }
+
+      iterator find(const TypeID& k)
+      { return iterator(this, findPos(k)); }
+
+      const_iterator find(const TypeID& k) const
+      { return const_iterator(this, findPos(k)); }
+
+      size_type count(const TypeID& k) const
+      { return (findValue(k) == 0) ? 0 : 1; }
+
+      iterator lower_bound(const TypeID& k)
+      { return iterator(this, lowerPos(k)); }
+
+      const_iterator lower_bound(const TypeID& k) const
+      { return const_iterator(this, lowerPos(k)); }
+
+      iterator upper_bound(const TypeID& k)
+      {
+         iterator it(lower_bound(k));
+         if (it != end() && it.pos == findPos(k))
+            ++it;
+         return it;
+      }
+
+      const_iterator upper_bound(const TypeID& k) const
+      { return const_cast<TypeIDTable*>(this)->upper_bound(k); }
+
+      std::pair<iterator, iterator> equal_range(const TypeID& k)
+      { return std::make_pair(lower_bound(k), upper_bound(k)); }
+
+      std::pair<const_iterator, const_iterator>
+      equal_range(const TypeID& k) const
+      { return std::make_pair(lower_bound(k), upper_bound(k)); }
+
+      bool operator==(const TypeIDTable& right) const
+      {
+         if (numSet != right.numSet)
+            return false;
+         for (size_type w = 0; w < numWords; w++)
+            if (bits[w] != right.bits[w])
+               return false;
+         for (size_type i = nextSlot(0); i < numSlots; i = nextSlot(i+1))
+            if (!(values[i] == right.values[i]))
+               return false;
+         return overflow == right.overflow;
+      }
+
+      bool operator!=(const TypeIDTable& right) const
+      { return !operator==(right); }
+
+   private:
+      bool isSet(size_type i) const
+      { return (bits[i / wordBits] >> (i % wordBits)) & 1; }
+
+      void setBit(size_type i)
+      {
+         bits[i / wordBits] |= Word(1) << (i % wordBits);
+         numSet++;
+      }
+
+      void clearBit(size_type i)
+      {
+         bits[i / wordBits] &= ~(Word(1) << (i % wordBits));
+         numSet--;
+      }
+
+      void clearBits()
+      {
+         for (size_type w = 0; w < numWords; w++)
+            bits[w] = 0;
+      }
+
+         /// First slot in use at or after \a i, or numSlots.
+      size_type nextSlot(size_type i) const
+      {
+         size_type w(i / wordBits);
+         if (w >= numWords)
+            return numSlots;
+         Word word(bits[w] & (~Word(0) << (i % wordBits)));
+         while (word == 0)
+         {
+            if (++w == numWords)
+               return numSlots;
+            word = bits[w];
+         }
+         return w * wordBits + lowestBit(word);
+      }
+
+         /// Last slot in use before \a i; \a i must not be the first.
+      size_type prevSlot(size_type i) const
+      {
+         while (i-- > 0)
+            if (isSet(i))
+               return i;
+         return 0;
+      }
+
+      static size_type lowestBit(Word word)
+      {
+#if defined(__GNUC__)
+         return __builtin_ctzll(word);
+#else
+         size_type n(0);
+         while (!(word & 1))
+         {
+            word >>= 1;
+            n++;
+         }
+         return n;
+#endif
+      }
+
+      size_type findPos(const TypeID& k) const
+      {
+         size_type i(k.type);
+         if (i < numSlots)
+            return isSet(i) ? i : numSlots + overflow.size();
+         return numSlots + (overflow.find(k) - overflow.begin());
+      }
+
+      size_type lowerPos(const TypeID& k) const
+      {
+         size_type i(k.type);
+         if (i < numSlots)
+            return nextSlot(i);
+         return numSlots + (overflow.lower_bound(k) - overflow.begin());
+      }
+
+      void assign(const TypeIDTable& right)
+      {
+         numSet = right.numSet;
+         for (size_type w = 0; w < numWords; w++)
+            bits[w] = right.bits[w];
+         for (size_type i = nextSlot(0); i < numSlots; i = nextSlot(i+1))
+            values[i] = right.values[i];
+         overflow = right.overflow;
+      }
+
+         /// Which slots are in use.
+      Word bits[numWords];
+         /// Number of slots in use.
+      size_type numSet;
+         /// Values of the standard types, indexed by TypeID::ValueType.
+      T values[numSlots];
+         /// Values of the other types.
+      Overflow overflow;
+   }; // class TypeIDTable
+
+   template <class T>
+   const typename TypeIDTable<T>::size_type TypeIDTable<T>::numSlots;
+
+   template <class T>
+   const typename TypeIDTable<T>::size_type TypeIDTable<T>::wordBits;
+
+   template <class T>
+   const typename TypeIDTable<T>::size_type TypeIDTable<T>::numWords;
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif // GPSTK_TYPEIDTABLE_HPP
@@ -0,0 +1,231 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "EarthBody.hpp"
+#include "EarthPoleTide.hpp"
+#include "ReferenceFrames.hpp"
+#include "IERS.hpp"
+#include "CivilTime.hpp"
+#include "TestUtil.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+
+using namespace std;
+using namespace gpstk;
+
+
+class EarthBody_T
+{
+public:
+   EarthBody_T();
+   ~EarthBody_T();
+
+      /// each term against its direct computation, at more epochs than
+      /// are kept
+   int termsTest();
+      /// the tides computed with the terms of an EarthBody
+   int tideTest();
+
+   bool ready;
+
+private:
+   static double maxDiff(const Matrix<double>& a, const Matrix<double>& b);
+
+   UTCTime utc0;
+   string eopFile;
+};
+
+
+EarthBody_T ::
+EarthBody_T()
+      : ready(false)
+{
+   CommonTime t0(CivilTime(2010, 3, 1, 0, 0, 0.0, TimeSystem::UTC));
+   utc0 = UTCTime(t0);
+
+      // earth orientation parameters in the format of the IERS finals
+      // file, changing from day to day
+   char name[] = "/tmp/EarthBody_TXXXXXX";
+   int fd = mkstemp(name);
+   if (fd < 0)
+      return;
+   close(fd);
+   eopFile = name;
+   ofstream out(name);
+   int mjd = int(utc0.mjdUTC());
+   for (int d = mjd - 10; d <= mjd + 10; d++)
+   {
+      char line[81];
+      memset(line, ' ', 80);
+      line[80] = 0;
+      char buf[16];
+      sprintf(buf, "%8.2f", double(d));
+      memcpy(line + 7, buf, 8);
+      sprintf(buf, "%9.6f", 0.1 + 0.001 * (d - mjd));
+      memcpy(line + 18, buf, 9);
+      sprintf(buf, "%9.6f", 0.3 - 0.002 * (d - mjd));
+      memcpy(line + 37, buf, 9);
+      sprintf(buf, "%10.7f", 0.05 - 0.0001 * (d - mjd));
+      memcpy(line + 58, buf, 10);
+      out << line << endl;
+   }
+   out.close();
+   IERS::loadIERSFile(eopFile);
+   ready = true;
+}
+
+
+EarthBody_T ::
+~EarthBody_T()
+{
+   if (!eopFile.empty())
+      remove(eopFile.c_str());
+}
+
+
+double EarthBody_T ::
+maxDiff(const Matrix<double>& a, const Matrix<double>& b)
+{
+   double d = 0.0;
+   for (size_t j = 0; j < a.rows(); j++)
+      for (size_t k = 0; k < a.cols(); k++)
+         d = max(d, fabs(a(j,k) - b(j,k)));
+   return d;
+}
+
+
+int EarthBody_T ::
+termsTest()
+{
+   TUDEF("EarthBody", "epochTerms");
+
+   EarthBody body;
+   body.setMaxEpochs(3);
+
+      // the stages of a step of the integrator, then back in time
+   double dt[] = { 0.0, 20.0, 40.0, 30.0, 0.0, 60.0, 20.0, 60.0, 90.0,
+                   3600.0, 0.0 };
+   for (size_t i = 0; i < sizeof(dt)/sizeof(dt[0]); i++)
+   {
+      UTCTime utc(utc0);
+      utc += dt[i];
+      Matrix<double> c2t = ReferenceFrames::J2kToECEFMatrix(utc);
+      Matrix<double> tod = ReferenceFrames::J2kToTODMatrix(utc);
+      double xp = IERS::xPole(utc.mjdUTC());
+      double yp = IERS::yPole(utc.mjdUTC());
+      double gmst = ReferenceFrames::iauGmst00(utc.asUT1(), utc.asTT());
+      double beta[6], fnut[5];
+      ReferenceFrames::doodsonArguments(utc.asUT1(), utc.asTT(), beta, fnut);
+
+         // the second pass uses the stored terms
+      for (int pass = 0; pass < 2; pass++)
+      {
+         TUASSERTFE(0.0, maxDiff(c2t, body.j2kToECEFMatrix(utc)));
+         TUASSERTFE(0.0, maxDiff(tod, body.j2kToTODMatrix(utc)));
+         double gxp, gyp;
+         body.polarMotion(utc, gxp, gyp);
+         TUASSERTFE(xp, gxp);
+         TUASSERTFE(yp, gyp);
+         TUASSERTFE(gmst, body.gmst(utc));
+         double gbeta[6], gfnut[5];
+         body.doodsonArguments(utc, gbeta, gfnut);
+         double d = 0.0;
+         for (int j = 0; j < 6; j++)
+            d = max(d, fabs(gbeta[j] - beta[j]));
+         for (int j = 0; j < 5; j++)
+            d = max(d, fabs(gfnut[j] - fnut[j]));
+         TUASSERTFE(0.0, d);
+      }
+   }
+
+      // after clearing, and in a copy
+   UTCTime utc(utc0);
+   utc += 7200.0;
+   body.clearEpochs();
+   EarthBody copy(body);
+   TUASSERTFE(0.0, maxDiff(ReferenceFrames::J2kToECEFMatrix(utc),
+                           copy.j2kToECEFMatrix(utc)));
+   TUASSERTFE(0.0, maxDiff(ReferenceFrames::J2kToECEFMatrix(utc),
+                           body.j2kToECEFMatrix(utc)));
+
+   TURETURN();
+}
+
+
+int EarthBody_T ::
+tideTest()
+{
+   TUDEF("EarthPoleTide", "getPoleTide");
+
+   EarthBody body;
+   EarthPoleTide tide;
+   for (int i = 0; i < 5; i++)
+   {
+      UTCTime utc(utc0);
+      utc += 21600.0 * i;
+      double dc, ds, edc, eds;
+      tide.getPoleTide(body, utc, dc, ds);
+      tide.getPoleTide(utc.mjdUTC(), edc, eds);
+      TUASSERTFEPS(edc, dc, 1e-20);
+      TUASSERTFEPS(eds, ds, 1e-20);
+      TUASSERT(dc != 0.0);
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   EarthBody_T testClass;
+   if (!testClass.ready)
+   {
+      cout << "Unable to write earth orientation parameters" << endl;
+      return 1;
+   }
+
+   errorTotal += testClass.termsTest();
+   errorTotal += testClass.tideTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
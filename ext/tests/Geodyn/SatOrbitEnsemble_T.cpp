@@ -0,0 +1,376 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "SatOrbitEnsemble.hpp"
+#include "ReferenceFrames.hpp"
+#include "IERS.hpp"
+#include "CivilTime.hpp"
+#include "TestUtil.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+
+class SatOrbitEnsemble_T
+{
+public:
+   SatOrbitEnsemble_T();
+   ~SatOrbitEnsemble_T();
+
+      /// the ensemble against one SatOrbitPropagator per satellite
+   int propagateTest();
+      /// results don't depend on the number of threads
+   int threadTest();
+      /// terms of EarthBody against ReferenceFrames
+   int earthBodyTest();
+      /// copies of a SatOrbit use their own EarthBody and force models
+   int copyTest();
+
+   bool ready;
+
+private:
+      /// Propagate every state in rv0 for 'steps' steps, either with
+      /// one SatOrbitPropagator each (numThreads 0) or an ensemble.
+   void propagate(unsigned numThreads, int steps,
+                  vector< Vector<double> >& rv,
+                  vector< Matrix<double> >& phi);
+
+   UTCTime utc0;
+   vector< Vector<double> > rv0;
+   string eopFile;
+};
+
+
+SatOrbitEnsemble_T ::
+SatOrbitEnsemble_T()
+      : ready(false)
+{
+   CommonTime t0(CivilTime(2010, 3, 1, 0, 0, 0.0, TimeSystem::UTC));
+   utc0 = UTCTime(t0);
+
+      // earth orientation parameters of zero, in the format of the IERS
+      // finals file
+   char name[] = "/tmp/SatOrbitEnsemble_TXXXXXX";
+   int fd = mkstemp(name);
+   if (fd < 0)
+      return;
+   close(fd);
+   eopFile = name;
+   ofstream out(name);
+   int mjd = int(utc0.mjdUTC());
+   for (int d = mjd - 10; d <= mjd + 10; d++)
+   {
+      char line[81];
+      memset(line, ' ', 80);
+      line[80] = 0;
+      char buf[16];
+      sprintf(buf, "%8.2f", double(d));
+      memcpy(line + 7, buf, 8);
+      memcpy(line + 18, " 0.000000", 9);
+      memcpy(line + 37, " 0.000000", 9);
+      memcpy(line + 58, " 0.0000000", 10);
+      out << line << endl;
+   }
+   out.close();
+   IERS::loadIERSFile(eopFile);
+
+      // low orbits of several inclinations, and a GPS orbit
+   for (int i = 0; i < 6; i++)
+   {
+      Vector<double> rv(6, 0.0);
+      double inc = i * 0.5;
+      double r = (i == 5) ? 26560.0e3 : 7000.0e3 + 100.0e3 * i;
+      double v = sqrt(3.986004418e14 / r);
+      rv(0) = r;
+      rv(4) = v * cos(inc);
+      rv(5) = v * sin(inc);
+      rv0.push_back(rv);
+   }
+   ready = true;
+}
+
+
+SatOrbitEnsemble_T ::
+~SatOrbitEnsemble_T()
+{
+   if (!eopFile.empty())
+      remove(eopFile.c_str());
+}
+
+
+void SatOrbitEnsemble_T ::
+propagate(unsigned numThreads, int steps,
+          vector< Vector<double> >& rv,
+          vector< Matrix<double> >& phi)
+{
+   const double step = 60.0;
+   vector<SatOrbit> orbits(rv0.size());
+   for (size_t i = 0; i < orbits.size(); i++)
+      orbits[i].enableGeopotential(SatOrbit::GM_JGM3, 8, 8);
+
+   rv.resize(rv0.size());
+   phi.resize(rv0.size());
+   if (numThreads == 0)
+   {
+      for (size_t i = 0; i < rv0.size(); i++)
+      {
+         SatOrbitPropagator op;
+         op.setOrbit(&orbits[i]);
+         op.setStepSize(step);
+         op.setInitState(utc0, rv0[i]);
+         for (int s = 1; s <= steps; s++)
+            op.integrateTo(s * step);
+         rv[i] = op.rvState();
+         phi[i] = op.transitionMatrix();
+      }
+      return;
+   }
+
+   SatOrbitEnsemble ens(utc0, numThreads);
+   ens.setStepSize(step);
+   for (size_t i = 0; i < rv0.size(); i++)
+      ens.addSatellite(orbits[i], rv0[i]);
+   for (int s = 1; s <= steps; s++)
+      ens.integrateTo(s * step);
+   for (size_t i = 0; i < rv0.size(); i++)
+   {
+      rv[i] = ens.rvState(i);
+      phi[i] = ens.transitionMatrix(i);
+   }
+}
+
+
+int SatOrbitEnsemble_T ::
+propagateTest()
+{
+   TUDEF("SatOrbitEnsemble", "integrateTo");
+
+   vector< Vector<double> > rvRef, rv;
+   vector< Matrix<double> > phiRef, phi;
+   propagate(0, 30, rvRef, phiRef);
+   propagate(4, 30, rv, phi);
+
+   double drv = 0.0, dphi = 0.0, moved = 0.0;
+   for (size_t i = 0; i < rv.size(); i++)
+   {
+      for (int j = 0; j < 6; j++)
+      {
+         drv = max(drv, fabs(rv[i](j) - rvRef[i](j)));
+         for (int k = 0; k < 6; k++)
+            dphi = max(dphi, fabs(phi[i](j,k) - phiRef[i](j,k)));
+      }
+      moved = max(moved, fabs(rv[i](0) - rv0[i](0)));
+   }
+   TUASSERTFE(0.0, drv);
+   TUASSERTFE(0.0, dphi);
+   TUASSERT(moved > 1.0e5);
+
+      // the ensemble gives back the EarthBody of each orbit
+   EarthBody shared;
+   SatOrbit own, other;
+   EarthBody *ownBody = own.getEarthBody();
+   other.setEarthBody(&shared);
+   {
+      SatOrbitEnsemble ens(utc0, 2);
+      ens.addSatellite(own, rv0[0]);
+      ens.addSatellite(other, rv0[1]);
+      TUASSERT(own.getEarthBody() == other.getEarthBody());
+      TUASSERT(own.getEarthBody() != ownBody);
+   }
+   TUASSERT(own.getEarthBody() == ownBody);
+   TUASSERT(other.getEarthBody() == &shared);
+
+      // satellites join only at the initial epoch
+   SatOrbit orbit, late;
+   SatOrbitEnsemble ens(utc0, 2);
+   ens.setStepSize(60.0);
+   ens.addSatellite(orbit, rv0[0]);
+   ens.integrateTo(60.0);
+   TUASSERTE(size_t, 1, ens.numSatellites());
+   try
+   {
+      ens.addSatellite(late, rv0[1]);
+      TUFAIL("Satellite added after the initial epoch");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("Satellite added after the initial epoch");
+   }
+   try
+   {
+      ens.rvState(1);
+      TUFAIL("Missing satellite accepted");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("Missing satellite rejected");
+   }
+
+   TURETURN();
+}
+
+
+int SatOrbitEnsemble_T ::
+threadTest()
+{
+   TUDEF("SatOrbitEnsemble", "integrateTo");
+
+   vector< Vector<double> > rv1, rv;
+   vector< Matrix<double> > phi1, phi;
+   propagate(1, 20, rv1, phi1);
+   propagate(3, 20, rv, phi);
+
+   double drv = 0.0;
+   for (size_t i = 0; i < rv.size(); i++)
+      for (int j = 0; j < 6; j++)
+         drv = max(drv, fabs(rv[i](j) - rv1[i](j)));
+   TUASSERTFE(0.0, drv);
+
+   TURETURN();
+}
+
+
+int SatOrbitEnsemble_T ::
+earthBodyTest()
+{
+   TUDEF("EarthBody", "j2kToECEFMatrix");
+
+   EarthBody body;
+   body.setMaxEpochs(2);
+
+      // more epochs than are kept, forward and back again
+   double dt[] = { 0.0, 30.0, 60.0, 30.0, 0.0, 90.0, 0.0 };
+   for (size_t i = 0; i < sizeof(dt)/sizeof(dt[0]); i++)
+   {
+      UTCTime utc(utc0);
+      utc += dt[i];
+      Matrix<double> exp = ReferenceFrames::J2kToECEFMatrix(utc);
+      for (int pass = 0; pass < 2; pass++)
+      {
+         Matrix<double> got = body.j2kToECEFMatrix(utc);
+         double d = 0.0;
+         for (int j = 0; j < 3; j++)
+            for (int k = 0; k < 3; k++)
+               d = max(d, fabs(got(j,k) - exp(j,k)));
+         TUASSERTFE(0.0, d);
+      }
+   }
+
+   TURETURN();
+}
+
+
+int SatOrbitEnsemble_T ::
+copyTest()
+{
+   TUDEF("SatOrbit", "SatOrbit(const SatOrbit&)");
+
+   SatOrbit orbit;
+   orbit.enableGeopotential(SatOrbit::GM_JGM3, 8, 8);
+
+      // propagate the original first, so it has its force models
+   SatOrbitPropagator op;
+   op.setOrbit(&orbit);
+   op.setStepSize(60.0);
+   op.setInitState(utc0, rv0[0]);
+   op.integrateTo(600.0);
+
+   SatOrbit copy(orbit), assigned;
+   assigned = orbit;
+   TUASSERT(copy.getEarthBody() != orbit.getEarthBody());
+   TUASSERT(assigned.getEarthBody() != orbit.getEarthBody());
+
+      // the copies outlive the original and give the same orbit
+   vector< Vector<double> > rv;
+   {
+      vector<SatOrbit> orbits(2, orbit);
+      orbits[1] = assigned;
+      for (size_t i = 0; i < orbits.size(); i++)
+      {
+         TUASSERT(orbits[i].getEarthBody() != orbit.getEarthBody());
+         SatOrbitPropagator opc;
+         opc.setOrbit(&orbits[i]);
+         opc.setStepSize(60.0);
+         opc.setInitState(utc0, rv0[0]);
+         opc.integrateTo(600.0);
+         rv.push_back(opc.rvState());
+      }
+   }
+   orbit.reset();
+   for (size_t i = 0; i < rv.size(); i++)
+   {
+      double d = 0.0;
+      for (int j = 0; j < 6; j++)
+         d = max(d, fabs(rv[i](j) - op.rvState()(j)));
+      TUASSERTFE(0.0, d);
+   }
+
+      // a shared EarthBody stays shared
+   EarthBody shared;
+   orbit.setEarthBody(&shared);
+   SatOrbit copyShared(orbit);
+   TUASSERT(copyShared.getEarthBody() == &shared);
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   SatOrbitEnsemble_T testClass;
+   if (!testClass.ready)
+   {
+      cout << "Unable to write earth orientation parameters" << endl;
+      return 1;
+   }
+
+   errorTotal += testClass.propagateTest();
+   errorTotal += testClass.threadTest();
+   errorTotal += testClass.earthBodyTest();
+   errorTotal += testClass.copyTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,202 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file SatOrbitPropagatorTiming.cpp
+ * Measure the time to propagate a low orbit over one day with
+ * SatOrbitPropagator, with the JGM3 field evaluated by the
+ * SphericalHarmonicGravity workspace kernel and by the three-pass
+ * computeVW/gravity/gravityGradient evaluation.
+ *
+ * Usage: SatOrbitPropagatorTiming [-d degree] [-s step] [-t hours]
+ *                                 [-e finals.data]
+ *
+ * The defaults are degree and order 70, a 60 s step and 24 hours.
+ * Without an IERS finals file, earth orientation parameters of zero
+ * are written to a temporary file and used. */
+
+#include <ctime>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <unistd.h>
+
+#include "SatOrbitPropagator.hpp"
+#include "IERS.hpp"
+#include "CivilTime.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+   /// SatOrbit with the choice of gravity evaluation.
+class TimingOrbit : public SatOrbit
+{
+public:
+   TimingOrbit(bool ws)
+         : workspace(ws)
+   {}
+
+   virtual Vector<double> getDerivatives(const double& t,
+                                         const Vector<double>& y)
+   {
+      if (!fmlPrepared)
+      {
+         createFMObjects(forceConfig);
+         forceConfig.pGeoEarth->enableWorkspace(workspace);
+      }
+      return SatOrbit::getDerivatives(t, y);
+   }
+
+private:
+   bool workspace;
+};
+
+
+   /// Write earth orientation parameters of zero around mjd in the
+   /// format of the IERS finals file.
+static string writeEOP(int mjd)
+{
+   char name[] = "/tmp/SatOrbitPropagatorTimingXXXXXX";
+   int fd = mkstemp(name);
+   if (fd < 0)
+      return string();
+   close(fd);
+   ofstream out(name);
+   for (int d = mjd - 10; d <= mjd + 12; d++)
+   {
+      char line[81];
+      memset(line, ' ', 80);
+      line[80] = 0;
+      char buf[16];
+      sprintf(buf, "%8.2f", double(d));
+      memcpy(line + 7, buf, 8);
+      memcpy(line + 18, " 0.000000", 9);
+      memcpy(line + 37, " 0.000000", 9);
+      memcpy(line + 58, " 0.0000000", 10);
+      out << line << endl;
+   }
+   return string(name);
+}
+
+
+   /// Propagate and return the seconds of CPU time and the final state.
+static double propagate(bool ws, int degree, double step, double hours,
+                        const UTCTime& utc0, const Vector<double>& rv0,
+                        Vector<double>& rv)
+{
+   TimingOrbit orbit(ws);
+   orbit.enableGeopotential(SatOrbit::GM_JGM3, degree, degree);
+
+   SatOrbitPropagator op;
+   op.setOrbit(&orbit);
+   op.setStepSize(step);
+   op.setInitState(utc0, rv0);
+
+   clock_t t0 = clock();
+   for (double t = step; t <= hours*3600.0 + 1e-6; t += step)
+      op.integrateTo(t);
+   double sec = double(clock() - t0) / CLOCKS_PER_SEC;
+   rv = op.rvState();
+   return sec;
+}
+
+
+int main(int argc, char *argv[])
+{
+   int degree = 70;
+   double step = 60.0, hours = 24.0;
+   string eopFile;
+   for (int i = 1; i < argc; i++)
+   {
+      if ((strcmp(argv[i], "-d") == 0) && (i+1 < argc))
+         degree = atoi(argv[++i]);
+      else if ((strcmp(argv[i], "-s") == 0) && (i+1 < argc))
+         step = atof(argv[++i]);
+      else if ((strcmp(argv[i], "-t") == 0) && (i+1 < argc))
+         hours = atof(argv[++i]);
+      else if ((strcmp(argv[i], "-e") == 0) && (i+1 < argc))
+         eopFile = argv[++i];
+   }
+
+   CommonTime t0(CivilTime(2010, 3, 1, 0, 0, 0.0, TimeSystem::UTC));
+   UTCTime utc0(t0);
+   string tmpFile;
+   if (eopFile.empty())
+      eopFile = tmpFile = writeEOP(int(utc0.mjdUTC()));
+   try
+   {
+      IERS::loadIERSFile(eopFile);
+   }
+   catch (Exception& e)
+   {
+      cerr << "Unable to load earth orientation from " << eopFile << endl;
+      return 1;
+   }
+
+      // a 700 km, 98 degree orbit
+   Vector<double> rv0(6, 0.0);
+   rv0(0) = 7078137.0;
+   rv0(4) = -1041.5;
+   rv0(5) = 7433.0;
+
+   cout << "JGM3 " << degree << "x" << degree << ", " << step
+        << " s steps over " << hours << " hours" << endl;
+
+   Vector<double> rvWs, rvOld;
+   double tws = propagate(true, degree, step, hours, utc0, rv0, rvWs);
+   double told = propagate(false, degree, step, hours, utc0, rv0, rvOld);
+
+   double dr = 0.0;
+   for (int i = 0; i < 3; i++)
+      dr = max(dr, fabs(rvWs(i) - rvOld(i)));
+
+   cout << fixed << setprecision(3)
+        << "workspace:  " << tws << " s" << endl
+        << "three-pass: " << told << " s, ratio " << setprecision(2)
+        << told/tws << endl
+        << "largest position difference " << scientific << setprecision(2)
+        << dr << " m" << endl;
+
+   if (!tmpFile.empty())
+      remove(tmpFile.c_str());
+   return 0;
+}
@@ -0,0 +1,243 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "JGM3GravityModel.hpp"
+#include "EGM96GravityModel.hpp"
+#include "TestUtil.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   // count the calls of operator new, to show that the workspace kernel
+   // does not allocate once it is set up
+static size_t allocCount = 0;
+
+void* operator new(size_t n)
+{
+   allocCount++;
+   void *p = malloc(n ? n : 1);
+   if (!p)
+      throw bad_alloc();
+   return p;
+}
+
+void operator delete(void *p) throw()
+{
+   free(p);
+}
+
+void operator delete(void *p, size_t) throw()
+{
+   free(p);
+}
+
+
+   /// Gives access to the three-pass evaluation.
+template <class Model>
+class TestGravity : public Model
+{
+public:
+   TestGravity(int n, int m)
+         : Model(n, m)
+   {}
+
+   void legacy(const Vector<double>& r, const Matrix<double>& E,
+               Vector<double>& a, Matrix<double>& g)
+   {
+      this->computeVW(r, E);
+      a = this->gravity(r, E);
+      g = this->gravityGradient(r, E);
+   }
+};
+
+
+class SphericalHarmonicGravity_T
+{
+public:
+   SphericalHarmonicGravity_T();
+
+      /// gravityAndGradient() against computeVW/gravity/gravityGradient
+   int workspaceTest();
+      /// the workspace follows setDesiredDegree()
+   int degreeTest();
+      /// repeated calls do not allocate
+   int allocTest();
+
+private:
+      /// Compare the two evaluations of model at every position and
+      /// rotation.
+   template <class Model>
+   void compare(TestUtil& testFramework, TestGravity<Model>& model);
+
+   vector< Vector<double> > positions;
+   vector< Matrix<double> > rotations;
+};
+
+
+SphericalHarmonicGravity_T ::
+SphericalHarmonicGravity_T()
+{
+      // LEO, GPS and geostationary radius, near the poles and the equator
+   double pos[][3] = { { 6525.919e3, 1710.416e3, 2508.886e3 },
+                       { -1500.e3, 300.e3, 6700.e3 },
+                       { 15600.e3, -7540.e3, 20140.e3 },
+                       { 42164.e3, 10.e3, -20.e3 } };
+   for (size_t i = 0; i < sizeof(pos)/sizeof(pos[0]); i++)
+   {
+      Vector<double> r(3);
+      r(0) = pos[i][0];
+      r(1) = pos[i][1];
+      r(2) = pos[i][2];
+      positions.push_back(r);
+   }
+
+   rotations.push_back(ident<double>(3));
+      // a rotation about z followed by a small tilt
+   double th = 1.234, ph = 0.01;
+   Matrix<double> Rz(3,3,0.0), Rx(3,3,0.0);
+   Rz(0,0) = cos(th);  Rz(0,1) = sin(th);
+   Rz(1,0) = -sin(th); Rz(1,1) = cos(th);
+   Rz(2,2) = 1.0;
+   Rx(0,0) = 1.0;
+   Rx(1,1) = cos(ph);  Rx(1,2) = sin(ph);
+   Rx(2,1) = -sin(ph); Rx(2,2) = cos(ph);
+   rotations.push_back(Rx * Rz);
+}
+
+
+template <class Model>
+void SphericalHarmonicGravity_T ::
+compare(TestUtil& testFramework, TestGravity<Model>& model)
+{
+   for (size_t i = 0; i < positions.size(); i++)
+   {
+      for (size_t k = 0; k < rotations.size(); k++)
+      {
+         Vector<double> a0, a1;
+         Matrix<double> g0, g1;
+         model.legacy(positions[i], rotations[k], a0, g0);
+         model.gravityAndGradient(positions[i], rotations[k], a1, g1);
+
+         TUASSERTE(size_t, 3, a1.size());
+         TUASSERTE(size_t, 3, g1.rows());
+         TUASSERTE(size_t, 3, g1.cols());
+         double amax = max(fabs(a0(0)), max(fabs(a0(1)), fabs(a0(2))));
+         double gmax = 0.0;
+         for (int r = 0; r < 3; r++)
+            for (int c = 0; c < 3; c++)
+               gmax = max(gmax, fabs(g0(r,c)));
+         for (int r = 0; r < 3; r++)
+         {
+            TUASSERTFEPS(a0(r), a1(r), 1e-13*amax);
+            for (int c = 0; c < 3; c++)
+               TUASSERTFEPS(g0(r,c), g1(r,c), 1e-12*gmax);
+         }
+      }
+   }
+}
+
+
+int SphericalHarmonicGravity_T ::
+workspaceTest()
+{
+   TUDEF("SphericalHarmonicGravity", "gravityAndGradient");
+
+   int sizes[][2] = { { 2, 0 }, { 4, 4 }, { 20, 20 }, { 30, 10 },
+                      { 70, 70 } };
+   for (size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++)
+   {
+      TestGravity<JGM3GravityModel> jgm3(sizes[s][0], sizes[s][1]);
+      compare(testFramework, jgm3);
+      TestGravity<EGM96GravityModel> egm96(sizes[s][0], sizes[s][1]);
+      compare(testFramework, egm96);
+   }
+   TURETURN();
+}
+
+
+int SphericalHarmonicGravity_T ::
+degreeTest()
+{
+   TUDEF("SphericalHarmonicGravity", "setDesiredDegree");
+
+      // built small, then raised past the constructor size as
+      // SatOrbit does, then lowered again
+   TestGravity<JGM3GravityModel> model(4, 4);
+   compare(testFramework, model);
+   model.setDesiredDegree(50, 50);
+   compare(testFramework, model);
+   model.setDesiredDegree(8, 3);
+   compare(testFramework, model);
+   TURETURN();
+}
+
+
+int SphericalHarmonicGravity_T ::
+allocTest()
+{
+   TUDEF("SphericalHarmonicGravity", "gravityAndGradient");
+
+   TestGravity<JGM3GravityModel> model(70, 70);
+   Vector<double> a;
+   Matrix<double> g;
+   model.gravityAndGradient(positions[0], rotations[1], a, g);
+   size_t before = allocCount;
+   for (int i = 0; i < 100; i++)
+      model.gravityAndGradient(positions[i%positions.size()], rotations[1],
+                               a, g);
+   TUASSERTE(size_t, 0, allocCount - before);
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   SphericalHarmonicGravity_T testClass;
+
+   errorTotal += testClass.workspaceTest();
+   errorTotal += testClass.degreeTest();
+   errorTotal += testClass.allocTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,199 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "Bancroft.hpp"
+#include "GNSSconstants.hpp"
+#include "MiscMath.hpp"
+#include "TestUtil.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+using namespace gpstk;
+
+   // count the calls of operator new, to show that a solution does
+   // not allocate
+static size_t allocCount = 0;
+
+void* operator new(size_t n)
+{
+   allocCount++;
+   void *p = malloc(n ? n : 1);
+   if (!p)
+      throw bad_alloc();
+   return p;
+}
+
+void operator delete(void *p) throw()
+{
+   free(p);
+}
+
+
+class Bancroft_T
+{
+public:
+   Bancroft_T();
+
+      /// the solution of exact data must be the receiver position
+   int solutionTest();
+      /// data screening and the return codes
+   int screeningTest();
+      /// repeated solutions must not allocate
+   int allocationTest();
+
+private:
+   Matrix<double> data;
+   double rx[3], clock;
+};
+
+
+Bancroft_T ::
+Bancroft_T()
+      : data(8,4)
+{
+      // a receiver near Austin, and satellites at GPS altitude
+   rx[0] = -740290.0; rx[1] = -5457072.0; rx[2] = 3207246.0;
+   clock = 1234.5;
+   const double r(26560000.0);
+   for (size_t i = 0; i < data.rows(); i++)
+   {
+      double lat = (10.0 + 7.0*i) * DEG_TO_RAD;
+      double lon = (230.0 + 19.0*i) * DEG_TO_RAD;
+      data(i,0) = r * ::cos(lat) * ::cos(lon);
+      data(i,1) = r * ::cos(lat) * ::sin(lon);
+      data(i,2) = r * ::sin(lat);
+      data(i,3) = RSS(data(i,0)-rx[0], data(i,1)-rx[1], data(i,2)-rx[2])
+         + clock;
+   }
+}
+
+
+int Bancroft_T ::
+solutionTest()
+{
+   TUDEF("Bancroft", "Compute");
+
+   Bancroft ban;
+   Vector<double> X;
+   TUASSERTE(int, 0, ban.Compute(data, X));
+   TUASSERTE(size_t, 4, X.size());
+   for (size_t i = 0; i < 3; i++)
+      TUASSERTFEPS(rx[i], X(i), 1.e-4);
+   TUASSERTFEPS(clock, X(3), 1.e-4);
+
+      // the const version is the same
+   const Matrix<double>& cdata(data);
+   Vector<double> Y;
+   TUASSERTE(int, 0, ban.Compute(cdata, Y));
+   for (size_t i = 0; i < 4; i++)
+      TUASSERTFE(X(i), Y(i));
+
+      // both solutions; the other one is far from the Earth's surface
+   ban.ChooseOne = false;
+   TUASSERTE(int, 0, ban.Compute(data, Y));
+   TUASSERTE(size_t, 4, ban.SecondSolution.size());
+   double r1 = RSS(Y(0), Y(1), Y(2));
+   double r2 = RSS(ban.SecondSolution(0), ban.SecondSolution(1),
+                   ban.SecondSolution(2));
+   TUASSERT(::fabs(r1 - 6378137.0) < 1.e5 || ::fabs(r2 - 6378137.0) < 1.e5);
+   TUASSERT(::fabs(r1 - r2) > 1.e5);
+   TURETURN();
+}
+
+
+int Bancroft_T ::
+screeningTest()
+{
+   TUDEF("Bancroft", "Compute");
+
+   Bancroft ban;
+   Vector<double> X;
+   Matrix<double> bad(data);
+      // bad ranges and satellite positions are dropped...
+   bad(0,3) = 1000.0;
+   bad(1,0) = 0.0;
+   bad(1,1) = 0.0;
+   TUASSERTE(int, 0, ban.Compute(bad, X));
+   for (size_t i = 0; i < 3; i++)
+      TUASSERTFEPS(rx[i], X(i), 1.e-4);
+      // ...until there are too few left
+   bad(2,3) = 1.e9;
+   bad(3,3) = -1.0;
+   bad(4,3) = 0.0;
+   TUASSERTE(int, -1, ban.Compute(bad, X));
+      // without screening, a rank-deficient problem is singular
+   ban.testInput = false;
+   Matrix<double> zero(4,4,0.0);
+   TUASSERTE(int, -2, ban.Compute(zero, X));
+   TURETURN();
+}
+
+
+int Bancroft_T ::
+allocationTest()
+{
+   TUDEF("Bancroft", "Compute");
+
+   Bancroft ban;
+   Vector<double> X;
+   ban.Compute(data, X);
+   size_t before(allocCount);
+   int iret(0);
+   for (int i = 0; i < 10; i++)
+      iret += ban.Compute(data, X);
+   size_t count(allocCount - before);
+   TUASSERTE(size_t, 0, count);
+   TUASSERTE(int, 0, iret);
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   Bancroft_T testClass;
+
+   errorTotal += testClass.solutionTest();
+   errorTotal += testClass.screeningTest();
+   errorTotal += testClass.allocationTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
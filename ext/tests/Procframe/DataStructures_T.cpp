@@ -0,0 +1,443 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "DataStructures.hpp"
+#include "FlatMap.hpp"
+#include "TypeIDTable.hpp"
+#include "TestUtil.hpp"
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace gpstk;
+
+   // count the calls of operator new, to show that refilling a
+   // satTypeValueMap does not allocate
+static size_t allocCount = 0;
+
+void* operator new(size_t n)
+{
+   allocCount++;
+   void *p = malloc(n ? n : 1);
+   if (!p)
+      throw bad_alloc();
+   return p;
+}
+
+void operator delete(void *p) throw()
+{
+   free(p);
+}
+
+void operator delete(void *p, size_t) throw()
+{
+   free(p);
+}
+
+
+class DataStructures_T
+{
+public:
+   DataStructures_T();
+
+      /// check FlatMap against std::map
+   int flatMapTest();
+      /// check SlotMap against std::map, and the reuse of its nodes
+   int slotMapTest();
+      /// check TypeIDTable against std::map, with standard and user types
+   int typeIDTableTest();
+      /// check the satTypeValueMap methods on the new containers
+   int satTypeValueMapTest();
+      /// read RINEX files into one gnssRinex and compare with the
+      /// conversion functions
+   int rinexTest();
+
+private:
+   string dataFilePath;
+};
+
+
+DataStructures_T ::
+DataStructures_T()
+{
+   dataFilePath = gpstk::getPathData() + gpstk::getFileSep();
+}
+
+
+int DataStructures_T ::
+flatMapTest()
+{
+   TUDEF("FlatMap", "insert");
+
+   FlatMap<int, double> fm;
+   map<int, double> sm;
+   srand(11);
+   for (int i = 0; i < 200; i++)
+   {
+      int k = rand() % 50;
+      double v = rand() / (double)RAND_MAX;
+      switch (rand() % 4)
+      {
+         case 0:
+            fm[k] = v;
+            sm[k] = v;
+            break;
+         case 1:
+            TUASSERTE(bool, sm.insert(make_pair(k, v)).second,
+                      fm.insert(make_pair(k, v)).second);
+            break;
+         case 2:
+            TUASSERTE(size_t, sm.erase(k), fm.erase(k));
+            break;
+         default:
+               // hint at the end, right or wrong
+            fm.insert(fm.end(), make_pair(k, v));
+            sm.insert(sm.end(), make_pair(k, v));
+            break;
+      }
+   }
+   TUASSERTE(size_t, sm.size(), fm.size());
+   bool same = true;
+   map<int, double>::const_iterator si = sm.begin();
+   FlatMap<int, double>::const_iterator fi = fm.begin();
+   for ( ; si != sm.end(); ++si, ++fi)
+      same = same && (si->first == fi->first) && (si->second == fi->second);
+   TUASSERT(same);
+
+   testFramework.changeSourceMethod("find");
+   for (int k = -1; k < 51; k++)
+   {
+      TUASSERTE(size_t, sm.count(k), fm.count(k));
+      TUASSERTE(bool, sm.find(k) == sm.end(), fm.find(k) == fm.end());
+      TUASSERTE(ptrdiff_t, distance(sm.begin(), sm.lower_bound(k)),
+                fm.lower_bound(k) - fm.begin());
+      TUASSERTE(ptrdiff_t, distance(sm.begin(), sm.upper_bound(k)),
+                fm.upper_bound(k) - fm.begin());
+   }
+
+   testFramework.changeSourceMethod("erase");
+   FlatMap<int, double>::iterator it = fm.begin();
+   while (it != fm.end())
+   {
+      if (it->first % 2)
+         it = fm.erase(it);
+      else
+         ++it;
+   }
+   for (it = fm.begin(); it != fm.end(); ++it)
+      TUASSERTE(int, 0, it->first % 2);
+
+   testFramework.changeSourceMethod("clear");
+   FlatMap<int, double> copy(fm);
+   TUASSERT(copy == fm);
+   fm.clear();
+   TUASSERT(fm.empty());
+   TUASSERT(copy != fm);
+   TURETURN();
+}
+
+
+int DataStructures_T ::
+slotMapTest()
+{
+   TUDEF("SlotMap", "operator[]");
+
+   SlotMap<int, vector<double> > m;
+   for (int k = 0; k < 20; k += 2)
+      m[k].assign(10, k);
+   vector<double>& ref(m[10]);
+      // inserting in front of it must not move the element
+   for (int k = 1; k < 20; k += 2)
+      m[k].assign(10, k);
+   TUASSERTE(size_t, 20, m.size());
+   TUASSERT(&ref == &m[10]);
+   bool sorted = true;
+   int expKey = 0;
+   SlotMap<int, vector<double> >::const_iterator ci;
+   for (ci = m.begin(); ci != m.end(); ++ci, ++expKey)
+      sorted = sorted && (ci->first == expKey) && (ci->second[0] == expKey);
+   TUASSERT(sorted);
+
+   testFramework.changeSourceMethod("erase");
+   const vector<double> *node = &m[7];
+   TUASSERTE(size_t, 1, m.erase(7));
+   TUASSERTE(size_t, 0, m.count(7));
+      // the next insertion gets the erased node, emptied but with its
+      // storage
+   vector<double>& reused(m[100]);
+   TUASSERT(&reused == node);
+   TUASSERT(reused.empty());
+   TUASSERTE(size_t, 10, reused.capacity());
+
+   testFramework.changeSourceMethod("operator=");
+   SlotMap<int, vector<double> > other;
+   other[3].assign(2, 3.);
+   const vector<double> *otherNode = &other[3];
+   other = m;
+   TUASSERT(other == m);
+      // assignment reuses the nodes it has
+   TUASSERT(otherNode == &other.begin()->second);
+
+   testFramework.changeSourceMethod("clear");
+   m.clear();
+   TUASSERT(m.empty());
+   allocCount = 0;
+   for (int k = 0; k < 20; k++)
+      m[k].assign(10, k);
+   size_t allocs = allocCount;
+   TUASSERTE(size_t, 0, allocs);
+   TURETURN();
+}
+
+
+int DataStructures_T ::
+typeIDTableTest()
+{
+   TUDEF("TypeIDTable", "insert");
+
+      // a few user types, kept in the overflow map
+   vector<TypeID> types;
+   for (int i = 0; i < 5; i++)
+      types.push_back(TypeID::regByName("TypeIDTable_T" +
+                                        StringUtils::asString(i), "test"));
+   TUASSERT(types[0].type >= TypeID::Last);
+   for (int i = 0; i < 40; i++)
+      types.push_back(TypeID(TypeID::ValueType((i * 37) % TypeID::Last)));
+
+   TypeIDTable<double> tt;
+   map<TypeID, double> sm;
+   srand(17);
+   for (int i = 0; i < 300; i++)
+   {
+      const TypeID& k(types[rand() % types.size()]);
+      double v = rand() / (double)RAND_MAX;
+      switch (rand() % 3)
+      {
+         case 0:
+            tt[k] = v;
+            sm[k] = v;
+            break;
+         case 1:
+            TUASSERTE(bool, sm.insert(make_pair(k, v)).second,
+                      tt.insert(make_pair(k, v)).second);
+            break;
+         default:
+            TUASSERTE(size_t, sm.erase(k), tt.erase(k));
+            break;
+      }
+   }
+   TUASSERTE(size_t, sm.size(), tt.size());
+
+      // same elements in the same order, forwards and backwards
+   bool same = true;
+   map<TypeID, double>::const_iterator si = sm.begin();
+   TypeIDTable<double>::const_iterator ti = tt.begin();
+   for ( ; si != sm.end(); ++si, ++ti)
+      same = same && (si->first == ti->first) && (si->second == ti->second);
+   TUASSERT(same && (ti == tt.end()));
+   map<TypeID, double>::const_reverse_iterator sri = sm.rbegin();
+   TypeIDTable<double>::const_iterator tri = tt.end();
+   for ( ; sri != sm.rend(); ++sri)
+   {
+      --tri;
+      same = same && (sri->first == (*tri).first);
+   }
+   TUASSERT(same && (tri == tt.begin()));
+
+   testFramework.changeSourceMethod("find");
+   for (size_t i = 0; i < types.size(); i++)
+   {
+      TUASSERTE(size_t, sm.count(types[i]), tt.count(types[i]));
+      TUASSERTE(bool, sm.find(types[i]) == sm.end(),
+                tt.find(types[i]) == tt.end());
+      TUASSERTE(bool, sm.count(types[i]) == 0, tt.findValue(types[i]) == 0);
+      TUASSERTE(ptrdiff_t, distance(sm.begin(), sm.lower_bound(types[i])),
+                distance(tt.begin(), tt.lower_bound(types[i])));
+      TUASSERTE(ptrdiff_t, distance(sm.begin(), sm.upper_bound(types[i])),
+                distance(tt.begin(), tt.upper_bound(types[i])));
+   }
+
+   testFramework.changeSourceMethod("operator=");
+   TypeIDTable<double> copy(tt);
+   TUASSERT(copy == tt);
+   *copy.findValue(sm.begin()->first) += 1.0;
+   TUASSERT(copy != tt);
+   copy = tt;
+   TUASSERT(copy == tt);
+
+   testFramework.changeSourceMethod("erase");
+      // values can be changed through the iterators, and erasing
+      // returns the next element
+   TypeIDTable<double>::iterator it = tt.begin();
+   while (it != tt.end())
+   {
+      if (it->first.type % 2)
+         it = tt.erase(it);
+      else
+      {
+         it->second = -1.0;
+         ++it;
+      }
+   }
+   bool even = true;
+   for (it = tt.begin(); it != tt.end(); ++it)
+      even = even && !(it->first.type % 2) && (it->second == -1.0);
+   TUASSERT(even);
+   tt.clear();
+   TUASSERT(tt.empty() && (tt.begin() == tt.end()));
+
+   TypeID::unregAll();
+   TURETURN();
+}
+
+
+int DataStructures_T ::
+satTypeValueMapTest()
+{
+   TUDEF("satTypeValueMap", "insertTypeIDVector");
+
+   satTypeValueMap stvm;
+   SatID sats[] = { SatID(5, SatID::systemGPS), SatID(1, SatID::systemGPS),
+                    SatID(3, SatID::systemGalileo) };
+   for (int i = 0; i < 3; i++)
+   {
+      stvm[sats[i]][TypeID::C1] = 2.e7 + i;
+      stvm[sats[i]][TypeID::L1] = 1.e8 + i;
+      stvm[sats[i]][TypeID::elevation] = 30. + i;
+   }
+   TUASSERTE(size_t, 3, stvm.numSats());
+   TUASSERTE(size_t, 9, stvm.numElements());
+   TUASSERTFE(1.e8 + 1, stvm.getValue(sats[1], TypeID::L1));
+   TUASSERTE(SatID, sats[1], stvm.begin()->first);
+
+   Vector<double> prefit(3);
+   prefit(0) = 1.; prefit(1) = 2.; prefit(2) = 3.;
+   stvm.insertTypeIDVector(TypeID::prefitC, prefit);
+   TUASSERTFE(2., stvm.getValue(sats[0], TypeID::prefitC));
+
+   testFramework.changeSourceMethod("keepOnlyTypeID");
+   TypeIDSet keep;
+   keep.insert(TypeID::C1);
+   keep.insert(TypeID::prefitC);
+   satTypeValueMap ext(stvm.extractTypeID(keep));
+   stvm.keepOnlyTypeID(keep);
+   TUASSERT(ext == stvm);
+   TUASSERTE(size_t, 6, stvm.numElements());
+   try
+   {
+      stvm.getValue(sats[0], TypeID::L1);
+      TUFAIL("removed type was found");
+   }
+   catch (TypeIDNotFound& e)
+   {
+      TUPASS("removed type not found");
+   }
+
+   testFramework.changeSourceMethod("removeSatID");
+   stvm.removeSatID(sats[0]);
+   TUASSERTE(size_t, 2, stvm.numSats());
+   Matrix<double> mat(stvm.getMatrixOfTypes(keep));
+   TUASSERTE(size_t, 2, mat.rows());
+   TUASSERTFE(2.e7 + 1, mat(0, 0));
+   TUASSERTFE(3., mat(1, 1));
+   TURETURN();
+}
+
+
+int DataStructures_T ::
+rinexTest()
+{
+   TUDEF("gnssRinex", "operator>>");
+
+   vector<string> files;
+   files.push_back(dataFilePath + "arlm200a.15o");
+   files.push_back(dataFilePath + "test_input_rinex3_76193040.14o");
+   for (size_t f = 0; f < files.size(); f++)
+   {
+      vector<satTypeValueMap> expBody;
+      vector<Rinex3ObsData> records;
+      Rinex3ObsStream strm(files[f].c_str());
+      strm >> strm.header;
+      Rinex3ObsData rod;
+      while (strm >> rod)
+      {
+         records.push_back(rod);
+         expBody.push_back(
+            satTypeValueMapFromRinex3ObsData(strm.header, rod));
+      }
+      TUASSERT(expBody.size() > 0);
+
+         // all epochs go through the same gnssRinex
+      Rinex3ObsStream strm2(files[f].c_str());
+      gnssRinex gRin;
+      size_t count = 0;
+      bool same = true;
+      while ((strm2 >> gRin) && (count < expBody.size()))
+         same = same && (gRin.body == expBody[count++]);
+      TUASSERT(same);
+      TUASSERTE(size_t, expBody.size(), count);
+
+         // once it has seen an epoch, refilling the map costs nothing
+      satTypeValueMap stvm;
+      satTypeValueMapFromRinex3ObsData(strm.header, records[0], stvm);
+      allocCount = 0;
+      satTypeValueMapFromRinex3ObsData(strm.header, records[0], stvm);
+      size_t allocs = allocCount;
+      TUASSERTE(size_t, 0, allocs);
+      TUASSERT(stvm == expBody[0]);
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   DataStructures_T testClass;
+
+   errorTotal += testClass.flatMapTest();
+   errorTotal += testClass.slotMapTest();
+   errorTotal += testClass.typeIDTableTest();
+   errorTotal += testClass.satTypeValueMapTest();
+   errorTotal += testClass.rinexTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,347 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include "StationPipeline.hpp"
+#include "Decimate.hpp"
+#include "TestUtil.hpp"
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace gpstk;
+
+   /// Stage that depends on the previous epochs of its station and takes
+   /// a varying time, so stations finish in a different order each epoch.
+class Accumulate : public ProcessingClass
+{
+public:
+   Accumulate() : sum(0.0), count(0), ordered(true) {}
+
+   virtual gnssSatTypeValue& Process(gnssSatTypeValue& gData)
+   { return gData; }
+
+   virtual gnssRinex& Process(gnssRinex& gData)
+   {
+      if ((count > 0) && !(last < gData.header.epoch))
+         ordered = false;
+      last = gData.header.epoch;
+      satTypeValueMap::iterator it;
+      for (it = gData.body.begin(); it != gData.body.end(); ++it)
+      {
+         sum += it->second[TypeID::C1];
+         it->second[TypeID::prefitC] = it->second[TypeID::C1] - sum;
+      }
+      count++;
+         // (count*7)%5 changes the order of completion every epoch
+      this_thread::sleep_for(chrono::microseconds(100 * ((count*7) % 5)));
+      return gData;
+   }
+
+   virtual string getClassName() const
+   { return "Accumulate"; }
+
+   double sum;
+   unsigned count;
+   CommonTime last;
+   bool ordered;
+};
+
+
+   /// Stage that decimates some epochs and fails on one.
+class Select : public ProcessingClass
+{
+public:
+   Select(int skip, int fail) : skipEvery(skip), failAt(fail), count(0) {}
+
+   virtual gnssSatTypeValue& Process(gnssSatTypeValue& gData)
+   { return gData; }
+
+   virtual gnssRinex& Process(gnssRinex& gData)
+   {
+      int epoch(count++);
+      if (epoch == failAt)
+      {
+         ProcessingException e("bad epoch");
+         GPSTK_THROW(e);
+      }
+      if ((skipEvery > 0) && ((epoch % skipEvery) == 0))
+      {
+         DecimateEpoch e("skipped");
+         GPSTK_THROW(e);
+      }
+      return gData;
+   }
+
+   virtual string getClassName() const
+   { return "Select"; }
+
+   int skipEvery, failAt, count;
+};
+
+
+class StationPipeline_T
+{
+public:
+   StationPipeline_T();
+
+      /// compare with processing each station in turn
+   int processTest(unsigned numThreads);
+      /// check the stage statistics
+   int statsTest();
+      /// check the handling of failures
+   int failTest();
+
+private:
+      /// Make the data of one epoch for all the stations
+   void makeEpoch(int epoch, vector<gnssRinex>& gRinVec);
+
+   static const int numStations = 6;
+   static const int numEpochs = 20;
+   vector<SourceID> sources;
+};
+
+
+StationPipeline_T ::
+StationPipeline_T()
+{
+   for (int i = 0; i < numStations; i++)
+   {
+      ostringstream name;
+      name << "STA" << i;
+      sources.push_back(SourceID(SourceID::GPS, name.str()));
+   }
+}
+
+
+void StationPipeline_T ::
+makeEpoch(int epoch, vector<gnssRinex>& gRinVec)
+{
+   gRinVec.resize(numStations);
+   for (int i = 0; i < numStations; i++)
+   {
+      gnssRinex& gRin(gRinVec[i]);
+      gRin.header.source = sources[i];
+      gRin.header.epoch = CommonTime::BEGINNING_OF_TIME + 30.0*epoch;
+      gRin.header.epochFlag = 0;
+      gRin.body.clear();
+      for (int prn = 1; prn <= 8; prn++)
+      {
+         gRin.body[SatID(prn, SatID::systemGPS)][TypeID::C1] =
+            2.0e7 + 1000.0*i + 10.0*prn + epoch;
+      }
+   }
+}
+
+
+int StationPipeline_T ::
+processTest(unsigned numThreads)
+{
+   TUDEF("StationPipeline", "Process");
+
+      // station i skips every (i+2)th epoch
+   vector<Accumulate> acc(numStations), accRef(numStations);
+   vector<Select> sel, selRef;
+   for (int i = 0; i < numStations; i++)
+   {
+      sel.push_back(Select(i+2, -1));
+      selRef.push_back(Select(i+2, -1));
+   }
+   vector<ProcessingList> lists(numStations), listsRef(numStations);
+   StationPipeline pipeline(numThreads);
+   for (int i = 0; i < numStations; i++)
+   {
+      lists[i].push_back(acc[i]);
+      lists[i].push_back(sel[i]);
+      listsRef[i].push_back(accRef[i]);
+      listsRef[i].push_back(selRef[i]);
+         // the last station isn't processed
+      if (i < numStations-1)
+         pipeline.addStation(sources[i], lists[i]);
+   }
+   TUASSERTE(size_t, numStations-1, pipeline.numStations());
+   TUASSERTE(unsigned, numThreads, pipeline.getNumThreads());
+
+   vector<gnssRinex> gRinVec;
+   bool same(true);
+   for (int epoch = 0; epoch < numEpochs; epoch++)
+   {
+      makeEpoch(epoch, gRinVec);
+      gnssDataMap expected, gds;
+      for (int i = 0; i < numStations; i++)
+      {
+         gnssRinex gRin(gRinVec[i]);
+         try
+         {
+            if (i < numStations-1)
+               listsRef[i].Process(gRin);
+            expected.addGnssRinex(gRin);
+         }
+         catch (DecimateEpoch& d)
+         {
+         }
+      }
+
+      pipeline.Process(gRinVec, gds);
+      same = same && (gds == expected);
+   }
+   TUASSERT(same);
+   for (int i = 0; i < numStations-1; i++)
+   {
+      TUASSERT(acc[i].ordered);
+      TUASSERTE(unsigned, numEpochs, acc[i].count);
+      TUASSERTFE(accRef[i].sum, acc[i].sum);
+   }
+   TUASSERTE(unsigned, 0, acc[numStations-1].count);
+   TURETURN();
+}
+
+
+int StationPipeline_T ::
+statsTest()
+{
+   TUDEF("StationPipeline", "getStageStats");
+
+   vector<Accumulate> acc(numStations);
+   vector<Select> sel;
+   for (int i = 0; i < numStations; i++)
+      sel.push_back(Select(2, -1));
+   vector<ProcessingList> lists(numStations);
+   StationPipeline pipeline(3);
+   for (int i = 0; i < numStations; i++)
+   {
+      lists[i].push_back(sel[i]);
+      lists[i].push_back(acc[i]);
+      pipeline.addStation(sources[i], lists[i]);
+   }
+
+   vector<gnssRinex> gRinVec;
+   for (int epoch = 0; epoch < numEpochs; epoch++)
+   {
+      makeEpoch(epoch, gRinVec);
+      gnssDataMap gds;
+      pipeline.Process(gRinVec, gds);
+         // every other epoch is decimated before Accumulate
+      TUASSERTE(size_t, (epoch % 2) ? numStations : 0, gds.size());
+   }
+
+   vector<StationPipeline::StageStats> stats(pipeline.getStageStats());
+   TUASSERTE(size_t, 2, stats.size());
+   TUASSERTE(string, "Select", stats[0].name);
+   TUASSERTE(string, "Accumulate", stats[1].name);
+   TUASSERTE(unsigned long, numStations*numEpochs, stats[0].count);
+   TUASSERTE(unsigned long, numStations*numEpochs/2, stats[1].count);
+   unsigned long binned(0);
+   for (unsigned b = 0; b < StationPipeline::StageStats::numBins; b++)
+      binned += stats[1].bins[b];
+   TUASSERTE(unsigned long, stats[1].count, binned);
+      // Accumulate sleeps up to 400 us
+   TUASSERT(stats[1].max >= 300.0e-6);
+   TUASSERT(stats[1].total > stats[0].total);
+
+   stats = pipeline.getStageStats(sources[0]);
+   TUASSERTE(unsigned long, numEpochs/2, stats[1].count);
+
+   ostringstream s;
+   pipeline.dumpStats(s);
+   TUASSERT(s.str().find("Accumulate") != string::npos);
+
+   testFramework.changeSourceMethod("resetStats");
+   pipeline.resetStats();
+   TUASSERTE(size_t, 0, pipeline.getStageStats().size());
+   TURETURN();
+}
+
+
+int StationPipeline_T ::
+failTest()
+{
+   TUDEF("StationPipeline", "Process");
+
+      // stations 4 and 2 fail on the same epoch; 2 is reported
+   vector<Select> sel;
+   for (int i = 0; i < numStations; i++)
+      sel.push_back(Select(0, (i == 2 || i == 4) ? 3 : -1));
+   vector<ProcessingList> lists(numStations);
+   StationPipeline pipeline(4);
+   for (int i = 0; i < numStations; i++)
+   {
+      lists[i].push_back(sel[i]);
+      pipeline.addStation(sources[i], lists[i]);
+   }
+
+   vector<gnssRinex> gRinVec;
+   for (int epoch = 0; epoch < 5; epoch++)
+   {
+      makeEpoch(epoch, gRinVec);
+      gnssDataMap gds;
+      try
+      {
+         pipeline.Process(gRinVec, gds);
+         TUASSERT(epoch != 3);
+         TUASSERTE(size_t, numStations, gds.size());
+      }
+      catch (ProcessingException& e)
+      {
+         TUASSERTE(int, 3, epoch);
+         TUASSERT(e.getText().find("STA2") != string::npos);
+         TUASSERT(e.getText().find("bad epoch") != string::npos);
+         TUASSERTE(size_t, 0, gds.size());
+      }
+   }
+      // all the stations were run on the failed epoch
+   for (int i = 0; i < numStations; i++)
+      TUASSERTE(int, 5, sel[i].count);
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   StationPipeline_T testClass;
+
+   errorTotal += testClass.processTest(1);
+   errorTotal += testClass.processTest(4);
+   errorTotal += testClass.statsTest();
+   errorTotal += testClass.failTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,295 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include <cmath>
+#include <vector>
+
+#include "EarthRotationCache.hpp"
+#include "ThreadPool.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+   /** Compare the interpolated terrestrial / inertial transformation of
+    * EarthRotationCache with the SOFA example ("SOFA Tools for Earth
+    * Attitude", cf. test_EO_SOFA and data/EarthOrientation_SOFA.exp) and
+    * with EarthOrientation::ECEFtoInertial(), which evaluates the series. */
+class EarthRotationCache_T
+{
+public:
+      /// the SOFA example at 2007/4/5 12:00 UTC
+   int sofaTest();
+      /// cache against the series over 1990-2040, and the node count
+   int seriesTest();
+      /// several threads sharing one cache, one changing its spacing
+   int threadTest();
+      /// spacing, clear() and IERS1996
+   int spacingTest();
+
+      /// largest difference between elements of two 3x3 matrices
+   static double maxDiff(const Matrix<double>& a, const Matrix<double>& b);
+      /// EOPs of the SOFA example, with convention conv
+   static EarthOrientation sofaEOP(IERSConvention conv);
+};
+
+
+double EarthRotationCache_T ::
+maxDiff(const Matrix<double>& a, const Matrix<double>& b)
+{
+   double mx(0.0);
+   for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++)
+         mx = std::max(mx, std::fabs(a(i,j)-b(i,j)));
+   return mx;
+}
+
+
+EarthOrientation EarthRotationCache_T ::
+sofaEOP(IERSConvention conv)
+{
+   EarthOrientation eo;
+   eo.convention = conv;
+   eo.xp = 0.0349282;            // arcsec
+   eo.yp = 0.4833163;            // arcsec
+   eo.UT1mUTC = -0.072073685;    // sec
+   return eo;
+}
+
+
+int EarthRotationCache_T ::
+sofaTest()
+{
+   TUDEF("EarthRotationCache", "ECEFtoInertial");
+
+      // celestial-to-terrestrial matrices of the SOFA example
+   const double c2t2003[3][3] = {
+      { +0.973480641543354, +0.228768323473305, -0.000703360187516 },
+      { -0.228768298106262, +0.973480894522827, +0.000117390801227 },
+      { +0.000711563001303, +0.000046628840564, +0.999999745751891 } };
+   const double c2t2010[3][3] = {
+      { +0.973104317698039, +0.230363826238753, -0.000703162908457 },
+      { -0.230363800456532, +0.973104570632837, +0.000118544106933 },
+      { +0.000711559314170, +0.000046627497638, +0.999999745754577 } };
+
+   EphTime ttag(54195, 43200.0, TimeSystem::UTC);
+   EarthRotationCache erc;
+
+   Matrix<double> M = transpose(
+      erc.ECEFtoInertial(sofaEOP(IERSConvention::IERS2003), ttag));
+   for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++)
+         TUASSERTFEPS(c2t2003[i][j], M(i,j), 1.e-12);
+
+   M = transpose(erc.ECEFtoInertial(sofaEOP(IERSConvention::IERS2010), ttag));
+   for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++)
+         TUASSERTFEPS(c2t2010[i][j], M(i,j), 1.e-12);
+
+      // CIP coordinates and CIO locator (s in arcsec)
+   double X, Y, s;
+   erc.XYS2010(ttag, X, Y, s);
+   TUASSERTFEPS(+0.000712263881101, X, 1.e-14);
+   TUASSERTFEPS(+0.000044386344069, Y, 1.e-14);
+   TUASSERTFEPS(-0.002200474866813, s/EarthOrientation::ARCSEC_TO_RAD, 1.e-9);
+
+   TURETURN();
+}
+
+
+int EarthRotationCache_T ::
+seriesTest()
+{
+   TUDEF("EarthRotationCache", "ECEFtoInertial");
+
+      // 0.2 microarcsecond, the bound documented for the default spacing
+   const double tol(0.2 * EarthOrientation::ARCSEC_TO_RAD * 1.e-6);
+   IERSConvention convs[2] = { IERSConvention::IERS2003,
+                               IERSConvention::IERS2010 };
+
+   for (int c = 0; c < 2; c++)
+   {
+      EarthRotationCache erc;
+      EarthOrientation eo(sofaEOP(convs[c]));
+      double mx(0.0);
+         // epochs spread over 1990-2040, each at a different
+         // position between the nodes
+      for (int i = 0; i < 500; i++)
+      {
+         EphTime t(47892 + 36*i, 86400.0*std::fmod(0.3819*i, 1.0),
+                   TimeSystem::UTC);
+         mx = std::max(mx, maxDiff(eo.ECEFtoInertial(t),
+                                   erc.ECEFtoInertial(eo, t)));
+      }
+      TUASSERT(mx < tol);
+
+         // one day of 30 second data uses no more than 12 nodes
+      erc.clear();
+      mx = 0.0;
+      for (int i = 0; i < 2880; i += 7)
+      {
+         EphTime t(58000, 30.0*i, TimeSystem::UTC);
+         mx = std::max(mx, maxDiff(eo.ECEFtoInertial(t),
+                                   erc.ECEFtoInertial(eo, t)));
+      }
+      TUASSERT(mx < tol);
+      TUASSERT(erc.size() <= 12);
+   }
+
+      // interpolated series values
+   EarthRotationCache erc;
+   EphTime t(58000, 12345.6, TimeSystem::UTC);
+   double deps, dpsi, X, Y, s;
+   erc.NutationAngles2003(t, deps, dpsi);
+   erc.XYS2010(t, X, Y, s);
+   TUASSERT(std::fabs(dpsi) > 1.e-6);
+   TUASSERT(std::fabs(deps) > 1.e-6);
+   TUASSERT(X > 0.0);
+   TUASSERT(std::fabs(s) < 1.e-7);
+
+   TURETURN();
+}
+
+
+int EarthRotationCache_T ::
+threadTest()
+{
+   TUDEF("EarthRotationCache", "ECEFtoInertial");
+
+   const int nEpochs(400);
+   EarthOrientation eo(sofaEOP(IERSConvention::IERS2010));
+
+   vector<EphTime> times;
+   vector<Matrix<double> > expected;
+   for (int i = 0; i < nEpochs; i++)
+   {
+      times.push_back(EphTime(58000 + i/40, 2160.0*(i%40), TimeSystem::UTC));
+      expected.push_back(eo.ECEFtoInertial(times.back()));
+   }
+
+   EarthRotationCache erc;
+   vector<double> diffs(nEpochs, 1.0);
+   {
+      ThreadPool pool(4);
+      for (int i = 0; i < nEpochs; i++)
+      {
+         pool.submit([&, i]()
+                     {
+                        diffs[i] = maxDiff(expected[i],
+                                           erc.ECEFtoInertial(eo, times[i]));
+                     });
+            // changing the spacing meanwhile; both are accurate enough
+         if (i % 10 == 5)
+            pool.submit([&, i]()
+                        { erc.setSpacing(i % 20 == 5 ? 0.0625 : 0.125); });
+      }
+      pool.wait();
+   }
+
+   double mx(0.0);
+   for (int i = 0; i < nEpochs; i++)
+      mx = std::max(mx, diffs[i]);
+   TUASSERT(mx < 1.e-12);
+
+   TURETURN();
+}
+
+
+int EarthRotationCache_T ::
+spacingTest()
+{
+   TUDEF("EarthRotationCache", "setSpacing");
+
+   try
+   {
+      EarthRotationCache erc(0.0);
+      TUFAIL("Zero spacing was accepted");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("Zero spacing rejected");
+   }
+
+   EarthRotationCache erc;
+   TUASSERTFE(0.125, erc.getSpacing());
+   try
+   {
+      erc.setSpacing(-1.0);
+      TUFAIL("Negative spacing was accepted");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("Negative spacing rejected");
+   }
+   TUASSERTFE(0.125, erc.getSpacing());
+
+      // a coarse grid is still consistent, but less accurate
+   EarthOrientation eo(sofaEOP(IERSConvention::IERS2010));
+   EphTime t(58000, 30000.0, TimeSystem::UTC);
+   erc.ECEFtoInertial(eo, t);
+   TUASSERTE(size_t, 4, erc.size());
+   erc.setSpacing(1.0);
+   TUASSERTE(size_t, 0, erc.size());
+   double d(maxDiff(eo.ECEFtoInertial(t), erc.ECEFtoInertial(eo, t)));
+   TUASSERT(d > 1.e-12);
+   TUASSERT(d < 1.e-8);
+   erc.clear();
+   TUASSERTE(size_t, 0, erc.size());
+
+      // IERS1996 is not cached
+   eo.convention = IERSConvention::IERS1996;
+   TUASSERTFE(0.0, maxDiff(eo.ECEFtoInertial(t), erc.ECEFtoInertial(eo, t)));
+   TUASSERTE(size_t, 0, erc.size());
+
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   EarthRotationCache_T testClass;
+
+   errorTotal += testClass.sofaTest();
+   errorTotal += testClass.seriesTest();
+   errorTotal += testClass.threadTest();
+   errorTotal += testClass.spacingTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,215 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/** @file SparseSRIFilterTiming.cpp
+ * Measure the time and memory of a network filter with SparseSRIFilter,
+ * and optionally with the dense SRIFilter.
+ *
+ * Usage: SparseSRIFilterTiming [-s stations] [-k sats] [-n epochs] [-dense]
+ *
+ * Each station has three coordinates, a receiver clock and a zenith
+ * delay, and sees every satellite (default 8); each satellite has a
+ * (constant) orbit parameter, which couples all the stations, and
+ * each station/satellite pair an ambiguity.  Every epoch has a
+ * pseudorange and a phase per pair, followed by a time update of the
+ * receiver clocks (white noise) and zenith delays (random walk).
+ * The clocks and zenith delays, then the satellite parameters, are
+ * ordered last. */
+
+#include <ctime>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include "SparseSRIFilter.hpp"
+#include "SRIFilter.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+   /// State indexes of the network.
+struct Network
+{
+   Network(unsigned ns, unsigned nk)
+         : nsta(ns), nsat(nk), nstate(5*ns + nk + ns*nk)
+   {}
+   unsigned crd(unsigned s) const { return 5*s; }
+   unsigned rclk(unsigned s) const { return 5*s+3; }
+   unsigned trop(unsigned s) const { return 5*s+4; }
+   unsigned orbit(unsigned k) const { return 5*nsta+k; }
+   unsigned amb(unsigned s, unsigned k) const
+   { return 5*nsta+nsat+s*nsat+k; }
+   unsigned nsta, nsat, nstate;
+};
+
+
+   /// One epoch of simulated partials and data.
+static void epoch(const Network& net, SparseMatrix<double>& H,
+                  Vector<double>& D, unsigned& seed)
+{
+   H = SparseMatrix<double>(2*net.nsta*net.nsat, net.nstate);
+   D = Vector<double>(H.rows());
+   unsigned row = 0;
+   for (unsigned s = 0; s < net.nsta; s++)
+   {
+      for (unsigned k = 0; k < net.nsat; k++, row += 2)
+      {
+         seed = seed * 1103515245u + 12345u;
+         double az = double((seed >> 8) & 0xffff) / 65536. * 2. * M_PI;
+         seed = seed * 1103515245u + 12345u;
+         double el = (10. + double((seed >> 8) & 0xffff) / 65536. * 80.) *
+            M_PI/180.;
+         double u[3] = { cos(el)*sin(az), cos(el)*cos(az), sin(el) };
+            // pseudorange, then phase 100 times more precise
+         for (unsigned p = 0; p < 2; p++)
+         {
+            double w = (p ? 100. : 1.);
+            for (unsigned j = 0; j < 3; j++)
+               H(row+p, net.crd(s)+j) = -w*u[j];
+            H(row+p, net.rclk(s)) = w;
+            H(row+p, net.orbit(k)) = w*u[k%3];
+            H(row+p, net.trop(s)) = w/sin(el);
+            if (p)
+               H(row+p, net.amb(s,k)) = w;
+            D(row+p) = w * double(int((seed >> 4) % 21) - 10) * 0.001;
+         }
+      }
+   }
+}
+
+
+int main(int argc, char *argv[])
+{
+   unsigned nsta = 100, nsat = 8, epochs = 10;
+   bool dense = false;
+   for (int i = 1; i < argc; i++)
+   {
+      if ((strcmp(argv[i], "-s") == 0) && (i+1 < argc))
+         nsta = strtoul(argv[++i], 0, 10);
+      else if ((strcmp(argv[i], "-k") == 0) && (i+1 < argc))
+         nsat = strtoul(argv[++i], 0, 10);
+      else if ((strcmp(argv[i], "-n") == 0) && (i+1 < argc))
+         epochs = strtoul(argv[++i], 0, 10);
+      else if (strcmp(argv[i], "-dense") == 0)
+         dense = true;
+   }
+
+   Network net(nsta, nsat);
+   const unsigned n = net.nstate;
+   cout << nsta << " stations, " << nsat << " satellites, " << n
+        << " states, " << 2*nsta*nsat << " data per epoch" << endl;
+
+      // a priori, and the noise model of the time update
+   vector<unsigned int> index(n), noisy, last;
+   Vector<double> X(n, 0.), sigma(n, 100.);
+   Matrix<double> Cov(dense ? n : 0, dense ? n : 0, 0.);
+   for (unsigned i = 0; i < n; i++)
+   {
+      index[i] = i;
+      if (dense)
+         Cov(i,i) = sigma(i)*sigma(i);
+   }
+   for (unsigned s = 0; s < nsta; s++)
+   {
+      noisy.push_back(net.rclk(s));
+      noisy.push_back(net.trop(s));
+   }
+   last = noisy;
+   for (unsigned k = 0; k < nsat; k++)
+      last.push_back(net.orbit(k));
+   Vector<double> phi(noisy.size(), 1.), qsig(noisy.size(), 1.e3);
+   for (unsigned s = 0; s < nsta; s++)
+      qsig(2*s+1) = 0.001;
+
+   SparseMatrix<double> H;
+   Vector<double> D, Xs, Xd;
+   unsigned seed = 12345;
+
+   SparseSRIFilter sparse(n);
+   sparse.addAPriori(index, X, sigma);
+   clock_t t0 = clock();
+   for (unsigned e = 0; e < epochs; e++)
+   {
+      epoch(net, H, D, seed);
+      if (e == 0)
+         sparse.computeOrdering(H, last);
+      sparse.measurementUpdate(H, D);
+      sparse.timeUpdate(noisy, phi, qsig);
+   }
+   sparse.getState(Xs);
+   double tsparse = double(clock() - t0) / CLOCKS_PER_SEC / epochs;
+   cout << fixed << setprecision(3) << "SparseSRIFilter: " << tsparse
+        << " s per epoch, R has " << sparse.datasize() << " non-zeros ("
+        << setprecision(1) << 100.*sparse.datasize()/(0.5*n*(n+1.))
+        << "% of the triangle)" << endl;
+
+   if (dense)
+   {
+      SRIFilter sri(n);
+      sri.addAPriori(Cov, X);
+      seed = 12345;
+      t0 = clock();
+      for (unsigned e = 0; e < epochs; e++)
+      {
+         epoch(net, H, D, seed);
+         Matrix<double> Hd(H);
+         sri.measurementUpdate(Hd, D);
+         for (size_t i = 0; i < noisy.size(); i++)
+         {
+            Matrix<double> PhiInv(ident<double>(n)), Rw(1,1,1./qsig(i));
+            Matrix<double> G(n,1,0.), Rwx(1,n);
+            Vector<double> Zw(1,0.);
+            G(noisy[i],0) = 1.;
+            sri.timeUpdate(PhiInv, Rw, G, Zw, Rwx);
+         }
+      }
+      sri.getState(Xd);
+      double tdense = double(clock() - t0) / CLOCKS_PER_SEC / epochs;
+      double dx = 0.;
+      for (unsigned i = 0; i < n; i++)
+         dx = max(dx, fabs(Xd(i) - Xs(i)));
+      cout << setprecision(3) << "SRIFilter:       " << tdense
+           << " s per epoch, ratio " << setprecision(1) << tdense/tsparse
+           << ", largest state difference " << scientific << setprecision(2)
+           << dx << endl;
+   }
+   return 0;
+}
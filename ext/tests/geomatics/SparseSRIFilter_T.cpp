@@ -0,0 +1,438 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2018, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include <cmath>
+#include <vector>
+
+#include "SparseSRIFilter.hpp"
+#include "SRIFilter.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+   /** Compare SparseSRIFilter with the dense SRIFilter on a small
+    * network: each station has three coordinates and a zenith delay,
+    * each satellite a clock, and each station/satellite pair an
+    * ambiguity. */
+class SparseSRIFilter_T
+{
+public:
+   SparseSRIFilter_T();
+
+      /// measurement updates with and without a fill-reducing order
+   int measurementTest();
+      /// time updates with finite, zero and very large process noise
+   int timeUpdateTest();
+      /// minimum degree ordering and re-ordering of existing information
+   int orderingTest();
+
+private:
+      /// state index of the coordinates of station s
+   unsigned int crd(unsigned int s) const { return 4*s; }
+      /// state index of the zenith delay of station s
+   unsigned int trop(unsigned int s) const { return 4*s+3; }
+      /// state index of the clock of satellite k
+   unsigned int clk(unsigned int k) const { return 4*nsta+k; }
+      /// state index of the ambiguity of station s, satellite k
+   unsigned int amb(unsigned int s, unsigned int k) const
+   { return 4*nsta+nsat+s*nsat+k; }
+
+      /// reproducible pseudo-random number in [-1,1)
+   double random();
+      /// one epoch of (simulated) partials and data, all pairs in view
+   void epoch(SparseMatrix<double>& H, Vector<double>& D);
+      /// add the same a priori information to both filters
+   void apriori(SRIFilter& dense, SparseSRIFilter& sparse);
+      /// largest difference of state and covariance, relative to the largest
+      /// element of the dense result
+   void compare(SRIFilter& dense, const SparseSRIFilter& sparse,
+                double& dx, double& dc);
+
+   unsigned int nsta, nsat, nstate;
+   unsigned long seed;
+};
+
+
+SparseSRIFilter_T ::
+SparseSRIFilter_T()
+      : nsta(6), nsat(5), seed(12345)
+{
+   nstate = 4*nsta + nsat + nsta*nsat;
+}
+
+
+double SparseSRIFilter_T ::
+random()
+{
+   seed = (seed * 1103515245UL + 12345UL) % 2147483648UL;
+   return double(seed)/1073741824.0 - 1.0;
+}
+
+
+void SparseSRIFilter_T ::
+epoch(SparseMatrix<double>& H, Vector<double>& D)
+{
+   H = SparseMatrix<double>(nsta*nsat, nstate);
+   D = Vector<double>(nsta*nsat);
+   unsigned int row(0);
+   for(unsigned int s=0; s<nsta; s++) {
+      for(unsigned int k=0; k<nsat; k++, row++) {
+         for(unsigned int i=0; i<3; i++)
+            H(row, crd(s)+i) = random();
+         H(row, trop(s)) = 1.5 + random();
+         H(row, clk(k)) = 1.0;
+         H(row, amb(s,k)) = 1.0;
+         D(row) = 0.1 * random();
+      }
+   }
+}
+
+
+void SparseSRIFilter_T ::
+apriori(SRIFilter& dense, SparseSRIFilter& sparse)
+{
+   Matrix<double> Cov(nstate, nstate, 0.0);
+   Vector<double> X(nstate), sigma(nstate);
+   vector<unsigned int> index(nstate);
+   for(unsigned int i=0; i<nstate; i++) {
+      index[i] = i;
+      X(i) = 0.01 * random();
+      sigma(i) = (i < 4*nsta ? 1.0 : 100.0);
+      Cov(i,i) = sigma(i)*sigma(i);
+   }
+   dense.addAPriori(Cov, X);
+   sparse.addAPriori(index, X, sigma);
+}
+
+
+void SparseSRIFilter_T ::
+compare(SRIFilter& dense, const SparseSRIFilter& sparse, double& dx, double& dc)
+{
+   Vector<double> Xd, Xs;
+   Matrix<double> Cd, Cs;
+   dense.getStateAndCovariance(Xd, Cd);
+   sparse.getStateAndCovariance(Xs, Cs);
+   double xmax(0.0), cmax(0.0);
+   dx = dc = 0.0;
+   for(unsigned int i=0; i<nstate; i++) {
+      xmax = max(xmax, fabs(Xd(i)));
+      dx = max(dx, fabs(Xd(i) - Xs(i)));
+      for(unsigned int j=0; j<nstate; j++) {
+         cmax = max(cmax, fabs(Cd(i,j)));
+         dc = max(dc, fabs(Cd(i,j) - Cs(i,j)));
+      }
+   }
+   dx /= xmax;
+   dc /= cmax;
+}
+
+
+int SparseSRIFilter_T ::
+measurementTest()
+{
+   TUDEF("SparseSRIFilter", "measurementUpdate");
+
+   SRIFilter dense(nstate);
+   SparseSRIFilter natural(nstate), ordered(nstate);
+   apriori(dense, natural);
+   seed = 12345;
+   SRIFilter dummy(nstate);
+   apriori(dummy, ordered);
+
+      // states with process noise go last, the ambiguities first
+   vector<unsigned int> last;
+   for(unsigned int s=0; s<nsta; s++) last.push_back(trop(s));
+   for(unsigned int k=0; k<nsat; k++) last.push_back(clk(k));
+
+   SparseMatrix<double> H;
+   Vector<double> D;
+   for(int n=0; n<5; n++) {
+      epoch(H, D);
+      if(n == 0)
+         TUCATCH(ordered.computeOrdering(H, last));
+
+      Matrix<double> Hd(H);
+      Vector<double> Dd(D), Dn(D), Do(D);
+      dense.measurementUpdate(Hd, Dd);
+      TUCATCH(natural.measurementUpdate(H, Dn));
+      TUCATCH(ordered.measurementUpdate(H, Do));
+
+         // the residuals are rotated differently, but their sum of
+         // squares is the same
+      double ssd(0.0), ssn(0.0), sso(0.0);
+      for(size_t i=0; i<D.size(); i++) {
+         ssd += Dd(i)*Dd(i);
+         ssn += Dn(i)*Dn(i);
+         sso += Do(i)*Do(i);
+      }
+      TUASSERTFEPS(ssd, ssn, 1.e-10*ssd);
+      TUASSERTFEPS(ssd, sso, 1.e-10*ssd);
+   }
+
+   double dx, dc;
+   compare(dense, natural, dx, dc);
+   TUASSERT(dx < 1.e-10);
+   TUASSERT(dc < 1.e-10);
+   compare(dense, ordered, dx, dc);
+   TUASSERT(dx < 1.e-10);
+   TUASSERT(dc < 1.e-10);
+
+      // the states with process noise are last, in the order given
+   const vector<unsigned int>& order(ordered.getOrdering());
+   for(size_t i=0; i<last.size(); i++)
+      TUASSERTE(unsigned int, last[i], order[nstate-last.size()+i]);
+   TUASSERT(ordered.datasize() < natural.datasize());
+
+      // with a measurement covariance
+   SparseMatrix<double> CM(D.size(), D.size());
+   for(unsigned int i=0; i<D.size(); i++) {
+      CM(i,i) = 4.e-4;
+      if(i > 0) CM(i,i-1) = CM(i-1,i) = 1.e-4;
+   }
+   epoch(H, D);
+   Matrix<double> Hd(H), CMd(CM);
+   Vector<double> Dd(D), Ds(D);
+   dense.measurementUpdate(Hd, Dd, CMd);
+   TUCATCH(ordered.measurementUpdate(H, Ds, CM));
+   compare(dense, ordered, dx, dc);
+   TUASSERT(dx < 1.e-10);
+   TUASSERT(dc < 1.e-10);
+
+      // dimension errors
+   try {
+      Vector<double> Dbad(D.size()+1);
+      ordered.measurementUpdate(H, Dbad);
+      TUFAIL("Inconsistent dimensions were accepted");
+   }
+   catch(MatrixException& e) {
+      TUPASS("Inconsistent dimensions rejected");
+   }
+
+      // no information on a state
+   SparseSRIFilter empty(nstate);
+   try {
+      Vector<double> X;
+      empty.getState(X);
+      TUFAIL("Singular SRI was accepted");
+   }
+   catch(MatrixException& e) {
+      TUPASS("Singular SRI rejected");
+   }
+   TURETURN();
+}
+
+
+int SparseSRIFilter_T ::
+timeUpdateTest()
+{
+   TUDEF("SparseSRIFilter", "timeUpdate");
+
+   SRIFilter dense(nstate);
+   SparseSRIFilter sparse(nstate);
+   seed = 54321;
+   apriori(dense, sparse);
+   vector<unsigned int> last;
+   for(unsigned int s=0; s<nsta; s++) last.push_back(trop(s));
+   for(unsigned int k=0; k<nsat; k++) last.push_back(clk(k));
+
+   SparseMatrix<double> H;
+   Vector<double> D;
+   double dx, dc;
+   for(int n=0; n<6; n++) {
+      epoch(H, D);
+      if(n == 0)
+         TUCATCH(sparse.computeOrdering(H, last));
+      Matrix<double> Hd(H);
+      Vector<double> Dd(D);
+      dense.measurementUpdate(Hd, Dd);
+      sparse.measurementUpdate(H, D);
+
+         // random walk zenith delays, white satellite clocks, a
+         // Gauss-Markov coordinate and, once, a reset ambiguity
+      vector<unsigned int> index;
+      vector<double> phi, sigma;
+      for(unsigned int s=0; s<nsta; s++) {
+         index.push_back(trop(s)); phi.push_back(1.0); sigma.push_back(0.01);
+      }
+      for(unsigned int k=0; k<nsat; k++) {
+         index.push_back(clk(k)); phi.push_back(1.0); sigma.push_back(1.e3);
+      }
+      index.push_back(crd(1)+2); phi.push_back(0.9); sigma.push_back(0.1);
+      index.push_back(crd(2)); phi.push_back(0.5); sigma.push_back(0.0);
+      if(n == 3) {
+         index.push_back(amb(4,2)); phi.push_back(1.0); sigma.push_back(1.e3);
+      }
+
+      for(size_t i=0; i<index.size(); i++) {
+         Matrix<double> PhiInv(ident<double>(nstate)), Rw(1,1), G(nstate,1,0.0);
+         Matrix<double> Rwx(1,nstate);
+         Vector<double> Zw(1,0.0);
+         PhiInv(index[i],index[i]) = 1.0/phi[i];
+         G(index[i],0) = 1.0;
+         Rw(0,0) = (sigma[i] > 0.0 ? 1.0/sigma[i] : 1.e20);
+         dense.timeUpdate(PhiInv, Rw, G, Zw, Rwx);
+      }
+      Vector<double> vphi(phi.size()), vsigma(sigma.size());
+      for(size_t i=0; i<phi.size(); i++) {
+         vphi(i) = phi[i];
+         vsigma(i) = sigma[i];
+      }
+      TUCATCH(sparse.timeUpdate(index, vphi, vsigma));
+
+      compare(dense, sparse, dx, dc);
+      TUASSERT(dx < 1.e-9);
+      TUASSERT(dc < 1.e-9);
+   }
+
+      // infinite noise removes all information on the state...
+   SparseSRIFilter reset(sparse);
+   TUCATCH(reset.timeUpdate(amb(0,0), 1.0, -1.0));
+   try {
+      Vector<double> X;
+      reset.getState(X);
+      TUFAIL("Reset state still has information");
+   }
+   catch(MatrixException& e) {
+      TUPASS("Reset state has no information");
+   }
+      // ... and new information on it restores the solution
+   vector<unsigned int> index(1, amb(0,0));
+   Vector<double> X, Xs, sigma(1, 1.e-6);
+   sparse.getState(Xs);
+   TUCATCH(reset.addAPriori(index, Vector<double>(1, Xs(amb(0,0))), sigma));
+   TUCATCH(reset.getState(X));
+   TUASSERTFEPS(Xs(amb(1,1)), X(amb(1,1)), 1.e-6);
+
+   try {
+      sparse.timeUpdate(nstate, 1.0, 1.0);
+      TUFAIL("Invalid state index was accepted");
+   }
+   catch(MatrixException& e) {
+      TUPASS("Invalid state index rejected");
+   }
+   TURETURN();
+}
+
+
+int SparseSRIFilter_T ::
+orderingTest()
+{
+   TUDEF("SparseSRIFilter", "minimumDegree");
+
+      // star graph: leaves first; when one leaf is left it ties with the
+      // center, and ties go to the smaller index
+   vector< vector<unsigned int> > adj(6);
+   for(unsigned int i=1; i<6; i++) adj[0].push_back(i);
+   vector<unsigned int> order(SparseSRIFilter::minimumDegree(adj));
+   TUASSERTE(size_t, 6, order.size());
+   for(unsigned int i=0; i<4; i++)
+      TUASSERTE(unsigned int, i+1, order[i]);
+   TUASSERTE(unsigned int, 0, order[4]);
+   TUASSERTE(unsigned int, 5, order[5]);
+
+      // node 3 is forced last; ties go to the smaller index
+   vector<unsigned int> last(1, 3);
+   adj.push_back(vector<unsigned int>(1, 2));     // node 6, a leaf of 2
+   order = SparseSRIFilter::minimumDegree(adj, last);
+   TUASSERTE(unsigned int, 3, order[6]);
+   TUASSERTE(unsigned int, 1, order[0]);
+   TUASSERTE(unsigned int, 6, order[3]);
+
+   try {
+      adj[1].push_back(7);
+      SparseSRIFilter::minimumDegree(adj);
+      TUFAIL("Invalid adjacency was accepted");
+   }
+   catch(MatrixException& e) {
+      TUPASS("Invalid adjacency rejected");
+   }
+
+      // arrow matrix: with the dense state first, R fills in completely;
+      // the minimum degree order puts it (nearly) last, and there is no fill
+   const unsigned int n(20);
+   SparseMatrix<double> H(n, n);
+   Vector<double> D(n), X0, X1;
+   for(unsigned int i=0; i<n; i++) {
+      H(i,0) = 1.0;
+      H(i,i) = 2.0 + i;
+      D(i) = double(i);
+   }
+   SparseSRIFilter natural(n), ordered(n);
+   Vector<double> Dn(D), Do(D);
+   natural.measurementUpdate(H, Dn);
+   ordered.computeOrdering(H);
+   ordered.measurementUpdate(H, Do);
+   TUASSERTE(unsigned int, n*(n+1)/2, natural.datasize());
+   TUASSERTE(unsigned int, 2*n-1, ordered.datasize());
+   TUASSERTE(unsigned int, 0, ordered.getOrdering()[n-2]);
+
+      // re-ordering existing information does not change the solution
+   natural.getState(X0);
+   TUCATCH(natural.setOrdering(ordered.getOrdering()));
+   natural.getState(X1);
+   for(unsigned int i=0; i<n; i++)
+      TUASSERTFEPS(X0(i), X1(i), 1.e-12);
+   ordered.getState(X1);
+   for(unsigned int i=0; i<n; i++)
+      TUASSERTFEPS(X0(i), X1(i), 1.e-12);
+
+   try {
+      vector<unsigned int> bad(n, 0);
+      natural.setOrdering(bad);
+      TUFAIL("Invalid ordering was accepted");
+   }
+   catch(MatrixException& e) {
+      TUPASS("Invalid ordering rejected");
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   int errorTotal = 0;
+   SparseSRIFilter_T testClass;
+
+   errorTotal += testClass.measurementTest();
+   errorTotal += testClass.timeUpdateTest();
+   errorTotal += testClass.orderingTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}